@@ -0,0 +1,71 @@
+#!/usr/bin/env python
+
+"""
+Compares two JSON outputs of a google benchmark suite, e.g. ct_benchmarks run with
+--benchmark_out=<file> --benchmark_out_format=json.
+
+usage: compare_benchmarks.py baseline.json contender.json [--threshold 0.1] [--metric real_time|cpu_time]
+
+Prints the relative change of every benchmark present in both files and returns 1 if any benchmark got
+slower than the threshold, so the script can be used as a regression check.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import sys
+
+
+def load(file_name, metric):
+    with open(file_name) as f:
+        data = json.load(f)
+
+    times = {}
+    for benchmark in data["benchmarks"]:
+        # skip aggregates (mean, median, stddev) of repeated runs, compare the mean if present
+        run_type = benchmark.get("run_type", "iteration")
+        if run_type == "aggregate" and benchmark.get("aggregate_name") != "mean":
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        times[name] = benchmark[metric]
+    return times
+
+
+def main(argv=sys.argv[1:]):
+    parser = argparse.ArgumentParser(description="Compare two google benchmark JSON outputs.")
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.1, help="relative slow-down counted as regression")
+    parser.add_argument("--metric", default="real_time", choices=["real_time", "cpu_time"])
+    args = parser.parse_args(argv)
+
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+
+    regressions = []
+    width = max([len(name) for name in baseline] + [9])
+    print("{:<{w}}  {:>14}  {:>14}  {:>8}".format("benchmark", "baseline", "contender", "change", w=width))
+    for name in sorted(baseline):
+        if name not in contender:
+            print("{:<{w}}  {:>14.4g}  {:>14}".format(name, baseline[name], "missing", w=width))
+            continue
+        change = contender[name] / baseline[name] - 1.0 if baseline[name] > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        print("{:<{w}}  {:>14.4g}  {:>14.4g}  {:>+7.1%}{}".format(
+            name, baseline[name], contender[name], change, flag, w=width))
+
+    for name in sorted(set(contender) - set(baseline)):
+        print("{:<{w}}  {:>14}  {:>14.4g}".format(name, "new", contender[name], w=width))
+
+    if regressions:
+        print("\n{} benchmark(s) slower by more than {:.0%}".format(len(regressions), args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
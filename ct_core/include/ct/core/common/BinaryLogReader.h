@@ -0,0 +1,170 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <map>
+
+#include "BinaryLogger.h"
+
+namespace ct {
+namespace core {
+
+//! Reads log files written by BinaryLogger
+/*!
+ * The file is memory-mapped, records refer to the mapped data without copying it.
+ * An incomplete record at the end of the file, e.g. from a logger which is still running or crashed, is ignored.
+ *
+ * Usage:
+ * \code
+ * ct::core::BinaryLogReader reader("log.ctlog");
+ * for (const auto& record : reader.records("x"))
+ *     std::cout << "iteration " << record.index << ": x0 = " << record.sample(0).transpose() << std::endl;
+ * \endcode
+ */
+class BinaryLogReader
+{
+public:
+    //! a DATA record, see BinaryLogFormat
+    struct Record
+    {
+        int64_t index;
+        double time;
+        size_t rows;
+        size_t cols;
+        size_t samples;
+        const double* data;  //!< points into the mapped file
+
+        //! the i-th matrix of this record
+        Eigen::Map<const Eigen::MatrixXd> sample(size_t i) const
+        {
+            return Eigen::Map<const Eigen::MatrixXd>(data + i * rows * cols, rows, cols);
+        }
+    };
+
+    //! opens and maps the file, throws if it is not a binary log
+    BinaryLogReader(const std::string& fileName) : data_(nullptr), size_(0)
+    {
+        const int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("BinaryLogReader: could not open " + fileName);
+
+        struct stat fileStat;
+        if (::fstat(fd, &fileStat) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("BinaryLogReader: could not stat " + fileName);
+        }
+        size_ = fileStat.st_size;
+
+        if (size_ > 0)
+        {
+            void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("BinaryLogReader: could not map " + fileName);
+            }
+            data_ = static_cast<const char*>(mapped);
+        }
+        ::close(fd);
+
+        if (size_ < BinaryLogFormat::fileHeaderBytes || std::memcmp(data_, BinaryLogFormat::magic(), 8) != 0)
+        {
+            unmap();
+            throw std::runtime_error("BinaryLogReader: " + fileName + " is not a binary log file");
+        }
+
+        parse();
+    }
+
+    BinaryLogReader(const BinaryLogReader&) = delete;
+    BinaryLogReader& operator=(const BinaryLogReader&) = delete;
+
+    ~BinaryLogReader() { unmap(); }
+
+    //! names of all channels, the position is the channel id
+    const std::vector<std::string>& channelNames() const { return channelNames_; }
+
+    bool hasChannel(const std::string& name) const { return channelIds_.find(name) != channelIds_.end(); }
+
+    //! all records of a channel in the order they were written
+    const std::vector<Record>& records(size_t channel) const { return records_.at(channel); }
+
+    //! all records of the first channel with the given name
+    const std::vector<Record>& records(const std::string& name) const
+    {
+        auto it = channelIds_.find(name);
+        if (it == channelIds_.end())
+            throw std::runtime_error("BinaryLogReader: unknown channel " + name);
+        return records_[it->second];
+    }
+
+private:
+    void parse()
+    {
+        typedef BinaryLogFormat::RecordHeader Header;
+
+        size_t pos = BinaryLogFormat::fileHeaderBytes;
+        while (pos + sizeof(Header) <= size_)
+        {
+            Header header;
+            std::memcpy(&header, data_ + pos, sizeof(Header));
+            pos += sizeof(Header);
+
+            if (header.payloadBytes > size_ - pos)
+                break;
+
+            const char* payload = data_ + pos;
+            pos += header.payloadBytes;
+
+            if (header.type == BinaryLogFormat::CHANNEL)
+            {
+                if (header.channel >= channelNames_.size())
+                {
+                    channelNames_.resize(header.channel + 1);
+                    records_.resize(header.channel + 1);
+                }
+                const std::string name(payload, ::strnlen(payload, header.payloadBytes));
+                channelNames_[header.channel] = name;
+                channelIds_.insert(std::make_pair(name, header.channel));
+            }
+            else if (header.type == BinaryLogFormat::DATA && header.channel < records_.size())
+            {
+                Record record;
+                record.index = header.index;
+                record.time = header.time;
+                record.rows = header.rows;
+                record.cols = header.cols;
+                record.samples = header.samples;
+                record.data = reinterpret_cast<const double*>(payload);
+                records_[header.channel].push_back(record);
+            }
+        }
+    }
+
+    void unmap()
+    {
+        if (data_)
+            ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+    }
+
+    const char* data_;
+    size_t size_;
+
+    std::vector<std::string> channelNames_;
+    std::map<std::string, size_t> channelIds_;
+    std::vector<std::vector<Record>> records_;
+};
+
+}  // namespace core
+}  // namespace ct
@@ -0,0 +1,375 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace ct {
+namespace core {
+
+//! Layout of the binary log files written by BinaryLogger and read by BinaryLogReader
+/*!
+ * A log file starts with the 8 byte magic string "CTBLOG01" followed by a 64 bit version number. It is followed by
+ * records, each consisting of a RecordHeader and a payload of RecordHeader::payloadBytes bytes.
+ *
+ * - CHANNEL records define a channel. The payload is its name, zero-padded to a multiple of 8 bytes.
+ * - DATA records contain 'samples' matrices of size rows x cols of a channel as contiguous doubles, every matrix
+ *   stored column-major. A record is usually one trajectory, e.g. the states of one solver iteration.
+ *
+ * All headers and payloads are multiples of 8 bytes, so a memory-mapped file can be accessed in place.
+ * Data is stored in the byte order of the machine it was written on.
+ */
+struct BinaryLogFormat
+{
+    enum RecordType : uint32_t
+    {
+        CHANNEL = 0,
+        DATA = 1
+    };
+
+    struct RecordHeader
+    {
+        uint32_t type;
+        uint32_t channel;
+        uint32_t rows;
+        uint32_t cols;
+        uint64_t samples;
+        int64_t index;  //!< user defined index, e.g. an iteration or MPC cycle counter
+        double time;    //!< time stamp in seconds, BinaryLogger::now() unless specified otherwise
+        uint64_t payloadBytes;
+    };
+
+    static const char* magic() { return "CTBLOG01"; }
+    static const uint64_t version = 1;
+    static const size_t fileHeaderBytes = 16;
+};
+
+
+//! An append-only binary logger which writes from a background thread
+/*!
+ * Threads which log (e.g. NLOC solvers or MPC loops) copy their data into a preallocated, lock-free ring buffer.
+ * A background thread empties the buffer and appends the records to a file in the format of BinaryLogFormat.
+ * Logging never blocks: if the buffer is full, the record is dropped and counted, see droppedRecords().
+ * After a few records, the slots of the ring buffer have grown to the size of the logged data and logging does not
+ * allocate memory anymore.
+ *
+ * Usage:
+ * \code
+ * ct::core::BinaryLogger logger("log.ctlog");
+ * size_t xChannel = logger.addChannel("x");
+ * logger.logTrajectory(xChannel, iteration, logger.now(), x);  // x e.g. a StateVectorArray
+ * \endcode
+ * The file can be read with BinaryLogReader.
+ */
+class BinaryLogger
+{
+public:
+    /*!
+     * @brief Constructor, opens the log file and starts the writer thread
+     * @param fileName the file to write to, existing files are overwritten
+     * @param queueCapacity number of records the ring buffer holds, rounded up to a power of two
+     */
+    BinaryLogger(const std::string& fileName, size_t queueCapacity = 256)
+        : enqueuePos_(0),
+          dequeuePos_(0),
+          flushedPos_(0),
+          dropped_(0),
+          stop_(false),
+          nChannels_(0),
+          start_(std::chrono::steady_clock::now())
+    {
+        size_t capacity = 1;
+        while (capacity < queueCapacity)
+            capacity *= 2;
+        mask_ = capacity - 1;
+
+        slots_.reset(new Slot[capacity]);
+        for (size_t i = 0; i < capacity; i++)
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+
+        file_ = std::fopen(fileName.c_str(), "wb");
+        if (!file_)
+            throw std::runtime_error("BinaryLogger: could not open " + fileName);
+
+        const uint64_t version = BinaryLogFormat::version;
+        std::fwrite(BinaryLogFormat::magic(), 1, 8, file_);
+        std::fwrite(&version, sizeof(version), 1, file_);
+
+        writer_ = std::thread(&BinaryLogger::writerLoop, this);
+    }
+
+    BinaryLogger(const BinaryLogger&) = delete;
+    BinaryLogger& operator=(const BinaryLogger&) = delete;
+
+    //! writes all pending records and closes the file
+    ~BinaryLogger()
+    {
+        stop_.store(true, std::memory_order_release);
+        writer_.join();
+        std::fclose(file_);
+    }
+
+    //! register a new channel and return its id
+    /*!
+     * Thread-safe but not lock-free, channels should be registered before logging starts.
+     * Channel names do not need to be unique, but the reader only finds the first channel of a name.
+     */
+    size_t addChannel(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(channelMutex_);
+        const size_t channel = nChannels_++;
+
+        // channel definitions must not get lost, wait for the writer if the buffer is full
+        while (!push([&](Record& r) {
+            r.type = BinaryLogFormat::CHANNEL;
+            r.channel = static_cast<uint32_t>(channel);
+            r.rows = r.cols = 0;
+            r.samples = 0;
+            r.index = 0;
+            r.time = now();
+            r.name = name;
+        }))
+            std::this_thread::yield();
+
+        return channel;
+    }
+
+    //! log 'samples' matrices of size rows x cols, stored contiguously and column-major in 'data'
+    /*!
+     * @return false if the record was dropped because the buffer was full
+     */
+    template <typename SCALAR>
+    bool log(size_t channel,
+        int64_t index,
+        double time,
+        const SCALAR* data,
+        size_t rows,
+        size_t cols,
+        size_t samples = 1)
+    {
+        return pushData(channel, index, time, rows, cols, samples, [&](double* out) {
+            for (size_t i = 0; i < rows * cols * samples; i++)
+                out[i] = static_cast<double>(data[i]);
+        });
+    }
+
+    //! log a single matrix or vector
+    template <typename Derived>
+    bool logMatrix(size_t channel, int64_t index, double time, const Eigen::MatrixBase<Derived>& m)
+    {
+        return pushData(channel, index, time, m.rows(), m.cols(), 1, [&](double* out) {
+            Eigen::Map<Eigen::MatrixXd>(out, m.rows(), m.cols()) = m.template cast<double>();
+        });
+    }
+
+    //! log a scalar
+    template <typename SCALAR>
+    bool logScalar(size_t channel, int64_t index, double time, const SCALAR& value)
+    {
+        return log(channel, index, time, &value, 1, 1, 1);
+    }
+
+    //! log a trajectory of equally sized matrices, e.g. a StateVectorArray or FeedbackArray
+    template <typename ARRAY>
+    bool logTrajectory(size_t channel, int64_t index, double time, const ARRAY& trajectory)
+    {
+        const size_t samples = trajectory.size();
+        const size_t rows = samples > 0 ? trajectory[0].rows() : 0;
+        const size_t cols = samples > 0 ? trajectory[0].cols() : 0;
+
+        return pushData(channel, index, time, rows, cols, samples, [&](double* out) {
+            for (size_t k = 0; k < samples; k++)
+                Eigen::Map<Eigen::MatrixXd>(out + k * rows * cols, rows, cols) = trajectory[k].template cast<double>();
+        });
+    }
+
+    //! seconds since construction of the logger, the default time stamp
+    double now() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    //! block until all records logged so far are written to the file
+    void flush()
+    {
+        const size_t target = enqueuePos_.load(std::memory_order_acquire);
+        while (flushedPos_.load(std::memory_order_acquire) < target)
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    //! number of records dropped because the ring buffer was full
+    size_t droppedRecords() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Record
+    {
+        uint32_t type;
+        uint32_t channel;
+        uint32_t rows;
+        uint32_t cols;
+        uint64_t samples;
+        int64_t index;
+        double time;
+        std::vector<double> data;
+        std::string name;
+    };
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    template <typename FILL>
+    bool pushData(size_t channel,
+        int64_t index,
+        double time,
+        size_t rows,
+        size_t cols,
+        size_t samples,
+        FILL&& fill)
+    {
+        const bool success = push([&](Record& r) {
+            r.type = BinaryLogFormat::DATA;
+            r.channel = static_cast<uint32_t>(channel);
+            r.rows = static_cast<uint32_t>(rows);
+            r.cols = static_cast<uint32_t>(cols);
+            r.samples = samples;
+            r.index = index;
+            r.time = time;
+            r.data.resize(rows * cols * samples);
+            fill(r.data.data());
+        });
+
+        if (!success)
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        return success;
+    }
+
+    //! claim a slot (bounded multi-producer queue after D. Vyukov), fill and publish it. False if the buffer is full
+    template <typename FILL>
+    bool push(FILL&& fill)
+    {
+        Slot* slot;
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            slot = &slots_[pos & mask_];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;
+            else
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+
+        fill(slot->record);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! write the next record if available (single consumer)
+    bool pop()
+    {
+        const size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[pos & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+            return false;
+
+        write(slot.record);
+
+        slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void write(const Record& r)
+    {
+        static const char padding[8] = {0};
+
+        BinaryLogFormat::RecordHeader header;
+        header.type = r.type;
+        header.channel = r.channel;
+        header.rows = r.rows;
+        header.cols = r.cols;
+        header.samples = r.samples;
+        header.index = r.index;
+        header.time = r.time;
+
+        if (r.type == BinaryLogFormat::CHANNEL)
+        {
+            header.payloadBytes = (r.name.size() + 7) / 8 * 8;
+            std::fwrite(&header, sizeof(header), 1, file_);
+            std::fwrite(r.name.data(), 1, r.name.size(), file_);
+            std::fwrite(padding, 1, header.payloadBytes - r.name.size(), file_);
+        }
+        else
+        {
+            header.payloadBytes = r.data.size() * sizeof(double);
+            std::fwrite(&header, sizeof(header), 1, file_);
+            std::fwrite(r.data.data(), sizeof(double), r.data.size(), file_);
+        }
+    }
+
+    void writerLoop()
+    {
+        for (;;)
+        {
+            // read the stop flag first, such that all records pushed before stopping are written
+            const bool stop = stop_.load(std::memory_order_acquire);
+
+            size_t nWritten = 0;
+            while (pop())
+                nWritten++;
+
+            if (nWritten > 0)
+            {
+                std::fflush(file_);
+                flushedPos_.store(dequeuePos_.load(std::memory_order_relaxed), std::memory_order_release);
+            }
+            else if (stop)
+                break;
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+
+    std::atomic<size_t> enqueuePos_;
+    std::atomic<size_t> dequeuePos_;
+    std::atomic<size_t> flushedPos_;
+    std::atomic<size_t> dropped_;
+    std::atomic<bool> stop_;
+
+    std::mutex channelMutex_;
+    size_t nChannels_;
+
+    std::chrono::steady_clock::time_point start_;
+
+    FILE* file_;
+    std::thread writer_;
+};
+
+}  // namespace core
+}  // namespace ct
@@ -235,13 +235,13 @@ private:
     void initializeCTSteppers(const IntegrationType& intType);
     /**
 	 * @brief      Initializes the adaptive odeint steppers. The odeint steppers
-	 *             only work for double currently
+	 *             only work for floating point types (double and float)
 	 *
 	 * @param[in]  intType  The integration type
 	 *
 	 */
     template <typename S = SCALAR>
-    typename std::enable_if<std::is_same<S, double>::value, void>::type initializeAdaptiveSteppers(
+    typename std::enable_if<std::is_floating_point<S>::value, void>::type initializeAdaptiveSteppers(
         const IntegrationType& intType)
     {
         switch (intType)
@@ -280,28 +280,26 @@ private:
     }
 
     template <typename S = SCALAR>
-    typename std::enable_if<!std::is_same<S, double>::value, void>::type initializeAdaptiveSteppers(
+    typename std::enable_if<!std::is_floating_point<S>::value, void>::type initializeAdaptiveSteppers(
         const IntegrationType& intType)
     {
     }
 
-#ifdef CPPADCG
     template <typename S = SCALAR>
-    typename std::enable_if<std::is_same<S, ADCGScalar>::value, void>::type initializeODEIntSteppers(
+    typename std::enable_if<!std::is_floating_point<S>::value, void>::type initializeODEIntSteppers(
         const IntegrationType& intType)
     {
     }
-#endif
 
     /**
-	 * @brief      Initializes the ODEint fixed size steppers for double type. Does not work for
+	 * @brief      Initializes the ODEint fixed size steppers for floating point types. Does not work for
 	 *             ad types
 	 *
 	 * @param[in]  intType  The int type
 	 *
 	 */
     template <typename S = SCALAR>
-    typename std::enable_if<std::is_same<S, double>::value, void>::type initializeODEIntSteppers(
+    typename std::enable_if<std::is_floating_point<S>::value, void>::type initializeODEIntSteppers(
         const IntegrationType& intType)
     {
         switch (intType)
@@ -51,6 +51,12 @@ public:
     //! update the time discretization
     virtual void setTimeDiscretization(const SCALAR& dt) = 0;
 
+    //! set a non-uniform time grid
+    /*!
+     * @param timeGrid the stage boundaries, stage n spans [timeGrid[n], timeGrid[n+1]]. The time discretization
+     * is then taken from the grid. An empty grid restores the uniform time discretization.
+     */
+    void setTimeGrid(const tpl::TimeArray<SCALAR>& timeGrid) { timeGrid_ = timeGrid; }
     //! update the approximation type for the discrete-time system
     virtual void setApproximation(const SensitivityApproximationSettings::APPROXIMATION& approx) {}
     /*!
@@ -86,6 +92,9 @@ public:
 protected:
     std::vector<StateVectorArrayPtr, Eigen::aligned_allocator<StateVectorArrayPtr>>* xSubstep_;
     std::vector<ControlVectorArrayPtr, Eigen::aligned_allocator<ControlVectorArrayPtr>>* uSubstep_;
+
+    //! optional non-uniform time grid, empty for a uniform time discretization
+    tpl::TimeArray<SCALAR> timeGrid_;
 };
 }
 }
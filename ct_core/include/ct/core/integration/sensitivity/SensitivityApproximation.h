@@ -59,6 +59,7 @@ public:
     //! copy constructor
     SensitivityApproximation(const SensitivityApproximation& other) : settings_(other.settings_)
     {
+        this->timeGrid_ = other.timeGrid_;
         if (other.linearSystem_ != nullptr)
             linearSystem_ = std::shared_ptr<LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>>(other.linearSystem_->clone());
     }
@@ -117,6 +118,10 @@ public:
         if (linearSystem_ == nullptr)
             throw std::runtime_error("Error in SensitivityApproximation: linearSystem not properly set.");
 
+        // on a non-uniform time grid, the discretization interval is the duration of stage n
+        if (this->timeGrid_.size() > 0)
+            settings_.dt_ = this->timeGrid_[n + 1] - this->timeGrid_[n];
+
         /*!
 		 * for an LTI system A and B won't change with time n, hence the linearizations result from the following LTV special case.
 		 */
@@ -149,11 +154,10 @@ public:
                 state_control_matrix_t Bc_front;
 
                 // front derivatives
-                linearSystem_->getDerivatives(Ac_front, Bc_front, x, u, n * settings_.dt_);
+                linearSystem_->getDerivatives(Ac_front, Bc_front, x, u, getTime(n));
                 Ac_front *= settings_.dt_;
 
-                state_matrix_t Ac_back =
-                    settings_.dt_ * linearSystem_->getDerivativeState(x_next, u, (n + 1) * settings_.dt_);
+                state_matrix_t Ac_back = settings_.dt_ * linearSystem_->getDerivativeState(x_next, u, getTime(n + 1));
 
 
                 //! tustin approximation
@@ -176,6 +180,9 @@ public:
 
 
 private:
+    //! the continuous time at the start of stage n
+    SCALAR getTime(const int n) const { return this->timeGrid_.size() == 0 ? n * settings_.dt_ : this->timeGrid_[n]; }
+
     void forwardEuler(const StateVector<STATE_DIM, SCALAR>& x_n,
         const ControlVector<CONTROL_DIM, SCALAR>& u_n,
         const int& n,
@@ -188,7 +195,7 @@ private:
 		 */
         state_matrix_t A_cont;
         state_control_matrix_t B_cont;
-        linearSystem_->getDerivatives(A_cont, B_cont, x_n, u_n, n * settings_.dt_);
+        linearSystem_->getDerivatives(A_cont, B_cont, x_n, u_n, getTime(n));
 
         A_discr = state_matrix_t::Identity() + settings_.dt_ * A_cont;
         B_discr = settings_.dt_ * B_cont;
@@ -206,7 +213,7 @@ private:
 		 */
         state_matrix_t A_cont;
         state_control_matrix_t B_cont;
-        linearSystem_->getDerivatives(A_cont, B_cont, x_n, u_n, n * settings_.dt_);
+        linearSystem_->getDerivatives(A_cont, B_cont, x_n, u_n, getTime(n));
 
         state_matrix_t aNew = settings_.dt_ * A_cont;
         A_discr.setZero();
@@ -225,7 +232,7 @@ private:
     {
         state_matrix_t Ac;
         state_control_matrix_t Bc;
-        linearSystem_->getDerivatives(Ac, Bc, x_n, u_n, n * settings_.dt_);
+        linearSystem_->getDerivatives(Ac, Bc, x_n, u_n, getTime(n));
 
         state_matrix_t Adt = settings_.dt_ * Ac;
 
@@ -252,19 +259,17 @@ private:
         state_matrix_t& A_sym,
         state_control_matrix_t& B_sym)
     {
-        const SCALAR& dt = settings_.dt_;
-
         // our implementation of symplectic integrators first updates the positions, we need to reconstruct an intermediate state accordingly
         StateVector<STATE_DIM, SCALAR> x_interm = x;
         x_interm.topRows(P_DIM) = x_next.topRows(P_DIM);
 
         state_matrix_t Ac1;          // continuous time A matrix for start state and control
         state_control_matrix_t Bc1;  // continuous time B matrix for start state and control
-        linearSystem_->getDerivatives(Ac1, Bc1, x, u, n * dt);
+        linearSystem_->getDerivatives(Ac1, Bc1, x, u, getTime(n));
 
         state_matrix_t Ac2;          // continuous time A matrix for intermediate state and control
         state_control_matrix_t Bc2;  // continuous time B matrix for intermediate state and control
-        linearSystem_->getDerivatives(Ac2, Bc2, x_interm, u, n * dt);
+        linearSystem_->getDerivatives(Ac2, Bc2, x_interm, u, getTime(n));
 
         getSymplecticEulerApproximation<V_DIM, P_DIM>(Ac1, Ac2, Bc1, Bc2, A_sym, B_sym);
     }
@@ -287,11 +292,9 @@ private:
         state_matrix_t& A_sym,
         state_control_matrix_t& B_sym)
     {
-        const SCALAR& dt = settings_.dt_;
-
         state_matrix_t Ac1;          // continuous time A matrix for start state and control
         state_control_matrix_t Bc1;  // continuous time B matrix for start state and control
-        linearSystem_->getDerivatives(Ac1, Bc1, x, u, n * dt);
+        linearSystem_->getDerivatives(Ac1, Bc1, x, u, getTime(n));
 
         getSymplecticEulerApproximation<V_DIM, P_DIM>(Ac1, Ac1, Bc1, Bc1, A_sym, B_sym);
     }
@@ -142,9 +142,13 @@ public:
         k_ = k;
         substep_ = 0;
 
+        // on a non-uniform time grid, stage k is split into numSteps intervals of equal length
+        if (this->timeGrid_.size() > 0)
+            dt_ = (this->timeGrid_[k + 1] - this->timeGrid_[k]) / numSteps;
+
         for (size_t i = 0; i < numSteps; ++i)
         {
-            stepper_->do_step(dFdxDot_, AB, k * dt_, dt_);
+            stepper_->do_step(dFdxDot_, AB, getTime(k), dt_);
         }
 
         A = AB.template leftCols<STATE_DIM>();
@@ -196,8 +200,8 @@ public:
 
         if (!timeVarying_)
         {
-            Aconst_ = linearSystem_->getDerivativeState(x, u, n * dt_);
-            Bconst_ = linearSystem_->getDerivativeControl(x, u, n * dt_);
+            Aconst_ = linearSystem_->getDerivativeState(x, u, getTime(n));
+            Bconst_ = linearSystem_->getDerivativeControl(x, u, getTime(n));
         }
 
         integrateSensitivity(n, numSteps, A, B);
@@ -205,6 +209,9 @@ public:
 
 
 private:
+    //! the continuous time at the start of stage n
+    SCALAR getTime(const size_t n) const { return this->timeGrid_.size() == 0 ? n * dt_ : this->timeGrid_[n]; }
+
     bool timeVarying_;
     bool symplectic_;
     double dt_;
@@ -34,29 +34,31 @@ DerivativesCppadJIT<IN_DIM, OUT_DIM>::DerivativesCppadJIT(const DerivativesCppad
       cgStdFun_(arg.cgStdFun_),
       inputDim_(arg.inputDim_),
       outputDim_(arg.outputDim_),
+      cgCppadFun_(arg.cgCppadFun_),
       compiled_(arg.compiled_),
       libName_(arg.libName_),
-      dynamicLib_(nullptr)
+      sparsityRowsJacobian_(arg.sparsityRowsJacobian_),
+      sparsityColsJacobian_(arg.sparsityColsJacobian_),
+      sparsityRowsHessian_(arg.sparsityRowsHessian_),
+      sparsityColsHessian_(arg.sparsityColsHessian_),
+      sparsityRowsJacobianEigen_(arg.sparsityRowsJacobianEigen_),
+      sparsityColsJacobianEigen_(arg.sparsityColsJacobianEigen_),
+      sparsityRowsHessianEigen_(arg.sparsityRowsHessianEigen_),
+      sparsityColsHessianEigen_(arg.sparsityColsHessianEigen_),
+      dynamicLib_(arg.dynamicLib_)
 #ifdef LLVM_VERSION_MAJOR
       ,
-      llvmModelLib_(nullptr)
+      llvmModelLib_(arg.llvmModelLib_)
 #endif
 {
-    cgCppadFun_ = arg.cgCppadFun_;
+    // the tape and the compiled library are shared, only the model holding the evaluation buffers is per instance
     if (compiled_)
     {
-        if (arg.dynamicLib_)  // in case of dynamic libraries
-        {
-            dynamicLib_ = internal::CGHelpers::loadDynamicLibCppad<double>(libName_);
+        if (dynamicLib_)  // in case of dynamic libraries
             model_ = std::shared_ptr<CppAD::cg::GenericModel<double>>(dynamicLib_->model(libName_));
-        }
 #ifdef LLVM_VERSION_MAJOR
-        else if (arg.llvmModelLib_)  // in case of regular JIT without dynamic lib
-        {
-            throw std::runtime_error("DerivativesCppadJIT: cloning of LLVM-JIT libraries is currently not supported.");
-            llvmModelLib_ = arg.llvmModelLib_;  // TODO: this is not clean, we need to properly clone the llvm model lib
+        else if (llvmModelLib_)  // in case of regular JIT without dynamic lib
             model_ = std::shared_ptr<CppAD::cg::GenericModel<double>>(llvmModelLib_->model(libName_));
-        }
 #endif
         else
             throw std::runtime_error("DerivativesCppadJIT: undefined behaviour in copy constructor.");
@@ -309,7 +311,7 @@ void DerivativesCppadJIT<IN_DIM, OUT_DIM>::compileJIT(const DerivativesCppadSett
 
     libName_ = libName + uniqueID;
 
-    CppAD::cg::ModelCSourceGen<double> cgen(cgCppadFun_, libName_);
+    CppAD::cg::ModelCSourceGen<double> cgen(*cgCppadFun_, libName_);
 
     cgen.setMultiThreading(settings.multiThreading_);
     cgen.setCreateForwardZero(settings.createForwardZero_);
@@ -469,10 +471,10 @@ void DerivativesCppadJIT<IN_DIM, OUT_DIM>::recordCg()
 
     y = cgStdFun_(x);
 
-    // store operation sequence in f: x -> y and stop recording
-    CppAD::ADFun<CG_VALUE_TYPE> fCodeGen(x, y);
+    // store operation sequence in f: x -> y and stop recording. Creates a new tape, clones keep the previous one
+    std::shared_ptr<CppAD::ADFun<CG_VALUE_TYPE>> fCodeGen(new CppAD::ADFun<CG_VALUE_TYPE>(x, y));
 
-    fCodeGen.optimize();
+    fCodeGen->optimize();
 
     cgCppadFun_ = fCodeGen;
 }
@@ -72,7 +72,9 @@ public:
     /*!
      * @brief copy constructor
      * @param arg instance to copy
-     * @note  It is  important to not only copy the pointer to the dynamic library, but to load the library properly instead.
+     * @note  The recorded tape and the compiled library are immutable and shared with the copy, only the model which
+     *        holds the evaluation buffers is created for every instance. Therefore copies can be evaluated
+     *        concurrently, but copying and compileJIT() on copies of an uncompiled instance are not thread-safe.
      */
     DerivativesCppadJIT(const DerivativesCppadJIT& arg);
 
@@ -192,7 +194,7 @@ protected:
     int inputDim_;   //! function input dimension
     int outputDim_;  //! function output dimension
 
-    CppAD::ADFun<CG_VALUE_TYPE> cgCppadFun_;  //!  auto-diff function
+    std::shared_ptr<CppAD::ADFun<CG_VALUE_TYPE>> cgCppadFun_;  //!  auto-diff function, shared among copies
 
     bool compiled_;        //! flag if Jacobian is compiled
     std::string libName_;  //! a unique name for this library
@@ -209,10 +211,10 @@ protected:
     //!
     CppAD::cg::GccCompiler<double> compiler_;  //! compile for codegeneration
     CppAD::cg::ClangCompiler<double> compilerClang_;
-    std::shared_ptr<CppAD::cg::DynamicLib<double>> dynamicLib_;          //! dynamic library to load after compilation
-    std::shared_ptr<CppAD::cg::GenericModel<double>> model_;             //! the model
+    std::shared_ptr<CppAD::cg::DynamicLib<double>> dynamicLib_;  //! dynamic library, shared among copies
+    std::shared_ptr<CppAD::cg::GenericModel<double>> model_;     //! the model, one per instance
 #ifdef LLVM_VERSION_MAJOR
-    std::shared_ptr<CppAD::cg::LlvmModelLibrary<double>> llvmModelLib_;  //! llvm in-memory library
+    std::shared_ptr<CppAD::cg::LlvmModelLibrary<double>> llvmModelLib_;  //! llvm in-memory library, shared
 #endif
 };
 
@@ -56,9 +56,14 @@ SystemDiscretizer<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::~SystemDiscreti
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
 SystemDiscretizer<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::SystemDiscretizer(const SystemDiscretizer& arg)
-    : dt_(arg.dt_), K_sim_(arg.K_sim_), dt_sim_(arg.dt_sim_), integratorType_(arg.integratorType_)
+    : dt_(arg.dt_),
+      K_sim_(arg.K_sim_),
+      dt_sim_(arg.dt_sim_),
+      timeGrid_(arg.timeGrid_),
+      integratorType_(arg.integratorType_),
+      cont_constant_controller_(new ConstantController<STATE_DIM, CONTROL_DIM, SCALAR>())
 {
-    changeContinuousTimeSystem(ContinuousSystemPtr(cont_time_system_->clone()));
+    changeContinuousTimeSystem(arg.cont_time_system_);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
@@ -91,6 +96,13 @@ void SystemDiscretizer<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::setParamet
     dt_sim_ = getSimulationTimestep();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+void SystemDiscretizer<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::setTimeGrid(
+    const tpl::TimeArray<SCALAR>& timeGrid)
+{
+    timeGrid_ = timeGrid;
+}
+
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
 void SystemDiscretizer<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::initialize()
@@ -137,14 +149,26 @@ void SystemDiscretizer<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::propagateC
     // initialize state to propagate
     stateNext = state;
 
+    // start time and sub-step size, on a non-uniform time grid they are given by the grid
+    SCALAR t0 = n * dt_;
+    SCALAR dt_sim = dt_sim_;
+    if (timeGrid_.size() > 0)
+    {
+        if (n < 0 || static_cast<size_t>(n) + 1 >= timeGrid_.size())
+            throw std::runtime_error("SystemDiscretizer: stage " + std::to_string(n) + " is outside of the time grid.");
+
+        t0 = timeGrid_[n];
+        dt_sim = (timeGrid_[n + 1] - timeGrid_[n]) / (SCALAR)K_sim_;
+    }
+
     // perform integration
     if (integratorType_ == ct::core::IntegrationType::EULER_SYM || integratorType_ == ct::core::IntegrationType::RK_SYM)
     {
-        integrateSymplectic<V_DIM, P_DIM, STATE_DIM>(stateNext, n * dt_, K_sim_, dt_sim_);
+        integrateSymplectic<V_DIM, P_DIM, STATE_DIM>(stateNext, t0, K_sim_, dt_sim);
     }
     else
     {
-        integrator_->integrate_n_steps(stateNext, n * dt_, K_sim_, dt_sim_);
+        integrator_->integrate_n_steps(stateNext, t0, K_sim_, dt_sim);
     }
 }
 
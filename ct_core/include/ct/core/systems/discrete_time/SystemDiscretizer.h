@@ -108,6 +108,13 @@ public:
     //! update parameters
     void setParameters(const SCALAR& dt, const int& K_sim = 1);
 
+    //! set a non-uniform time grid
+    /*!
+     * @param timeGrid the stage boundaries, stage n spans [timeGrid[n], timeGrid[n+1]] and is integrated in K_sim
+     * steps. An empty grid restores the uniform time discretization with dt.
+     */
+    void setTimeGrid(const tpl::TimeArray<SCALAR>& timeGrid);
+
     //! update the SystemDiscretizer with a new nonlinear, continuous-time system
     void changeContinuousTimeSystem(ContinuousSystemPtr newSystem);
 
@@ -162,6 +169,9 @@ protected:
     //! the integration sub-step size, which is a function of dt_ and K_sim_
     SCALAR dt_sim_;
 
+    //! optional non-uniform time grid, empty for a uniform time discretization
+    tpl::TimeArray<SCALAR> timeGrid_;
+
     //! the integration type for forward integration
     ct::core::IntegrationType integratorType_;
 
@@ -113,6 +113,8 @@ public:
 	 * @param type new interpolation strategy
 	 */
     void setInterpolationType(const InterpolationType& type) { interp_.changeInterpolationType(type); }
+    //! get the interpolation strategy
+    InterpolationType getInterpolationType() const { return interp_.getInterpolationType(); }
     //! set timestamps
     /*!
 	 * @param time new time stamps
@@ -0,0 +1,177 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+#include <cstdio>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ct/core/core.h>
+
+
+using namespace ct::core;
+
+const std::string logFile = "BinaryLoggerTest.ctlog";
+
+
+TEST(BinaryLoggerTest, RoundTrip)
+{
+    StateVectorArray<3> x(11);
+    FeedbackArray<3, 2> L(10);
+    for (size_t k = 0; k < x.size(); k++)
+        x[k].setRandom();
+    for (size_t k = 0; k < L.size(); k++)
+        L[k].setRandom();
+    const Eigen::Matrix<float, 2, 1> u(1.5f, -2.0f);
+
+    {
+        BinaryLogger logger(logFile);
+        const size_t xChannel = logger.addChannel("x");
+        const size_t LChannel = logger.addChannel("L");
+        const size_t uChannel = logger.addChannel("a_longer_channel_name/u");
+
+        ASSERT_TRUE(logger.logTrajectory(xChannel, 1, 0.5, x));
+        ASSERT_TRUE(logger.logTrajectory(LChannel, 1, 0.5, L));
+        ASSERT_TRUE(logger.logMatrix(uChannel, 2, 1.0, u));
+        ASSERT_TRUE(logger.logScalar(uChannel, 3, 1.5, 42.0));
+        logger.flush();
+    }
+
+    BinaryLogReader reader(logFile);
+    ASSERT_EQ(reader.channelNames().size(), 3u);
+    ASSERT_TRUE(reader.hasChannel("a_longer_channel_name/u"));
+    ASSERT_FALSE(reader.hasChannel("y"));
+
+    const auto& xRecords = reader.records("x");
+    ASSERT_EQ(xRecords.size(), 1u);
+    ASSERT_EQ(xRecords[0].index, 1);
+    ASSERT_EQ(xRecords[0].time, 0.5);
+    ASSERT_EQ(xRecords[0].samples, x.size());
+    for (size_t k = 0; k < x.size(); k++)
+        ASSERT_TRUE(xRecords[0].sample(k).isApprox(x[k]));
+
+    const auto& LRecords = reader.records("L");
+    ASSERT_EQ(LRecords[0].rows, 2u);
+    ASSERT_EQ(LRecords[0].cols, 3u);
+    for (size_t k = 0; k < L.size(); k++)
+        ASSERT_TRUE(LRecords[0].sample(k).isApprox(L[k]));
+
+    const auto& uRecords = reader.records(2);
+    ASSERT_EQ(uRecords.size(), 2u);
+    ASSERT_TRUE(uRecords[0].sample(0).isApprox(u.cast<double>()));
+    ASSERT_EQ(uRecords[1].sample(0)(0), 42.0);
+
+    std::remove(logFile.c_str());
+}
+
+
+TEST(BinaryLoggerTest, ConcurrentWriters)
+{
+    const size_t nThreads = 4;
+    const size_t nRecords = 2000;
+
+    size_t dropped;
+    {
+        BinaryLogger logger(logFile, 64);
+        std::vector<size_t> channels;
+        for (size_t t = 0; t < nThreads; t++)
+            channels.push_back(logger.addChannel("thread" + std::to_string(t)));
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < nThreads; t++)
+        {
+            threads.push_back(std::thread([&, t]() {
+                StateVectorArray<4> x(50);
+                for (size_t i = 0; i < nRecords; i++)
+                {
+                    for (size_t k = 0; k < x.size(); k++)
+                        x[k].setConstant(i);
+                    logger.logTrajectory(channels[t], i, logger.now(), x);
+                }
+            }));
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        logger.flush();
+        dropped = logger.droppedRecords();
+    }
+
+    // every record is either in the file or counted as dropped, and records of a thread stay in order
+    BinaryLogReader reader(logFile);
+    size_t nRead = 0;
+    for (size_t t = 0; t < nThreads; t++)
+    {
+        const auto& records = reader.records("thread" + std::to_string(t));
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            if (i > 0)
+            {
+                ASSERT_GT(records[i].index, records[i - 1].index);
+            }
+            ASSERT_EQ(records[i].samples, 50u);
+            ASSERT_EQ(records[i].sample(49)(3), records[i].index);
+        }
+        nRead += records.size();
+    }
+    ASSERT_EQ(nRead + dropped, nThreads * nRecords);
+
+    std::remove(logFile.c_str());
+}
+
+
+TEST(BinaryLoggerTest, DropsWhenFull)
+{
+    {
+        BinaryLogger logger(logFile, 4);
+        const size_t channel = logger.addChannel("burst");
+
+        // the writer thread cannot keep up with a burst this large into 4 slots
+        StateVectorArray<10> x(1000, StateVector<10>::Ones());
+        size_t accepted = 0;
+        for (size_t i = 0; i < 1000; i++)
+            accepted += logger.logTrajectory(channel, i, 0.0, x);
+        logger.flush();
+
+        ASSERT_GT(logger.droppedRecords(), 0u);
+        ASSERT_EQ(accepted + logger.droppedRecords(), 1000u);
+    }
+
+    BinaryLogReader reader(logFile);
+    ASSERT_LT(reader.records("burst").size(), 1000u);
+
+    std::remove(logFile.c_str());
+}
+
+
+TEST(BinaryLoggerTest, TruncatedFile)
+{
+    {
+        BinaryLogger logger(logFile);
+        const size_t channel = logger.addChannel("x");
+        for (size_t i = 0; i < 3; i++)
+            logger.logMatrix(channel, i, 0.0, StateVector<5>::Constant(i));
+    }
+
+    // cut the last record in half
+    FILE* file = std::fopen(logFile.c_str(), "rb");
+    std::vector<char> content(1 << 16);
+    content.resize(std::fread(content.data(), 1, content.size(), file));
+    std::fclose(file);
+    file = std::fopen(logFile.c_str(), "wb");
+    std::fwrite(content.data(), 1, content.size() - 20, file);
+    std::fclose(file);
+
+    BinaryLogReader reader(logFile);
+    ASSERT_EQ(reader.records("x").size(), 2u);
+
+    std::remove(logFile.c_str());
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
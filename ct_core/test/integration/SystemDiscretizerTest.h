@@ -92,3 +92,40 @@ TEST(SystemDiscretizerTest, IntegratorComparison)
         }
     }
 }
+
+
+TEST(SystemDiscretizerTest, CopyWithTimeGrid)
+{
+    const size_t state_dim = 2;
+    const size_t control_dim = 1;
+
+    shared_ptr<SecondOrderSystem> oscillator(new SecondOrderSystem(10.0, 1.0));
+
+    // a non-uniform time grid with three stages
+    tpl::TimeArray<double> timeGrid(4, 0.0);
+    timeGrid[1] = 0.01;
+    timeGrid[2] = 0.03;
+    timeGrid[3] = 0.07;
+
+    SystemDiscretizer<state_dim, control_dim> systemDiscretizer(oscillator, 0.01, RK4, 5);
+    systemDiscretizer.setTimeGrid(timeGrid);
+    std::shared_ptr<SystemDiscretizer<state_dim, control_dim>> copy(systemDiscretizer.clone());
+
+    StateVector<state_dim> x, x_copy;
+    x << 1.0, 0.0;
+    x_copy = x;
+    for (int n = 0; n < 3; n++)
+    {
+        ControlVector<control_dim> u;
+        u(0) = 0.5 * n;
+
+        // the copy propagates independently of the original and gives the same result
+        systemDiscretizer.propagateControlledDynamics(x, n, u, x);
+        copy->propagateControlledDynamics(x_copy, n, u, x_copy);
+        ASSERT_LT((x - x_copy).array().abs().maxCoeff(), 1e-14);
+    }
+
+    // the last stage of the time grid has no end time
+    ControlVector<control_dim> u = ControlVector<control_dim>::Zero();
+    ASSERT_THROW(systemDiscretizer.propagateControlledDynamics(x, 3, u, x), std::runtime_error);
+}
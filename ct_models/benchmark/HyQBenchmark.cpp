@@ -0,0 +1,155 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks the linearization of HyQ with contact model (code-generated, RBD, inverse dynamics and numerical
+ * differentiation) and complete GNMS / iLQR solves of a stance task with the code-generated linearization,
+ * sweeping the horizon length, the number of threads and the algorithm.
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/rbd/rbd.h>
+
+#include <ct/models/HyQ/HyQ.h>
+#include <ct/models/HyQ/codegen/HyQWithContactModelLinearizedForward.h>
+
+using namespace ct;
+
+typedef rbd::FloatingBaseFDSystem<rbd::HyQ::Dynamics, false> HyQSystem;
+typedef rbd::EEContactModel<HyQSystem::Kinematics> ContactModel;
+
+const size_t STATE_DIM = HyQSystem::STATE_DIM;
+const size_t CONTROL_DIM = HyQSystem::CONTROL_DIM;
+
+//! HyQ with the contact model the code-generated linearization was created with
+std::shared_ptr<HyQSystem> createHyQSystem()
+{
+    std::shared_ptr<HyQSystem> hyqSys(new HyQSystem);
+    std::shared_ptr<ContactModel> contactModel(new ContactModel(5000.0, 1000.0, 100.0, 100.0, -0.02,
+        ContactModel::VELOCITY_SMOOTHING::SIGMOID, hyqSys->dynamics().kinematicsPtr()));
+    hyqSys->setContactModel(contactModel);
+    return hyqSys;
+}
+
+//! standing configuration with the feet close to the ground
+core::StateVector<STATE_DIM> standingState()
+{
+    core::StateVector<STATE_DIM> x = core::StateVector<STATE_DIM>::Zero();
+    x(5) = 0.6;
+    for (size_t leg = 0; leg < 4; leg++)
+    {
+        x(6 + 3 * leg + 1) = (leg < 2) ? 0.7 : -0.7;
+        x(6 + 3 * leg + 2) = (leg < 2) ? -1.4 : 1.4;
+    }
+    return x;
+}
+
+/*!
+ * @param state range(0): 0 code-generated, 1 RbdLinearizer, 2 InverseDynamicsLinearizer, 3 numerical differentiation
+ */
+void BM_HyQLinearization(benchmark::State& state)
+{
+    const std::string names[4] = {"codegen", "RbdLinearizer", "InverseDynamicsLinearizer", "numdiff"};
+    state.SetLabel(names[state.range(0)]);
+
+    std::shared_ptr<HyQSystem> hyqSys = createHyQSystem();
+
+    std::shared_ptr<core::LinearSystem<STATE_DIM, CONTROL_DIM>> linearSystem;
+    switch (state.range(0))
+    {
+        case 0:
+            linearSystem.reset(new models::HyQ::HyQWithContactModelLinearizedForward);
+            break;
+        case 1:
+            linearSystem.reset(new rbd::RbdLinearizer<HyQSystem>(hyqSys));
+            break;
+        case 2:
+            linearSystem.reset(new rbd::InverseDynamicsLinearizer<HyQSystem>(hyqSys));
+            break;
+        default:
+            linearSystem.reset(new core::SystemLinearizer<STATE_DIM, CONTROL_DIM>(hyqSys, false));
+    }
+
+    core::StateVector<STATE_DIM> x = standingState();
+    x.tail<STATE_DIM / 2>().setRandom();
+    const core::ControlVector<CONTROL_DIM> u = core::ControlVector<CONTROL_DIM>::Random();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(linearSystem->getDerivativeState(x, u).data());
+        benchmark::DoNotOptimize(linearSystem->getDerivativeControl(x, u).data());
+    }
+}
+
+BENCHMARK(BM_HyQLinearization)->DenseRange(0, 3)->Unit(benchmark::kMicrosecond);
+
+/*!
+ * @param state range(0): number of stages, range(1): number of threads, range(2): NLOptConSettings::NLOCP_ALGORITHM
+ */
+void BM_HyQNLOCSolve(benchmark::State& state)
+{
+    typedef optcon::NLOptConSolver<STATE_DIM, CONTROL_DIM, STATE_DIM / 2, STATE_DIM / 2> Solver;
+
+    const size_t K = state.range(0);
+
+    optcon::NLOptConSettings settings;
+    settings.dt = 0.004;
+    settings.K_sim = 2;
+    settings.nThreads = state.range(1);
+    settings.nThreadsEigen = 1;
+    settings.nlocp_algorithm = static_cast<optcon::NLOptConSettings::NLOCP_ALGORITHM>(state.range(2));
+    settings.lqocp_solver = optcon::NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    settings.discretization = optcon::NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    settings.integrator = core::IntegrationType::RK4CT;
+    settings.max_iterations = 5;
+    settings.epsilon = 1e-6;
+    settings.recordSmallestEigenvalue = false;
+    settings.printSummary = false;
+    settings.lineSearchSettings.type = optcon::LineSearchSettings::TYPE::SIMPLE;
+    state.SetLabel(settings.nlocp_algorithm == optcon::NLOptConSettings::NLOCP_ALGORITHM::GNMS ? "GNMS" : "iLQR");
+
+    const core::StateVector<STATE_DIM> x0 = standingState();
+    core::StateVector<STATE_DIM> xNominal = x0;
+    xNominal(5) = 0.55;
+
+    Eigen::Matrix<double, STATE_DIM, STATE_DIM> Q = Eigen::Matrix<double, STATE_DIM, STATE_DIM>::Identity();
+    Q.block<6, 6>(0, 0) *= 100.0;
+    const Eigen::Matrix<double, CONTROL_DIM, CONTROL_DIM> R =
+        1e-3 * Eigen::Matrix<double, CONTROL_DIM, CONTROL_DIM>::Identity();
+    std::shared_ptr<optcon::CostFunctionQuadratic<STATE_DIM, CONTROL_DIM>> costFunction(
+        new optcon::CostFunctionQuadraticSimple<STATE_DIM, CONTROL_DIM>(
+            Q, R, xNominal, core::ControlVector<CONTROL_DIM>::Zero(), xNominal, 10.0 * Q));
+
+    std::shared_ptr<core::LinearSystem<STATE_DIM, CONTROL_DIM>> linearSystem(
+        new models::HyQ::HyQWithContactModelLinearizedForward);
+    optcon::ContinuousOptConProblem<STATE_DIM, CONTROL_DIM> problem(
+        K * settings.dt, x0, createHyQSystem(), costFunction, linearSystem);
+
+    typename Solver::Policy_t initialGuess(core::StateVectorArray<STATE_DIM>(K + 1, x0),
+        core::ControlVectorArray<CONTROL_DIM>(K, core::ControlVector<CONTROL_DIM>::Zero()),
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM>(K, core::FeedbackMatrix<STATE_DIM, CONTROL_DIM>::Zero()),
+        settings.dt);
+
+    Solver solver(problem, settings);
+
+    // every iteration appends to the summary of the backend
+    const optcon::SummaryAllIterations<double>& summary = solver.getBackend()->getSummary();
+    size_t iterations = 0;
+    for (auto _ : state)
+    {
+        const size_t iterationsBefore = summary.iterations.size();
+        solver.setInitialGuess(initialGuess);
+        solver.solve();
+        iterations = summary.iterations.size() - iterationsBefore;
+    }
+
+    state.counters["iterations"] = iterations;
+}
+
+BENCHMARK(BM_HyQNLOCSolve)
+    ->ArgNames({"K", "threads", "algorithm"})
+    ->ArgsProduct({{50, 200}, {1, 4}, {optcon::NLOptConSettings::GNMS, optcon::NLOptConSettings::ILQR}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -27,6 +27,7 @@ void timing(bool useContactModel)
         hyqSys->setContactModel(contactModel);
 
     ct::rbd::RbdLinearizer<HyQSystem> linearizer(hyqSys);
+    ct::rbd::InverseDynamicsLinearizer<HyQSystem> idLinearizer(hyqSys);
     ct::core::SystemLinearizer<HyQSystem::STATE_DIM, HyQSystem::CONTROL_DIM> sysLinearizer(hyqSys, false);
 
     typedef std::shared_ptr<ct::core::LinearSystem<HyQSystem::STATE_DIM, HyQSystem::CONTROL_DIM>> LinModelPtr;
@@ -59,11 +60,13 @@ void timing(bool useContactModel)
     std::vector<JacA, Eigen::aligned_allocator<JacA>> forwardA(nTests);
     std::vector<JacA, Eigen::aligned_allocator<JacA>> reverseA(nTests);
     std::vector<JacA, Eigen::aligned_allocator<JacA>> rbdA(nTests);
+    std::vector<JacA, Eigen::aligned_allocator<JacA>> idA(nTests);
     std::vector<JacA, Eigen::aligned_allocator<JacA>> numDiffA(nTests);
 
     std::vector<JacB, Eigen::aligned_allocator<JacB>> forwardB(nTests);
     std::vector<JacB, Eigen::aligned_allocator<JacB>> reverseB(nTests);
     std::vector<JacB, Eigen::aligned_allocator<JacB>> rbdB(nTests);
+    std::vector<JacB, Eigen::aligned_allocator<JacB>> idB(nTests);
     std::vector<JacB, Eigen::aligned_allocator<JacB>> numDiffB(nTests);
 
     std::cout << "input dim: " << HyQSystem::STATE_DIM + HyQSystem::CONTROL_DIM
@@ -107,6 +110,16 @@ void timing(bool useContactModel)
     msTotal = std::chrono::duration<double, std::micro>(diff).count() / 1000.0;
     std::cout << "rbdA: " << msTotal << " ms. Average: " << msTotal / double(nTests) << " ms" << std::endl;
 
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < nTests; i++)
+    {
+        idA[i] = idLinearizer.getDerivativeState(x[i], u[i]);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    diff = end - start;
+    msTotal = std::chrono::duration<double, std::micro>(diff).count() / 1000.0;
+    std::cout << "idA: " << msTotal << " ms. Average: " << msTotal / double(nTests) << " ms" << std::endl;
+
     start = std::chrono::high_resolution_clock::now();
     for (size_t i = 0; i < nTests; i++)
     {
@@ -147,6 +160,16 @@ void timing(bool useContactModel)
     msTotal = std::chrono::duration<double, std::micro>(diff).count() / 1000.0;
     std::cout << "rbdB: " << msTotal << " ms. Average: " << msTotal / double(nTests) << " ms" << std::endl;
 
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < nTests; i++)
+    {
+        idB[i] = idLinearizer.getDerivativeControl(x[i], u[i]);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    diff = end - start;
+    msTotal = std::chrono::duration<double, std::micro>(diff).count() / 1000.0;
+    std::cout << "idB: " << msTotal << " ms. Average: " << msTotal / double(nTests) << " ms" << std::endl;
+
     start = std::chrono::high_resolution_clock::now();
     for (size_t i = 0; i < nTests; i++)
     {
@@ -175,6 +198,13 @@ void timing(bool useContactModel)
             std::cout << "rbd A: " << std::endl << rbdA[i] << std::endl << std::endl << std::endl;
             failed = true;
         }
+        if (!forwardA[i].isApprox(idA[i], 1e-5))
+        {
+            std::cout << "Forward A and InverseDynamicsLinearizer A not similar" << std::endl;
+            std::cout << "forward A: " << std::endl << forwardA[i] << std::endl;
+            std::cout << "id A: " << std::endl << idA[i] << std::endl << std::endl << std::endl;
+            failed = true;
+        }
         if (!forwardA[i].isApprox(reverseA[i], 1e-12))
         {
             std::cout << "Forward A and reverse A not similar" << std::endl;
@@ -206,6 +236,13 @@ void timing(bool useContactModel)
             std::cout << "rbd B: " << std::endl << rbdB[i] << std::endl << std::endl << std::endl;
             failed = true;
         }
+        if (!forwardB[i].isApprox(idB[i], 1e-5))
+        {
+            std::cout << "Forward B and InverseDynamicsLinearizer B not similar" << std::endl;
+            std::cout << "forward B: " << std::endl << forwardB[i] << std::endl;
+            std::cout << "id B: " << std::endl << idB[i] << std::endl << std::endl << std::endl;
+            failed = true;
+        }
         if (!forwardB[i].isApprox(reverseB[i], 1e-12))
         {
             std::cout << "Forward B and reverse B not similar" << std::endl;
@@ -0,0 +1,247 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks the quadratization of cost functions over a horizon of 500 stages: the individual derivative methods
+ * against the fused quadratizeIntermediate(), the stage-wise against the horizon-level quadratization of tracking
+ * terms, and an analytical against a statically composed cost function. The number of terms and the variant are
+ * benchmark arguments.
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/optcon/optcon.h>
+
+using namespace ct::core;
+using namespace ct::optcon;
+
+namespace {
+
+const size_t state_dim = 12;
+const size_t control_dim = 4;
+const size_t K = 500;
+const double dt = 0.01;
+
+//! the stage-wise quadratization of a cost function
+struct Quadratization
+{
+    Quadratization()
+        : x(K, StateVector<state_dim>::Random()),
+          u(K, ControlVector<control_dim>::Random()),
+          q(K),
+          Q(K),
+          r(K),
+          R(K),
+          P(K),
+          times(K)
+    {
+        for (size_t k = 0; k < K; k++)
+            times[k] = dt * k;
+    }
+
+    StateVectorArray<state_dim> x;
+    ControlVectorArray<control_dim> u;
+    StateVectorArray<state_dim> q;
+    StateMatrixArray<state_dim> Q;
+    ControlVectorArray<control_dim> r;
+    ControlMatrixArray<control_dim> R;
+    FeedbackArray<state_dim, control_dim> P;
+    TimeArray times;
+};
+
+//! create an analytical cost function with nTerms terms, alternating between quadratic, linear and mixed terms
+std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> createCostFunction(size_t nTerms)
+{
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>());
+
+    for (size_t i = 0; i < nTerms; i++)
+    {
+        switch (i % 3)
+        {
+            case 0:
+            {
+                costFunction->addIntermediateTerm(std::shared_ptr<TermQuadratic<state_dim, control_dim>>(
+                    new TermQuadratic<state_dim, control_dim>(Eigen::Matrix<double, state_dim, state_dim>::Random(),
+                        Eigen::Matrix<double, control_dim, control_dim>::Random(), StateVector<state_dim>::Random(),
+                        ControlVector<control_dim>::Random())));
+                break;
+            }
+            case 1:
+            {
+                costFunction->addIntermediateTerm(
+                    std::shared_ptr<TermLinear<state_dim, control_dim>>(new TermLinear<state_dim, control_dim>(
+                        StateVector<state_dim>::Random(), ControlVector<control_dim>::Random())));
+                break;
+            }
+            default:
+            {
+                ControlVector<control_dim> u_ref = ControlVector<control_dim>::Random();
+                costFunction->addIntermediateTerm(
+                    std::shared_ptr<TermMixed<state_dim, control_dim>>(new TermMixed<state_dim, control_dim>(
+                        Eigen::Matrix<double, control_dim, state_dim>::Random(), StateVector<state_dim>::Random(),
+                        u_ref)));
+                break;
+            }
+        }
+    }
+
+    return costFunction;
+}
+
+//! create an analytical cost function with nTerms time-activated tracking terms
+std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> createTrackingCostFunction(size_t nTerms)
+{
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>());
+
+    for (size_t i = 0; i < nTerms; i++)
+    {
+        StateTrajectory<state_dim> stateTraj;
+        ControlTrajectory<control_dim> controlTraj;
+        for (size_t k = 0; k <= K; k++)
+        {
+            stateTraj.push_back(StateVector<state_dim>::Random(), dt * k, true);
+            controlTraj.push_back(ControlVector<control_dim>::Random(), dt * k, true);
+        }
+
+        std::shared_ptr<TermQuadTracking<state_dim, control_dim>> trackingTerm(
+            new TermQuadTracking<state_dim, control_dim>(Eigen::Matrix<double, state_dim, state_dim>::Random(),
+                Eigen::Matrix<double, control_dim, control_dim>::Random(), InterpolationType::LIN,
+                InterpolationType::LIN, true));
+        trackingTerm->setStateAndControlReference(stateTraj, controlTraj);
+        trackingTerm->setTimeActivation(std::shared_ptr<ct::core::tpl::ActivationBase<double>>(
+            new ct::core::tpl::RBFGaussActivation<double>(dt * K * i / nTerms, dt * K / 4)));
+        costFunction->addIntermediateTerm(trackingTerm);
+    }
+
+    return costFunction;
+}
+
+}  // namespace
+
+/*!
+ * @param state range(0): number of terms, range(1): 0 individual derivative methods, 1 fused quadratization
+ */
+void BM_CostQuadratize(benchmark::State& state)
+{
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction = createCostFunction(state.range(0));
+    const bool fused = state.range(1);
+    state.SetLabel(fused ? "fused" : "separate");
+
+    Quadratization quad;
+    for (auto _ : state)
+    {
+        for (size_t k = 0; k < K; k++)
+        {
+            costFunction->setCurrentStateAndControl(quad.x[k], quad.u[k], quad.times[k]);
+            if (fused)
+            {
+                costFunction->quadratizeIntermediate(quad.q[k], quad.Q[k], quad.r[k], quad.R[k], quad.P[k]);
+            }
+            else
+            {
+                quad.Q[k] = costFunction->stateSecondDerivativeIntermediate();
+                quad.R[k] = costFunction->controlSecondDerivativeIntermediate();
+                quad.P[k] = costFunction->stateControlDerivativeIntermediate();
+                quad.q[k] = costFunction->stateDerivativeIntermediate();
+                quad.r[k] = costFunction->controlDerivativeIntermediate();
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+/*!
+ * The horizon-level quadratization includes prepareHorizon(), which is done once per solve.
+ * @param state range(0): number of tracking terms, range(1): 0 stage-wise, 1 horizon-level quadratization
+ */
+void BM_CostQuadratizeTracking(benchmark::State& state)
+{
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction =
+        createTrackingCostFunction(state.range(0));
+    const bool horizon = state.range(1);
+    state.SetLabel(horizon ? "horizon" : "stagewise");
+
+    Quadratization quad;
+    for (auto _ : state)
+    {
+        if (horizon)
+        {
+            costFunction->prepareHorizon(quad.times);
+            costFunction->quadratizeIntermediateHorizon(
+                quad.x, quad.u, 0, K - 1, dt, quad.q, quad.Q, quad.r, quad.R, quad.P);
+        }
+        else
+        {
+            for (size_t k = 0; k < K; k++)
+            {
+                costFunction->setCurrentStateAndControl(quad.x[k], quad.u[k], quad.times[k]);
+                costFunction->quadratizeIntermediate(quad.q[k], quad.Q[k], quad.r[k], quad.R[k], quad.P[k]);
+                quad.q[k] *= dt;
+                quad.Q[k] *= dt;
+                quad.r[k] *= dt;
+                quad.R[k] *= dt;
+                quad.P[k] *= dt;
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+/*!
+ * @param state range(0): 0 CostFunctionAnalytical, 1 StaticCostFunction with the same terms
+ */
+void BM_CostQuadratizeStatic(benchmark::State& state)
+{
+    typedef TermQuadratic<state_dim, control_dim> Quad_t;
+    typedef TermSmoothAbs<state_dim, control_dim> Abs_t;
+    typedef TermMixed<state_dim, control_dim> Mixed_t;
+
+    Quad_t quadTerm(Eigen::Matrix<double, state_dim, state_dim>::Random(),
+        Eigen::Matrix<double, control_dim, control_dim>::Random(), StateVector<state_dim>::Random(),
+        ControlVector<control_dim>::Random());
+    Abs_t absTerm(Eigen::Matrix<double, state_dim, 1>::Random(), Eigen::Matrix<double, state_dim, 1>::Random(),
+        Eigen::Matrix<double, control_dim, 1>::Random(), Eigen::Matrix<double, control_dim, 1>::Random(), 0.5);
+    ControlVector<control_dim> u_ref = ControlVector<control_dim>::Random();
+    Mixed_t mixedTerm(Eigen::Matrix<double, control_dim, state_dim>::Random(), StateVector<state_dim>::Random(), u_ref);
+
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction;
+    if (state.range(0) == 0)
+    {
+        std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> analytical(
+            new CostFunctionAnalytical<state_dim, control_dim>());
+        analytical->addIntermediateTerm(std::shared_ptr<Quad_t>(new Quad_t(quadTerm)));
+        analytical->addIntermediateTerm(std::shared_ptr<Abs_t>(new Abs_t(absTerm)));
+        analytical->addIntermediateTerm(std::shared_ptr<Mixed_t>(new Mixed_t(mixedTerm)));
+        costFunction = analytical;
+    }
+    else
+    {
+        costFunction.reset(new StaticCostFunction<state_dim, control_dim, std::tuple<Quad_t, Abs_t, Mixed_t>>(
+            std::make_tuple(quadTerm, absTerm, mixedTerm)));
+    }
+    state.SetLabel(state.range(0) == 0 ? "analytical" : "static");
+
+    Quadratization quad;
+    for (auto _ : state)
+    {
+        for (size_t k = 0; k < K; k++)
+        {
+            costFunction->setCurrentStateAndControl(quad.x[k], quad.u[k], quad.times[k]);
+            costFunction->quadratizeIntermediate(quad.q[k], quad.Q[k], quad.r[k], quad.R[k], quad.P[k]);
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(BM_CostQuadratize)
+    ->ArgNames({"terms", "fused"})
+    ->ArgsProduct({{10, 20, 30}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CostQuadratizeTracking)
+    ->ArgNames({"terms", "horizon"})
+    ->ArgsProduct({{10, 20, 30}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CostQuadratizeStatic)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,59 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks the fixed-point iteration and the doubling algorithm for the DARE on chains of lightly damped
+ * oscillators, sweeping the time step of the discretization and the solver type (benchmark arguments). The
+ * fixed-point iteration converges slowly for small time steps.
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/optcon/optcon.h>
+
+using namespace ct::optcon;
+
+/*!
+ * @param state range(0): time step 10^-range(0), range(1): DARESolverType
+ */
+template <size_t N_OSCILLATORS>
+void BM_DARE(benchmark::State& state)
+{
+    const size_t STATE_DIM = 2 * N_OSCILLATORS;
+    const size_t CONTROL_DIM = N_OSCILLATORS;
+
+    const double dt = std::pow(10.0, -state.range(0));
+    const double zeta = 0.005;
+    const DARESolverType solverType = static_cast<DARESolverType>(state.range(1));
+    state.SetLabel(solverType == DOUBLING ? "doubling" : "fixed-point");
+
+    // forward Euler discretization of decoupled oscillators with eigenfrequencies 1, 2, 3, ... rad/s
+    Eigen::Matrix<double, STATE_DIM, STATE_DIM> A = Eigen::Matrix<double, STATE_DIM, STATE_DIM>::Identity();
+    Eigen::Matrix<double, STATE_DIM, CONTROL_DIM> B = Eigen::Matrix<double, STATE_DIM, CONTROL_DIM>::Zero();
+    for (size_t i = 0; i < N_OSCILLATORS; i++)
+    {
+        const double omega = i + 1.0;
+        A(2 * i, 2 * i + 1) = dt;
+        A(2 * i + 1, 2 * i) = -omega * omega * dt;
+        A(2 * i + 1, 2 * i + 1) = 1 - 2 * zeta * omega * dt;
+        B(2 * i + 1, i) = dt;
+    }
+
+    const Eigen::Matrix<double, STATE_DIM, STATE_DIM> Q =
+        1e-2 * Eigen::Matrix<double, STATE_DIM, STATE_DIM>::Identity();
+    const Eigen::Matrix<double, CONTROL_DIM, CONTROL_DIM> R =
+        Eigen::Matrix<double, CONTROL_DIM, CONTROL_DIM>::Identity();
+    Eigen::Matrix<double, CONTROL_DIM, STATE_DIM> K;
+
+    DARE<STATE_DIM, CONTROL_DIM> dare(solverType);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(dare.computeSteadyStateRiccatiMatrix(Q, R, A, B, K, false, 1e-9, 1000000));
+
+    state.counters["iterations"] = dare.getNumIterations();
+}
+
+BENCHMARK_TEMPLATE(BM_DARE, 3)
+    ->ArgNames({"dt_exp", "solver"})
+    ->ArgsProduct({{1, 2, 3}, {FIXED_POINT_ITERATION, DOUBLING}})
+    ->Unit(benchmark::kMillisecond);
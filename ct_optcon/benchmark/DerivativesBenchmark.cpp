@@ -0,0 +1,66 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks Jacobians of a vector-valued function by numerical differentiation and, if compiled with CppADCodeGen,
+ * by just-in-time compiled auto-diff code, sweeping the input dimension (template argument).
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/core/core.h>
+
+using namespace ct::core;
+
+//! a coupled nonlinear map with a dense Jacobian
+template <typename SCALAR, int DIM>
+Eigen::Matrix<SCALAR, DIM, 1> testFunction(const Eigen::Matrix<SCALAR, DIM, 1>& x)
+{
+    typedef typename tpl::TraitSelector<SCALAR>::Trait Trait;
+
+    const SCALAR sum = x.sum();
+    Eigen::Matrix<SCALAR, DIM, 1> y;
+    for (int i = 0; i < DIM; i++)
+        y(i) = Trait::sin(x(i)) * sum + x(i) * x((i + 1) % DIM);
+    return y;
+}
+
+template <int DIM>
+void BM_JacobianNumDiff(benchmark::State& state)
+{
+    typedef DerivativesNumDiff<DIM, DIM> Derivatives;
+    typename Derivatives::Function f = testFunction<double, DIM>;
+    Derivatives derivatives(f, state.range(0));
+    state.SetLabel(state.range(0) ? "central" : "forward");
+
+    const Eigen::VectorXd x = Eigen::VectorXd::Random(DIM);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(derivatives.jacobian(x));
+}
+
+BENCHMARK_TEMPLATE(BM_JacobianNumDiff, 6)->DenseRange(0, 1);
+BENCHMARK_TEMPLATE(BM_JacobianNumDiff, 36)->DenseRange(0, 1);
+BENCHMARK_TEMPLATE(BM_JacobianNumDiff, 72)->DenseRange(0, 1);
+
+#ifdef CPPADCG
+template <int DIM>
+void BM_JacobianCppadJIT(benchmark::State& state)
+{
+    typedef DerivativesCppadJIT<DIM, DIM> Derivatives;
+    typename Derivatives::FUN_TYPE_CG f = testFunction<typename Derivatives::CG_SCALAR, DIM>;
+    Derivatives derivatives(f);
+
+    DerivativesCppadSettings settings;
+    settings.createJacobian_ = true;
+    derivatives.compileJIT(settings, "benchmarkJacobian" + std::to_string(DIM));
+
+    const Eigen::VectorXd x = Eigen::VectorXd::Random(DIM);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(derivatives.jacobian(x));
+}
+
+BENCHMARK_TEMPLATE(BM_JacobianCppadJIT, 6);
+BENCHMARK_TEMPLATE(BM_JacobianCppadJIT, 36);
+BENCHMARK_TEMPLATE(BM_JacobianCppadJIT, 72);
+#endif
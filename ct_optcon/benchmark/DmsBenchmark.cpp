@@ -0,0 +1,80 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks the cost gradient of the DMS problem computed by forward sensitivities and by the adjoint method with and
+ * without checkpointing, sweeping the control dimension (template argument) and the gradient type (benchmark argument).
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/optcon/optcon.h>
+
+#include "MIMOIntegrator.h"
+
+using namespace ct;
+using namespace ct::optcon;
+
+/*!
+ * @param state range(0): 0 forward sensitivities, 1 adjoint, 2 adjoint with a checkpoint interval of 10
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+void BM_DmsCostGradient(benchmark::State& state)
+{
+    DmsSettings settings;
+    settings.N_ = 10;
+    settings.T_ = 1.0;
+    settings.dt_sim_ = 0.001;
+    settings.nThreads_ = 1;
+    settings.splineType_ = DmsSettings::PIECEWISE_LINEAR;
+    settings.costEvaluationType_ = DmsSettings::FULL;
+    settings.integrationType_ = DmsSettings::RK4;
+    settings.costGradientType_ = state.range(0) == 0 ? DmsSettings::FORWARD : DmsSettings::ADJOINT;
+    settings.adjointCheckpointInterval_ = state.range(0) == 2 ? 10 : 0;
+
+    const std::string names[3] = {"forward", "adjoint", "adjoint checkpointed"};
+    state.SetLabel(names[state.range(0)]);
+
+    std::vector<std::shared_ptr<core::ControlledSystem<STATE_DIM, CONTROL_DIM>>> systems;
+    std::vector<std::shared_ptr<core::LinearSystem<STATE_DIM, CONTROL_DIM>>> linearSystems;
+    std::vector<std::shared_ptr<CostFunctionQuadratic<STATE_DIM, CONTROL_DIM>>> costFunctions;
+
+    auto costFunction = example::createMIMOIntegratorCostFunction<STATE_DIM, CONTROL_DIM>(
+        core::StateVector<STATE_DIM>::Ones());
+    for (size_t i = 0; i < settings.N_; i++)
+    {
+        systems.push_back(std::shared_ptr<core::ControlledSystem<STATE_DIM, CONTROL_DIM>>(
+            new example::MIMOIntegrator<STATE_DIM, CONTROL_DIM>()));
+        linearSystems.push_back(std::shared_ptr<core::LinearSystem<STATE_DIM, CONTROL_DIM>>(
+            new example::MIMOIntegratorLinear<STATE_DIM, CONTROL_DIM>()));
+        costFunctions.push_back(
+            std::shared_ptr<CostFunctionQuadratic<STATE_DIM, CONTROL_DIM>>(costFunction->clone()));
+    }
+
+    DmsProblem<STATE_DIM, CONTROL_DIM> dmsProblem(
+        settings, systems, linearSystems, costFunctions, {}, {}, {}, core::StateVector<STATE_DIM>::Zero());
+
+    const size_t n = dmsProblem.getVarCount();
+    Eigen::VectorXd w(n);
+    Eigen::VectorXd grad(n);
+    Eigen::Map<Eigen::VectorXd> gradMap(grad.data(), n);
+    Eigen::Map<const Eigen::VectorXd> wMap(w.data(), n);
+
+    for (auto _ : state)
+    {
+        // a new point for every gradient, such that no shot is reused
+        state.PauseTiming();
+        w.setRandom();
+        dmsProblem.extractOptimizationVars(wMap, true);
+        state.ResumeTiming();
+
+        dmsProblem.evaluateCostGradient(n, gradMap);
+        benchmark::DoNotOptimize(grad.data());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_DmsCostGradient, 12, 1)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DmsCostGradient, 12, 3)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DmsCostGradient, 12, 6)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DmsCostGradient, 12, 12)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
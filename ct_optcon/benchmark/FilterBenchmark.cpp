@@ -0,0 +1,181 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks a predict/update cycle of the extended Kalman filter, its square-root variant, the square-root unscented
+ * Kalman filter and the information filter at 1 kHz, sweeping the number of outputs (template argument). Also
+ * benchmarks the propagation of the sigma points of a 30-state unscented Kalman filter through a CTSystemModel, point
+ * by point or as a batch, sweeping the integrator and the number of threads (benchmark arguments).
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/optcon/optcon.h>
+
+using namespace ct::core;
+using namespace ct::optcon;
+
+namespace {
+
+const size_t state_dim = 12;
+const size_t control_dim = 4;
+const double dt = 0.001;
+
+//! a discrete-time linear system
+class LinearSystemModel : public SystemModelBase<state_dim, control_dim>
+{
+public:
+    LinearSystemModel(const state_matrix_t& A, const Eigen::Matrix<double, state_dim, control_dim>& B) : A_(A), B_(B)
+    {
+    }
+
+    state_vector_t computeDynamics(const state_vector_t& x,
+        const control_vector_t& u,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return A_ * x + B_ * u;
+    }
+
+    state_matrix_t computeDerivativeState(const state_vector_t& x,
+        const control_vector_t& u,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return A_;
+    }
+
+    state_matrix_t computeDerivativeNoise(const state_vector_t& x,
+        const control_vector_t& u,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return state_matrix_t::Identity();
+    }
+
+private:
+    state_matrix_t A_;
+    Eigen::Matrix<double, state_dim, control_dim> B_;
+};
+
+const size_t nPendulums = 15;
+
+//! a chain of pendulums coupled by springs, the first pendulum is actuated
+class PendulumChain : public ControlledSystem<2 * nPendulums, 1>
+{
+public:
+    PendulumChain() : ControlledSystem<2 * nPendulums, 1>(SYSTEM_TYPE::SECOND_ORDER) {}
+    PendulumChain* clone() const override { return new PendulumChain(*this); }
+    void computeControlledDynamics(const StateVector<2 * nPendulums>& x,
+        const double& t,
+        const ControlVector<1>& u,
+        StateVector<2 * nPendulums>& dxdt) override
+    {
+        const double g_l = 9.81;
+        const double k = 2.0;
+        const double d = 0.1;
+
+        for (size_t i = 0; i < nPendulums; i++)
+        {
+            const double q = x(i);
+            const double qd = x(nPendulums + i);
+            double spring = 0;
+            if (i > 0)
+                spring += k * std::sin(x(i - 1) - q);
+            if (i + 1 < nPendulums)
+                spring += k * std::sin(x(i + 1) - q);
+
+            dxdt(i) = qd;
+            dxdt(nPendulums + i) = -g_l * std::sin(q) - d * qd + spring;
+        }
+        dxdt(nPendulums) += u(0);
+    }
+};
+
+}  // namespace
+
+/*!
+ * The smallest eigenvalue of the covariance after the run is reported, negative values indicate a loss of
+ * definiteness.
+ */
+template <template <size_t, size_t, size_t, typename> class FILTER, size_t OUTPUT_DIM>
+void BM_KalmanFilter(benchmark::State& state)
+{
+    std::srand(0);
+    const StateMatrix<state_dim> A = StateMatrix<state_dim>::Identity() + dt * StateMatrix<state_dim>::Random();
+    const Eigen::Matrix<double, state_dim, control_dim> B =
+        dt * Eigen::Matrix<double, state_dim, control_dim>::Random();
+    std::shared_ptr<LinearSystemModel> model(new LinearSystemModel(A, B));
+
+    std::shared_ptr<LTIMeasurementModel<OUTPUT_DIM, state_dim>> measModel(
+        new LTIMeasurementModel<OUTPUT_DIM, state_dim>(
+            OutputStateMatrix<OUTPUT_DIM, state_dim>::Random(), OutputMatrix<OUTPUT_DIM>::Identity()));
+
+    const StateMatrix<state_dim> Q = 1e-2 * StateMatrix<state_dim>::Identity();
+    const OutputMatrix<OUTPUT_DIM> R = 1e-4 * OutputMatrix<OUTPUT_DIM>::Identity();
+    FILTER<state_dim, control_dim, OUTPUT_DIM, double> filter(
+        model, measModel, Q, R, StateVector<state_dim>::Zero(), StateMatrix<state_dim>::Identity());
+
+    StateVector<state_dim> x = StateVector<state_dim>::Zero();
+    const ControlVector<control_dim> u = ControlVector<control_dim>::Ones();
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        x = model->computeDynamics(x, u, dt, i * dt);
+        filter.predict(u, dt, i * dt);
+        filter.update(measModel->computeMeasurement(x), dt, i * dt);
+        i++;
+    }
+
+    Eigen::SelfAdjointEigenSolver<StateMatrix<state_dim>> eig(filter.getCovarianceMatrix());
+    state.counters["min_eig_P"] = eig.eigenvalues().minCoeff();
+}
+
+// a fixed number of cycles, since the simulated system is not stable
+#define CT_BENCHMARK_FILTER(OUTPUT_DIM)                                                                       \
+    BENCHMARK_TEMPLATE(BM_KalmanFilter, ExtendedKalmanFilter, OUTPUT_DIM)->Iterations(10000);                 \
+    BENCHMARK_TEMPLATE(BM_KalmanFilter, SquareRootExtendedKalmanFilter, OUTPUT_DIM)->Iterations(10000);       \
+    BENCHMARK_TEMPLATE(BM_KalmanFilter, SquareRootUnscentedKalmanFilter, OUTPUT_DIM)->Iterations(10000);      \
+    BENCHMARK_TEMPLATE(BM_KalmanFilter, InformationFilter, OUTPUT_DIM)->Iterations(10000);
+
+CT_BENCHMARK_FILTER(3)
+CT_BENCHMARK_FILTER(12)
+CT_BENCHMARK_FILTER(48)
+
+/*!
+ * @param state range(0): IntegrationType, range(1): 0 point by point as done by SystemModelBase, otherwise the number
+ * of threads of the batch propagation
+ */
+void BM_SigmaPointPropagation(benchmark::State& state)
+{
+    const size_t sigmaDim = 2 * nPendulums;
+    const IntegrationType intType = static_cast<IntegrationType>(state.range(0));
+    state.SetLabel(intType == IntegrationType::RK4 ? "RK4" : "EULERCT");
+
+    CTSystemModel<sigmaDim, 1> sysModel(
+        std::shared_ptr<PendulumChain>(new PendulumChain()), nullptr, StateMatrix<sigmaDim>::Identity(), intType);
+    if (state.range(1) > 0)
+        sysModel.setNumBatchThreads(state.range(1));
+
+    Eigen::Matrix<double, sigmaDim, Eigen::Dynamic> points(sigmaDim, 2 * sigmaDim + 1);
+    points.setRandom();
+    const ControlVector<1> u = ControlVector<1>::Ones();
+
+    size_t run = 0;
+    for (auto _ : state)
+    {
+        if (state.range(1) == 0)
+            sysModel.SystemModelBase<sigmaDim, 1>::computeDynamicsBatch(points, u, dt, run * dt);
+        else
+            sysModel.computeDynamicsBatch(points, u, dt, run * dt);
+        benchmark::DoNotOptimize(points.data());
+        run++;
+    }
+}
+
+BENCHMARK(BM_SigmaPointPropagation)
+    ->ArgNames({"integrator", "threads"})
+    ->ArgsProduct({{static_cast<int>(IntegrationType::EULERCT), static_cast<int>(IntegrationType::RK4)}, {0, 1, 4}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
@@ -0,0 +1,70 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks 100 fixed steps of the Integrator steppers on a chain of coupled pendulums, sweeping the state
+ * dimension (template argument) and the stepper (benchmark argument).
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/core/core.h>
+
+using namespace ct::core;
+
+//! a chain of pendulums coupled by springs
+template <size_t N_PENDULUMS>
+class PendulumChain : public ControlledSystem<2 * N_PENDULUMS, 1>
+{
+public:
+    static const size_t STATE_DIM = 2 * N_PENDULUMS;
+
+    PendulumChain() : ControlledSystem<STATE_DIM, 1>(SYSTEM_TYPE::SECOND_ORDER) {}
+    PendulumChain* clone() const override { return new PendulumChain(*this); }
+    void computeControlledDynamics(const StateVector<STATE_DIM>& x,
+        const double& t,
+        const ControlVector<1>& u,
+        StateVector<STATE_DIM>& dxdt) override
+    {
+        for (size_t i = 0; i < N_PENDULUMS; i++)
+        {
+            double spring = 0.0;
+            if (i > 0)
+                spring += 2.0 * std::sin(x(i - 1) - x(i));
+            if (i + 1 < N_PENDULUMS)
+                spring += 2.0 * std::sin(x(i + 1) - x(i));
+
+            dxdt(i) = x(N_PENDULUMS + i);
+            dxdt(N_PENDULUMS + i) = -9.81 * std::sin(x(i)) - 0.1 * x(N_PENDULUMS + i) + spring;
+        }
+        dxdt(N_PENDULUMS) += u(0);
+    }
+};
+
+template <size_t N_PENDULUMS>
+void BM_Integrator(benchmark::State& state)
+{
+    const IntegrationType types[5] = {EULER, RK4, MODIFIED_MIDPOINT, EULERCT, RK4CT};
+    const std::string names[5] = {"EULER", "RK4", "MODIFIED_MIDPOINT", "EULERCT", "RK4CT"};
+    state.SetLabel(names[state.range(0)]);
+
+    const size_t nSteps = 100;
+    Integrator<2 * N_PENDULUMS> integrator(
+        std::shared_ptr<PendulumChain<N_PENDULUMS>>(new PendulumChain<N_PENDULUMS>()), types[state.range(0)]);
+
+    const StateVector<2 * N_PENDULUMS> x0 = StateVector<2 * N_PENDULUMS>::Random();
+
+    for (auto _ : state)
+    {
+        StateVector<2 * N_PENDULUMS> x = x0;
+        integrator.integrate_n_steps(x, 0.0, nSteps, 0.001);
+        benchmark::DoNotOptimize(x.data());
+    }
+
+    state.counters["steps/s"] = benchmark::Counter(nSteps, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(BM_Integrator, 2)->DenseRange(0, 4)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Integrator, 6)->DenseRange(0, 4)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Integrator, 18)->DenseRange(0, 4)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,46 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks the evaluation of state trajectories with zero-order hold and linear interpolation, sweeping the state
+ * dimension (template argument) and the number of samples (benchmark argument). The query times are sorted, as
+ * during a rollout, so the cached index of the interpolation is exercised.
+ */
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <ct/core/core.h>
+
+using namespace ct::core;
+
+template <size_t STATE_DIM>
+void BM_Interpolation(benchmark::State& state)
+{
+    const size_t nSamples = state.range(0);
+    const InterpolationType type = static_cast<InterpolationType>(state.range(1));
+    state.SetLabel(type == ZOH ? "ZOH" : "LIN");
+
+    const double dt = 0.01;
+    StateVectorArray<STATE_DIM> data(nSamples);
+    for (auto& x : data)
+        x.setRandom();
+    StateTrajectory<STATE_DIM> trajectory(data, dt, 0.0, type);
+
+    const size_t nQueries = 1000;
+    std::vector<double> queries(nQueries);
+    for (size_t i = 0; i < nQueries; i++)
+        queries[i] = (nSamples - 1) * dt * (i + 0.5) / nQueries;
+
+    for (auto _ : state)
+    {
+        for (const double t : queries)
+            benchmark::DoNotOptimize(trajectory.eval(t));
+    }
+
+    state.counters["queries/s"] = benchmark::Counter(nQueries, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(BM_Interpolation, 4)->ArgsProduct({{100, 10000}, {ZOH, LIN}})->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Interpolation, 36)->ArgsProduct({{100, 10000}, {ZOH, LIN}})->Unit(benchmark::kMicrosecond);
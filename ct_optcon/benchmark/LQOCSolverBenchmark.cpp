@@ -0,0 +1,85 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks the solution of unconstrained LQ optimal control problems with the Riccati solver and HPIPM, sweeping
+ * the state dimension (template argument) and the horizon length (benchmark argument). The condensing solver is
+ * compared on short horizons, where it is meant to be used.
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/optcon/optcon.h>
+
+#include "MIMOIntegrator.h"
+
+using namespace ct;
+using namespace ct::optcon;
+
+template <class SOLVER, size_t STATE_DIM, size_t CONTROL_DIM>
+void BM_LQOCSolve(benchmark::State& state)
+{
+    const size_t N = state.range(0);
+    const double dt = 0.01;
+
+    std::shared_ptr<core::LinearSystem<STATE_DIM, CONTROL_DIM>> linearSystem(
+        new example::MIMOIntegratorLinear<STATE_DIM, CONTROL_DIM>());
+    core::SensitivityApproximation<STATE_DIM, CONTROL_DIM> discreteSystem(
+        dt, linearSystem, core::SensitivityApproximationSettings::APPROXIMATION::MATRIX_EXPONENTIAL);
+
+    auto costFunction = example::createMIMOIntegratorCostFunction<STATE_DIM, CONTROL_DIM>(
+        core::StateVector<STATE_DIM>::Ones());
+
+    std::shared_ptr<LQOCProblem<STATE_DIM, CONTROL_DIM>> problem(new LQOCProblem<STATE_DIM, CONTROL_DIM>(N));
+    problem->setFromTimeInvariantLinearQuadraticProblem(
+        discreteSystem, *costFunction, core::StateVector<STATE_DIM>::Zero(), dt);
+
+    NLOptConSettings settings;
+    settings.fixedHessianCorrection = true;
+    settings.epsilon = 0;
+    settings.recordSmallestEigenvalue = false;
+    settings.nThreadsEigen = 1;
+
+    SOLVER solver;
+    solver.configure(settings);
+    solver.setProblem(problem);
+    solver.initializeAndAllocate();
+
+    for (auto _ : state)
+    {
+        solver.solve();
+        solver.computeStatesAndControls();
+        solver.computeFeedbackMatrices();
+        solver.compute_lv();
+        benchmark::DoNotOptimize(solver.getSolutionControl());
+    }
+
+    state.counters["stages/s"] = benchmark::Counter(N, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+#define CT_BENCHMARK_LQOC_SOLVER(...)                                                                              \
+    BENCHMARK_TEMPLATE(BM_LQOCSolve, __VA_ARGS__)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
+
+CT_BENCHMARK_LQOC_SOLVER(GNRiccatiSolver<4, 2>, 4, 2)
+CT_BENCHMARK_LQOC_SOLVER(GNRiccatiSolver<12, 6>, 12, 6)
+CT_BENCHMARK_LQOC_SOLVER(GNRiccatiSolver<36, 12>, 36, 12)
+
+#ifdef HPIPM
+CT_BENCHMARK_LQOC_SOLVER(HPIPMInterface<4, 2>, 4, 2)
+CT_BENCHMARK_LQOC_SOLVER(HPIPMInterface<12, 6>, 12, 6)
+CT_BENCHMARK_LQOC_SOLVER(HPIPMInterface<36, 12>, 36, 12)
+#endif
+
+#define CT_BENCHMARK_LQOC_SOLVER_SHORT(...) \
+    BENCHMARK_TEMPLATE(BM_LQOCSolve, __VA_ARGS__)->DenseRange(5, 20, 5)->Unit(benchmark::kMicrosecond);
+
+CT_BENCHMARK_LQOC_SOLVER_SHORT(GNRiccatiSolver<12, 2>, 12, 2)
+CT_BENCHMARK_LQOC_SOLVER_SHORT(CondensingLQOCSolver<12, 2>, 12, 2)
+CT_BENCHMARK_LQOC_SOLVER_SHORT(GNRiccatiSolver<36, 4>, 36, 4)
+CT_BENCHMARK_LQOC_SOLVER_SHORT(CondensingLQOCSolver<36, 4>, 36, 4)
+
+#ifdef HPIPM
+CT_BENCHMARK_LQOC_SOLVER_SHORT(HPIPMInterface<12, 2>, 12, 2)
+CT_BENCHMARK_LQOC_SOLVER_SHORT(HPIPMInterface<36, 4>, 36, 4)
+#endif
@@ -0,0 +1,117 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks the MPC cycles of a GNMS solver on the linear oscillator with a full re-linearization in every cycle
+ * against the incremental re-linearization for different tolerances (benchmark argument), with the linearization
+ * computed by forward Euler or by the sensitivity integrator (template argument).
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/optcon/optcon.h>
+
+#include "LinearOscillator.h"
+
+using namespace ct;
+using namespace ct::optcon;
+using namespace ct::optcon::example;
+
+/*!
+ * One benchmark iteration runs the MPC loop until the fixed final time is reached, the items are MPC cycles.
+ * @param state range(0): 0 full re-linearization, n > 0 incremental re-linearization with tolerance 10^-n
+ */
+template <bool SENSITIVITY_INTEGRATOR>
+void BM_NLOC_MPC(benchmark::State& state)
+{
+    NLOptConSettings nloc_settings;
+    nloc_settings.dt = 0.01;
+    nloc_settings.K_sim = SENSITIVITY_INTEGRATOR ? 10 : 1;
+    nloc_settings.K_shot = 1;
+    nloc_settings.max_iterations = 10;
+    nloc_settings.min_cost_improvement = 1e-10;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    nloc_settings.integrator = SENSITIVITY_INTEGRATOR ? core::IntegrationType::RK4 : core::IntegrationType::EULER;
+    nloc_settings.useSensitivityIntegrator = SENSITIVITY_INTEGRATOR;
+    nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    nloc_settings.nThreads = 1;
+    nloc_settings.nThreadsEigen = 1;
+    nloc_settings.printSummary = false;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+    core::StateVector<state_dim> x0;
+    x0 << 1.0, 0.0;
+    const core::Time timeHorizon = 3.0;
+
+    std::shared_ptr<core::ControlledSystem<state_dim, control_dim>> system(new LinearOscillator);
+    std::shared_ptr<core::LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear);
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+        system, tpl::createCostFunctionLinearOscillator<double>(x_final), analyticLinearSystem);
+    optConProblem.setTimeHorizon(timeHorizon);
+    optConProblem.setInitialState(x0);
+
+    // converged initial guess
+    const int K = nloc_settings.computeK(timeHorizon);
+    core::StateFeedbackController<state_dim, control_dim> initController(
+        core::StateVectorArray<state_dim>(K + 1, x0),
+        core::ControlVectorArray<control_dim>(K, core::ControlVector<control_dim>::Zero()),
+        core::FeedbackArray<state_dim, control_dim>(K, core::FeedbackMatrix<state_dim, control_dim>::Zero()),
+        nloc_settings.dt);
+    NLOptConSolver<state_dim, control_dim> initSolver(optConProblem, nloc_settings);
+    initSolver.setInitialGuess(initController);
+    initSolver.solve();
+
+    nloc_settings.max_iterations = 1;
+    nloc_settings.incrementalLinearization = state.range(0) > 0;
+    nloc_settings.incrementalLinearizationTol = std::pow(10.0, -state.range(0));
+    state.SetLabel(state.range(0) > 0 ? "incremental" : "full");
+
+    mpc_settings settings;
+    settings.stateForwardIntegration_ = true;
+    settings.stateForwardIntegratorType_ = nloc_settings.integrator;
+    settings.stateForwardIntegration_dt_ = nloc_settings.dt;
+    settings.postTruncation_ = false;
+    settings.measureDelay_ = false;
+    settings.fixedDelayUs_ = 20000;
+    settings.mpc_mode = MPC_MODE::FIXED_FINAL_TIME;
+    settings.coldStart_ = false;
+    settings.useExternalTiming_ = true;
+
+    size_t numCycles = 0;
+    size_t numSkipped = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        MPC<NLOptConSolver<state_dim, control_dim>> mpcSolver(optConProblem, nloc_settings, settings);
+        mpcSolver.setInitialGuess(initSolver.getSolution());
+        core::StateVector<state_dim> x = x0;
+        mpcSolver.prepareIteration(0.0);
+        state.ResumeTiming();
+
+        for (int i = 0; i < 100; i++)
+        {
+            const double t = i * 1e-6 * settings.fixedDelayUs_;
+            core::StateFeedbackController<state_dim, control_dim> newPolicy;
+            core::Time ts_newPolicy;
+
+            mpcSolver.finishIteration(x, t, newPolicy, ts_newPolicy);
+            mpcSolver.prepareIteration(t);
+
+            numSkipped += mpcSolver.getSolver().getBackend()->getNumSkippedLQApproximations();
+            numCycles++;
+
+            x = newPolicy.getReferenceStateTrajectory().front();
+            if (mpcSolver.timeHorizonReached())
+                break;
+        }
+    }
+
+    state.SetItemsProcessed(numCycles);
+    state.counters["skipped_stages"] = numCycles > 0 ? double(numSkipped) / numCycles : 0.0;
+}
+
+BENCHMARK_TEMPLATE(BM_NLOC_MPC, false)->ArgName("tol_exp")->Arg(0)->DenseRange(2, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_NLOC_MPC, true)->ArgName("tol_exp")->Arg(0)->DenseRange(2, 4)->Unit(benchmark::kMillisecond);
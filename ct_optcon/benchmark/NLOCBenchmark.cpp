@@ -0,0 +1,92 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks complete GNMS and iLQR solves from a fixed initial guess, sweeping the state dimension (system),
+ * the horizon length, the number of threads and the algorithm (benchmark arguments).
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/optcon/optcon.h>
+
+#include "DiehlSystem.h"
+#include "LinkedMasses.h"
+#include "MIMOIntegrator.h"
+
+using namespace ct;
+using namespace ct::optcon;
+
+/*!
+ * @param state range(0): number of stages, range(1): number of threads, range(2): NLOptConSettings::NLOCP_ALGORITHM
+ */
+template <class SYSTEM, class LINEAR_SYSTEM, size_t STATE_DIM, size_t CONTROL_DIM>
+void BM_NLOCSolve(benchmark::State& state)
+{
+    typedef NLOptConSolver<STATE_DIM, CONTROL_DIM> Solver;
+
+    const size_t K = state.range(0);
+
+    NLOptConSettings settings;
+    settings.dt = 0.01;
+    settings.K_sim = 1;
+    settings.nThreads = state.range(1);
+    settings.nThreadsEigen = 1;
+    settings.nlocp_algorithm = static_cast<NLOptConSettings::NLOCP_ALGORITHM>(state.range(2));
+    settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    settings.integrator = core::IntegrationType::EULERCT;
+    settings.max_iterations = 20;
+    settings.min_cost_improvement = 1e-10;
+    settings.epsilon = 0.0;
+    settings.recordSmallestEigenvalue = false;
+    settings.fixedHessianCorrection = false;
+    settings.printSummary = false;
+    settings.lineSearchSettings.type = LineSearchSettings::TYPE::SIMPLE;
+    state.SetLabel(settings.nlocp_algorithm == NLOptConSettings::NLOCP_ALGORITHM::GNMS ? "GNMS" : "iLQR");
+
+    std::shared_ptr<core::ControlledSystem<STATE_DIM, CONTROL_DIM>> system(new SYSTEM());
+    std::shared_ptr<core::LinearSystem<STATE_DIM, CONTROL_DIM>> linearSystem(new LINEAR_SYSTEM());
+    auto costFunction = example::createMIMOIntegratorCostFunction<STATE_DIM, CONTROL_DIM>(
+        core::StateVector<STATE_DIM>::Constant(0.5));
+
+    const core::StateVector<STATE_DIM> x0 = core::StateVector<STATE_DIM>::Zero();
+    ContinuousOptConProblem<STATE_DIM, CONTROL_DIM> problem(K * settings.dt, x0, system, costFunction, linearSystem);
+
+    typename Solver::Policy_t initialGuess(core::StateVectorArray<STATE_DIM>(K + 1, x0),
+        core::ControlVectorArray<CONTROL_DIM>(K, core::ControlVector<CONTROL_DIM>::Zero()),
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM>(K, core::FeedbackMatrix<STATE_DIM, CONTROL_DIM>::Zero()),
+        settings.dt);
+
+    Solver solver(problem, settings);
+
+    // every iteration appends to the summary of the backend
+    const SummaryAllIterations<double>& summary = solver.getBackend()->getSummary();
+    size_t iterations = 0;
+    for (auto _ : state)
+    {
+        const size_t iterationsBefore = summary.iterations.size();
+        solver.setInitialGuess(initialGuess);
+        solver.solve();
+        iterations = summary.iterations.size() - iterationsBefore;
+    }
+
+    state.counters["iterations"] = iterations;
+}
+
+typedef example::DiehlSystem Diehl;
+typedef example::DiehlSystemLinear DiehlLinear;
+typedef example::MIMOIntegrator<12, 6> MIMOIntegrator12;
+typedef example::MIMOIntegratorLinear<12, 6> MIMOIntegratorLinear12;
+
+#define CT_BENCHMARK_NLOC(...)                                                                                     \
+    BENCHMARK(BM_NLOCSolve<__VA_ARGS__>)                                                                           \
+        ->ArgNames({"K", "threads", "algorithm"})                                                                  \
+        ->ArgsProduct({{50, 200, 800}, {1, 2, 4}, {NLOptConSettings::GNMS, NLOptConSettings::ILQR}})             \
+        ->Unit(benchmark::kMillisecond)                                                                            \
+        ->UseRealTime();
+
+CT_BENCHMARK_NLOC(Diehl, DiehlLinear, 1, 1)
+CT_BENCHMARK_NLOC(LinkedMasses, LinkedMasses, 8, 3)
+CT_BENCHMARK_NLOC(MIMOIntegrator12, MIMOIntegratorLinear12, 12, 6)
@@ -0,0 +1,52 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * Benchmarks the discretization of a dense linear system with the different SensitivityApproximation modes,
+ * sweeping the state dimension (template argument) and the approximation type (benchmark argument).
+ */
+
+#include <benchmark/benchmark.h>
+#include <ct/optcon/optcon.h>
+
+#include "MIMOIntegrator.h"
+
+using namespace ct;
+using namespace ct::optcon;
+
+typedef core::SensitivityApproximationSettings::APPROXIMATION Approximation;
+
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+void BM_SensitivityApproximation(benchmark::State& state)
+{
+    const Approximation approximation = static_cast<Approximation>(state.range(0));
+    const std::string names[5] = {
+        "FORWARD_EULER", "BACKWARD_EULER", "SYMPLECTIC_EULER", "TUSTIN", "MATRIX_EXPONENTIAL"};
+    state.SetLabel(names[state.range(0)]);
+
+    std::shared_ptr<example::MIMOIntegratorLinear<STATE_DIM, CONTROL_DIM>> linearSystem(
+        new example::MIMOIntegratorLinear<STATE_DIM, CONTROL_DIM>());
+    linearSystem->A_.setRandom();
+    linearSystem->B_.setRandom();
+
+    // symplectic Euler splits the state in equally sized position and velocity parts
+    core::SensitivityApproximation<STATE_DIM, CONTROL_DIM> sensitivity(0.01, linearSystem, approximation);
+
+    core::StateVector<STATE_DIM> x = core::StateVector<STATE_DIM>::Random();
+    core::ControlVector<CONTROL_DIM> u = core::ControlVector<CONTROL_DIM>::Random();
+    core::StateMatrix<STATE_DIM> A;
+    core::StateControlMatrix<STATE_DIM, CONTROL_DIM> B;
+
+    for (auto _ : state)
+    {
+        sensitivity.getAandB(x, u, x, 0, 1, A, B);
+        benchmark::DoNotOptimize(A.data());
+        benchmark::DoNotOptimize(B.data());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_SensitivityApproximation, 4, 2)->DenseRange(0, 4);
+BENCHMARK_TEMPLATE(BM_SensitivityApproximation, 12, 6)->DenseRange(0, 4);
+BENCHMARK_TEMPLATE(BM_SensitivityApproximation, 36, 12)->DenseRange(0, 4);
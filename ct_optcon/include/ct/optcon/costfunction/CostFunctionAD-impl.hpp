@@ -13,7 +13,13 @@ namespace optcon {
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionAD()
     : CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>(),
-      stateControlTime_(Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM + 1, 1>::Zero())
+      stateControlTime_(Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM + 1, 1>::Zero()),
+      intermediateHasGeneratedTerms_(true),
+      finalHasGeneratedTerms_(true),
+      useAnalyticalDerivatives_(false),
+      profiling_(false),
+      intermediateGeneratedTime_(0.0),
+      finalGeneratedTime_(0.0)
 {
     intermediateFun_ = [&](const Eigen::Matrix<CGScalar, STATE_DIM + CONTROL_DIM + 1, 1>& stateInputTime) {
         return this->evaluateIntermediateCg(stateInputTime);
@@ -33,6 +39,16 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::CostFunctionAD(const CostFunctionAD& arg)
     : CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>(arg),
       stateControlTime_(arg.stateControlTime_),
+      intermediateTermIsAnalytical_(arg.intermediateTermIsAnalytical_),
+      finalTermIsAnalytical_(arg.finalTermIsAnalytical_),
+      intermediateHasGeneratedTerms_(arg.intermediateHasGeneratedTerms_),
+      finalHasGeneratedTerms_(arg.finalHasGeneratedTerms_),
+      useAnalyticalDerivatives_(arg.useAnalyticalDerivatives_),
+      profiling_(arg.profiling_),
+      intermediateTermTimes_(arg.intermediateTermTimes_.size(), 0.0),
+      finalTermTimes_(arg.finalTermTimes_.size(), 0.0),
+      intermediateGeneratedTime_(0.0),
+      finalGeneratedTime_(0.0),
       intermediateFun_(arg.intermediateFun_),
       finalFun_(arg.finalFun_)
 {
@@ -72,6 +88,24 @@ CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>* CostFunctionAD<STATE_DIM, CONTRO
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::initialize()
 {
+    // terms with closed-form derivatives are excluded from the generated code
+    intermediateHasGeneratedTerms_ = false;
+    for (size_t i = 0; i < intermediateTerms_.size(); i++)
+    {
+        intermediateTermIsAnalytical_[i] =
+            useAnalyticalDerivatives_ && intermediateTerms_[i]->hasAnalyticalDerivatives();
+        intermediateHasGeneratedTerms_ = intermediateHasGeneratedTerms_ || !intermediateTermIsAnalytical_[i];
+    }
+
+    finalHasGeneratedTerms_ = false;
+    for (size_t i = 0; i < finalTerms_.size(); i++)
+    {
+        finalTermIsAnalytical_[i] = useAnalyticalDerivatives_ && finalTerms_[i]->hasAnalyticalDerivatives();
+        finalHasGeneratedTerms_ = finalHasGeneratedTerms_ || !finalTermIsAnalytical_[i];
+    }
+
+    resetProfiling();
+
     intermediateFun_ = [&](const Eigen::Matrix<CGScalar, STATE_DIM + CONTROL_DIM + 1, 1>& stateInputTime) {
         return this->evaluateIntermediateCg(stateInputTime);
     };
@@ -89,8 +123,10 @@ void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::initialize()
     settings.createJacobian_ = true;
     settings.createHessian_ = true;
 
-    finalCostCodegen_->compileJIT(settings, "finalCosts");
-    intermediateCostCodegen_->compileJIT(settings, "intermediateCosts");
+    if (finalHasGeneratedTerms_)
+        finalCostCodegen_->compileJIT(settings, "finalCosts");
+    if (intermediateHasGeneratedTerms_)
+        intermediateCostCodegen_->compileJIT(settings, "intermediateCosts");
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -99,6 +135,7 @@ void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::addIntermediateADTerm(
     bool verbose)
 {
     intermediateTerms_.push_back(term);
+    intermediateTermIsAnalytical_.push_back(false);
 
     if (verbose)
     {
@@ -112,6 +149,7 @@ void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::addFinalADTerm(
     bool verbose)
 {
     finalTerms_.push_back(term);
+    finalTermIsAnalytical_.push_back(false);
 
     if (verbose)
     {
@@ -187,9 +225,12 @@ CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermediateCg(
 {
     CGScalar y = CGScalar(0.0);
 
-    for (auto it : intermediateTerms_)
-        y += it->evaluateCppadCg(stateInputTime.segment(0, STATE_DIM), stateInputTime.segment(STATE_DIM, CONTROL_DIM),
-            stateInputTime(STATE_DIM + CONTROL_DIM));
+    for (size_t i = 0; i < intermediateTerms_.size(); i++)
+    {
+        if (!intermediateTermIsAnalytical_[i])
+            y += intermediateTerms_[i]->evaluateCppadCg(stateInputTime.segment(0, STATE_DIM),
+                stateInputTime.segment(STATE_DIM, CONTROL_DIM), stateInputTime(STATE_DIM + CONTROL_DIM));
+    }
 
     Eigen::Matrix<CGScalar, 1, 1> out;
     out << y;
@@ -203,121 +244,340 @@ CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateTerminalCg(
 {
     CGScalar y = CGScalar(0.0);
 
-    for (auto it : finalTerms_)
-        y += it->evaluateCppadCg(stateInputTime.segment(0, STATE_DIM), stateInputTime.segment(STATE_DIM, CONTROL_DIM),
-            stateInputTime(STATE_DIM + CONTROL_DIM));
+    for (size_t i = 0; i < finalTerms_.size(); i++)
+    {
+        if (!finalTermIsAnalytical_[i])
+            y += finalTerms_[i]->evaluateCppadCg(stateInputTime.segment(0, STATE_DIM),
+                stateInputTime.segment(STATE_DIM, CONTROL_DIM), stateInputTime(STATE_DIM + CONTROL_DIM));
+    }
 
     Eigen::Matrix<CGScalar, 1, 1> out;
     out << y;
     return out;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+template <typename RESULT, typename F>
+void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::addAnalyticalTerms(
+    const std::vector<std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>>>& terms,
+    const std::vector<bool>& isAnalytical,
+    std::vector<double>& times,
+    RESULT& result,
+    F&& f)
+{
+    for (size_t i = 0; i < terms.size(); i++)
+    {
+        if (!isAnalytical[i])
+            continue;
+
+        if (profiling_)
+        {
+            auto start = std::chrono::steady_clock::now();
+            result += f(*terms[i]);
+            times[i] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        else
+            result += f(*terms[i]);
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+SCALAR CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateGenerated(JacCG& codegen,
+    bool hasGeneratedTerms,
+    double& time)
+{
+    if (!hasGeneratedTerms)
+        return SCALAR(0.0);
+
+    auto start = std::chrono::steady_clock::now();
+    SCALAR y = codegen.forwardZero(stateControlTime_)(0);
+    if (profiling_)
+        time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return y;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobian_t
+CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::jacobianGenerated(JacCG& codegen,
+    bool hasGeneratedTerms,
+    double& time)
+{
+    if (!hasGeneratedTerms)
+        return jacobian_t::Zero();
+
+    auto start = std::chrono::steady_clock::now();
+    jacobian_t jac = codegen.jacobian(stateControlTime_);
+    if (profiling_)
+        time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return jac;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::MatrixXs
+CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::hessianGenerated(JacCG& codegen,
+    bool hasGeneratedTerms,
+    double& time)
+{
+    if (!hasGeneratedTerms)
+        return MatrixXs::Zero(STATE_DIM + CONTROL_DIM + 1, STATE_DIM + CONTROL_DIM + 1);
+
+    auto start = std::chrono::steady_clock::now();
+    Eigen::Matrix<SCALAR, 1, 1> w;
+    w << SCALAR(1.0);
+    MatrixXs hes = codegen.hessian(stateControlTime_, w);
+    if (profiling_)
+        time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return hes;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 SCALAR CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermediate()
 {
-    return this->evaluateIntermediateBase() + intermediateCostCodegen_->forwardZero(stateControlTime_)(0);
+    SCALAR y = this->evaluateIntermediateBase() +
+               evaluateGenerated(*intermediateCostCodegen_, intermediateHasGeneratedTerms_, intermediateGeneratedTime_);
+    addAnalyticalTerms(intermediateTerms_, intermediateTermIsAnalytical_, intermediateTermTimes_, y,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.evaluateAnalytical(this->x_, this->u_, this->t_);
+        });
+    return y;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 SCALAR CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateTerminal()
 {
-    return this->evaluateTerminalBase() + finalCostCodegen_->forwardZero(stateControlTime_)(0);
+    SCALAR y = this->evaluateTerminalBase() +
+               evaluateGenerated(*finalCostCodegen_, finalHasGeneratedTerms_, finalGeneratedTime_);
+    addAnalyticalTerms(finalTerms_, finalTermIsAnalytical_, finalTermTimes_, y,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.evaluateAnalytical(this->x_, this->u_, this->t_);
+        });
+    return y;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::state_vector_t
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeIntermediate()
 {
-    Eigen::Matrix<SCALAR, 1, STATE_DIM + CONTROL_DIM + 1> jacTot =
-        intermediateCostCodegen_->jacobian(stateControlTime_);
-    return jacTot.template leftCols<STATE_DIM>().transpose() + this->stateDerivativeIntermediateBase();
+    jacobian_t jac =
+        jacobianGenerated(*intermediateCostCodegen_, intermediateHasGeneratedTerms_, intermediateGeneratedTime_);
+    state_vector_t derivative =
+        jac.template leftCols<STATE_DIM>().transpose() + this->stateDerivativeIntermediateBase();
+    addAnalyticalTerms(intermediateTerms_, intermediateTermIsAnalytical_, intermediateTermTimes_, derivative,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.stateDerivative(this->x_, this->u_, this->t_);
+        });
+    return derivative;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::state_vector_t
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeTerminal()
 {
-    Eigen::Matrix<SCALAR, 1, STATE_DIM + CONTROL_DIM + 1> jacTot = finalCostCodegen_->jacobian(stateControlTime_);
-    return jacTot.template leftCols<STATE_DIM>().transpose() + this->stateDerivativeTerminalBase();
+    jacobian_t jac = jacobianGenerated(*finalCostCodegen_, finalHasGeneratedTerms_, finalGeneratedTime_);
+    state_vector_t derivative = jac.template leftCols<STATE_DIM>().transpose() + this->stateDerivativeTerminalBase();
+    addAnalyticalTerms(finalTerms_, finalTermIsAnalytical_, finalTermTimes_, derivative,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.stateDerivative(this->x_, this->u_, this->t_);
+        });
+    return derivative;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::control_vector_t
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::controlDerivativeIntermediate()
 {
-    Eigen::Matrix<SCALAR, 1, STATE_DIM + CONTROL_DIM + 1> jacTot =
-        intermediateCostCodegen_->jacobian(stateControlTime_);
-    return jacTot.template block<1, CONTROL_DIM>(0, STATE_DIM).transpose() + this->controlDerivativeIntermediateBase();
+    jacobian_t jac =
+        jacobianGenerated(*intermediateCostCodegen_, intermediateHasGeneratedTerms_, intermediateGeneratedTime_);
+    control_vector_t derivative =
+        jac.template block<1, CONTROL_DIM>(0, STATE_DIM).transpose() + this->controlDerivativeIntermediateBase();
+    addAnalyticalTerms(intermediateTerms_, intermediateTermIsAnalytical_, intermediateTermTimes_, derivative,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.controlDerivative(this->x_, this->u_, this->t_);
+        });
+    return derivative;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::control_vector_t
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::controlDerivativeTerminal()
 {
-    Eigen::Matrix<SCALAR, 1, STATE_DIM + CONTROL_DIM + 1> jacTot = finalCostCodegen_->jacobian(stateControlTime_);
-    return jacTot.template block<1, CONTROL_DIM>(0, STATE_DIM).transpose() + this->controlDerivativeTerminalBase();
+    jacobian_t jac = jacobianGenerated(*finalCostCodegen_, finalHasGeneratedTerms_, finalGeneratedTime_);
+    control_vector_t derivative =
+        jac.template block<1, CONTROL_DIM>(0, STATE_DIM).transpose() + this->controlDerivativeTerminalBase();
+    addAnalyticalTerms(finalTerms_, finalTermIsAnalytical_, finalTermTimes_, derivative,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.controlDerivative(this->x_, this->u_, this->t_);
+        });
+    return derivative;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::state_matrix_t
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::stateSecondDerivativeIntermediate()
 {
-    Eigen::Matrix<SCALAR, 1, 1> w;
-    w << SCALAR(1.0);
-    MatrixXs hesTot = intermediateCostCodegen_->hessian(stateControlTime_, w);
-    return hesTot.template block<STATE_DIM, STATE_DIM>(0, 0) + this->stateSecondDerivativeIntermediateBase();
+    MatrixXs hes =
+        hessianGenerated(*intermediateCostCodegen_, intermediateHasGeneratedTerms_, intermediateGeneratedTime_);
+    state_matrix_t derivative =
+        hes.template block<STATE_DIM, STATE_DIM>(0, 0) + this->stateSecondDerivativeIntermediateBase();
+    addAnalyticalTerms(intermediateTerms_, intermediateTermIsAnalytical_, intermediateTermTimes_, derivative,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.stateSecondDerivative(this->x_, this->u_, this->t_);
+        });
+    return derivative;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::state_matrix_t
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::stateSecondDerivativeTerminal()
 {
-    Eigen::Matrix<SCALAR, 1, 1> w;
-    w << SCALAR(1.0);
-    MatrixXs hesTot = finalCostCodegen_->hessian(stateControlTime_, w);
-    return hesTot.template block<STATE_DIM, STATE_DIM>(0, 0) + this->stateSecondDerivativeTerminalBase();
+    MatrixXs hes = hessianGenerated(*finalCostCodegen_, finalHasGeneratedTerms_, finalGeneratedTime_);
+    state_matrix_t derivative =
+        hes.template block<STATE_DIM, STATE_DIM>(0, 0) + this->stateSecondDerivativeTerminalBase();
+    addAnalyticalTerms(finalTerms_, finalTermIsAnalytical_, finalTermTimes_, derivative,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.stateSecondDerivative(this->x_, this->u_, this->t_);
+        });
+    return derivative;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::control_matrix_t
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::controlSecondDerivativeIntermediate()
 {
-    Eigen::Matrix<SCALAR, 1, 1> w;
-    w << SCALAR(1.0);
-    MatrixXs hesTot = intermediateCostCodegen_->hessian(stateControlTime_, w);
-    return hesTot.template block<CONTROL_DIM, CONTROL_DIM>(STATE_DIM, STATE_DIM) +
-           this->controlSecondDerivativeIntermediateBase();
+    MatrixXs hes =
+        hessianGenerated(*intermediateCostCodegen_, intermediateHasGeneratedTerms_, intermediateGeneratedTime_);
+    control_matrix_t derivative = hes.template block<CONTROL_DIM, CONTROL_DIM>(STATE_DIM, STATE_DIM) +
+                                  this->controlSecondDerivativeIntermediateBase();
+    addAnalyticalTerms(intermediateTerms_, intermediateTermIsAnalytical_, intermediateTermTimes_, derivative,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.controlSecondDerivative(this->x_, this->u_, this->t_);
+        });
+    return derivative;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::control_matrix_t
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::controlSecondDerivativeTerminal()
 {
-    Eigen::Matrix<SCALAR, 1, 1> w;
-    w << SCALAR(1.0);
-    MatrixXs hesTot = finalCostCodegen_->hessian(stateControlTime_, w);
-    return hesTot.template block<CONTROL_DIM, CONTROL_DIM>(STATE_DIM, STATE_DIM) +
-           this->controlSecondDerivativeTerminalBase();
+    MatrixXs hes = hessianGenerated(*finalCostCodegen_, finalHasGeneratedTerms_, finalGeneratedTime_);
+    control_matrix_t derivative = hes.template block<CONTROL_DIM, CONTROL_DIM>(STATE_DIM, STATE_DIM) +
+                                  this->controlSecondDerivativeTerminalBase();
+    addAnalyticalTerms(finalTerms_, finalTermIsAnalytical_, finalTermTimes_, derivative,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.controlSecondDerivative(this->x_, this->u_, this->t_);
+        });
+    return derivative;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::control_state_matrix_t
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeIntermediate()
 {
-    Eigen::Matrix<SCALAR, 1, 1> w;
-    w << SCALAR(1.0);
-    MatrixXs hesTot = intermediateCostCodegen_->hessian(stateControlTime_, w);
-    return hesTot.template block<CONTROL_DIM, STATE_DIM>(STATE_DIM, 0) + this->stateControlDerivativeIntermediateBase();
+    MatrixXs hes =
+        hessianGenerated(*intermediateCostCodegen_, intermediateHasGeneratedTerms_, intermediateGeneratedTime_);
+    control_state_matrix_t derivative =
+        hes.template block<CONTROL_DIM, STATE_DIM>(STATE_DIM, 0) + this->stateControlDerivativeIntermediateBase();
+    addAnalyticalTerms(intermediateTerms_, intermediateTermIsAnalytical_, intermediateTermTimes_, derivative,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.stateControlDerivative(this->x_, this->u_, this->t_);
+        });
+    return derivative;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::control_state_matrix_t
 CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeTerminal()
 {
-    Eigen::Matrix<SCALAR, 1, 1> w;
-    w << SCALAR(1.0);
-    MatrixXs hesTot = finalCostCodegen_->hessian(stateControlTime_, w);
-    return hesTot.template block<CONTROL_DIM, STATE_DIM>(STATE_DIM, 0) + this->stateControlDerivativeTerminalBase();
+    MatrixXs hes = hessianGenerated(*finalCostCodegen_, finalHasGeneratedTerms_, finalGeneratedTime_);
+    control_state_matrix_t derivative =
+        hes.template block<CONTROL_DIM, STATE_DIM>(STATE_DIM, 0) + this->stateControlDerivativeTerminalBase();
+    addAnalyticalTerms(finalTerms_, finalTermIsAnalytical_, finalTermTimes_, derivative,
+        [&](TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>& term) {
+            return term.stateControlDerivative(this->x_, this->u_, this->t_);
+        });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::quadratizeIntermediate(state_vector_t& q,
+    state_matrix_t& Q,
+    control_vector_t& r,
+    control_matrix_t& R,
+    control_state_matrix_t& P)
+{
+    this->quadratizeIntermediateBase(q, Q, r, R, P);
+
+    // evaluate the generated jacobian and hessian only once for all blocks
+    if (intermediateHasGeneratedTerms_)
+    {
+        jacobian_t jacTot =
+            jacobianGenerated(*intermediateCostCodegen_, intermediateHasGeneratedTerms_, intermediateGeneratedTime_);
+        MatrixXs hesTot =
+            hessianGenerated(*intermediateCostCodegen_, intermediateHasGeneratedTerms_, intermediateGeneratedTime_);
+
+        q += jacTot.template leftCols<STATE_DIM>().transpose();
+        r += jacTot.template block<1, CONTROL_DIM>(0, STATE_DIM).transpose();
+        Q += hesTot.template block<STATE_DIM, STATE_DIM>(0, 0);
+        R += hesTot.template block<CONTROL_DIM, CONTROL_DIM>(STATE_DIM, STATE_DIM);
+        P += hesTot.template block<CONTROL_DIM, STATE_DIM>(STATE_DIM, 0);
+    }
+
+    // terms with closed-form derivatives, accumulated directly into the output
+    for (size_t i = 0; i < intermediateTerms_.size(); i++)
+    {
+        if (!intermediateTermIsAnalytical_[i])
+            continue;
+
+        auto start = std::chrono::steady_clock::now();
+        intermediateTerms_[i]->quadratize(this->x_, this->u_, this->t_, SCALAR(1.0), q, Q, r, R, P);
+        if (profiling_)
+            intermediateTermTimes_[i] +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::setUseAnalyticalDerivatives(bool useAnalyticalDerivatives)
+{
+    useAnalyticalDerivatives_ = useAnalyticalDerivatives;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::setProfiling(bool profiling)
+{
+    profiling_ = profiling;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::resetProfiling()
+{
+    intermediateTermTimes_.assign(intermediateTerms_.size(), 0.0);
+    finalTermTimes_.assign(finalTerms_.size(), 0.0);
+    intermediateGeneratedTime_ = 0.0;
+    finalGeneratedTime_ = 0.0;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAD<STATE_DIM, CONTROL_DIM, SCALAR>::printProfiling() const
+{
+    std::cout << "CostFunctionAD profiling [ms]" << std::endl;
+    std::cout << "intermediate terms:" << std::endl;
+    for (size_t i = 0; i < intermediateTerms_.size(); i++)
+        if (intermediateTermIsAnalytical_[i])
+            std::cout << "  " << intermediateTerms_[i]->getName()
+                      << " (analytical): " << 1e3 * intermediateTermTimes_[i] << std::endl;
+        else
+            std::cout << "  " << intermediateTerms_[i]->getName() << " (generated)" << std::endl;
+    std::cout << "  generated code: " << 1e3 * intermediateGeneratedTime_ << std::endl;
+
+    std::cout << "final terms:" << std::endl;
+    for (size_t i = 0; i < finalTerms_.size(); i++)
+        if (finalTermIsAnalytical_[i])
+            std::cout << "  " << finalTerms_[i]->getName() << " (analytical): " << 1e3 * finalTermTimes_[i]
+                      << std::endl;
+        else
+            std::cout << "  " << finalTerms_[i]->getName() << " (generated)" << std::endl;
+    std::cout << "  generated code: " << 1e3 * finalGeneratedTime_ << std::endl;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
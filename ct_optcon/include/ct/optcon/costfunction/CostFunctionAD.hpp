@@ -8,6 +8,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #ifdef CPPADCG
 
 #include <ct/core/core.h>
+#include <chrono>
 #include <memory>
 
 #include <boost/property_tree/ptree.hpp>
@@ -31,6 +32,11 @@ namespace optcon {
  * auto-diff terms. For analytical terms it will use provided derivatives
  * and for auto-diff terms derivatives will be computed using auto-diff.
  *
+ * Auto-diff terms which also provide closed-form derivatives (see TermBase::hasAnalyticalDerivatives()) can be
+ * excluded from the generated code with setUseAnalyticalDerivatives(). Their analytical derivatives are then added to
+ * the ones of the generated code instead, such that no auto-diff is spent on e.g. quadratic terms. With setProfiling(), the time spent in every term can be
+ * reported.
+ *
  * Unit test \ref ADTest.cpp illustrates the use of a CostFunctionAD.
  */
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
@@ -135,6 +141,38 @@ public:
     control_state_matrix_t stateControlDerivativeIntermediate() override;
     control_state_matrix_t stateControlDerivativeTerminal() override;
 
+    void quadratizeIntermediate(state_vector_t& q,
+        state_matrix_t& Q,
+        control_vector_t& r,
+        control_matrix_t& R,
+        control_state_matrix_t& P) override;
+
+    /**
+	 * \brief Select whether auto-diff terms with closed-form derivatives are evaluated analytically
+	 *
+	 * Disabled by default. Takes effect at the next call to initialize(). Auto-diff terms are evaluated without time
+	 * activation in both cases.
+	 *
+	 * @param useAnalyticalDerivatives true to exclude terms with analytical derivatives from the generated code
+	 */
+    void setUseAnalyticalDerivatives(bool useAnalyticalDerivatives);
+
+    /**
+	 * \brief Enable the timing of the auto-diff terms
+	 *
+	 * Terms evaluated analytically are timed individually, all other terms are evaluated in one generated function
+	 * and timed together.
+	 *
+	 * @param profiling true to enable the timing
+	 */
+    void setProfiling(bool profiling);
+
+    //! reset the accumulated timings
+    void resetProfiling();
+
+    //! print the accumulated timings of the auto-diff terms
+    void printProfiling() const;
+
     std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>> getIntermediateADTermById(const size_t id);
 
     std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>> getFinalADTermById(const size_t id);
@@ -146,6 +184,26 @@ public:
 
 
 private:
+    typedef Eigen::Matrix<SCALAR, 1, STATE_DIM + CONTROL_DIM + 1> jacobian_t;
+
+    //! add f(term) of the terms which are evaluated analytically to result, timing each term if profiling is enabled
+    template <typename RESULT, typename F>
+    void addAnalyticalTerms(
+        const std::vector<std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>>>& terms,
+        const std::vector<bool>& isAnalytical,
+        std::vector<double>& times,
+        RESULT& result,
+        F&& f);
+
+    //! value of the generated code, zero if it contains no terms
+    SCALAR evaluateGenerated(JacCG& codegen, bool hasGeneratedTerms, double& time);
+
+    //! jacobian of the generated code, zero if it contains no terms
+    jacobian_t jacobianGenerated(JacCG& codegen, bool hasGeneratedTerms, double& time);
+
+    //! hessian of the generated code, zero if it contains no terms
+    MatrixXs hessianGenerated(JacCG& codegen, bool hasGeneratedTerms, double& time);
+
     MatrixCg evaluateIntermediateCg(const Eigen::Matrix<CGScalar, STATE_DIM + CONTROL_DIM + 1, 1>& stateInputTime);
     MatrixCg evaluateTerminalCg(const Eigen::Matrix<CGScalar, STATE_DIM + CONTROL_DIM + 1, 1>& stateInputTime);
 
@@ -157,6 +215,20 @@ private:
     //! final AD terms
     std::vector<std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR, CGScalar>>> finalTerms_;
 
+    //! flags marking the AD terms which are evaluated analytically and excluded from the generated code
+    std::vector<bool> intermediateTermIsAnalytical_;
+    std::vector<bool> finalTermIsAnalytical_;
+    bool intermediateHasGeneratedTerms_;
+    bool finalHasGeneratedTerms_;
+    bool useAnalyticalDerivatives_;
+
+    //! accumulated times of the analytically evaluated terms and the generated code [sec]
+    bool profiling_;
+    std::vector<double> intermediateTermTimes_;
+    std::vector<double> finalTermTimes_;
+    double intermediateGeneratedTime_;
+    double finalGeneratedTime_;
+
     //! generated jacobians
     std::shared_ptr<JacCG> intermediateCostCodegen_;
     std::shared_ptr<JacCG> finalCostCodegen_;
@@ -173,5 +173,31 @@ CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeTe
     return this->stateControlDerivativeTerminalBase();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::quadratizeIntermediate(state_vector_t& q,
+    state_matrix_t& Q,
+    control_vector_t& r,
+    control_matrix_t& R,
+    control_state_matrix_t& P)
+{
+    this->quadratizeIntermediateBase(q, Q, r, R, P);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionAnalytical<STATE_DIM, CONTROL_DIM, SCALAR>::quadratizeIntermediateHorizon(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const size_t firstIndex,
+    const size_t lastIndex,
+    const SCALAR& scale,
+    core::StateVectorArray<STATE_DIM, SCALAR>& q,
+    core::StateMatrixArray<STATE_DIM, SCALAR>& Q,
+    core::ControlVectorArray<CONTROL_DIM, SCALAR>& r,
+    core::ControlMatrixArray<CONTROL_DIM, SCALAR>& R,
+    core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& P)
+{
+    this->quadratizeIntermediateHorizonBase(x, u, firstIndex, lastIndex, scale, q, Q, r, R, P);
+}
+
 }  // namespace optcon
 }  // namespace ct
@@ -86,6 +86,23 @@ public:
     control_state_matrix_t stateControlDerivativeIntermediate() override;
     control_state_matrix_t stateControlDerivativeTerminal() override;
 
+    void quadratizeIntermediate(state_vector_t& q,
+        state_matrix_t& Q,
+        control_vector_t& r,
+        control_matrix_t& R,
+        control_state_matrix_t& P) override;
+
+    void quadratizeIntermediateHorizon(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        const SCALAR& scale,
+        core::StateVectorArray<STATE_DIM, SCALAR>& q,
+        core::StateMatrixArray<STATE_DIM, SCALAR>& Q,
+        core::ControlVectorArray<CONTROL_DIM, SCALAR>& r,
+        core::ControlMatrixArray<CONTROL_DIM, SCALAR>& R,
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& P) override;
+
     void loadFromConfigFile(const std::string& filename, bool verbose = false) override;
 
 private:
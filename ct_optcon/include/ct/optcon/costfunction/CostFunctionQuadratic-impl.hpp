@@ -311,13 +311,13 @@ SCALAR CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateIntermedia
 {
     SCALAR y = SCALAR(0.0);
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
             continue;
         }
-        y += it->computeActivation(this->t_) * it->eval(this->x_, this->u_, this->t_);
+        y += it->eval(this->x_, this->u_, this->t_);
     }
 
     return y;
@@ -329,13 +329,124 @@ SCALAR CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateTerminalBa
 {
     SCALAR y = SCALAR(0.0);
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         y += it->evaluate(this->x_, this->u_, this->t_);
 
     return y;
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::quadratizeIntermediate(state_vector_t& q,
+    state_matrix_t& Q,
+    control_vector_t& r,
+    control_matrix_t& R,
+    control_state_matrix_t& P)
+{
+    q = stateDerivativeIntermediate();
+    Q = stateSecondDerivativeIntermediate();
+    r = controlDerivativeIntermediate();
+    R = controlSecondDerivativeIntermediate();
+    P = stateControlDerivativeIntermediate();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::quadratizeIntermediateBase(state_vector_t& q,
+    state_matrix_t& Q,
+    control_vector_t& r,
+    control_matrix_t& R,
+    control_state_matrix_t& P)
+{
+    q.setZero();
+    Q.setZero();
+    r.setZero();
+    R.setZero();
+    P.setZero();
+
+    for (const auto& it : this->intermediateCostAnalytical_)
+    {
+        if (!it->isActiveAtTime(this->t_))
+        {
+            continue;
+        }
+        it->quadratize(this->x_, this->u_, this->t_, it->computeActivation(this->t_), q, Q, r, R, P);
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::prepareHorizon(const core::tpl::TimeArray<SCALAR>& times)
+{
+    horizonTimes_ = times;
+
+    core::tpl::TimeArray<SCALAR> shiftedTimes(times);
+    for (size_t k = 0; k < shiftedTimes.size(); k++)
+        shiftedTimes[k] += this->t_shift_;
+
+    for (const auto& it : this->intermediateCostAnalytical_)
+        it->prepareHorizon(shiftedTimes);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::quadratizeIntermediateHorizon(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const size_t firstIndex,
+    const size_t lastIndex,
+    const SCALAR& scale,
+    core::StateVectorArray<STATE_DIM, SCALAR>& q,
+    core::StateMatrixArray<STATE_DIM, SCALAR>& Q,
+    core::ControlVectorArray<CONTROL_DIM, SCALAR>& r,
+    core::ControlMatrixArray<CONTROL_DIM, SCALAR>& R,
+    core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& P)
+{
+    assert(lastIndex < horizonTimes_.size());
+
+    for (size_t k = firstIndex; k <= lastIndex; k++)
+    {
+        this->setCurrentStateAndControl(x[k], u[k], horizonTimes_[k]);
+        quadratizeIntermediate(q[k], Q[k], r[k], R[k], P[k]);
+        q[k] *= scale;
+        Q[k] *= scale;
+        r[k] *= scale;
+        R[k] *= scale;
+        P[k] *= scale;
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::quadratizeIntermediateHorizonBase(
+    const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+    const size_t firstIndex,
+    const size_t lastIndex,
+    const SCALAR& scale,
+    core::StateVectorArray<STATE_DIM, SCALAR>& q,
+    core::StateMatrixArray<STATE_DIM, SCALAR>& Q,
+    core::ControlVectorArray<CONTROL_DIM, SCALAR>& r,
+    core::ControlMatrixArray<CONTROL_DIM, SCALAR>& R,
+    core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& P)
+{
+    assert(lastIndex < horizonTimes_.size());
+
+    for (size_t k = firstIndex; k <= lastIndex; k++)
+    {
+        q[k].setZero();
+        Q[k].setZero();
+        r[k].setZero();
+        R[k].setZero();
+        P[k].setZero();
+    }
+
+    // every term processes all stages at once
+    for (const auto& it : this->intermediateCostAnalytical_)
+        it->quadratizeHorizon(x, u, firstIndex, lastIndex, scale, q, Q, r, R, P);
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::state_vector_t
 CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeIntermediateBase()
@@ -343,7 +454,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeIntermedia
     state_vector_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
@@ -363,7 +474,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateDerivativeTerminalBa
     state_vector_t derivative;
     derivative.setZero();
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         derivative += it->stateDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
@@ -376,7 +487,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateSecondDerivativeInte
     state_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
@@ -395,7 +506,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateSecondDerivativeTerm
     state_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         derivative += it->stateSecondDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
@@ -409,7 +520,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlDerivativeIntermed
     control_vector_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
@@ -428,7 +539,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlDerivativeTerminal
     control_vector_t derivative;
     derivative.setZero();
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         derivative += it->controlDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
@@ -442,7 +553,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlSecondDerivativeIn
     control_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
@@ -461,7 +572,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::controlSecondDerivativeTe
     control_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         derivative += it->controlSecondDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
@@ -475,7 +586,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeInt
     control_state_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->intermediateCostAnalytical_)
+    for (const auto& it : this->intermediateCostAnalytical_)
     {
         if (!it->isActiveAtTime(this->t_))
         {
@@ -494,7 +605,7 @@ CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>::stateControlDerivativeTer
     control_state_matrix_t derivative;
     derivative.setZero();
 
-    for (auto it : this->finalCostAnalytical_)
+    for (const auto& it : this->finalCostAnalytical_)
         derivative += it->stateControlDerivative(this->x_, this->u_, this->t_);
 
     return derivative;
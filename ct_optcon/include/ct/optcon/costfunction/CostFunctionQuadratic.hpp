@@ -159,6 +159,61 @@ public:
 	 */
     virtual control_state_matrix_t stateControlDerivativeTerminal();
 
+    /**
+	 * \brief Computes the quadratic approximation of the intermediate cost in a single call
+	 *
+	 * Equivalent to calling stateDerivativeIntermediate(), stateSecondDerivativeIntermediate(),
+	 * controlDerivativeIntermediate(), controlSecondDerivativeIntermediate() and stateControlDerivativeIntermediate(),
+	 * but cost functions built from analytical terms visit every term only once and evaluate its time activation once.
+	 * @param q state derivative
+	 * @param Q state second derivative
+	 * @param r control derivative
+	 * @param R control second derivative
+	 * @param P state-control cross derivative
+	 */
+    virtual void quadratizeIntermediate(state_vector_t& q,
+        state_matrix_t& Q,
+        control_vector_t& r,
+        control_matrix_t& R,
+        control_state_matrix_t& P);
+
+    /**
+	 * \brief Prepares the horizon-level quadratization of the intermediate cost for the given stage times
+	 *
+	 * Time-varying data of the terms, e.g. time activations and interpolated references, is precomputed for all
+	 * stages. Terms which are already prepared for the same times are not re-evaluated.
+	 * @param times the times of the stages (the time shift is applied on top)
+	 */
+    virtual void prepareHorizon(const core::tpl::TimeArray<SCALAR>& times);
+
+    /**
+	 * \brief Computes the quadratic approximation of the intermediate cost for stages firstIndex to lastIndex of the
+	 * prepared horizon
+	 *
+	 * Equivalent to calling quadratizeIntermediate() for every stage and scaling the result, but cost functions built
+	 * from analytical terms evaluate each term for all stages at once.
+	 * @param x state trajectory
+	 * @param u control trajectory
+	 * @param firstIndex first stage
+	 * @param lastIndex last stage
+	 * @param scale scaling of all derivatives, e.g. the time step
+	 * @param q state derivatives
+	 * @param Q state second derivatives
+	 * @param r control derivatives
+	 * @param R control second derivatives
+	 * @param P state-control cross derivatives
+	 */
+    virtual void quadratizeIntermediateHorizon(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        const SCALAR& scale,
+        core::StateVectorArray<STATE_DIM, SCALAR>& q,
+        core::StateMatrixArray<STATE_DIM, SCALAR>& Q,
+        core::ControlVectorArray<CONTROL_DIM, SCALAR>& r,
+        core::ControlMatrixArray<CONTROL_DIM, SCALAR>& R,
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& P);
+
     //! update the reference state for intermediate cost terms
     virtual void updateReferenceState(const state_vector_t& x_ref);
 
@@ -222,6 +277,25 @@ protected:
     //! evaluate terminal analytical control mixed state control derivatives
     control_state_matrix_t stateControlDerivativeTerminalBase();
 
+    //! quadratize the intermediate analytical cost terms in a single pass over the terms
+    void quadratizeIntermediateBase(state_vector_t& q,
+        state_matrix_t& Q,
+        control_vector_t& r,
+        control_matrix_t& R,
+        control_state_matrix_t& P);
+
+    //! quadratize the intermediate analytical cost terms for a range of stages of the prepared horizon
+    void quadratizeIntermediateHorizonBase(const core::StateVectorArray<STATE_DIM, SCALAR>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR>& u,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        const SCALAR& scale,
+        core::StateVectorArray<STATE_DIM, SCALAR>& q,
+        core::StateMatrixArray<STATE_DIM, SCALAR>& Q,
+        core::ControlVectorArray<CONTROL_DIM, SCALAR>& r,
+        core::ControlMatrixArray<CONTROL_DIM, SCALAR>& R,
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR>& P);
+
     //! compute the state derivative by numerical differentiation (can be used for testing)
     state_vector_t stateDerivativeIntermediateNumDiff();
 
@@ -239,6 +313,9 @@ protected:
 
     /** list of final cost terms for which analytic derivatives are available */
     std::vector<std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR>>> finalCostAnalytical_;
+
+    /** stage times of the prepared horizon, without time shift */
+    core::tpl::TimeArray<SCALAR> horizonTimes_;
 };
 
 
@@ -121,7 +121,7 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 SCALAR CostFunctionQuadraticSimple<STATE_DIM, CONTROL_DIM, SCALAR>::evaluateTerminal()
 {
     state_vector_t x_deviation_final = this->x_ - x_final_;
-    return SCALAR(0.5) * x_deviation_final.transpose() * Q_final_ * x_deviation_final;
+    return SCALAR(0.5) * (x_deviation_final.transpose() * Q_final_ * x_deviation_final)(0);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
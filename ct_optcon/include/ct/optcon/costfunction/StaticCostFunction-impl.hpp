@@ -0,0 +1,296 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::StaticCostFunction(
+    const INTERMEDIATE_TERMS& intermediateTerms,
+    const FINAL_TERMS& finalTerms)
+    : intermediateTerms_(intermediateTerms), finalTerms_(finalTerms)
+{
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::StaticCostFunction(
+    const StaticCostFunction& arg)
+    : CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>(arg),
+      intermediateTerms_(arg.intermediateTerms_),
+      finalTerms_(arg.finalTerms_)
+{
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>*
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::clone() const
+{
+    return new StaticCostFunction(*this);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::~StaticCostFunction()
+{
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+template <size_t I>
+typename std::tuple_element<I, INTERMEDIATE_TERMS>::type&
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::getIntermediateTerm()
+{
+    return std::get<I>(intermediateTerms_);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+template <size_t I>
+typename std::tuple_element<I, FINAL_TERMS>::type&
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::getFinalTerm()
+{
+    return std::get<I>(finalTerms_);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+size_t StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::addIntermediateTerm(
+    std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR>> term,
+    bool verbose)
+{
+    throw std::runtime_error("StaticCostFunction: terms cannot be added at runtime, use CostFunctionAnalytical.");
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+size_t StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::addFinalTerm(
+    std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR>> term,
+    bool verbose)
+{
+    throw std::runtime_error("StaticCostFunction: terms cannot be added at runtime, use CostFunctionAnalytical.");
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+template <typename TUPLE, typename F, size_t... I>
+void StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::forEachTerm(TUPLE& terms,
+    F&& f,
+    std::index_sequence<I...>)
+{
+    using expander = int[];
+    (void)expander{0, ((void)f(std::get<I>(terms)), 0)...};
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+template <typename TUPLE, typename F>
+void StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::forEachTerm(TUPLE& terms,
+    F&& f)
+{
+    forEachTerm(terms, std::forward<F>(f), std::make_index_sequence<std::tuple_size<TUPLE>::value>());
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+template <typename F>
+void StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::forEachActiveIntermediateTerm(
+    F&& f)
+{
+    const SCALAR t = this->t_;
+    forEachTerm(intermediateTerms_, [&](auto& term) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        if (term.Term_t::isActiveAtTime(t))
+            f(term, term.computeActivation(t));
+    });
+}
+
+// the terms are called qualified with their exact type, which bypasses the virtual dispatch and allows inlining
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+SCALAR StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::evaluateIntermediate()
+{
+    SCALAR y = SCALAR(0.0);
+    forEachActiveIntermediateTerm([&](auto& term, const SCALAR& weight) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        y += weight * term.Term_t::evaluate(this->x_, this->u_, this->t_);
+    });
+    return y;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+SCALAR StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::evaluateTerminal()
+{
+    SCALAR y = SCALAR(0.0);
+    forEachTerm(finalTerms_, [&](auto& term) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        y += term.Term_t::evaluate(this->x_, this->u_, this->t_);
+    });
+    return y;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+typename StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::state_vector_t
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::stateDerivativeIntermediate()
+{
+    state_vector_t derivative = state_vector_t::Zero();
+    forEachActiveIntermediateTerm([&](auto& term, const SCALAR& weight) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        derivative += weight * term.Term_t::stateDerivative(this->x_, this->u_, this->t_);
+    });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+typename StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::state_vector_t
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::stateDerivativeTerminal()
+{
+    state_vector_t derivative = state_vector_t::Zero();
+    forEachTerm(finalTerms_, [&](auto& term) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        derivative += term.Term_t::stateDerivative(this->x_, this->u_, this->t_);
+    });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+typename StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::state_matrix_t
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::stateSecondDerivativeIntermediate()
+{
+    state_matrix_t derivative = state_matrix_t::Zero();
+    forEachActiveIntermediateTerm([&](auto& term, const SCALAR& weight) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        derivative += weight * term.Term_t::stateSecondDerivative(this->x_, this->u_, this->t_);
+    });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+typename StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::state_matrix_t
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::stateSecondDerivativeTerminal()
+{
+    state_matrix_t derivative = state_matrix_t::Zero();
+    forEachTerm(finalTerms_, [&](auto& term) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        derivative += term.Term_t::stateSecondDerivative(this->x_, this->u_, this->t_);
+    });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+typename StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::control_vector_t
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::controlDerivativeIntermediate()
+{
+    control_vector_t derivative = control_vector_t::Zero();
+    forEachActiveIntermediateTerm([&](auto& term, const SCALAR& weight) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        derivative += weight * term.Term_t::controlDerivative(this->x_, this->u_, this->t_);
+    });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+typename StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::control_vector_t
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::controlDerivativeTerminal()
+{
+    control_vector_t derivative = control_vector_t::Zero();
+    forEachTerm(finalTerms_, [&](auto& term) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        derivative += term.Term_t::controlDerivative(this->x_, this->u_, this->t_);
+    });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+typename StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::control_matrix_t
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::
+    controlSecondDerivativeIntermediate()
+{
+    control_matrix_t derivative = control_matrix_t::Zero();
+    forEachActiveIntermediateTerm([&](auto& term, const SCALAR& weight) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        derivative += weight * term.Term_t::controlSecondDerivative(this->x_, this->u_, this->t_);
+    });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+typename StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::control_matrix_t
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::controlSecondDerivativeTerminal()
+{
+    control_matrix_t derivative = control_matrix_t::Zero();
+    forEachTerm(finalTerms_, [&](auto& term) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        derivative += term.Term_t::controlSecondDerivative(this->x_, this->u_, this->t_);
+    });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+typename StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::control_state_matrix_t
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::
+    stateControlDerivativeIntermediate()
+{
+    control_state_matrix_t derivative = control_state_matrix_t::Zero();
+    forEachActiveIntermediateTerm([&](auto& term, const SCALAR& weight) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        derivative += weight * term.Term_t::stateControlDerivative(this->x_, this->u_, this->t_);
+    });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+typename StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::control_state_matrix_t
+StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::stateControlDerivativeTerminal()
+{
+    control_state_matrix_t derivative = control_state_matrix_t::Zero();
+    forEachTerm(finalTerms_, [&](auto& term) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        derivative += term.Term_t::stateControlDerivative(this->x_, this->u_, this->t_);
+    });
+    return derivative;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+void StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::quadratizeIntermediate(
+    state_vector_t& q,
+    state_matrix_t& Q,
+    control_vector_t& r,
+    control_matrix_t& R,
+    control_state_matrix_t& P)
+{
+    q.setZero();
+    Q.setZero();
+    r.setZero();
+    R.setZero();
+    P.setZero();
+
+    // one pass over all terms, each term contributes all of its derivatives
+    forEachActiveIntermediateTerm([&](auto& term, const SCALAR& weight) {
+        using Term_t = typename std::decay<decltype(term)>::type;
+        q.noalias() += weight * term.Term_t::stateDerivative(this->x_, this->u_, this->t_);
+        Q.noalias() += weight * term.Term_t::stateSecondDerivative(this->x_, this->u_, this->t_);
+        r.noalias() += weight * term.Term_t::controlDerivative(this->x_, this->u_, this->t_);
+        R.noalias() += weight * term.Term_t::controlSecondDerivative(this->x_, this->u_, this->t_);
+        P.noalias() += weight * term.Term_t::stateControlDerivative(this->x_, this->u_, this->t_);
+    });
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+void StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::updateReferenceState(
+    const state_vector_t& x_ref)
+{
+    forEachTerm(intermediateTerms_, [&](auto& term) { term.updateReferenceState(x_ref); });
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+void StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::updateFinalState(
+    const state_vector_t& x_final)
+{
+    forEachTerm(finalTerms_, [&](auto& term) { term.updateReferenceState(x_final); });
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename INTERMEDIATE_TERMS, typename FINAL_TERMS, typename SCALAR>
+void StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>::updateReferenceControl(
+    const control_vector_t& u_ref)
+{
+    forEachTerm(intermediateTerms_, [&](auto& term) { term.updateReferenceControl(u_ref); });
+}
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,140 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include "CostFunctionQuadratic.hpp"
+
+namespace ct {
+namespace optcon {
+
+/**
+ * \ingroup CostFunction
+ *
+ * \brief A cost function composed of a fixed set of analytical terms at compile time
+ *
+ * The terms are stored by value in a std::tuple and called without virtual dispatch, such that the compiler can
+ * inline all term evaluations and derivatives into a single fixed-size kernel. Use this cost function for tuned costs
+ * whose structure does not change at runtime, otherwise use CostFunctionAnalytical.
+ *
+ * Example:
+ * \code
+ * typedef TermQuadratic<12, 4> Quad_t;
+ * typedef TermSmoothAbs<12, 4> Abs_t;
+ * StaticCostFunction<12, 4, std::tuple<Quad_t, Abs_t>, std::tuple<Quad_t>> costFunction(
+ *     std::make_tuple(Quad_t(Q, R), Abs_t(a, x_ref, b, u_ref, alpha)), std::make_tuple(Quad_t(Q_final, R_final)));
+ * \endcode
+ *
+ * Terms can be accessed through getIntermediateTerm() and getFinalTerm(). Adding terms at runtime is not supported.
+ *
+ * @tparam INTERMEDIATE_TERMS std::tuple of the intermediate term types
+ * @tparam FINAL_TERMS std::tuple of the final term types
+ */
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    typename INTERMEDIATE_TERMS,
+    typename FINAL_TERMS = std::tuple<>,
+    typename SCALAR = double>
+class StaticCostFunction : public CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM> state_matrix_t;
+    typedef Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM> control_matrix_t;
+    typedef Eigen::Matrix<SCALAR, CONTROL_DIM, STATE_DIM> control_state_matrix_t;
+
+    typedef core::StateVector<STATE_DIM, SCALAR> state_vector_t;
+    typedef core::ControlVector<CONTROL_DIM, SCALAR> control_vector_t;
+
+    /**
+	 * \brief Constructor
+	 * @param intermediateTerms the intermediate terms
+	 * @param finalTerms the final terms
+	 */
+    StaticCostFunction(const INTERMEDIATE_TERMS& intermediateTerms, const FINAL_TERMS& finalTerms = FINAL_TERMS());
+
+    /**
+	 * \brief Copy constructor
+	 * @param arg cost function to copy
+	 */
+    StaticCostFunction(const StaticCostFunction& arg);
+
+    /**
+	 * Deep-cloning of cost function
+	 * @return base pointer to clone
+	 */
+    StaticCostFunction<STATE_DIM, CONTROL_DIM, INTERMEDIATE_TERMS, FINAL_TERMS, SCALAR>* clone() const override;
+
+    /**
+	 * Destructor
+	 */
+    virtual ~StaticCostFunction();
+
+    //! access the intermediate term with index I
+    template <size_t I>
+    typename std::tuple_element<I, INTERMEDIATE_TERMS>::type& getIntermediateTerm();
+
+    //! access the final term with index I
+    template <size_t I>
+    typename std::tuple_element<I, FINAL_TERMS>::type& getFinalTerm();
+
+    //! not supported, the terms are fixed at compile time
+    size_t addIntermediateTerm(std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR>> term,
+        bool verbose = false) override;
+
+    //! not supported, the terms are fixed at compile time
+    size_t addFinalTerm(std::shared_ptr<TermBase<STATE_DIM, CONTROL_DIM, SCALAR>> term, bool verbose = false) override;
+
+    SCALAR evaluateIntermediate() override;
+    SCALAR evaluateTerminal() override;
+
+    state_vector_t stateDerivativeIntermediate() override;
+    state_vector_t stateDerivativeTerminal() override;
+
+    state_matrix_t stateSecondDerivativeIntermediate() override;
+    state_matrix_t stateSecondDerivativeTerminal() override;
+
+    control_vector_t controlDerivativeIntermediate() override;
+    control_vector_t controlDerivativeTerminal() override;
+
+    control_matrix_t controlSecondDerivativeIntermediate() override;
+    control_matrix_t controlSecondDerivativeTerminal() override;
+
+    control_state_matrix_t stateControlDerivativeIntermediate() override;
+    control_state_matrix_t stateControlDerivativeTerminal() override;
+
+    void quadratizeIntermediate(state_vector_t& q,
+        state_matrix_t& Q,
+        control_vector_t& r,
+        control_matrix_t& R,
+        control_state_matrix_t& P) override;
+
+    void updateReferenceState(const state_vector_t& x_ref) override;
+    void updateFinalState(const state_vector_t& x_final) override;
+    void updateReferenceControl(const control_vector_t& u_ref) override;
+
+private:
+    //! call f on every term of the tuple
+    template <typename TUPLE, typename F, size_t... I>
+    static void forEachTerm(TUPLE& terms, F&& f, std::index_sequence<I...>);
+
+    //! call f on every term of the tuple
+    template <typename TUPLE, typename F>
+    static void forEachTerm(TUPLE& terms, F&& f);
+
+    //! call f(term, weight) on every intermediate term which is active at the current time
+    template <typename F>
+    void forEachActiveIntermediateTerm(F&& f);
+
+    INTERMEDIATE_TERMS intermediateTerms_;
+    FINAL_TERMS finalTerms_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -20,3 +20,4 @@
 #include "CostFunctionAnalytical-impl.hpp"
 #include "CostFunctionQuadratic-impl.hpp"
 #include "CostFunctionQuadraticSimple-impl.hpp"
+#include "StaticCostFunction-impl.hpp"
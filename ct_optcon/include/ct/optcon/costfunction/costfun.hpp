@@ -20,3 +20,4 @@
 #include "CostFunctionAD.hpp"
 #include "CostFunctionAnalytical.hpp"
 #include "CostFunctionQuadraticSimple.hpp"
+#include "StaticCostFunction.hpp"
@@ -48,6 +48,21 @@ ct::core::ADCGScalar TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::eval
 }
 #endif
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+SCALAR_EVAL TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateAnalytical(
+    const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+    const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+    const SCALAR_EVAL& t)
+{
+    throw std::runtime_error("The cost function term " + name_ + " does not implement evaluateAnalytical.");
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+bool TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::hasAnalyticalDerivatives() const
+{
+    return false;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 bool TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::isActiveAtTime(SCALAR_EVAL t)
 {
@@ -60,6 +75,76 @@ SCALAR_EVAL TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::computeActiva
     return c_i_->computeActivation(t);
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::quadratize(
+    const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+    const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+    const SCALAR_EVAL& t,
+    const SCALAR_EVAL& weight,
+    core::StateVector<STATE_DIM, SCALAR_EVAL>& q,
+    state_matrix_t& Q,
+    core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& r,
+    control_matrix_t& R,
+    control_state_matrix_t& P)
+{
+    q.noalias() += weight * stateDerivative(x, u, t);
+    Q.noalias() += weight * stateSecondDerivative(x, u, t);
+    r.noalias() += weight * controlDerivative(x, u, t);
+    R.noalias() += weight * controlSecondDerivative(x, u, t);
+    P.noalias() += weight * stateControlDerivative(x, u, t);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::prepareHorizon(
+    const core::tpl::TimeArray<SCALAR_EVAL>& times)
+{
+    if (horizonIsPrepared(times))
+        return;
+
+    horizonTimes_ = times;
+    horizonWeights_.resize(times.size());
+    for (size_t k = 0; k < times.size(); k++)
+        horizonWeights_(k) = isActiveAtTime(times[k]) ? computeActivation(times[k]) : SCALAR_EVAL(0.0);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::quadratizeHorizon(
+    const core::StateVectorArray<STATE_DIM, SCALAR_EVAL>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR_EVAL>& u,
+    const size_t firstIndex,
+    const size_t lastIndex,
+    const SCALAR_EVAL& scale,
+    core::StateVectorArray<STATE_DIM, SCALAR_EVAL>& q,
+    core::StateMatrixArray<STATE_DIM, SCALAR_EVAL>& Q,
+    core::ControlVectorArray<CONTROL_DIM, SCALAR_EVAL>& r,
+    core::ControlMatrixArray<CONTROL_DIM, SCALAR_EVAL>& R,
+    core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR_EVAL>& P)
+{
+    assert(lastIndex < horizonTimes_.size());
+
+    for (size_t k = firstIndex; k <= lastIndex; k++)
+    {
+        if (horizonWeights_(k) == SCALAR_EVAL(0.0))
+            continue;
+
+        quadratize(x[k], u[k], horizonTimes_[k], scale * horizonWeights_(k), q[k], Q[k], r[k], R[k], P[k]);
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+bool TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::horizonIsPrepared(
+    const core::tpl::TimeArray<SCALAR_EVAL>& times) const
+{
+    return horizonTimes_.size() > 0 && horizonTimes_.size() == times.size() &&
+           std::equal(times.begin(), times.end(), horizonTimes_.begin());
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::resetHorizon()
+{
+    horizonTimes_.clear();
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 core::StateVector<STATE_DIM, SCALAR_EVAL> TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateDerivative(
     const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
@@ -139,6 +224,7 @@ void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::setTimeActivation(
     bool verbose)
 {
     c_i_ = c_i;
+    resetHorizon();
     if (verbose)
         c_i_->printInfo();
 }
@@ -168,6 +254,7 @@ void TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::loadTimeActivation(c
         else
         {
             c_i_ = c_i;
+            resetHorizon();
             if (verbose)
                 c_i_->printInfo();
         }
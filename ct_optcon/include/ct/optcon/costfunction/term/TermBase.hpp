@@ -108,6 +108,28 @@ public:
         const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
         const SCALAR_EVAL& t);
 
+    /**
+	 * @brief      Evaluates the term at x, u, t in the evaluation scalar type, without time activation
+	 *
+	 * Used by CostFunctionAD for auto-diff terms which provide analytical derivatives, see hasAnalyticalDerivatives().
+	 *
+	 * @param[in]  x     The current state
+	 * @param[in]  u     The current control
+	 * @param[in]  t     The current time
+	 *
+	 * @return     The evaluated cost term
+	 */
+    virtual SCALAR_EVAL evaluateAnalytical(const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+        const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+        const SCALAR_EVAL& t);
+
+    /**
+	 * \brief Returns if the term implements evaluateAnalytical() and all analytical derivatives
+	 * CostFunctionAD uses the analytical derivatives of such terms instead of generating code for them.
+	 * @return true if the term provides closed-form derivatives
+	 */
+    virtual bool hasAnalyticalDerivatives() const;
+
     /**
 	 * \brief Returns if term is non-zero at a specific time
 	 * By default, all terms are evaluated at all times. However, if a term is not active at a certain time, you can overload this
@@ -147,6 +169,73 @@ public:
         const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
         const SCALAR_EVAL& t);
 
+    /**
+	 * @brief      Adds the weighted quadratic approximation of this term at x, u, t to q, Q, r, R and P
+	 *
+	 * Used by CostFunctionQuadratic::quadratizeIntermediate() to obtain all derivatives in a single pass over the
+	 * terms. The default implementation calls the individual derivative methods, terms which share intermediate
+	 * results between the derivatives may overload it.
+	 *
+	 * @param[in]  x       The current state
+	 * @param[in]  u       The current control
+	 * @param[in]  t       The current time
+	 * @param[in]  weight  The weight of this term, typically the time activation
+	 * @param      q       The state derivative to add to
+	 * @param      Q       The state second derivative to add to
+	 * @param      r       The control derivative to add to
+	 * @param      R       The control second derivative to add to
+	 * @param      P       The state-control cross derivative to add to
+	 */
+    virtual void quadratize(const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+        const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+        const SCALAR_EVAL& t,
+        const SCALAR_EVAL& weight,
+        core::StateVector<STATE_DIM, SCALAR_EVAL>& q,
+        state_matrix_t& Q,
+        core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& r,
+        control_matrix_t& R,
+        control_state_matrix_t& P);
+
+    /**
+	 * @brief      Precomputes the time-dependent data of this term for the stages of a horizon
+	 *
+	 * Evaluates the time activation for all stages. Terms with time-varying data, e.g. reference trajectories,
+	 * overload this method to precompute them as well. Nothing is done if the horizon is already prepared for the
+	 * same times.
+	 *
+	 * @param[in]  times  The times of the stages
+	 */
+    virtual void prepareHorizon(const core::tpl::TimeArray<SCALAR_EVAL>& times);
+
+    /**
+	 * @brief      Adds the weighted quadratic approximations of this term for stages firstIndex to lastIndex of the
+	 *             prepared horizon to the arrays q, Q, r, R and P
+	 *
+	 * The weight of a stage is scale times its precomputed time activation. The default implementation calls
+	 * quadratize() for every active stage, terms may overload it to process all stages at once.
+	 *
+	 * @param[in]  x           The state trajectory
+	 * @param[in]  u           The control trajectory
+	 * @param[in]  firstIndex  The first stage to quadratize
+	 * @param[in]  lastIndex   The last stage to quadratize
+	 * @param[in]  scale       The scaling applied to all stages, e.g. the time step
+	 * @param      q           The state derivatives to add to
+	 * @param      Q           The state second derivatives to add to
+	 * @param      r           The control derivatives to add to
+	 * @param      R           The control second derivatives to add to
+	 * @param      P           The state-control cross derivatives to add to
+	 */
+    virtual void quadratizeHorizon(const core::StateVectorArray<STATE_DIM, SCALAR_EVAL>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR_EVAL>& u,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        const SCALAR_EVAL& scale,
+        core::StateVectorArray<STATE_DIM, SCALAR_EVAL>& q,
+        core::StateMatrixArray<STATE_DIM, SCALAR_EVAL>& Q,
+        core::ControlVectorArray<CONTROL_DIM, SCALAR_EVAL>& r,
+        core::ControlMatrixArray<CONTROL_DIM, SCALAR_EVAL>& R,
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR_EVAL>& P);
+
     //! load this term from a configuration file
     virtual void loadConfigFile(const std::string& filename, const std::string& termName, bool verbose = false);
 
@@ -176,6 +265,19 @@ public:
 
     //! retrieve this term's current reference state
     virtual Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1> getReferenceState() const;
+
+protected:
+    //! true if the horizon data was precomputed for the given times
+    bool horizonIsPrepared(const core::tpl::TimeArray<SCALAR_EVAL>& times) const;
+
+    //! invalidate the precomputed horizon data, required whenever time-varying data of the term changes
+    void resetHorizon();
+
+    //! the times of the prepared horizon, empty if no horizon is prepared
+    core::tpl::TimeArray<SCALAR_EVAL> horizonTimes_;
+
+    //! the time activation of every stage of the prepared horizon, zero for inactive stages
+    Eigen::Matrix<SCALAR_EVAL, Eigen::Dynamic, 1> horizonWeights_;
 };
 
 }  // namespace optcon
@@ -48,6 +48,21 @@ SCALAR TermLinear<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluate(const E
     return evalLocal<SCALAR>(x, u, t);
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+SCALAR_EVAL TermLinear<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateAnalytical(
+    const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+    const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+    const SCALAR_EVAL& t)
+{
+    return evalLocal<SCALAR_EVAL>(x, u, t);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+bool TermLinear<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::hasAnalyticalDerivatives() const
+{
+    return true;
+}
+
 #ifdef CPPADCG
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 ct::core::ADCGScalar TermLinear<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateCppadCg(
@@ -45,6 +45,12 @@ public:
         const Eigen::Matrix<SCALAR, CONTROL_DIM, 1>& u,
         const SCALAR& t) override;
 
+    SCALAR_EVAL evaluateAnalytical(const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+        const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+        const SCALAR_EVAL& t) override;
+
+    bool hasAnalyticalDerivatives() const override;
+
 #ifdef CPPADCG
     virtual ct::core::ADCGScalar evaluateCppadCg(const core::StateVector<STATE_DIM, ct::core::ADCGScalar>& x,
         const core::ControlVector<CONTROL_DIM, ct::core::ADCGScalar>& u,
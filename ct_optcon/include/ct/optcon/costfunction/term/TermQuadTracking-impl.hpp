@@ -16,14 +16,20 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::TermQuadTracking(
     const bool trackControlTrajectory)
     : Q_(Q),
       R_(R),
-      x_traj_ref_(stateSplineType),
-      u_traj_ref_(controlSplineType),
+      x_traj_ref_(std::make_shared<const core::StateTrajectory<STATE_DIM, SCALAR_EVAL>>(stateSplineType)),
+      u_traj_ref_(std::make_shared<const core::ControlTrajectory<CONTROL_DIM, SCALAR_EVAL>>(controlSplineType)),
+      x_interp_(stateSplineType),
+      u_interp_(controlSplineType),
       trackControlTrajectory_(trackControlTrajectory)
 {
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::TermQuadTracking()
+    : x_traj_ref_(std::make_shared<const core::StateTrajectory<STATE_DIM, SCALAR_EVAL>>()),
+      u_traj_ref_(std::make_shared<const core::ControlTrajectory<CONTROL_DIM, SCALAR_EVAL>>()),
+      x_interp_(x_traj_ref_->getInterpolationType()),
+      u_interp_(u_traj_ref_->getInterpolationType())
 {
     // default values
     Q_.setIdentity();
@@ -39,6 +45,8 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::TermQuadTracking(
       R_(arg.R_),
       x_traj_ref_(arg.x_traj_ref_),
       u_traj_ref_(arg.u_traj_ref_),
+      x_interp_(arg.x_interp_.getInterpolationType()),
+      u_interp_(arg.u_interp_.getInterpolationType()),
       trackControlTrajectory_(arg.trackControlTrajectory_)
 {
 }
@@ -69,8 +77,30 @@ void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::setStateAndC
     const core::StateTrajectory<STATE_DIM>& xTraj,
     const core::ControlTrajectory<CONTROL_DIM>& uTraj)
 {
-    x_traj_ref_ = xTraj;
-    u_traj_ref_ = uTraj;
+    // replace instead of modifying the references, since clones may still use the previous ones
+    x_traj_ref_ = std::make_shared<const core::StateTrajectory<STATE_DIM, SCALAR_EVAL>>(xTraj);
+    u_traj_ref_ = std::make_shared<const core::ControlTrajectory<CONTROL_DIM, SCALAR_EVAL>>(uTraj);
+    x_interp_.changeInterpolationType(xTraj.getInterpolationType());
+    u_interp_.changeInterpolationType(uTraj.getInterpolationType());
+    this->resetHorizon();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+auto TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateReference(const SCALAR_EVAL& t)
+    -> state_vector_t
+{
+    state_vector_t x_ref;
+    x_interp_.interpolate(x_traj_ref_->getTimeArray(), x_traj_ref_->getDataArray(), t, x_ref);
+    return x_ref;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+auto TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::controlReference(const SCALAR_EVAL& t)
+    -> control_vector_t
+{
+    control_vector_t u_ref;
+    u_interp_.interpolate(u_traj_ref_->getTimeArray(), u_traj_ref_->getDataArray(), t, u_ref);
+    return u_ref;
 }
 
 
@@ -83,6 +113,21 @@ SCALAR TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluate(
     return evalLocal<SCALAR>(x, u, t);
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+SCALAR_EVAL TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evaluateAnalytical(
+    const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+    const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+    const SCALAR_EVAL& t)
+{
+    return evalLocal<SCALAR_EVAL>(x, u, t);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+bool TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::hasAnalyticalDerivatives() const
+{
+    return true;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 ct::core::StateVector<STATE_DIM, SCALAR_EVAL>
 TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateDerivative(
@@ -90,7 +135,7 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateDerivative(
     const ct::core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
     const SCALAR_EVAL& t)
 {
-    Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1> xDiff = x - x_traj_ref_.eval(t);
+    Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1> xDiff = x - stateReference(t);
 
     return xDiff.transpose() * Q_.transpose() + xDiff.transpose() * Q_;
 }
@@ -115,7 +160,7 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::controlDerivative
     Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1> uDiff;
 
     if (trackControlTrajectory_)
-        uDiff = u - u_traj_ref_.eval(t);
+        uDiff = u - controlReference(t);
     else
         uDiff = u;
 
@@ -142,6 +187,72 @@ TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::stateControlDeriv
     return control_state_matrix_t::Zero();
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::prepareHorizon(
+    const core::tpl::TimeArray<SCALAR_EVAL>& times)
+{
+    if (this->horizonIsPrepared(times))
+        return;
+
+    TermBase<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::prepareHorizon(times);
+
+    // interpolate the references once for all stages
+    horizonStateRef_.resize(STATE_DIM, times.size());
+    horizonControlRef_.resize(CONTROL_DIM, trackControlTrajectory_ ? times.size() : 0);
+    for (size_t k = 0; k < times.size(); k++)
+    {
+        horizonStateRef_.col(k) = stateReference(times[k]);
+        if (trackControlTrajectory_)
+            horizonControlRef_.col(k) = controlReference(times[k]);
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
+void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::quadratizeHorizon(
+    const core::StateVectorArray<STATE_DIM, SCALAR_EVAL>& x,
+    const core::ControlVectorArray<CONTROL_DIM, SCALAR_EVAL>& u,
+    const size_t firstIndex,
+    const size_t lastIndex,
+    const SCALAR_EVAL& scale,
+    core::StateVectorArray<STATE_DIM, SCALAR_EVAL>& q,
+    core::StateMatrixArray<STATE_DIM, SCALAR_EVAL>& Q,
+    core::ControlVectorArray<CONTROL_DIM, SCALAR_EVAL>& r,
+    core::ControlMatrixArray<CONTROL_DIM, SCALAR_EVAL>& R,
+    core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR_EVAL>& P)
+{
+    assert(lastIndex < this->horizonTimes_.size());
+    const size_t n = lastIndex - firstIndex + 1;
+
+    const Eigen::Matrix<SCALAR_EVAL, Eigen::Dynamic, 1> w = scale * this->horizonWeights_.segment(firstIndex, n);
+    const state_matrix_t Qs = Q_ + Q_.transpose();
+    const control_matrix_t Rs = R_ + R_.transpose();
+
+    // collect the deviations from the references with one column per stage
+    Eigen::Matrix<SCALAR_EVAL, STATE_DIM, Eigen::Dynamic> xDiff(STATE_DIM, n);
+    Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, Eigen::Dynamic> uDiff(CONTROL_DIM, n);
+    for (size_t i = 0; i < n; i++)
+    {
+        xDiff.col(i) = x[firstIndex + i];
+        uDiff.col(i) = u[firstIndex + i];
+    }
+    xDiff -= horizonStateRef_.middleCols(firstIndex, n);
+    if (trackControlTrajectory_)
+        uDiff -= horizonControlRef_.middleCols(firstIndex, n);
+
+    // gradients of all stages in one pass
+    const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, Eigen::Dynamic> qBlock = Qs * (xDiff * w.asDiagonal());
+    const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, Eigen::Dynamic> rBlock = Rs * (uDiff * w.asDiagonal());
+
+    // scatter into the stages, the hessians are constant up to the weight
+    for (size_t i = 0; i < n; i++)
+    {
+        q[firstIndex + i] += qBlock.col(i);
+        Q[firstIndex + i] += w(i) * Qs;
+        r[firstIndex + i] += rBlock.col(i);
+        R[firstIndex + i] += w(i) * Rs;
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR_EVAL, typename SCALAR>
 void TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::loadConfigFile(const std::string& filename,
     const std::string& termName,
@@ -52,6 +52,12 @@ public:
         const Eigen::Matrix<SCALAR, CONTROL_DIM, 1>& u,
         const SCALAR& t) override;
 
+    SCALAR_EVAL evaluateAnalytical(const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+        const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+        const SCALAR_EVAL& t) override;
+
+    bool hasAnalyticalDerivatives() const override;
+
     core::StateVector<STATE_DIM, SCALAR_EVAL> stateDerivative(const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
         const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
         const SCALAR_EVAL& t) override;
@@ -72,6 +78,19 @@ public:
         const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
         const SCALAR_EVAL& t) override;
 
+    void prepareHorizon(const core::tpl::TimeArray<SCALAR_EVAL>& times) override;
+
+    void quadratizeHorizon(const core::StateVectorArray<STATE_DIM, SCALAR_EVAL>& x,
+        const core::ControlVectorArray<CONTROL_DIM, SCALAR_EVAL>& u,
+        const size_t firstIndex,
+        const size_t lastIndex,
+        const SCALAR_EVAL& scale,
+        core::StateVectorArray<STATE_DIM, SCALAR_EVAL>& q,
+        core::StateMatrixArray<STATE_DIM, SCALAR_EVAL>& Q,
+        core::ControlVectorArray<CONTROL_DIM, SCALAR_EVAL>& r,
+        core::ControlMatrixArray<CONTROL_DIM, SCALAR_EVAL>& R,
+        core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR_EVAL>& P) override;
+
     virtual void loadConfigFile(const std::string& filename,
         const std::string& termName,
         bool verbose = false) override;
@@ -83,12 +102,27 @@ protected:
     state_matrix_t Q_;
     control_matrix_t R_;
 
-    // the reference trajectories to be tracked
-    ct::core::StateTrajectory<STATE_DIM, SCALAR_EVAL> x_traj_ref_;
-    ct::core::ControlTrajectory<CONTROL_DIM, SCALAR_EVAL> u_traj_ref_;
+    typedef ct::core::StateVector<STATE_DIM, SCALAR_EVAL> state_vector_t;
+    typedef ct::core::ControlVector<CONTROL_DIM, SCALAR_EVAL> control_vector_t;
+
+    //! interpolate the references at time t
+    state_vector_t stateReference(const SCALAR_EVAL& t);
+    control_vector_t controlReference(const SCALAR_EVAL& t);
+
+    // the reference trajectories to be tracked. They are not modified after being set and are shared among clones
+    std::shared_ptr<const ct::core::StateTrajectory<STATE_DIM, SCALAR_EVAL>> x_traj_ref_;
+    std::shared_ptr<const ct::core::ControlTrajectory<CONTROL_DIM, SCALAR_EVAL>> u_traj_ref_;
+
+    // the interpolation of the references keeps a search index, hence it is per instance
+    ct::core::Interpolation<state_vector_t, Eigen::aligned_allocator<state_vector_t>, SCALAR_EVAL> x_interp_;
+    ct::core::Interpolation<control_vector_t, Eigen::aligned_allocator<control_vector_t>, SCALAR_EVAL> u_interp_;
 
     // Option whether the control trajectory deviation shall be penalized or not
     bool trackControlTrajectory_;
+
+    // the reference trajectories interpolated at the stages of the prepared horizon, one column per stage
+    Eigen::Matrix<SCALAR_EVAL, STATE_DIM, Eigen::Dynamic> horizonStateRef_;
+    Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, Eigen::Dynamic> horizonControlRef_;
 };
 
 
@@ -98,12 +132,12 @@ SC TermQuadTracking<STATE_DIM, CONTROL_DIM, SCALAR_EVAL, SCALAR>::evalLocal(cons
     const Eigen::Matrix<SC, CONTROL_DIM, 1>& u,
     const SC& t)
 {
-    Eigen::Matrix<SC, STATE_DIM, 1> xDiff = x - x_traj_ref_.eval((SCALAR_EVAL)t).template cast<SC>();
+    Eigen::Matrix<SC, STATE_DIM, 1> xDiff = x - stateReference((SCALAR_EVAL)t).template cast<SC>();
 
     Eigen::Matrix<SC, CONTROL_DIM, 1> uDiff;
 
     if (trackControlTrajectory_)
-        uDiff = u - u_traj_ref_.eval((SCALAR_EVAL)t).template cast<SC>();
+        uDiff = u - controlReference((SCALAR_EVAL)t).template cast<SC>();
     else
         uDiff = u;
 
@@ -66,6 +66,12 @@ public:
         const Eigen::Matrix<SCALAR, CONTROL_DIM, 1>& u,
         const SCALAR& t) override;
 
+    SCALAR_EVAL evaluateAnalytical(const Eigen::Matrix<SCALAR_EVAL, STATE_DIM, 1>& x,
+        const Eigen::Matrix<SCALAR_EVAL, CONTROL_DIM, 1>& u,
+        const SCALAR_EVAL& t) override;
+
+    bool hasAnalyticalDerivatives() const override;
+
 #ifdef CPPADCG
     virtual ct::core::ADCGScalar evaluateCppadCg(const core::StateVector<STATE_DIM, ct::core::ADCGScalar>& x,
         const core::ControlVector<CONTROL_DIM, ct::core::ADCGScalar>& u,
@@ -92,6 +98,16 @@ public:
         const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
         const SCALAR_EVAL& t) override;
 
+    void quadratize(const core::StateVector<STATE_DIM, SCALAR_EVAL>& x,
+        const core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& u,
+        const SCALAR_EVAL& t,
+        const SCALAR_EVAL& weight,
+        core::StateVector<STATE_DIM, SCALAR_EVAL>& q,
+        state_matrix_t& Q,
+        core::ControlVector<CONTROL_DIM, SCALAR_EVAL>& r,
+        control_matrix_t& R,
+        control_state_matrix_t& P) override;
+
     virtual void loadConfigFile(const std::string& filename,
         const std::string& termName,
         bool verbose = false) override;
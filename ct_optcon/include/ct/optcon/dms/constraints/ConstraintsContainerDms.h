@@ -16,6 +16,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <ct/optcon/nlp/DiscreteConstraintContainerBase.h>
 #include <ct/optcon/dms/constraints/InitStateConstraint.h>
 #include <ct/optcon/dms/constraints/ContinuityConstraint.h>
+#include <ct/optcon/dms/constraints/TimeHorizonEqualityConstraint.h>
 #include <ct/optcon/dms/dms_core/DmsSettings.h>
 #include <ct/optcon/dms/constraints/ConstraintDiscretizer.h>
 
@@ -0,0 +1,94 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <ct/optcon/nlp/DiscreteConstraintBase.h>
+#include <ct/optcon/dms/dms_core/OptVectorDms.h>
+
+namespace ct {
+namespace optcon {
+
+/**
+ * @ingroup    DMS
+ *
+ * @brief      This class implements the time horizon constraint for the time
+ *             grid optimization, i.e. the optimized time segments h_i need
+ *             to add up to the time horizon T
+ *
+ * @tparam     STATE_DIM    The state dimension
+ * @tparam     CONTROL_DIM  The input dimension
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class TimeHorizonEqualityConstraint : public tpl::DiscreteConstraintBase<SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef tpl::DiscreteConstraintBase<SCALAR> BASE;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> VectorXs;
+
+    /**
+	 * @brief      Default constructor
+	 */
+    TimeHorizonEqualityConstraint() = default;
+    /**
+	 * @brief      Custom constructor
+	 *
+	 * @param[in]  w         The optimization variables
+	 * @param[in]  settings  The dms settings
+	 */
+    TimeHorizonEqualityConstraint(std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w,
+        const DmsSettings settings)
+        : w_(w), settings_(settings)
+    {
+        lb_.resize(1);
+        ub_.resize(1);
+        lb_.setConstant(SCALAR(0.0));
+        ub_.setConstant(SCALAR(0.0));
+    }
+
+    VectorXs eval() override
+    {
+        VectorXs val(1);
+        val(0) = w_->getOptimizedTimeSegments().sum() - SCALAR(settings_.T_);
+        return val;
+    }
+
+    VectorXs evalSparseJacobian() override { return VectorXs::Ones(settings_.N_); }
+    size_t getNumNonZerosJacobian() override { return settings_.N_; }
+    void genSparsityPattern(Eigen::VectorXi& iRow_vec, Eigen::VectorXi& jCol_vec) override
+    {
+        BASE::genBlockIndices(w_->getTimeSegmentIndex(0), 1, settings_.N_, iRow_vec, jCol_vec, 0);
+    }
+
+    void genSparsityPatternHessian(Eigen::VectorXi& iRow_vec, Eigen::VectorXi& jCol_vec) override
+    {
+        // linear constraint, no second order contribution
+        iRow_vec.resize(0);
+        jCol_vec.resize(0);
+    }
+
+    void sparseHessianValues(const Eigen::VectorXd& optVec,
+        const Eigen::VectorXd& lambda,
+        Eigen::VectorXd& sparseHes) override
+    {
+        sparseHes.resize(0);
+    }
+
+    VectorXs getLowerBound() override { return lb_; }
+    VectorXs getUpperBound() override { return ub_; }
+    size_t getConstraintSize() override { return 1; }
+private:
+    std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w_;
+    DmsSettings settings_;
+
+    //Constraint bounds
+    VectorXs lb_;  // lower bound
+    VectorXs ub_;  // upper bound
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -27,6 +27,12 @@ ConstraintsContainerDms<STATE_DIM, CONTROL_DIM, SCALAR>::ConstraintsContainerDms
         this->constraints_.push_back(c_i);
     }
 
+    if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+    {
+        this->constraints_.push_back(std::shared_ptr<TimeHorizonEqualityConstraint<STATE_DIM, CONTROL_DIM, SCALAR>>(
+            new TimeHorizonEqualityConstraint<STATE_DIM, CONTROL_DIM, SCALAR>(w, settings)));
+    }
+
     if (discretizedConstraints)
     {
         std::cout << "Adding discretized constraints" << std::endl;
@@ -98,7 +98,9 @@ public:
         size_t wLength = (settings.N_ + 1) * (STATE_DIM + CONTROL_DIM);
         if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
         {
-            throw std::runtime_error("We do not support adaptive time gridding");
+            if (settings_.solverSettings_.ipoptSettings_.hessian_approximation_ == "exact")
+                throw std::runtime_error("The exact hessian is not available for time grid optimization");
+            wLength += settings_.N_;  // the time segments h_i
         }
 
         this->optVariables_ = std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>>(
@@ -176,6 +178,9 @@ public:
 
     void updateProblem() override
     {
+        if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+            timeGrid_->updateTimeGrid(optVariablesDms_->getOptimizedTimeSegments());
+
         controlSpliner_->computeSpline(optVariablesDms_->getOptimizedInputs().toImplementation());
         for (auto shotContainer : shotContainers_)
             shotContainer->reset();
@@ -260,6 +265,23 @@ public:
         optVariablesDms_->changeInitialState(x0);
     }
 
+    /**
+	 * @brief      Sets the derivatives of the dynamics f(x,u) used for the
+	 *             exact Lagrangian Hessian (e.g. a DerivativesCppadJIT
+	 *             instance). Every shot receives its own clone.
+	 *
+	 * @param[in]  dynamicsDerivatives  The dynamics derivatives
+	 */
+    void setDynamicsDerivatives(
+        const std::shared_ptr<typename SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>::DynamicsDerivatives_t>&
+            dynamicsDerivatives)
+    {
+        for (auto shotContainer : shotContainers_)
+            shotContainer->setDynamicsDerivatives(
+                std::shared_ptr<typename SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>::DynamicsDerivatives_t>(
+                    dynamicsDerivatives->clone()));
+    }
+
     /**
 	 * @brief      Prints the solution trajectories
 	 */
@@ -27,6 +27,7 @@ public:
     typedef enum ObjectiveType { KEEP_TIME_AND_GRID = 0, OPTIMIZE_GRID = 1, num_types_objectives } ObjectiveType_t;
     typedef enum IntegrationType { EULER = 0, RK4 = 1, RK5 = 2, num_types_integration } IntegrationType_t;
     typedef enum CostEvaluationType { SIMPLE = 0, FULL = 1, num_types_costevaluation } CostEvaluationType_t;
+    typedef enum CostGradientType { FORWARD = 0, ADJOINT = 1, num_types_costgradient } CostGradientType_t;
 
     /**
 	 * @brief      Default constructor. Sets some default DMS settings. Note
@@ -39,6 +40,8 @@ public:
           nThreads_(1),
           splineType_(ZERO_ORDER_HOLD),
           costEvaluationType_(SIMPLE),
+          costGradientType_(FORWARD),
+          adjointCheckpointInterval_(0),
           objectiveType_(KEEP_TIME_AND_GRID),
           h_min_(0.1),
           integrationType_(RK4),
@@ -53,6 +56,8 @@ public:
     size_t nThreads_;                          // number of threads
     SplineType_t splineType_;                  // spline interpolation type between the nodes
     CostEvaluationType_t costEvaluationType_;  // the the of costevaluator
+    CostGradientType_t costGradientType_;      // forward sensitivities or backward costate for the full cost gradient
+    size_t adjointCheckpointInterval_;         // integration steps between adjoint checkpoints (0: whole shot)
     ObjectiveType_t objectiveType_;            // Timegrid optimization on(expensive) or off?
     double h_min_;                             // minimum admissible distance between two nodes in [sec]
     IntegrationType_t integrationType_;        // the integration type between the nodes
@@ -74,6 +79,9 @@ public:
         std::cout << "Number of threads: " << nThreads_ << std::endl;
         std::cout << "Splinetype: " << splineToString[splineType_] << std::endl;
         std::cout << "Cost eval: " << costEvalToString[costEvaluationType_] << std::endl;
+        std::cout << "Cost gradient: " << costGradToString[costGradientType_] << std::endl;
+        if (costGradientType_ == ADJOINT)
+            std::cout << "Adjoint checkpoint interval: " << adjointCheckpointInterval_ << std::endl;
         std::cout << "Objective type: " << objTypeToString[objectiveType_] << std::endl;
         std::cout << "Integration type: " << integratorToString[integrationType_] << std::endl;
         std::cout << "Simulation timestep dt_sim: " << dt_sim_ << std::endl;
@@ -100,6 +108,9 @@ public:
         if (costEvaluationType_ < 0 || !(costEvaluationType_ < CostEvaluationType_t::num_types_costevaluation))
             return false;
 
+        if (costGradientType_ < 0 || !(costGradientType_ < CostGradientType_t::num_types_costgradient))
+            return false;
+
         if (objectiveType_ < 0 || !(objectiveType_ < ObjectiveType_t::num_types_objectives))
             return false;
 
@@ -134,6 +145,9 @@ public:
         nThreads_ = pt.get<unsigned int>(ns + ".nThreads");
         splineType_ = static_cast<SplineType_t>(pt.get<unsigned int>(ns + ".InterpolationType"));
         costEvaluationType_ = static_cast<CostEvaluationType_t>(pt.get<unsigned int>(ns + ".CostEvaluationType"));
+        costGradientType_ =
+            static_cast<CostGradientType_t>(pt.get<unsigned int>(ns + ".CostGradientType", FORWARD));
+        adjointCheckpointInterval_ = pt.get<unsigned int>(ns + ".AdjointCheckpointInterval", 0);
         objectiveType_ = static_cast<ObjectiveType_t>(pt.get<unsigned int>(ns + ".ObjectiveType"));
         h_min_ = pt.get<double>(ns + ".h_min");
 
@@ -160,6 +174,8 @@ private:
     std::map<IntegrationType, std::string> integratorToString = {
         {EULER, "Euler"}, {RK4, "Runge-Kutta 4th order"}, {RK5, "RK5 adaptive step size"}};
     std::map<CostEvaluationType, std::string> costEvalToString = {{SIMPLE, "Simple"}, {FULL, "Full"}};
+    std::map<CostGradientType, std::string> costGradToString = {
+        {FORWARD, "Forward sensitivities"}, {ADJOINT, "Adjoint"}};
 };
 }
 }
@@ -190,6 +190,18 @@ public:
                 this->getNonlinearSystemsInstances()[i] = typename Base::OptConProblem_t::DynamicsPtr_t(dyn->clone());
     }
 
+    /**
+	 * @brief      Sets the derivatives of the dynamics used for exact Hessians
+	 *
+	 * @param[in]  dynamicsDerivatives  The dynamics derivatives, e.g. DerivativesCppadJIT
+	 */
+    void setDynamicsDerivatives(
+        const std::shared_ptr<typename SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>::DynamicsDerivatives_t>&
+            dynamicsDerivatives)
+    {
+        dmsProblem_->setDynamicsDerivatives(dynamicsDerivatives);
+    }
+
     void changeLinearSystem(const typename Base::OptConProblem_t::LinearPtr_t& lin) override
     {
         this->getLinearSystemsInstances().resize(settings_.N_);
@@ -116,6 +116,24 @@ public:
      */
     size_t getControlIndex(const size_t pairNum) const;
 
+    /**
+     * @brief      Returns the index of the time segment h_i of shot shotNr
+     *             inside the optimization vector. Only available with time
+     *             grid optimization
+     *
+     * @param[in]  shotNr  The shot number
+     *
+     * @return     The time segment index
+     */
+    size_t getTimeSegmentIndex(const size_t shotNr) const;
+
+    /**
+     * @brief      Returns the optimized time segments h_i of all shots
+     *
+     * @return     The optimized time segments
+     */
+    Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> getOptimizedTimeSegments() const;
+
     /**
      * @brief      Sets an initial guess for the optimal solution. The optimal
      *             solution is set as a linear interpolation between inital
@@ -168,6 +186,7 @@ private:
     /* maps the number of a "pair" to the index in w where ... */
     std::map<size_t, size_t> pairNumToStateIdx_;   /* ... its state starts */
     std::map<size_t, size_t> pairNumToControlIdx_; /* ... its control starts */
+    size_t timeSegmentStartIdx_;                   /* index of the first time segment h_0 */
 
     state_vector_array_t stateSolution_;
     control_vector_array_t inputSolution_;
@@ -13,7 +13,9 @@ namespace optcon {
 /**
  * @brief      This class can integrate a controlled system and a costfunction.
  *             Furthermore, it provides first order derivatives with respect to
- *             initial state and control
+ *             initial state, control and shot duration, either by forward
+ *             sensitivities or by a checkpointed adjoint sweep, and second
+ *             order derivatives of the shot Lagrangian
  *
  * @tparam     STATE_DIM    The state dimension
  * @tparam     CONTROL_DIM  The control dimension
@@ -29,6 +31,11 @@ public:
     typedef Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM> state_matrix;
     typedef Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM> control_matrix;
     typedef Eigen::Matrix<SCALAR, STATE_DIM, CONTROL_DIM> state_control_matrix;
+    typedef Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM, STATE_DIM + CONTROL_DIM> state_control_hessian;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic> MatrixXs;
+
+    //! derivatives of the dynamics f(x,u) with input [x; u], used for second order sensitivities
+    typedef ct::core::Derivatives<STATE_DIM + CONTROL_DIM, STATE_DIM, SCALAR> DynamicsDerivatives_t;
 
 
     /**
@@ -39,7 +46,7 @@ public:
      */
     SensitivityIntegratorCT(const std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>>& system,
         const ct::core::IntegrationType stepperType = ct::core::IntegrationType::EULERCT)
-        : cacheData_(false), cacheSensitivities_(false)
+        : cacheData_(false), cacheSensitivities_(false), recordSegment_(false)
     {
         setControlledSystem(system);
         initializeDerived(stepperType);
@@ -66,12 +73,19 @@ public:
                     new ct::core::internal::StepperEulerCT<state_matrix, SCALAR>());
                 stepperDU0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_control_matrix, SCALAR>>(
                     new ct::core::internal::StepperEulerCT<state_control_matrix, SCALAR>());
+                stepperDH_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>>(
+                    new ct::core::internal::StepperEulerCT<state_vector, SCALAR>());
                 stepperCost_ = std::shared_ptr<ct::core::internal::StepperCTBase<SCALAR, SCALAR>>(
                     new ct::core::internal::StepperEulerCT<SCALAR, SCALAR>());
                 stepperCostDX0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>>(
                     new ct::core::internal::StepperEulerCT<state_vector, SCALAR>());
                 stepperCostDU0_ = std::shared_ptr<ct::core::internal::StepperCTBase<control_vector, SCALAR>>(
                     new ct::core::internal::StepperEulerCT<control_vector, SCALAR>());
+
+                // the Euler stage is weighted with the costate at the end of the step (exact discrete adjoint)
+                stageWeights_ = {SCALAR(1.0)};
+                stageCoefficients_ = MatrixXs::Zero(1, 1);
+                stageCostateInterpolation_ = {SCALAR(1.0)};
                 break;
             }
 
@@ -83,12 +97,21 @@ public:
                     new ct::core::internal::StepperRK4CT<state_matrix, SCALAR>());
                 stepperDU0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_control_matrix, SCALAR>>(
                     new ct::core::internal::StepperRK4CT<state_control_matrix, SCALAR>());
+                stepperDH_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>>(
+                    new ct::core::internal::StepperRK4CT<state_vector, SCALAR>());
                 stepperCost_ = std::shared_ptr<ct::core::internal::StepperCTBase<SCALAR, SCALAR>>(
                     new ct::core::internal::StepperRK4CT<SCALAR, SCALAR>());
                 stepperCostDX0_ = std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>>(
                     new ct::core::internal::StepperRK4CT<state_vector, SCALAR>());
                 stepperCostDU0_ = std::shared_ptr<ct::core::internal::StepperCTBase<control_vector, SCALAR>>(
                     new ct::core::internal::StepperRK4CT<control_vector, SCALAR>());
+
+                stageWeights_ = {SCALAR(1.0 / 6.0), SCALAR(1.0 / 3.0), SCALAR(1.0 / 3.0), SCALAR(1.0 / 6.0)};
+                stageCoefficients_ = MatrixXs::Zero(4, 4);
+                stageCoefficients_(1, 0) = SCALAR(0.5);
+                stageCoefficients_(2, 1) = SCALAR(0.5);
+                stageCoefficients_(3, 2) = SCALAR(1.0);
+                stageCostateInterpolation_ = {SCALAR(0.0), SCALAR(0.5), SCALAR(0.5), SCALAR(1.0)};
                 break;
             }
 
@@ -138,6 +161,15 @@ public:
                             statesCached_[dU0Index_], timesCached_[dU0Index_]);
             dU0Index_++;
         };
+
+        // in normalized shot time the controls do not depend on the shot duration
+        dHdot_ = [this](const state_vector& dHIn, state_vector& dHdt, const SCALAR t) {
+            if (cacheSensitivities_)
+                arraydH_.push_back(dHIn);
+
+            dHdt = arrayA_[dHIndex_] * dHIn + derivativesCached_[dHIndex_] / shotDuration_;
+            dHIndex_++;
+        };
     }
 
     /**
@@ -153,14 +185,30 @@ public:
             control_vector controlAction;
             controlledSystem_->getController()->computeControl(x, t, controlAction);
 
+            controlledSystem_->computeControlledDynamics(x, t, controlAction, dxdt);
+
             if (cacheData_)
             {
                 statesCached_.push_back(x);
                 controlsCached_.push_back(controlAction);
                 timesCached_.push_back(t);
+                derivativesCached_.push_back(dxdt);
             }
+        };
+
+        xDotSegment_ = [this](const state_vector& x, state_vector& dxdt, const SCALAR t) {
+            control_vector controlAction;
+            controlledSystem_->getController()->computeControl(x, t, controlAction);
 
             controlledSystem_->computeControlledDynamics(x, t, controlAction, dxdt);
+
+            if (recordSegment_)
+            {
+                segmentStates_.push_back(x);
+                segmentControls_.push_back(controlAction);
+                segmentTimes_.push_back(t);
+                segmentDerivatives_.push_back(dxdt);
+            }
         };
     }
 
@@ -208,8 +256,25 @@ public:
                             costFunction_->controlDerivativeIntermediate();
             costIndex_++;
         };
+
+        costdHdot_ = [this](const SCALAR& costdHIn, SCALAR& costdHdt, const SCALAR t) {
+            costFunction_->setCurrentStateAndControl(
+                statesCached_[costIndex_], controlsCached_[costIndex_], timesCached_[costIndex_]);
+            costdHdt = arraydH_[costIndex_].dot(costFunction_->stateDerivativeIntermediate()) +
+                       costFunction_->evaluateIntermediate() / shotDuration_;
+            costIndex_++;
+        };
     }
 
+    /**
+     * @brief      Enables or disables caching the sensitivity trajectories,
+     *             which are only required by the forward cost sensitivities
+     *             and the Lagrangian Hessian
+     *
+     * @param[in]  cacheSensitivities  Whether to cache the sensitivities
+     */
+    void setCacheSensitivities(const bool cacheSensitivities) { cacheSensitivities_ = cacheSensitivities; }
+
     /**
      * @brief          Integrates the system starting from state and startTime
      *                 for numSteps integration steps. Returns the full state
@@ -339,6 +404,30 @@ public:
         }
     }
 
+    /**
+     * @brief          Integrates the sensitivity ODE of the integrator with
+     *                 respect to the shot duration h = numSteps * dt. The shot
+     *                 is treated in normalized time, i.e. the number of steps
+     *                 is fixed and the step size scales with h.
+     *
+     * @param[in, out] dH         The sensitivity vector wrt h
+     * @param[in]      startTime  The start time
+     * @param[in]      numSteps   The number of integration steps
+     * @param[in]      dt         The integration timestep
+     */
+    void integrateSensitivityDH(state_vector& dH, const SCALAR startTime, const size_t numSteps, const SCALAR dt)
+    {
+        dHIndex_ = 0;
+        shotDuration_ = numSteps * dt;
+        SCALAR time = startTime;
+        dH.setZero();
+        for (size_t i = 0; i < numSteps; ++i)
+        {
+            stepperDH_->do_step(dHdot_, dH, time, dt);
+            time += dt;
+        }
+    }
+
     /**
      * @brief          Integrates the costfunction using the states and controls
      *                 from the costintegration
@@ -432,6 +521,268 @@ public:
         }
     }
 
+    /**
+     * @brief          Integrates the sensitivity of the cost with respect to
+     *                 the shot duration h = numSteps * dt in normalized time
+     *
+     * @param[in, out] dH         The initial cost sensitivity
+     * @param[in]      startTime  The start time
+     * @param[in]      numSteps   The number of integration steps
+     * @param[in]      dt         The integration time step
+     */
+    void integrateCostSensitivityDH(SCALAR& dH, const SCALAR startTime, const size_t numSteps, const SCALAR dt)
+    {
+        costIndex_ = 0;
+        shotDuration_ = numSteps * dt;
+        SCALAR time = startTime;
+        dH = SCALAR(0.0);
+        for (size_t i = 0; i < numSteps; ++i)
+        {
+            stepperCost_->do_step(costdHdot_, dH, time, dt);
+            time += dt;
+        }
+    }
+
+    /**
+     * @brief          Computes the gradient of the integrated cost with
+     *                 respect to the initial state x0, the control inputs u0
+     *                 (and uf) and the shot duration h = numSteps * dt in
+     *                 normalized time by integrating a single costate backwards
+     *                 through the discrete adjoint of the integration scheme.
+     *                 In contrast to the forward cost sensitivities, no
+     *                 sensitivity matrices are propagated or stored, which
+     *                 pays off for large control dimensions.
+     *
+     *                 Only every checkpointInterval-th state of the forward
+     *                 pass is kept. The backward sweep re-integrates one
+     *                 segment between two checkpoints at a time and evaluates
+     *                 the linearization on the fly, such that the memory is
+     *                 bounded by the number of checkpoints plus the stages of
+     *                 one segment.
+     *
+     * @param[in]      x0                  The initial state of the shot
+     * @param[in]      startTime           The start time
+     * @param[in]      numSteps            The number of integration steps
+     * @param[in]      dt                  The integration time step
+     * @param[in]      checkpointInterval  The number of integration steps between two checkpoints, 0 for one segment
+     * @param[in]      withUf              Whether to compute the gradient wrt the final control input
+     * @param[out]     dX0                 The cost gradient wrt x0
+     * @param[out]     dU0                 The cost gradient wrt u0
+     * @param[out]     dUf                 The cost gradient wrt uf
+     * @param[out]     dH                  The cost gradient wrt the shot duration
+     */
+    void integrateCostGradientAdjoint(const state_vector& x0,
+        const SCALAR startTime,
+        const size_t numSteps,
+        const SCALAR dt,
+        const size_t checkpointInterval,
+        const bool withUf,
+        state_vector& dX0,
+        control_vector& dU0,
+        control_vector& dUf,
+        SCALAR& dH)
+    {
+        if (!costFunction_ || !linearSystem_)
+            throw std::runtime_error("SensitivityIntegratorCT: adjoint gradient requires cost and linear system");
+
+        const size_t nStages = stageWeights_.size();
+        const size_t interval =
+            (checkpointInterval == 0 || checkpointInterval > numSteps) ? numSteps : checkpointInterval;
+
+        // forward pass, keeping only the checkpoints
+        checkpoints_.clear();
+        state_vector x = x0;
+        SCALAR time = startTime;
+        for (size_t i = 0; i < numSteps; ++i)
+        {
+            if (i % interval == 0)
+                checkpoints_.push_back(x);
+            stepperState_->do_step(xDotSegment_, x, time, dt);
+            time += dt;
+        }
+
+        // backward pass over the segments
+        state_vector lambda = state_vector::Zero();
+        dU0.setZero();
+        dUf.setZero();
+        dH = SCALAR(0.0);
+        stageAdjoints_.resize(nStages);
+        for (int c = static_cast<int>(checkpoints_.size()) - 1; c >= 0; c--)
+        {
+            const size_t firstStep = c * interval;
+            const size_t segmentSteps = std::min(interval, numSteps - firstStep);
+
+            // recompute the stage points of the segment
+            segmentStates_.clear();
+            segmentControls_.clear();
+            segmentTimes_.clear();
+            segmentDerivatives_.clear();
+            recordSegment_ = true;
+            x = checkpoints_[c];
+            time = startTime + firstStep * dt;
+            for (size_t i = 0; i < segmentSteps; ++i)
+            {
+                stepperState_->do_step(xDotSegment_, x, time, dt);
+                time += dt;
+            }
+            recordSegment_ = false;
+
+            for (int i = static_cast<int>(segmentSteps) - 1; i >= 0; i--)
+            {
+                // adjoint of one explicit Runge-Kutta step, lambda holds the costate at the end of the step
+                for (int j = static_cast<int>(nStages) - 1; j >= 0; j--)
+                {
+                    const size_t k = i * nStages + j;
+
+                    // sensitivity of the cost wrt the stage derivative
+                    state_vector dJdK = dt * stageWeights_[j] * lambda;
+                    for (size_t m = j + 1; m < nStages; m++)
+                        dJdK += dt * stageCoefficients_(m, j) * stageAdjoints_[m];
+
+                    const state_vector& xk = segmentStates_[k];
+                    const control_vector& uk = segmentControls_[k];
+                    const SCALAR tk = segmentTimes_[k];
+                    costFunction_->setCurrentStateAndControl(xk, uk, tk);
+
+                    // the linear system returns references to internal storage, evaluate each term before the next call
+                    const state_vector AtdJdK = linearSystem_->getDerivativeState(xk, uk, tk).transpose() * dJdK;
+                    const control_vector dJdU = linearSystem_->getDerivativeControl(xk, uk, tk).transpose() * dJdK +
+                                                dt * stageWeights_[j] * costFunction_->controlDerivativeIntermediate();
+
+                    stageAdjoints_[j] = AtdJdK + dt * stageWeights_[j] * costFunction_->stateDerivativeIntermediate();
+
+                    dU0 += controlledSystem_->getController()->getDerivativeU0(xk, tk).transpose() * dJdU;
+                    if (withUf)
+                        dUf += controlledSystem_->getController()->getDerivativeUf(xk, tk).transpose() * dJdU;
+
+                    // the step size enters the stage and the quadrature weights
+                    dH += (stageWeights_[j] * costFunction_->evaluateIntermediate() +
+                              segmentDerivatives_[k].dot(dJdK) / dt) /
+                          SCALAR(numSteps);
+                }
+
+                for (size_t j = 0; j < nStages; j++)
+                    lambda += stageAdjoints_[j];
+            }
+        }
+
+        dX0 = lambda;
+    }
+
+    /**
+     * @brief      Sets the derivatives of the dynamics which are used to
+     *             evaluate the second order sensitivities, e.g. a
+     *             DerivativesCppadJIT instance of f(x,u). If none are set, the
+     *             weighted dynamics Hessian is obtained by central differences
+     *             of the linear system.
+     *
+     * @param[in]  dynamicsDerivatives  The derivatives of the dynamics
+     */
+    void setDynamicsDerivatives(const std::shared_ptr<DynamicsDerivatives_t>& dynamicsDerivatives)
+    {
+        dynamicsDerivatives_ = dynamicsDerivatives;
+    }
+
+    /**
+     * @brief          Computes the Hessian of the shot Lagrangian mu^T x(t_f) +
+     *                 omega * int L(x,u) dt with respect to the shot decision
+     *                 variables [x0, u0, (uf)] by a second-order adjoint sweep.
+     *                 A single costate is integrated backwards over the cached
+     *                 rollout and contracted with the first order
+     *                 sensitivities, which therefore need to be available from
+     *                 integrateSensitivityDX0(), integrateSensitivityDU0() and
+     *                 (if requested) integrateSensitivityDUf().
+     *
+     *                 For Euler integration this is the exact Hessian of the
+     *                 discretized shot, for RK4 the costate is interpolated
+     *                 across the stages.
+     *
+     * @param[out]     hessian     The dense Hessian, size nx + nu (+ nu if withUf)
+     * @param[in]      mu          The multiplier on the final state
+     * @param[in]      omega       The multiplier on the integrated cost
+     * @param[in]      numSteps    The number of integration steps
+     * @param[in]      dt          The integration time step
+     * @param[in]      withUf      Whether to include the final control input
+     */
+    void integrateLagrangianHessian(MatrixXs& hessian,
+        const state_vector& mu,
+        const SCALAR omega,
+        const size_t numSteps,
+        const SCALAR dt,
+        const bool withUf)
+    {
+        const size_t nStages = stageWeights_.size();
+        const size_t nz = STATE_DIM + CONTROL_DIM + (withUf ? CONTROL_DIM : 0);
+
+        if (arraydX0_.size() != numSteps * nStages || arraydU0_.size() != numSteps * nStages ||
+            (withUf && arraydUf_.size() != numSteps * nStages) || arrayA_.size() != numSteps * nStages)
+            throw std::runtime_error("SensitivityIntegratorCT: first order sensitivities are not cached");
+
+        if (omega != SCALAR(0.0) && !costFunction_)
+            throw std::runtime_error("SensitivityIntegratorCT: cost function required for cost Hessian");
+
+        // backward sweep for the costate at the step boundaries
+        costates_.resize(numSteps + 1);
+        costates_[numSteps] = mu;
+        for (int i = static_cast<int>(numSteps) - 1; i >= 0; i--)
+        {
+            state_vector rhs = state_vector::Zero();
+            for (size_t j = 0; j < nStages; j++)
+            {
+                const size_t k = i * nStages + j;
+                rhs += stageWeights_[j] * (arrayA_[k].transpose() * costates_[i + 1]);
+                if (omega != SCALAR(0.0))
+                {
+                    costFunction_->setCurrentStateAndControl(statesCached_[k], controlsCached_[k], timesCached_[k]);
+                    rhs += stageWeights_[j] * omega * costFunction_->stateDerivativeIntermediate();
+                }
+            }
+            costates_[i] = costates_[i + 1] + dt * rhs;
+        }
+
+        // forward sweep contracting the weighted second derivatives with the first order sensitivities
+        hessian.setZero(nz, nz);
+        MatrixXs Z = MatrixXs::Zero(STATE_DIM + CONTROL_DIM, nz);
+        for (size_t i = 0; i < numSteps; i++)
+        {
+            for (size_t j = 0; j < nStages; j++)
+            {
+                const size_t k = i * nStages + j;
+                const state_vector lambda = (SCALAR(1.0) - stageCostateInterpolation_[j]) * costates_[i] +
+                                            stageCostateInterpolation_[j] * costates_[i + 1];
+
+                Z.template topLeftCorner<STATE_DIM, STATE_DIM>() = arraydX0_[k];
+                Z.template block<STATE_DIM, CONTROL_DIM>(0, STATE_DIM) = arraydU0_[k];
+                Z.template block<CONTROL_DIM, CONTROL_DIM>(STATE_DIM, STATE_DIM) =
+                    controlledSystem_->getController()->getDerivativeU0(statesCached_[k], timesCached_[k]);
+                if (withUf)
+                {
+                    Z.template block<STATE_DIM, CONTROL_DIM>(0, STATE_DIM + CONTROL_DIM) = arraydUf_[k];
+                    Z.template block<CONTROL_DIM, CONTROL_DIM>(STATE_DIM, STATE_DIM + CONTROL_DIM) =
+                        controlledSystem_->getController()->getDerivativeUf(statesCached_[k], timesCached_[k]);
+                }
+
+                state_control_hessian W;
+                computeWeightedDynamicsHessian(k, lambda, W);
+
+                if (omega != SCALAR(0.0))
+                {
+                    costFunction_->setCurrentStateAndControl(statesCached_[k], controlsCached_[k], timesCached_[k]);
+                    W.template topLeftCorner<STATE_DIM, STATE_DIM>() +=
+                        omega * costFunction_->stateSecondDerivativeIntermediate();
+                    W.template bottomRightCorner<CONTROL_DIM, CONTROL_DIM>() +=
+                        omega * costFunction_->controlSecondDerivativeIntermediate();
+                    const Eigen::Matrix<SCALAR, CONTROL_DIM, STATE_DIM> P =
+                        omega * costFunction_->stateControlDerivativeIntermediate();
+                    W.template bottomLeftCorner<CONTROL_DIM, STATE_DIM>() += P;
+                    W.template topRightCorner<STATE_DIM, CONTROL_DIM>() += P.transpose();
+                }
+
+                hessian.noalias() += (dt * stageWeights_[j]) * (Z.transpose() * W * Z);
+            }
+        }
+    }
+
     /**
      * @brief      Linearizes the system around the rollout from the state
      *             interation
@@ -454,6 +805,7 @@ public:
         statesCached_.clear();
         controlsCached_.clear();
         timesCached_.clear();
+        derivativesCached_.clear();
     }
 
 
@@ -465,6 +817,7 @@ public:
         arraydX0_.clear();
         arraydU0_.clear();
         arraydUf_.clear();
+        arraydH_.clear();
     }
 
 
@@ -478,6 +831,64 @@ public:
     }
 
 private:
+    /**
+     * @brief      Evaluates the Hessian of lambda^T f(x,u) with respect to
+     *             [x; u] at a cached rollout point
+     *
+     * @param[in]  k       The index of the cached point
+     * @param[in]  lambda  The costate weighting the dynamics
+     * @param[out] W       The weighted Hessian
+     */
+    void computeWeightedDynamicsHessian(const size_t k, const state_vector& lambda, state_control_hessian& W)
+    {
+        Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM, 1> xu;
+        xu << statesCached_[k], controlsCached_[k];
+
+        if (dynamicsDerivatives_)
+        {
+            Eigen::VectorXd hesValues;
+            Eigen::VectorXi iRow, jCol;
+            dynamicsDerivatives_->sparseHessian(
+                xu.template cast<double>(), lambda.template cast<double>(), hesValues, iRow, jCol);
+
+            // the sparsity pattern may only cover one triangle
+            W.setZero();
+            for (int i = 0; i < hesValues.rows(); i++)
+            {
+                W(iRow(i), jCol(i)) = SCALAR(hesValues(i));
+                W(jCol(i), iRow(i)) = SCALAR(hesValues(i));
+            }
+            return;
+        }
+
+        // central differences of the linearization weighted with the costate
+        const SCALAR eps = std::cbrt(Eigen::NumTraits<SCALAR>::epsilon());
+        for (size_t i = 0; i < STATE_DIM + CONTROL_DIM; i++)
+        {
+            const SCALAR h = eps * std::max(SCALAR(1.0), std::abs(xu(i)));
+            Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM, 1> xuPlus = xu, xuMinus = xu;
+            xuPlus(i) += h;
+            xuMinus(i) -= h;
+
+            const state_vector xP = xuPlus.template head<STATE_DIM>(), xM = xuMinus.template head<STATE_DIM>();
+            const control_vector uP = xuPlus.template tail<CONTROL_DIM>(), uM = xuMinus.template tail<CONTROL_DIM>();
+
+            // the linear system returns references to internal storage, evaluate each term before the next call
+            const state_vector AtLambdaPlus =
+                linearSystem_->getDerivativeState(xP, uP, timesCached_[k]).transpose() * lambda;
+            const state_vector AtLambdaMinus =
+                linearSystem_->getDerivativeState(xM, uM, timesCached_[k]).transpose() * lambda;
+            const control_vector BtLambdaPlus =
+                linearSystem_->getDerivativeControl(xP, uP, timesCached_[k]).transpose() * lambda;
+            const control_vector BtLambdaMinus =
+                linearSystem_->getDerivativeControl(xM, uM, timesCached_[k]).transpose() * lambda;
+
+            W.col(i).template head<STATE_DIM>() = (AtLambdaPlus - AtLambdaMinus) / (SCALAR(2.0) * h);
+            W.col(i).template tail<CONTROL_DIM>() = (BtLambdaPlus - BtLambdaMinus) / (SCALAR(2.0) * h);
+        }
+        W = (SCALAR(0.5) * (W + W.transpose())).eval();
+    }
+
     std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>> controlledSystem_;
     std::shared_ptr<ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>> linearSystem_;
     std::shared_ptr<optcon::CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>> costFunction_;
@@ -487,11 +898,13 @@ private:
     std::function<void(const state_vector&, state_vector&, const SCALAR)> costdX0dot_;
     std::function<void(const control_vector&, control_vector&, const SCALAR)> costdU0dot_;
     std::function<void(const control_vector&, control_vector&, const SCALAR)> costdUfdot_;
+    std::function<void(const SCALAR&, SCALAR&, const SCALAR)> costdHdot_;
 
     // Sensitivities
     std::function<void(const state_matrix&, state_matrix&, const SCALAR)> dX0dot_;
     std::function<void(const state_control_matrix&, state_control_matrix&, const SCALAR)> dU0dot_;
     std::function<void(const state_control_matrix&, state_control_matrix&, const SCALAR)> dUfdot_;
+    std::function<void(const state_vector&, state_vector&, const SCALAR)> dHdot_;
 
     // Cache
     bool cacheData_;
@@ -499,6 +912,7 @@ private:
     ct::core::StateVectorArray<STATE_DIM, SCALAR> statesCached_;
     ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> controlsCached_;
     ct::core::tpl::TimeArray<SCALAR> timesCached_;
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> derivativesCached_;
 
     ct::core::StateMatrixArray<STATE_DIM, SCALAR> arrayA_;
     ct::core::StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> arrayB_;
@@ -506,20 +920,41 @@ private:
     ct::core::StateMatrixArray<STATE_DIM, SCALAR> arraydX0_;
     ct::core::StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> arraydU0_;
     ct::core::StateControlMatrixArray<STATE_DIM, CONTROL_DIM, SCALAR> arraydUf_;
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> arraydH_;
 
     std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>> stepperState_;
     std::shared_ptr<ct::core::internal::StepperCTBase<state_matrix, SCALAR>> stepperDX0_;
     std::shared_ptr<ct::core::internal::StepperCTBase<state_control_matrix, SCALAR>> stepperDU0_;
+    std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>> stepperDH_;
 
     std::shared_ptr<ct::core::internal::StepperCTBase<SCALAR, SCALAR>> stepperCost_;
     std::shared_ptr<ct::core::internal::StepperCTBase<state_vector, SCALAR>> stepperCostDX0_;
     std::shared_ptr<ct::core::internal::StepperCTBase<control_vector, SCALAR>> stepperCostDU0_;
 
+    // Second order sensitivities
+    std::shared_ptr<DynamicsDerivatives_t> dynamicsDerivatives_;
+    std::vector<SCALAR> stageWeights_;
+    std::vector<SCALAR> stageCostateInterpolation_;
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> costates_;
+
     size_t costIndex_;
     size_t dX0Index_;
     size_t dU0Index_;
+    size_t dHIndex_;
+    SCALAR shotDuration_;
+
+    // Adjoint gradient
+    bool recordSegment_;
+    MatrixXs stageCoefficients_;
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> checkpoints_;
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> stageAdjoints_;
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> segmentStates_;
+    ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> segmentControls_;
+    ct::core::tpl::TimeArray<SCALAR> segmentTimes_;
+    ct::core::StateVectorArray<STATE_DIM, SCALAR> segmentDerivatives_;
 
     std::function<void(const state_vector&, state_vector&, const SCALAR)> xDot_;
+    std::function<void(const state_vector&, state_vector&, const SCALAR)> xDotSegment_;
 };
 }
 }
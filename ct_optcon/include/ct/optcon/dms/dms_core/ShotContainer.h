@@ -48,6 +48,9 @@ public:
     typedef typename DIMENSIONS::state_matrix_array_t state_matrix_array_t;
     typedef typename DIMENSIONS::state_control_matrix_array_t state_control_matrix_array_t;
 
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> VectorXs;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic> MatrixXs;
+
     ShotContainer() = delete;
 
     /**
@@ -83,10 +86,12 @@ public:
           costIntegrationCount_(0),
           sensIntegrationCount_(0),
           costSensIntegrationCount_(0),
+          discreteH_(state_vector_t::Zero()),
           cost_(SCALAR(0.0)),
           discreteQ_(state_vector_t::Zero()),
           discreteR_(control_vector_t::Zero()),
-          discreteRNext_(control_vector_t::Zero())
+          discreteRNext_(control_vector_t::Zero()),
+          discreteCostH_(SCALAR(0.0))
     {
         if (shotNr_ >= settings.N_)
             throw std::runtime_error("Dms Shot Integrator: shot index >= settings.N_ - check your settings.");
@@ -121,17 +126,33 @@ public:
             }
         }
 
-        tStart_ = timeGrid_->getShotStartTime(shotNr_);
-        // SCALAR t_shot_end = timeGrid_->getShotEndTime(shotNr_);
-
-        // +0.5 needed to avoid rounding errors from double to size_t
+        // with time grid optimization the number of steps stays fixed and the shot is integrated in normalized time
         nSteps_ = nIntegrationSteps;
-        // std::cout << "shotNr_: " << shotNr_ << "\t nSteps: " << nSteps_ << std::endl;
+        updateShotTiming();
 
         integratorCT_->setLinearSystem(linearSystem_);
 
-        if (settings_.costEvaluationType_ == DmsSettings::FULL)
+        // the exact Hessian requires the sensitivity trajectories, which are cached along with the cost
+        const bool exactHessian = settings_.solverSettings_.ipoptSettings_.hessian_approximation_ == "exact";
+        if (settings_.costEvaluationType_ == DmsSettings::FULL || exactHessian)
             integratorCT_->setCostFunction(costFct_);
+
+        // the adjoint cost gradient does not need the sensitivity trajectories
+        if (settings_.costGradientType_ == DmsSettings::ADJOINT && !exactHessian)
+            integratorCT_->setCacheSensitivities(false);
+    }
+
+    /**
+	 * @brief      Sets the derivatives of the dynamics used for the exact
+	 *             Lagrangian Hessian, e.g. a DerivativesCppadJIT instance
+	 *
+	 * @param[in]  dynamicsDerivatives  The dynamics derivatives
+	 */
+    void setDynamicsDerivatives(
+        const std::shared_ptr<typename SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>::DynamicsDerivatives_t>&
+            dynamicsDerivatives)
+    {
+        integratorCT_->setDynamicsDerivatives(dynamicsDerivatives);
     }
 
     /**
@@ -142,9 +163,9 @@ public:
         if ((w_->getUpdateCount() != integrationCount_))
         {
             integrationCount_ = w_->getUpdateCount();
+            updateShotTiming();
             state_vector_t initState = w_->getOptimizedState(shotNr_);
-            integratorCT_->integrate(
-                initState, tStart_, nSteps_, SCALAR(settings_.dt_sim_), stateSubsteps_, timeSubsteps_);
+            integratorCT_->integrate(initState, tStart_, nSteps_, dt_, stateSubsteps_, timeSubsteps_);
         }
     }
 
@@ -155,7 +176,7 @@ public:
             costIntegrationCount_ = w_->getUpdateCount();
             integrateShot();
             cost_ = SCALAR(0.0);
-            integratorCT_->integrateCost(cost_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
+            integratorCT_->integrateCost(cost_, tStart_, nSteps_, dt_);
         }
     }
 
@@ -171,36 +192,140 @@ public:
             discreteA_.setIdentity();
             discreteB_.setZero();
             integratorCT_->linearize();
-            integratorCT_->integrateSensitivityDX0(discreteA_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
-            integratorCT_->integrateSensitivityDU0(discreteB_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
+            integratorCT_->integrateSensitivityDX0(discreteA_, tStart_, nSteps_, dt_);
+            integratorCT_->integrateSensitivityDU0(discreteB_, tStart_, nSteps_, dt_);
 
             if (settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR)
             {
                 discreteBNext_.setZero();
-                integratorCT_->integrateSensitivityDUf(discreteBNext_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
+                integratorCT_->integrateSensitivityDUf(discreteBNext_, tStart_, nSteps_, dt_);
             }
+
+            if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+                integratorCT_->integrateSensitivityDH(discreteH_, tStart_, nSteps_, dt_);
         }
     }
 
+    /**
+	 * @brief      Computes the gradient of the integrated cost with respect
+	 *             to the shot variables, either by forward sensitivities or
+	 *             by a backward adjoint sweep, depending on the settings
+	 */
     void integrateCostSensitivities()
     {
         if ((w_->getUpdateCount() != costSensIntegrationCount_))
         {
             costSensIntegrationCount_ = w_->getUpdateCount();
+
+            if (settings_.costGradientType_ == DmsSettings::ADJOINT)
+            {
+                updateShotTiming();
+                integratorCT_->integrateCostGradientAdjoint(w_->getOptimizedState(shotNr_), tStart_, nSteps_, dt_,
+                    settings_.adjointCheckpointInterval_, settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR,
+                    discreteQ_, discreteR_, discreteRNext_, discreteCostH_);
+                return;
+            }
+
             integrateSensitivities();
             discreteQ_.setZero();
             discreteR_.setZero();
-            integratorCT_->integrateCostSensitivityDX0(discreteQ_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
-            integratorCT_->integrateCostSensitivityDU0(discreteR_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
+            integratorCT_->integrateCostSensitivityDX0(discreteQ_, tStart_, nSteps_, dt_);
+            integratorCT_->integrateCostSensitivityDU0(discreteR_, tStart_, nSteps_, dt_);
 
             if (settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR)
             {
                 discreteRNext_.setZero();
-                integratorCT_->integrateCostSensitivityDUf(discreteRNext_, tStart_, nSteps_, SCALAR(settings_.dt_sim_));
+                integratorCT_->integrateCostSensitivityDUf(discreteRNext_, tStart_, nSteps_, dt_);
             }
+
+            if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+                integratorCT_->integrateCostSensitivityDH(discreteCostH_, tStart_, nSteps_, dt_);
         }
     }
 
+    /**
+	 * @brief      Computes the Hessian of mu^T x(t_f) + omega * (integrated
+	 *             cost) with respect to the shot variables s_i, q_i (and
+	 *             q_{i+1} for piecewise linear controls)
+	 *
+	 * @param[in]  mu     The multiplier on the integrated state
+	 * @param[in]  omega  The multiplier on the integrated cost
+	 *
+	 * @return     The dense Hessian of the shot
+	 */
+    const MatrixXs& integrateLagrangianHessian(const state_vector_t& mu, const SCALAR omega)
+    {
+        integrateSensitivities();
+        integratorCT_->integrateLagrangianHessian(
+            lagrangianHessian_, mu, omega, nSteps_, dt_, settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR);
+        return lagrangianHessian_;
+    }
+
+    /**
+	 * @brief      Returns the indices of the shot variables [s_i, q_i,
+	 *             (q_{i+1})] in the optimization vector
+	 *
+	 * @return     The optimization vector indices
+	 */
+    std::vector<size_t> getHessianIndices() const
+    {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < STATE_DIM; i++)
+            indices.push_back(w_->getStateIndex(shotNr_) + i);
+        for (size_t i = 0; i < CONTROL_DIM; i++)
+            indices.push_back(w_->getControlIndex(shotNr_) + i);
+        if (settings_.splineType_ == DmsSettings::PIECEWISE_LINEAR)
+            for (size_t i = 0; i < CONTROL_DIM; i++)
+                indices.push_back(w_->getControlIndex(shotNr_ + 1) + i);
+        return indices;
+    }
+
+    /**
+	 * @brief      Generates the lower triangular sparsity pattern of a dense
+	 *             Hessian block acting on the given optimization vector indices
+	 *
+	 * @param[in]  indices  The optimization vector indices of the block
+	 * @param[out] iRow     The row indices
+	 * @param[out] jCol     The column indices
+	 */
+    static void genLowerTriangularIndices(const std::vector<size_t>& indices,
+        Eigen::VectorXi& iRow,
+        Eigen::VectorXi& jCol)
+    {
+        const size_t n = indices.size();
+        iRow.resize(n * (n + 1) / 2);
+        jCol.resize(n * (n + 1) / 2);
+        size_t count = 0;
+        for (size_t a = 0; a < n; a++)
+            for (size_t b = 0; b < n; b++)
+                if (indices[a] > indices[b] || (indices[a] == indices[b] && a == b))
+                {
+                    iRow(count) = indices[a];
+                    jCol(count) = indices[b];
+                    count++;
+                }
+    }
+
+    /**
+	 * @brief      Extracts the values of a dense Hessian block in the order of
+	 *             genLowerTriangularIndices()
+	 *
+	 * @param[in]  indices  The optimization vector indices of the block
+	 * @param[in]  hessian  The dense Hessian block
+	 * @param[out] values   The values of the lower triangular part
+	 */
+    template <typename VECTOR>
+    static void getLowerTriangularValues(const std::vector<size_t>& indices, const MatrixXs& hessian, VECTOR& values)
+    {
+        const size_t n = indices.size();
+        values.resize(n * (n + 1) / 2);
+        size_t count = 0;
+        for (size_t a = 0; a < n; a++)
+            for (size_t b = 0; b < n; b++)
+                if (indices[a] > indices[b] || (indices[a] == indices[b] && a == b))
+                    values(count++) = hessian(a, b);
+    }
+
     void reset()
     {
         integratorCT_->clearStates();
@@ -247,10 +372,7 @@ public:
 	 *
 	 * @return     The integrated sensitivity
 	 */
-    // const state_vector_t getdXdHiIntegrated()
-    // {
-    // 	return dXdHi_history_.back();
-    // }
+    const state_vector_t& getdXdHiIntegrated() { return discreteH_; }
 
     /**
 	 * @brief      Gets the full integrated state trajectory.
@@ -312,13 +434,25 @@ public:
 	 *
 	 * @return     The cost gradient
 	 */
-    // const double getdLdHiIntegrated() const
-    // {
-    // 	return costGradientHi_;
-    // }
+    const SCALAR getdLdHiIntegrated() const { return discreteCostH_; }
 
 
 private:
+    /**
+	 * @brief      Updates the start time and the integration step of the
+	 *             shot. With time grid optimization the shot is integrated in
+	 *             normalized time, i.e. with a fixed number of steps whose
+	 *             size scales with the current shot duration h_i
+	 */
+    void updateShotTiming()
+    {
+        tStart_ = timeGrid_->getShotStartTime(shotNr_);
+        if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+            dt_ = timeGrid_->getShotDuration(shotNr_) / SCALAR(nSteps_);
+        else
+            dt_ = SCALAR(settings_.dt_sim_);
+    }
+
     std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>> controlledSystem_;
     std::shared_ptr<ct::core::LinearSystem<STATE_DIM, CONTROL_DIM, SCALAR>> linearSystem_;
     std::shared_ptr<ct::optcon::CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>> costFct_;
@@ -343,16 +477,21 @@ private:
     state_matrix_t discreteA_;
     state_control_matrix_t discreteB_;
     state_control_matrix_t discreteBNext_;
+    state_vector_t discreteH_;
 
     //Cost and cost gradient
     SCALAR cost_;
     state_vector_t discreteQ_;
     control_vector_t discreteR_;
     control_vector_t discreteRNext_;
+    SCALAR discreteCostH_;
+
+    MatrixXs lagrangianHessian_;
 
     std::shared_ptr<SensitivityIntegratorCT<STATE_DIM, CONTROL_DIM, SCALAR>> integratorCT_;
     size_t nSteps_;
     SCALAR tStart_;
+    SCALAR dt_;
 };
 
 }  // namespace optcon
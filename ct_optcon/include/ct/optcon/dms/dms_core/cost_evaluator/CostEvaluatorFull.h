@@ -124,13 +124,9 @@ public:
                         " cost gradient not yet implemented for this type of interpolation. Exiting"));
             }
 
-            // H-part.
-            // if(settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
-            // {
-            // 	costFct_->setCurrentStateAndControl(shotContainers_[shotNr]->getStateIntegrated(),
-            // 										controlSpliner_->evalSpline(shotContainers_[shotNr]->getIntegrationTimeFinal(), shotNr));
-            // 	grad(w_->getTimeSegmentIndex(shotNr)) = costFct_->evaluateIntermediate() + shotContainers_[shotNr]->getdLdHiIntegrated();
-            // }
+            // H-part, the shots are integrated in normalized time
+            if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+                grad(w_->getTimeSegmentIndex(shotNr)) += shotContainers_[shotNr]->getdLdHiIntegrated();
         }
 
         /* gradient of terminal cost */
@@ -139,7 +135,73 @@ public:
             costFct_->stateDerivativeTerminal();  // * dXdSi.back();
     }
 
+    void getSparsityPatternHessian(Eigen::VectorXi& iRow, Eigen::VectorXi& jCol) override
+    {
+        std::vector<Eigen::VectorXi> iRowBlocks(shotContainers_.size() + 1), jColBlocks(shotContainers_.size() + 1);
+        size_t nele = 0;
+        for (size_t shotNr = 0; shotNr < shotContainers_.size(); ++shotNr)
+        {
+            ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>::genLowerTriangularIndices(
+                shotContainers_[shotNr]->getHessianIndices(), iRowBlocks[shotNr], jColBlocks[shotNr]);
+            nele += iRowBlocks[shotNr].rows();
+        }
+
+        ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>::genLowerTriangularIndices(
+            terminalHessianIndices(), iRowBlocks.back(), jColBlocks.back());
+        nele += iRowBlocks.back().rows();
+
+        iRow.resize(nele);
+        jCol.resize(nele);
+        size_t count = 0;
+        for (size_t b = 0; b < iRowBlocks.size(); b++)
+        {
+            iRow.segment(count, iRowBlocks[b].rows()) = iRowBlocks[b];
+            jCol.segment(count, jColBlocks[b].rows()) = jColBlocks[b];
+            count += iRowBlocks[b].rows();
+        }
+    }
+
+    void sparseHessianValues(const Eigen::VectorXd& optVec, const Eigen::VectorXd& lambda, Eigen::VectorXd& hes) override
+    {
+        const SCALAR omega = SCALAR(lambda(0));
+        std::vector<Eigen::VectorXd> hesBlocks(shotContainers_.size() + 1);
+
+#pragma omp parallel for num_threads(settings_.nThreads_)
+        for (size_t shotNr = 0; shotNr < shotContainers_.size(); ++shotNr)
+        {
+            ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>::getLowerTriangularValues(
+                shotContainers_[shotNr]->getHessianIndices(),
+                shotContainers_[shotNr]->integrateLagrangianHessian(state_vector_t::Zero(), omega),
+                hesBlocks[shotNr]);
+        }
+
+        /* hessian of terminal cost */
+        costFct_->setCurrentStateAndControl(w_->getOptimizedState(settings_.N_), control_vector_t::Zero());
+        ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>::getLowerTriangularValues(terminalHessianIndices(),
+            omega * costFct_->stateSecondDerivativeTerminal(), hesBlocks.back());
+
+        size_t nele = 0;
+        for (const auto& block : hesBlocks)
+            nele += block.rows();
+
+        hes.resize(nele);
+        size_t count = 0;
+        for (const auto& block : hesBlocks)
+        {
+            hes.segment(count, block.rows()) = block;
+            count += block.rows();
+        }
+    }
+
 private:
+    std::vector<size_t> terminalHessianIndices() const
+    {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < STATE_DIM; i++)
+            indices.push_back(w_->getStateIndex(settings_.N_) + i);
+        return indices;
+    }
+
     std::shared_ptr<ct::optcon::CostFunctionQuadratic<STATE_DIM, CONTROL_DIM, SCALAR>> costFct_;
     std::shared_ptr<OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>> w_;
     std::shared_ptr<SplinerBase<control_vector_t, SCALAR>> controlSpliner_;
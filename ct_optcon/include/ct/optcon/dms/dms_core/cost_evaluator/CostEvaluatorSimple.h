@@ -12,6 +12,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <ct/optcon/costfunction/CostFunctionQuadratic.hpp>
 
 #include <ct/optcon/dms/dms_core/OptVectorDms.h>
+#include <ct/optcon/dms/dms_core/ShotContainer.h>
 #include <ct/optcon/dms/dms_core/spline/SplinerBase.h>
 #include <ct/optcon/nlp/DiscreteCostEvaluatorBase.h>
 
@@ -40,6 +41,8 @@ public:
     typedef typename DIMENSIONS::state_vector_t state_vector_t;
     typedef typename DIMENSIONS::control_vector_t control_vector_t;
 
+    typedef Eigen::Matrix<SCALAR, STATE_DIM + CONTROL_DIM, STATE_DIM + CONTROL_DIM> node_hessian_t;
+
     CostEvaluatorSimple() = delete;
 
     /**
@@ -66,7 +69,21 @@ public:
 
     void evalGradient(size_t grad_length, Eigen::Map<Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>>& grad) override;
 
+    void getSparsityPatternHessian(Eigen::VectorXi& iRow, Eigen::VectorXi& jCol) override;
+
+    void sparseHessianValues(const Eigen::VectorXd& optVec, const Eigen::VectorXd& lambda, Eigen::VectorXd& hes) override;
+
 private:
+    /**
+   * @brief      Returns the optimization vector indices of the state-control
+   *             pair at a node
+   *
+   * @param[in]  pairNum  The node number
+   *
+   * @return     The indices of [s_i, q_i]
+   */
+    std::vector<size_t> nodeHessianIndices(const size_t pairNum) const;
+
     /**
    * @brief      Updates the weights for the cost interpolation
    */
@@ -84,7 +101,9 @@ private:
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 SCALAR CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::eval()
 {
-    // updatePhi();
+    if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+        updatePhi();
+
     SCALAR cost = SCALAR(0.0);
 
     for (size_t i = 0; i < settings_.N_ + 1; ++i)
@@ -105,7 +124,10 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::evalGradient(size_t grad_length,
     Eigen::Map<Eigen::Matrix<SCALAR, Eigen::Dynamic, 1>>& grad)
 {
-    // updatePhi();
+    const bool optimizeGrid = (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID);
+    if (optimizeGrid)
+        updatePhi();
+
     grad.setZero();
     for (size_t i = 0; i < settings_.N_ + 1; ++i)
     {
@@ -113,6 +135,31 @@ void CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::evalGradient(size_t gr
             w_->getOptimizedState(i), w_->getOptimizedControl(i), timeGrid_->getShotStartTime(i));
         grad.segment(w_->getStateIndex(i), STATE_DIM) += phi_(i) * costFct_->stateDerivativeIntermediate();
         grad.segment(w_->getControlIndex(i), CONTROL_DIM) += phi_(i) * costFct_->controlDerivativeIntermediate();
+
+        // derivative of the summation weights w.r.t. the adjacent time segments
+        if (optimizeGrid)
+        {
+            const SCALAR l_i = costFct_->evaluateIntermediate();
+            switch (settings_.splineType_)
+            {
+                case DmsSettings::ZERO_ORDER_HOLD:
+                {
+                    if (i < settings_.N_)
+                        grad(w_->getTimeSegmentIndex(i)) += l_i;
+                    break;
+                }
+                case DmsSettings::PIECEWISE_LINEAR:
+                {
+                    if (i > 0)
+                        grad(w_->getTimeSegmentIndex(i - 1)) += SCALAR(0.5) * l_i;
+                    if (i < settings_.N_)
+                        grad(w_->getTimeSegmentIndex(i)) += SCALAR(0.5) * l_i;
+                    break;
+                }
+                default:
+                    throw(std::runtime_error(" ERROR: Unknown spline-type in CostEvaluatorSimple - exiting."));
+            }
+        }
     }
 
     /* gradient of terminal cost */
@@ -121,6 +168,82 @@ void CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::evalGradient(size_t gr
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::getSparsityPatternHessian(Eigen::VectorXi& iRow,
+    Eigen::VectorXi& jCol)
+{
+    const size_t nNode = (STATE_DIM + CONTROL_DIM) * (STATE_DIM + CONTROL_DIM + 1) / 2;
+    const size_t nTerminal = STATE_DIM * (STATE_DIM + 1) / 2;
+    iRow.resize((settings_.N_ + 1) * nNode + nTerminal);
+    jCol.resize((settings_.N_ + 1) * nNode + nTerminal);
+
+    Eigen::VectorXi iRowBlock, jColBlock;
+    for (size_t i = 0; i < settings_.N_ + 1; ++i)
+    {
+        ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>::genLowerTriangularIndices(
+            nodeHessianIndices(i), iRowBlock, jColBlock);
+        iRow.segment(i * nNode, nNode) = iRowBlock;
+        jCol.segment(i * nNode, nNode) = jColBlock;
+    }
+
+    std::vector<size_t> terminalIndices(nodeHessianIndices(settings_.N_));
+    terminalIndices.resize(STATE_DIM);
+    ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>::genLowerTriangularIndices(terminalIndices, iRowBlock, jColBlock);
+    iRow.tail(nTerminal) = iRowBlock;
+    jCol.tail(nTerminal) = jColBlock;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::sparseHessianValues(const Eigen::VectorXd& optVec,
+    const Eigen::VectorXd& lambda,
+    Eigen::VectorXd& hes)
+{
+    const SCALAR omega = SCALAR(lambda(0));
+    const size_t nNode = (STATE_DIM + CONTROL_DIM) * (STATE_DIM + CONTROL_DIM + 1) / 2;
+    const size_t nTerminal = STATE_DIM * (STATE_DIM + 1) / 2;
+    hes.resize((settings_.N_ + 1) * nNode + nTerminal);
+
+    Eigen::VectorXd hesBlock;
+    node_hessian_t nodeHessian;
+    for (size_t i = 0; i < settings_.N_ + 1; ++i)
+    {
+        costFct_->setCurrentStateAndControl(
+            w_->getOptimizedState(i), w_->getOptimizedControl(i), timeGrid_->getShotStartTime(i));
+        nodeHessian.template topLeftCorner<STATE_DIM, STATE_DIM>() = costFct_->stateSecondDerivativeIntermediate();
+        nodeHessian.template bottomRightCorner<CONTROL_DIM, CONTROL_DIM>() =
+            costFct_->controlSecondDerivativeIntermediate();
+        nodeHessian.template bottomLeftCorner<CONTROL_DIM, STATE_DIM>() = costFct_->stateControlDerivativeIntermediate();
+        nodeHessian.template topRightCorner<STATE_DIM, CONTROL_DIM>() =
+            nodeHessian.template bottomLeftCorner<CONTROL_DIM, STATE_DIM>().transpose();
+
+        ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>::getLowerTriangularValues(
+            nodeHessianIndices(i), (omega * phi_(i)) * nodeHessian, hesBlock);
+        hes.segment(i * nNode, nNode) = hesBlock;
+    }
+
+    /* hessian of terminal cost */
+    std::vector<size_t> terminalIndices(nodeHessianIndices(settings_.N_));
+    terminalIndices.resize(STATE_DIM);
+    costFct_->setCurrentStateAndControl(w_->getOptimizedState(settings_.N_), control_vector_t::Zero());
+    ShotContainer<STATE_DIM, CONTROL_DIM, SCALAR>::getLowerTriangularValues(
+        terminalIndices, omega * costFct_->stateSecondDerivativeTerminal(), hesBlock);
+    hes.tail(nTerminal) = hesBlock;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+std::vector<size_t> CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::nodeHessianIndices(const size_t pairNum) const
+{
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < STATE_DIM; i++)
+        indices.push_back(w_->getStateIndex(pairNum) + i);
+    for (size_t i = 0; i < CONTROL_DIM; i++)
+        indices.push_back(w_->getControlIndex(pairNum) + i);
+    return indices;
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::updatePhi()
 {
@@ -141,7 +264,7 @@ void CostEvaluatorSimple<STATE_DIM, CONTROL_DIM, SCALAR>::updatePhi()
             for (size_t i = 1; i < settings_.N_; i++)
                 phi_(i) = SCALAR(0.5) * (timeGrid_->getShotEndTime(i) - timeGrid_->getShotStartTime(i - 1));
 
-            phi_(settings_.N_) = SCALAR(0.5) * (timeGrid_->getShotDuration(settings_.N_));
+            phi_(settings_.N_) = SCALAR(0.5) * (timeGrid_->getShotDuration(settings_.N_ - 1));
             break;
         }
         default:
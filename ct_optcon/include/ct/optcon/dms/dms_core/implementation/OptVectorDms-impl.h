@@ -22,6 +22,16 @@ OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::OptVectorDms(size_t n, const DmsSe
     }
     stateSolution_.resize(numPairs_);
     inputSolution_.resize(numPairs_);
+
+    // the time segments are appended to the state-control pairs, bounded from below by h_min
+    timeSegmentStartIdx_ = currIndex;
+    if (settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID)
+    {
+        this->xLb_.segment(timeSegmentStartIdx_, settings_.N_).setConstant(SCALAR(settings_.h_min_));
+        this->xUb_.segment(timeSegmentStartIdx_, settings_.N_).setConstant(SCALAR(settings_.T_));
+        this->xInit_.segment(timeSegmentStartIdx_, settings_.N_).setConstant(SCALAR(settings_.T_ / settings_.N_));
+        this->x_.segment(timeSegmentStartIdx_, settings_.N_) = this->xInit_.segment(timeSegmentStartIdx_, settings_.N_);
+    }
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -75,6 +85,19 @@ size_t OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::getControlIndex(const size_
     return pairNumToControlIdx_.find(pairNum)->second;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+size_t OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::getTimeSegmentIndex(const size_t shotNr) const
+{
+    assert(settings_.objectiveType_ == DmsSettings::OPTIMIZE_GRID);
+    return timeSegmentStartIdx_ + shotNr;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::getOptimizedTimeSegments() const
+{
+    return this->x_.segment(timeSegmentStartIdx_, settings_.N_);
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void OptVectorDms<STATE_DIM, CONTROL_DIM, SCALAR>::changeInitialState(const state_vector_t& x0)
 {
@@ -18,7 +18,11 @@ CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::CTSystemModel(
       constantController_(new ct::core::ConstantController<STATE_DIM, CONTROL_DIM, SCALAR>()),
       sensApprox_(sensApprox),
       dFdv_(dFdv),
-      integrator_(system_, intType)
+      integrator_(system_, intType),
+      intType_(intType),
+      batchGeneration_(0),
+      batchPending_(0),
+      batchShutdown_(false)
 {
     if (!system_)
         throw std::runtime_error("CTSystemModel: System not initialized!");
@@ -27,6 +31,12 @@ CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::CTSystemModel(
     system_->setController(constantController_);
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::~CTSystemModel()
+{
+    stopBatchWorkers();
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 auto CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDynamics(const state_vector_t& state,
     const control_vector_t& u,
@@ -39,6 +49,161 @@ auto CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDynamics(const state_
     return x;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDynamicsBatch(Eigen::Ref<state_batch_t> states,
+    const control_vector_t& u,
+    const Time_t dt,
+    Time_t t)
+{
+    const bool supported = intType_ == ct::core::IntegrationType::EULER ||
+                           intType_ == ct::core::IntegrationType::EULERCT ||
+                           intType_ == ct::core::IntegrationType::RK4 || intType_ == ct::core::IntegrationType::RK4CT;
+    if (!supported)
+    {
+        Base::computeDynamicsBatch(states, u, dt, t);
+        return;
+    }
+
+    if (batchWorkers_.empty() || states.cols() <= 1)
+    {
+        integrateBatch(*system_, states, u, dt, t);
+        return;
+    }
+
+    // hand the batch over to the workers, the calling thread takes the first block
+    {
+        std::unique_lock<std::mutex> lock(batchMutex_);
+        batchStates_ = &states;
+        batchControl_ = &u;
+        batchDt_ = dt;
+        batchT_ = t;
+        batchBlockSize_ = (states.cols() + batchWorkers_.size()) / (batchWorkers_.size() + 1);
+        batchPending_ = batchWorkers_.size();
+        batchGeneration_++;
+    }
+    batchWakeUp_.notify_all();
+
+    integrateBatchBlock(0);
+
+    std::unique_lock<std::mutex> lock(batchMutex_);
+    batchDone_.wait(lock, [this]() { return batchPending_ == 0; });
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::setNumBatchThreads(size_t nThreads)
+{
+    stopBatchWorkers();
+
+    batchSystems_.clear();
+    for (size_t i = 1; i < nThreads; i++)
+        batchSystems_.push_back(std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>>(
+            system_->clone()));
+
+    batchShutdown_ = false;
+    for (size_t i = 1; i < nThreads; i++)
+        batchWorkers_.push_back(std::thread(&CTSystemModel::batchWorker, this, i, batchGeneration_));
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::stopBatchWorkers()
+{
+    {
+        std::unique_lock<std::mutex> lock(batchMutex_);
+        batchShutdown_ = true;
+    }
+    batchWakeUp_.notify_all();
+
+    for (auto& worker : batchWorkers_)
+        worker.join();
+    batchWorkers_.clear();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::batchWorker(size_t workerId, size_t generation)
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(batchMutex_);
+            batchWakeUp_.wait(lock, [&]() { return batchShutdown_ || batchGeneration_ != generation; });
+            if (batchShutdown_)
+                return;
+            generation = batchGeneration_;
+        }
+
+        integrateBatchBlock(workerId);
+
+        std::unique_lock<std::mutex> lock(batchMutex_);
+        if (--batchPending_ == 0)
+            batchDone_.notify_one();
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::integrateBatchBlock(size_t threadId)
+{
+    Eigen::Ref<state_batch_t>& states = *batchStates_;
+    const Eigen::Index start = threadId * batchBlockSize_;
+    const Eigen::Index size = std::min(batchBlockSize_, states.cols() - start);
+    if (size <= 0)
+        return;
+
+    ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>& system =
+        threadId == 0 ? *system_ : *batchSystems_[threadId - 1];
+    integrateBatch(system, states.middleCols(start, size), *batchControl_, batchDt_, batchT_);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+bool CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::integrateBatch(
+    ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>& system,
+    Eigen::Ref<state_batch_t> states,
+    const control_vector_t& u,
+    const Time_t dt,
+    const Time_t t)
+{
+    const Eigen::Index nStates = states.cols();
+    ct::core::StateVector<STATE_DIM, SCALAR> x;
+    ct::core::StateVector<STATE_DIM, SCALAR> dxdt;
+
+    // evaluate the dynamics for all states of the batch at time tau
+    auto evaluate = [&](const auto& X, const Time_t tau, state_batch_t& dXdt) {
+        for (Eigen::Index i = 0; i < nStates; i++)
+        {
+            x = X.col(i);
+            system.computeControlledDynamics(x, tau, u, dxdt);
+            dXdt.col(i) = dxdt;
+        }
+    };
+
+    state_batch_t K1(STATE_DIM, nStates);
+
+    switch (intType_)
+    {
+        case ct::core::IntegrationType::EULER:
+        case ct::core::IntegrationType::EULERCT:
+        {
+            evaluate(states, t, K1);
+            states += dt * K1;
+            return true;
+        }
+        case ct::core::IntegrationType::RK4:
+        case ct::core::IntegrationType::RK4CT:
+        {
+            const Time_t dt_half = dt / Time_t(2);
+            state_batch_t K2(STATE_DIM, nStates), K3(STATE_DIM, nStates), K4(STATE_DIM, nStates);
+
+            evaluate(states, t, K1);
+            evaluate(states + dt_half * K1, t + dt_half, K2);
+            evaluate(states + dt_half * K2, t + dt_half, K3);
+            evaluate(states + dt * K3, t + dt, K4);
+            states += (dt / Time_t(6)) * (K1 + Time_t(2) * (K2 + K3) + K4);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 auto CTSystemModel<STATE_DIM, CONTROL_DIM, SCALAR>::computeDerivativeState(const state_vector_t& state,
     const control_vector_t& u,
@@ -5,6 +5,10 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "SystemModelBase.h"
 
 namespace ct {
@@ -17,6 +21,11 @@ namespace optcon {
  *        but also computes derivatives w.r.t. both state and noise. When propagating the system, CTSystemModel does not
  *        use the specified control input, but uses the assigned system controller instead.
  *
+ *        A batch of states, e.g. the sigma points of an unscented filter, is propagated together for the fixed-step
+ *        integration types (Euler and RK4). The stages of the integration step are then computed for all states at
+ *        once in a contiguous STATE_DIM x N layout, and the work can be split across persistent worker threads. Other
+ *        integration types fall back to propagating the states one by one.
+ *
  * \todo   this needs to get unified with the system-interface from optcon
  *
  * @tparam STATE_DIM
@@ -32,6 +41,7 @@ public:
     using typename Base::control_vector_t;
     using typename Base::state_matrix_t;
     using typename Base::state_vector_t;
+    using typename Base::state_batch_t;
     using typename Base::Time_t;
 
     using SensitivityApprox_t =
@@ -43,12 +53,28 @@ public:
         const state_matrix_t& dFdv,
         const ct::core::IntegrationType& intType = ct::core::IntegrationType::EULERCT);
 
+    //! Destructor, stops the batch worker threads.
+    ~CTSystemModel();
+
     //! Propagates the system giving the next state as output. Control input is generated by the system controller.
     state_vector_t computeDynamics(const state_vector_t& state,
         const control_vector_t& u,
         const Time_t dt,
         Time_t t) override;
 
+    //! Propagates a batch of states, stored column-wise, with the control input u.
+    void computeDynamicsBatch(Eigen::Ref<state_batch_t> states,
+        const control_vector_t& u,
+        const Time_t dt,
+        Time_t t) override;
+
+    //! Set the number of threads used by computeDynamicsBatch(), the default is 1.
+    /*!
+     * The calling thread takes part in the work, each additional worker thread works on its own clone of the system.
+     * Threads are only worth their synchronization overhead for large batches or expensive dynamics.
+     */
+    void setNumBatchThreads(size_t nThreads);
+
     //! Computes the derivative w.r.t state. Control input is generated by the system controller.
     state_matrix_t computeDerivativeState(const state_vector_t& state,
         const control_vector_t& u,
@@ -76,6 +102,45 @@ protected:
 
     //! Integrator.
     ct::core::Integrator<STATE_DIM, SCALAR> integrator_;
+
+    //! Integration type.
+    ct::core::IntegrationType intType_;
+
+    //! Additional system instances for the worker threads of the batch propagation.
+    std::vector<std::shared_ptr<ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>>> batchSystems_;
+
+private:
+    //! stop and join the batch worker threads
+    void stopBatchWorkers();
+
+    //! main loop of a batch worker thread, waits for batches after the given generation
+    void batchWorker(size_t workerId, size_t generation);
+
+    //! propagate the block of the current batch assigned to a thread, thread 0 is the calling thread
+    void integrateBatchBlock(size_t threadId);
+
+    //! batch worker threads and their synchronization
+    std::vector<std::thread> batchWorkers_;
+    std::mutex batchMutex_;
+    std::condition_variable batchWakeUp_;
+    std::condition_variable batchDone_;
+    size_t batchGeneration_;
+    size_t batchPending_;
+    bool batchShutdown_;
+
+    //! the batch currently being propagated
+    Eigen::Ref<state_batch_t>* batchStates_;
+    const control_vector_t* batchControl_;
+    Time_t batchDt_;
+    Time_t batchT_;
+    Eigen::Index batchBlockSize_;
+
+    //! one fixed-step integration step for a block of states, returns false if the integration type is not supported
+    bool integrateBatch(ct::core::ControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR>& system,
+        Eigen::Ref<state_batch_t> states,
+        const control_vector_t& u,
+        const Time_t dt,
+        const Time_t t);
 };
 
 }  // namespace optcon
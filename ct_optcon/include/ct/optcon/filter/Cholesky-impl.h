@@ -0,0 +1,95 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <typename _MatrixType, int _UpLo>
+Cholesky<_MatrixType, _UpLo>::Cholesky() : Eigen::LLT<_MatrixType, _UpLo>()
+{
+}
+
+template <typename _MatrixType, int _UpLo>
+Cholesky<_MatrixType, _UpLo>::Cholesky(const _MatrixType& m) : Eigen::LLT<_MatrixType, _UpLo>(m)
+{
+}
+
+template <typename _MatrixType, int _UpLo>
+Cholesky<_MatrixType, _UpLo>& Cholesky<_MatrixType, _UpLo>::setIdentity()
+{
+    this->m_matrix.setIdentity();
+    this->m_isInitialized = true;
+    return *this;
+}
+
+template <typename _MatrixType, int _UpLo>
+bool Cholesky<_MatrixType, _UpLo>::isIdentity() const
+{
+    eigen_assert(this->m_isInitialized && "LLT is not initialized.");
+    return this->m_matrix.isIdentity();
+}
+
+template <typename _MatrixType, int _UpLo>
+template <typename Derived>
+Cholesky<_MatrixType, _UpLo>& Cholesky<_MatrixType, _UpLo>::setL(const Eigen::MatrixBase<Derived>& matrix)
+{
+    this->m_matrix = matrix.template triangularView<Eigen::Lower>();
+    this->m_isInitialized = true;
+    return *this;
+}
+
+template <typename _MatrixType, int _UpLo>
+template <typename Derived>
+Cholesky<_MatrixType, _UpLo>& Cholesky<_MatrixType, _UpLo>::setU(const Eigen::MatrixBase<Derived>& matrix)
+{
+    this->m_matrix = matrix.template triangularView<Eigen::Upper>().adjoint();
+    this->m_isInitialized = true;
+    return *this;
+}
+
+template <typename _MatrixType, int _UpLo>
+template <typename Derived>
+Cholesky<_MatrixType, _UpLo>& Cholesky<_MatrixType, _UpLo>::setFromSquareRoot(const Eigen::MatrixBase<Derived>& A)
+{
+    static_assert(_UpLo == Eigen::Lower, "Cholesky::setFromSquareRoot is only available for the lower form.");
+
+    // A^T = Q R implies A A^T = R^T R
+    typedef Eigen::Matrix<typename Derived::Scalar, Derived::ColsAtCompileTime, Derived::RowsAtCompileTime> At_t;
+    Eigen::HouseholderQR<At_t> qr(A.transpose());
+
+    const Eigen::Index n = A.rows();
+    this->m_matrix = qr.matrixQR().topRows(n).template triangularView<Eigen::Upper>().transpose();
+
+    // make the diagonal non-negative, flipping the sign of a column does not change L L^T
+    for (Eigen::Index i = 0; i < n; i++)
+        if (this->m_matrix(i, i) < 0)
+            this->m_matrix.col(i) *= -1;
+
+    this->m_isInitialized = true;
+    this->m_info = Eigen::Success;
+    return *this;
+}
+
+template <typename _MatrixType, int _UpLo>
+Cholesky<_MatrixType, _UpLo>& Cholesky<_MatrixType, _UpLo>::computeSemidefinite(const _MatrixType& m)
+{
+    static_assert(_UpLo == Eigen::Lower, "Cholesky::computeSemidefinite is only available for the lower form.");
+
+    this->compute(m);
+    if (this->info() == Eigen::Success)
+        return *this;
+
+    // m = P^T L D L^T P, hence P^T L sqrt(D) is a square root of m
+    Eigen::LDLT<_MatrixType> ldlt(m);
+    _MatrixType A = ldlt.matrixL();
+    A = ldlt.transpositionsP().transpose() * A;
+    A *= ldlt.vectorD().cwiseMax(0).cwiseSqrt().asDiagonal();
+    return setFromSquareRoot(A);
+}
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,71 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \ingroup Filter
+ *
+ * \brief Cholesky square root decomposition of a symmetric positive-definite matrix.
+ *
+ * Besides the factorization of a given matrix, the decomposition can be obtained directly from a (non-triangular)
+ * square root of the matrix, which is the basic operation of square-root filters, and be modified by rank-one updates
+ * through Eigen::LLT::rankUpdate().
+ *
+ * @tparam MatrixType The matrix type
+ * @tparam UpLo Square root form (Eigen::Lower or Eigen::Upper)
+ */
+template <typename MatrixType, int UpLo = Eigen::Lower>
+class Cholesky : public Eigen::LLT<MatrixType, UpLo>
+{
+public:
+    //! Constructor.
+    Cholesky();
+    //! Construct cholesky square root decomposition from matrix
+    Cholesky(const MatrixType& m);
+    //! Set decomposition to identity
+    Cholesky& setIdentity();
+
+    //! Check whether the decomposed matrix is the identity matrix
+    bool isIdentity() const;
+
+    /*!
+     * \brief Set lower triangular part of the decomposition
+     * @param matrix The lower part stored in a full matrix
+     */
+    template <typename Derived>
+    Cholesky& setL(const Eigen::MatrixBase<Derived>& matrix);
+
+    /*!
+     * \brief Set upper triangular part of the decomposition
+     * @param matrix The upper part stored in a full matrix
+     */
+    template <typename Derived>
+    Cholesky& setU(const Eigen::MatrixBase<Derived>& matrix);
+
+    /*!
+     * \brief Set the decomposition of A * A^T from the rectangular square root A
+     *
+     * The triangular factor is obtained from a QR decomposition of A^T, without forming A * A^T. Only available for
+     * the lower triangular form.
+     * @param A square root with at least as many columns as rows
+     */
+    template <typename Derived>
+    Cholesky& setFromSquareRoot(const Eigen::MatrixBase<Derived>& A);
+
+    /*!
+     * \brief Decompose a symmetric positive semi-definite matrix
+     *
+     * Falls back to a LDLT decomposition if the matrix is singular, such that for example zero covariances can be
+     * decomposed. Only available for the lower triangular form.
+     */
+    Cholesky& computeSemidefinite(const MatrixType& m);
+};
+
+}  // namespace optcon
+}  // namespace ct
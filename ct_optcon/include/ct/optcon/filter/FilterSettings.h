@@ -7,6 +7,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <boost/property_tree/info_parser.hpp>
 
+#include "../lqr/riccati/DARE.hpp"
+
 namespace ct {
 namespace optcon {
 
@@ -89,9 +91,10 @@ struct SteadyStateKalmanFilterSettings
 {
     ct::core::StateVector<STATE_DIM> x0; /*!< Initial state estimate. */
     size_t maxDAREIterations;            /*!< Max number of iteration for solving DARE. */
+    DARESolverType dareSolverType;       /*!< Algorithm for solving the DARE. */
 
     //! default constructor
-    SteadyStateKalmanFilterSettings() : maxDAREIterations(1000u) {}
+    SteadyStateKalmanFilterSettings() : maxDAREIterations(1000u), dareSolverType(FIXED_POINT_ITERATION) {}
     //! print the current settings
     void print() const
     {
@@ -99,6 +102,7 @@ struct SteadyStateKalmanFilterSettings
         std::cout << "=====================" << std::endl;
         std::cout << "x0:\n" << x0 << std::endl;
         std::cout << "maxDAREIterations:\t" << maxDAREIterations << std::endl;
+        std::cout << "dareSolverType:\t" << dareSolverType << std::endl;
         std::cout << "              =======" << std::endl;
         std::cout << std::endl;
     }
@@ -113,6 +117,7 @@ struct SteadyStateKalmanFilterSettings
         boost::property_tree::read_info(filename, pt);
 
         maxDAREIterations = pt.get<size_t>(ns + ".maxDAREIterations", 1000);
+        dareSolverType = static_cast<DARESolverType>(pt.get<int>(ns + ".dareSolverType", FIXED_POINT_ITERATION));
         ct::core::loadMatrix(filename, "x0", x0, ns);
 
         if (verbose)
@@ -0,0 +1,113 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+InformationFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::InformationFilter(
+    std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+    std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+    const state_matrix_t& Q,
+    const output_matrix_t& R,
+    const state_vector_t& x0,
+    const state_matrix_t& P0)
+    : Base(f, h, x0), Q_(Q), R_(R)
+{
+    Eigen::LLT<Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM>> llt(P0);
+    if (llt.info() != Eigen::Success)
+        throw std::runtime_error("InformationFilter : initial covariance needs to be positive definite.");
+    Y_ = llt.solve(state_matrix_t::Identity());
+
+    // mark the cached measurement noise as invalid
+    R_meas_.setConstant(std::numeric_limits<SCALAR>::quiet_NaN());
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto InformationFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::predict(const control_vector_t& u,
+    const ct::core::Time& dt,
+    const ct::core::Time& t) -> const state_vector_t&
+{
+    // STEP 1 - compute information matrix prediction
+
+    // the system is linearized at the current control input, but using the state estimate from the previous timestep.
+    state_matrix_t dFdx = this->f_->computeDerivativeState(this->x_est_, u, dt, t);
+    state_matrix_t dFdv = this->f_->computeDerivativeNoise(this->x_est_, u, dt, t);
+
+    // the prediction is additive in covariance form
+    const state_matrix_t& P = getCovarianceMatrix();
+    state_matrix_t P_pred = (dFdx * P * dFdx.transpose()) + dFdv * (dt * Q_) * dFdv.transpose();
+
+    Eigen::LLT<Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM>> llt(P_pred);
+    if (llt.info() != Eigen::Success)
+        throw std::runtime_error("InformationFilter : predicted covariance is not positive definite.");
+    Y_ = llt.solve(state_matrix_t::Identity());
+
+    // STEP 2 - compute state prediction (based on last state esimate but current control input)
+
+    this->x_est_ = this->f_->computeDynamics(this->x_est_, u, dt, t);
+
+    return this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto InformationFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::update(const output_vector_t& y,
+    const ct::core::Time& dt,
+    const ct::core::Time& t) -> const state_vector_t&
+{
+    ct::core::OutputStateMatrix<OUTPUT_DIM, STATE_DIM, SCALAR> dHdx = this->h_->computeDerivativeState(this->x_est_, t);
+    output_matrix_t dHdw = this->h_->computeDerivativeNoise(this->x_est_, t);
+
+    // STEP 1 - inverse measurement noise covariance, only refactorized if it changed
+    output_matrix_t R_meas = dHdw * R_ * dHdw.transpose();
+    if (!(R_meas.array() == R_meas_.array()).all())
+    {
+        Eigen::LLT<Eigen::Matrix<SCALAR, OUTPUT_DIM, OUTPUT_DIM>> llt(R_meas);
+        if (llt.info() != Eigen::Success)
+            throw std::runtime_error("InformationFilter : measurement noise covariance is not positive definite.");
+        R_meas_ = R_meas;
+        R_meas_inv_ = llt.solve(output_matrix_t::Identity());
+    }
+
+    // STEP 2 - information matrix correction
+    const Eigen::Matrix<SCALAR, STATE_DIM, OUTPUT_DIM> HtRinv = dHdx.transpose() * R_meas_inv_;
+    Y_.noalias() += HtRinv * dHdx;
+
+    // STEP 3 - state estimate correction, x += Y^-1 * H^T * R^-1 * (y - h(x))
+    Eigen::LLT<Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM>> llt(Y_);
+    if (llt.info() != Eigen::Success)
+        throw std::runtime_error("InformationFilter : information matrix is not positive definite.");
+    this->x_est_ += llt.solve(HtRinv * (y - this->h_->computeMeasurement(this->x_est_)));
+
+    return this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto InformationFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::getCovarianceMatrix() -> const state_matrix_t&
+{
+    Eigen::LLT<Eigen::Matrix<SCALAR, STATE_DIM, STATE_DIM>> llt(Y_);
+    if (llt.info() != Eigen::Success)
+        throw std::runtime_error("InformationFilter : information matrix is not positive definite.");
+    P_ = llt.solve(state_matrix_t::Identity());
+    return P_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto InformationFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::getInformationMatrix() const
+    -> const state_matrix_t&
+{
+    return Y_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void InformationFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setInformationMatrix(const state_matrix_t& Y)
+{
+    Y_ = Y;
+}
+
+}  // namespace optcon
+}  // namespace ct
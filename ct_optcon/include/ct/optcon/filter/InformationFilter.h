@@ -0,0 +1,89 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "EstimatorBase.h"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \ingroup Filter
+ *
+ * \brief Extended Information Filter.
+ *
+ * Extended Kalman Filter in information form, which propagates the information matrix Y = P^-1 instead of the
+ * covariance P. The measurement update is additive in information form,
+ * \f$ Y^+ = Y + H^T R^{-1} H \f$, such that the cost of an update is linear in the number of outputs apart from the
+ * inverse of the measurement noise covariance, which is only recomputed when dHdw * R * dHdw^T changes. The filter is
+ * hence best suited for measurement models with many outputs, while the prediction requires a factorization of the
+ * (small) information matrix.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR = double>
+class InformationFilter final : public EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using Base = EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>;
+    using typename Base::control_vector_t;
+    using typename Base::output_matrix_t;
+    using typename Base::output_vector_t;
+    using typename Base::state_matrix_t;
+    using typename Base::state_vector_t;
+
+    //! Constructor.
+    /*!
+     * @param P0 initial covariance, needs to be positive definite
+     */
+    InformationFilter(std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+        std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+        const state_matrix_t& Q,
+        const output_matrix_t& R,
+        const state_vector_t& x0,
+        const state_matrix_t& P0);
+
+    //! Estimator predict method.
+    const state_vector_t& predict(const control_vector_t& u,
+        const ct::core::Time& dt,
+        const ct::core::Time& t) override;
+
+    //! Estimator update method.
+    const state_vector_t& update(const output_vector_t& y, const ct::core::Time& dt, const ct::core::Time& t) override;
+
+    //! return current covariance matrix, computed from the information matrix
+    const state_matrix_t& getCovarianceMatrix();
+
+    //! return current information matrix
+    const state_matrix_t& getInformationMatrix() const;
+
+    //! set the information matrix, may be semi-definite if followed by an update
+    void setInformationMatrix(const state_matrix_t& Y);
+
+    //! update Q matrix
+    void setQ(const state_matrix_t& Q) { Q_ = Q; }
+    //! update R matrix
+    void setR(const output_matrix_t& R) { R_ = R; }
+protected:
+    //! Filter Q matrix.
+    state_matrix_t Q_;
+
+    //! Filter R matrix.
+    output_matrix_t R_;
+
+    //! Information matrix.
+    state_matrix_t Y_;
+
+    //! Covariance estimate, only computed on request.
+    state_matrix_t P_;
+
+    //! Measurement noise covariance dHdw * R * dHdw^T of the last update and its inverse.
+    output_matrix_t R_meas_;
+    output_matrix_t R_meas_inv_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,119 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+SquareRootExtendedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::SquareRootExtendedKalmanFilter(
+    std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+    std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+    const state_matrix_t& Q,
+    const output_matrix_t& R,
+    const state_vector_t& x0,
+    const state_matrix_t& P0)
+    : Base(f, h, x0)
+{
+    setQ(Q);
+    setR(R);
+    setCovarianceMatrix(P0);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootExtendedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::predict(const control_vector_t& u,
+    const ct::core::Time& dt,
+    const ct::core::Time& t) -> const state_vector_t&
+{
+    // STEP 1 - compute covariance square root prediction
+
+    // the system is linearized at the current control input, but using the state estimate from the previous timestep.
+    state_matrix_t dFdx = this->f_->computeDerivativeState(this->x_est_, u, dt, t);
+    state_matrix_t dFdv = this->f_->computeDerivativeNoise(this->x_est_, u, dt, t);
+
+    // [dFdx * S, dFdv * sqrt(dt * Q)] is a square root of dFdx * P * dFdx^T + dFdv * (dt * Q) * dFdv^T
+    Eigen::Matrix<SCALAR, STATE_DIM, 2 * STATE_DIM> A;
+    A.template leftCols<STATE_DIM>().noalias() = dFdx * S_.matrixL();
+    A.template rightCols<STATE_DIM>().noalias() = std::sqrt(SCALAR(dt)) * dFdv * S_Q_.matrixL();
+    S_.setFromSquareRoot(A);
+
+    // STEP 2 - compute state prediction (based on last state esimate but current control input)
+
+    this->x_est_ = this->f_->computeDynamics(this->x_est_, u, dt, t);
+
+    return this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootExtendedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::update(const output_vector_t& y,
+    const ct::core::Time& dt,
+    const ct::core::Time& t) -> const state_vector_t&
+{
+    // STEP 1 - compute residual convariances
+    ct::core::OutputStateMatrix<OUTPUT_DIM, STATE_DIM, SCALAR> dHdx = this->h_->computeDerivativeState(this->x_est_, t);
+    output_matrix_t dHdw = this->h_->computeDerivativeNoise(this->x_est_, t);
+
+    // STEP 2 - triangularize the pre-array [S_R, dHdx * S; 0, S] to the post-array [S_e, 0; K_bar, S_new], where
+    // S_e is the square root of the innovation covariance and K_bar = K * S_e
+    Eigen::Matrix<SCALAR, OUTPUT_DIM + STATE_DIM, OUTPUT_DIM + STATE_DIM> A;
+    A.template topLeftCorner<OUTPUT_DIM, OUTPUT_DIM>().noalias() = dHdw * S_R_.matrixL();
+    A.template topRightCorner<OUTPUT_DIM, STATE_DIM>().noalias() = dHdx * S_.matrixL();
+    A.template bottomLeftCorner<STATE_DIM, OUTPUT_DIM>().setZero();
+    A.template bottomRightCorner<STATE_DIM, STATE_DIM>() = S_.matrixL();
+
+    CovarianceSquareRoot<OUTPUT_DIM + STATE_DIM> post;
+    post.setFromSquareRoot(A);
+    const auto& L = post.matrixLLT();
+
+    // STEP 3 - state estimate correction, K = K_bar * S_e^-1
+    output_vector_t innovation = y - this->h_->computeMeasurement(this->x_est_);
+    output_vector_t e = L.template topLeftCorner<OUTPUT_DIM, OUTPUT_DIM>()
+                            .template triangularView<Eigen::Lower>()
+                            .solve(innovation);
+    this->x_est_.noalias() += L.template bottomLeftCorner<STATE_DIM, OUTPUT_DIM>() * e;
+
+    // STEP 4 - covariance square root correction
+    S_.setL(L.template bottomRightCorner<STATE_DIM, STATE_DIM>());
+
+    return this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootExtendedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::getCovarianceMatrix()
+    -> const state_matrix_t&
+{
+    P_ = S_.reconstructedMatrix();
+    return P_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootExtendedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::getCovarianceSquareRoot() const
+    -> const CovarianceSquareRoot<STATE_DIM>&
+{
+    return S_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SquareRootExtendedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setCovarianceMatrix(
+    const state_matrix_t& P)
+{
+    S_.computeSemidefinite(P);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SquareRootExtendedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setQ(const state_matrix_t& Q)
+{
+    S_Q_.computeSemidefinite(Q);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SquareRootExtendedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setR(const output_matrix_t& R)
+{
+    S_R_.computeSemidefinite(R);
+}
+
+}  // namespace optcon
+}  // namespace ct
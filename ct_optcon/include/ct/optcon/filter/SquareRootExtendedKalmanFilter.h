@@ -0,0 +1,87 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "EstimatorBase.h"
+#include "Cholesky.h"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \ingroup Filter
+ *
+ * \brief Square-root Extended Kalman Filter.
+ *
+ * Equivalent to the ExtendedKalmanFilter, but propagates the lower Cholesky factor S of the covariance P = S S^T
+ * instead of the covariance itself. Both the time update and the measurement update are computed through a QR
+ * decomposition of a stacked array of square-root factors, such that no matrix is inverted and P stays positive
+ * definite by construction, also over long runs at high rates.
+ *
+ * The Cholesky factors of Q and R are computed once, when they are set.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR = double>
+class SquareRootExtendedKalmanFilter final : public EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using Base = EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>;
+    using typename Base::control_vector_t;
+    using typename Base::output_matrix_t;
+    using typename Base::output_vector_t;
+    using typename Base::state_matrix_t;
+    using typename Base::state_vector_t;
+
+    template <size_t SIZE>
+    using CovarianceSquareRoot = Cholesky<Eigen::Matrix<SCALAR, SIZE, SIZE>>;
+
+    //! Constructor.
+    SquareRootExtendedKalmanFilter(std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+        std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+        const state_matrix_t& Q,
+        const output_matrix_t& R,
+        const state_vector_t& x0 = state_vector_t::Zero(),
+        const state_matrix_t& P0 = state_matrix_t::Zero());
+
+    //! Estimator predict method.
+    const state_vector_t& predict(const control_vector_t& u,
+        const ct::core::Time& dt,
+        const ct::core::Time& t) override;
+
+    //! Estimator update method.
+    const state_vector_t& update(const output_vector_t& y, const ct::core::Time& dt, const ct::core::Time& t) override;
+
+    //! return current covariance matrix, assembled from its square root
+    const state_matrix_t& getCovarianceMatrix();
+
+    //! return the lower Cholesky factor of the current covariance matrix
+    const CovarianceSquareRoot<STATE_DIM>& getCovarianceSquareRoot() const;
+
+    //! set the covariance matrix, P may be semi-definite
+    void setCovarianceMatrix(const state_matrix_t& P);
+
+    //! update Q matrix
+    void setQ(const state_matrix_t& Q);
+    //! update R matrix
+    void setR(const output_matrix_t& R);
+
+private:
+    //! lower Cholesky factor of Q
+    CovarianceSquareRoot<STATE_DIM> S_Q_;
+
+    //! lower Cholesky factor of R
+    CovarianceSquareRoot<OUTPUT_DIM> S_R_;
+
+    //! lower Cholesky factor of the covariance estimate
+    CovarianceSquareRoot<STATE_DIM> S_;
+
+    //! covariance estimate, only assembled on request
+    state_matrix_t P_;
+};
+
+}  // namespace optcon
+}  // namespace ct
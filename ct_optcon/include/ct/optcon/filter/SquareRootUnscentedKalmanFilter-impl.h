@@ -0,0 +1,186 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::SquareRootUnscentedKalmanFilter(
+    std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+    std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+    const state_matrix_t& Q,
+    const output_matrix_t& R,
+    const state_vector_t& x0,
+    const state_matrix_t& P0,
+    SCALAR alpha,
+    SCALAR beta,
+    SCALAR kappa)
+    : Base(f, h, x0), alpha_(alpha), beta_(beta), kappa_(kappa)
+{
+    setQ(Q);
+    setR(R);
+    setCovarianceMatrix(P0);
+    computeWeights();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::predict(const control_vector_t& u,
+    const ct::core::Time& dt,
+    const ct::core::Time& t) -> const state_vector_t&
+{
+    state_matrix_t dFdv = this->f_->computeDerivativeNoise(this->x_est_, u, dt, t);
+
+    computeSigmaPoints();
+
+    // Pass the sigma points through non-linear state transition function
+    this->f_->computeDynamicsBatch(sigmaStatePoints_, u, dt, t);
+
+    this->x_est_ = sigmaStatePoints_ * sigmaWeights_m_;
+
+    if (!computeSquareRootFromSigmaPoints<STATE_DIM>(
+            this->x_est_, sigmaStatePoints_, std::sqrt(SCALAR(dt)) * dFdv * S_Q_.matrixL(), S_))
+        throw std::runtime_error("SquareRootUnscentedKalmanFilter : Numerical error.");
+
+    return this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::update(const output_vector_t& z,
+    const ct::core::Time& dt,
+    const ct::core::Time& t) -> const state_vector_t&
+{
+    output_matrix_t dHdw = this->h_->computeDerivativeNoise(this->x_est_, t);
+
+    computeSigmaPoints();
+
+    // Predict measurements for each sigma point
+    SigmaPoints<OUTPUT_DIM> sigmaMeasurementPoints;
+    for (size_t i = 0; i < SigmaPointCount; ++i)
+        sigmaMeasurementPoints.col(i) = this->h_->computeMeasurement(sigmaStatePoints_.col(i), t);
+
+    output_vector_t y = sigmaMeasurementPoints * sigmaWeights_m_;
+
+    // Square root of the innovation covariance
+    CovarianceSquareRoot<OUTPUT_DIM> S_yy;
+    if (!computeSquareRootFromSigmaPoints<OUTPUT_DIM>(y, sigmaMeasurementPoints, dHdw * S_R_.matrixL(), S_yy))
+        throw std::runtime_error("SquareRootUnscentedKalmanFilter : Numerical error.");
+
+    // Kalman gain K = P_xy * (S_yy * S_yy^T)^-1, through triangular solves
+    Eigen::Matrix<SCALAR, STATE_DIM, OUTPUT_DIM> P_xy =
+        (sigmaStatePoints_.colwise() - this->x_est_) * sigmaWeights_c_.asDiagonal() *
+        (sigmaMeasurementPoints.colwise() - y).transpose();
+    Eigen::Matrix<SCALAR, STATE_DIM, OUTPUT_DIM> K = S_yy.solve(P_xy.transpose()).transpose();
+
+    // Update state
+    this->x_est_ += K * (z - y);
+
+    // Update state covariance, P -= U * U^T with U = K * S_yy, as a sequence of rank-one downdates
+    Eigen::Matrix<SCALAR, STATE_DIM, OUTPUT_DIM> U = K * S_yy.matrixL();
+    for (size_t i = 0; i < OUTPUT_DIM; ++i)
+    {
+        S_.rankUpdate(U.col(i), SCALAR(-1));
+        if (S_.info() != Eigen::Success)
+            throw std::runtime_error("SquareRootUnscentedKalmanFilter : Covariance downdate failed.");
+    }
+
+    return this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::getCovarianceMatrix()
+    -> const state_matrix_t&
+{
+    P_ = S_.reconstructedMatrix();
+    return P_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+auto SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::getCovarianceSquareRoot() const
+    -> const CovarianceSquareRoot<STATE_DIM>&
+{
+    return S_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setCovarianceMatrix(
+    const state_matrix_t& P)
+{
+    S_.computeSemidefinite(P);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setQ(const state_matrix_t& Q)
+{
+    S_Q_.computeSemidefinite(Q);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setR(const output_matrix_t& R)
+{
+    S_R_.computeSemidefinite(R);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeWeights()
+{
+    SCALAR L = SCALAR(STATE_DIM);
+    SCALAR lambda = alpha_ * alpha_ * (L + kappa_) - L;
+
+    // Make sure L != -lambda to avoid division by zero
+    if (std::abs(L + lambda) <= 1e-6)
+        throw std::runtime_error("SquareRootUnscentedKalmanFilter : Invalid sigma point parameters.");
+
+    gamma_ = std::sqrt(L + lambda);
+
+    SCALAR W_m_0 = lambda / (L + lambda);
+    SCALAR W_c_0 = W_m_0 + (SCALAR(1) - alpha_ * alpha_ + beta_);
+    SCALAR W_i = SCALAR(1) / (SCALAR(2) * (L + lambda));
+
+    sigmaWeights_m_.setConstant(W_i);
+    sigmaWeights_c_.setConstant(W_i);
+    sigmaWeights_m_[0] = W_m_0;
+    sigmaWeights_c_[0] = W_c_0;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeSigmaPoints()
+{
+    // the square root of the covariance is available, no factorization needed
+    const state_matrix_t gammaS = gamma_ * S_.matrixL().toDenseMatrix();
+
+    sigmaStatePoints_.template leftCols<1>() = this->x_est_;
+    sigmaStatePoints_.template block<STATE_DIM, STATE_DIM>(0, 1) = gammaS.colwise() + this->x_est_;
+    sigmaStatePoints_.template rightCols<STATE_DIM>() = (-gammaS).colwise() + this->x_est_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+template <size_t SIZE>
+bool SquareRootUnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeSquareRootFromSigmaPoints(
+    const Eigen::Matrix<SCALAR, SIZE, 1>& mean,
+    const SigmaPoints<SIZE>& sigmaPoints,
+    const Eigen::Matrix<SCALAR, SIZE, SIZE>& noiseSquareRoot,
+    CovarianceSquareRoot<SIZE>& S)
+{
+    // the outer sigma points share the same positive weight, QR of the weighted deviations and noise square root
+    Eigen::Matrix<SCALAR, SIZE, SigmaPointCount - 1 + SIZE> A;
+    A.template leftCols<SigmaPointCount - 1>() =
+        std::sqrt(sigmaWeights_c_[1]) * (sigmaPoints.template rightCols<SigmaPointCount - 1>().colwise() - mean);
+    A.template rightCols<SIZE>() = noiseSquareRoot;
+    S.setFromSquareRoot(A);
+
+    // the center sigma point may have a negative weight and enters through a rank-one update
+    if (sigmaWeights_c_[0] != SCALAR(0))
+    {
+        const SCALAR w0 = sigmaWeights_c_[0];
+        S.rankUpdate(sigmaPoints.col(0) - mean, w0);
+    }
+
+    return S.info() == Eigen::Success;
+}
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,115 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "EstimatorBase.h"
+#include "Cholesky.h"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * \ingroup Filter
+ *
+ * \brief Square-root Unscented Kalman Filter.
+ *
+ * Propagates the lower Cholesky factor S of the covariance P = S S^T, which directly provides the sigma points, such
+ * that the covariance does not need to be factorized at every step. The predicted square roots are obtained by a QR
+ * decomposition of the weighted sigma point deviations, followed by a rank-one update for the center sigma point, and
+ * the measurement update is applied as a sequence of rank-one downdates. The Kalman gain is computed through
+ * triangular solves instead of inverting the innovation covariance.
+ *
+ * Different from the UnscentedKalmanFilter, the process and measurement noise are specified by the covariances Q and
+ * R, which enter through the noise derivatives as in the ExtendedKalmanFilter.
+ *
+ * The sigma points are redrawn from the current estimate for every measurement update, such that several updates can
+ * follow a prediction.
+ *
+ * @tparam STATE_DIM
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR = double>
+class SquareRootUnscentedKalmanFilter final : public EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using Base = EstimatorBase<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>;
+    using typename Base::control_vector_t;
+    using typename Base::output_matrix_t;
+    using typename Base::output_vector_t;
+    using typename Base::state_matrix_t;
+    using typename Base::state_vector_t;
+
+    static constexpr size_t SigmaPointCount = 2 * STATE_DIM + 1;
+
+    template <size_t SIZE>
+    using SigmaPoints = Eigen::Matrix<SCALAR, SIZE, SigmaPointCount>;
+
+    template <size_t SIZE>
+    using CovarianceSquareRoot = Cholesky<Eigen::Matrix<SCALAR, SIZE, SIZE>>;
+
+    //! Constructor.
+    SquareRootUnscentedKalmanFilter(std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
+        std::shared_ptr<LinearMeasurementModel<OUTPUT_DIM, STATE_DIM, SCALAR>> h,
+        const state_matrix_t& Q,
+        const output_matrix_t& R,
+        const state_vector_t& x0 = state_vector_t::Zero(),
+        const state_matrix_t& P0 = state_matrix_t::Identity(),
+        SCALAR alpha = SCALAR(1.0),
+        SCALAR beta = SCALAR(2.0),
+        SCALAR kappa = SCALAR(0.0));
+
+    //! Estimator predict method.
+    const state_vector_t& predict(const control_vector_t& u,
+        const ct::core::Time& dt,
+        const ct::core::Time& t) override;
+
+    //! Estimator update method.
+    const state_vector_t& update(const output_vector_t& y, const ct::core::Time& dt, const ct::core::Time& t) override;
+
+    //! return current covariance matrix, assembled from its square root
+    const state_matrix_t& getCovarianceMatrix();
+
+    //! return the lower Cholesky factor of the current covariance matrix
+    const CovarianceSquareRoot<STATE_DIM>& getCovarianceSquareRoot() const;
+
+    //! set the covariance matrix, P may be semi-definite
+    void setCovarianceMatrix(const state_matrix_t& P);
+
+    //! update Q matrix
+    void setQ(const state_matrix_t& Q);
+    //! update R matrix
+    void setR(const output_matrix_t& R);
+
+private:
+    //! Compute weights of sigma points.
+    void computeWeights();
+
+    //! Compute sigma points from current state estimate and covariance square root.
+    void computeSigmaPoints();
+
+    //! Compute the covariance square root of sigma points, with an additional square root of the noise covariance.
+    template <size_t SIZE>
+    bool computeSquareRootFromSigmaPoints(const Eigen::Matrix<SCALAR, SIZE, 1>& mean,
+        const SigmaPoints<SIZE>& sigmaPoints,
+        const Eigen::Matrix<SCALAR, SIZE, SIZE>& noiseSquareRoot,
+        CovarianceSquareRoot<SIZE>& S);
+
+    CovarianceSquareRoot<STATE_DIM> S_Q_;                       //! Cholesky factor of Q.
+    CovarianceSquareRoot<OUTPUT_DIM> S_R_;                      //! Cholesky factor of R.
+    CovarianceSquareRoot<STATE_DIM> S_;                         //! Cholesky factor of the covariance matrix.
+    state_matrix_t P_;                                          //! Covariance matrix, only assembled on request.
+    Eigen::Matrix<SCALAR, SigmaPointCount, 1> sigmaWeights_m_;  //! Sigma measurement weights.
+    Eigen::Matrix<SCALAR, SigmaPointCount, 1> sigmaWeights_c_;  //! Sigma covariance weights.
+    SigmaPoints<STATE_DIM> sigmaStatePoints_;                   //! Sigma points.
+    SCALAR alpha_;  //! Scaling parameter for spread of sigma points (usually \f$ 1E-4 \leq \alpha \leq 1 \f$)
+    SCALAR beta_;   //! Parameter for prior knowledge about the distribution (\f$ \beta = 2 \f$ is optimal for Gaussian)
+    SCALAR kappa_;  //! Secondary scaling parameter (usually 0)
+    SCALAR gamma_;  //! \f$ \gamma = \sqrt{L + \lambda} \f$ with \f$ L \f$ being the state dimensionality
+};
+
+}  // namespace optcon
+}  // namespace ct
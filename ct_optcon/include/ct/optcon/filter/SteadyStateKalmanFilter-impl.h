@@ -15,8 +15,9 @@ SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::SteadyState
     const state_matrix_t& Q,
     const output_matrix_t& R,
     const state_vector_t& x0,
-    size_t maxDAREIterations)
-    : Base(f, h, x0), Q_(Q), R_(R), maxDAREIterations_(maxDAREIterations)
+    size_t maxDAREIterations,
+    DARESolverType dareSolverType)
+    : Base(f, h, x0), Q_(Q), R_(R), maxDAREIterations_(maxDAREIterations), dareSolverType_(dareSolverType)
 {
     P_.setZero();
 }
@@ -29,7 +30,8 @@ SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::SteadyState
     : Base(f, h, sskf_settings.x0),
       Q_(sskf_settings.Q),
       R_(sskf_settings.R),
-      maxDAREIterations_(sskf_settings.maxDAREIterations)
+      maxDAREIterations_(sskf_settings.maxDAREIterations),
+      dareSolverType_(sskf_settings.dareSolverType)
 {
 }
 
@@ -51,7 +53,7 @@ auto SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::update
     ct::core::OutputStateMatrix<OUTPUT_DIM, STATE_DIM, SCALAR> dHdx = this->h_->computeDerivativeState(this->x_est_, t);
     Eigen::Matrix<SCALAR, OUTPUT_DIM, STATE_DIM> K;
 
-    DARE<STATE_DIM, OUTPUT_DIM, SCALAR> dare;
+    DARE<STATE_DIM, OUTPUT_DIM, SCALAR> dare(dareSolverType_);
     try
     {
         P_ = dare.computeSteadyStateRiccatiMatrix(
@@ -71,5 +73,12 @@ void SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setMax
     maxDAREIterations_ = maxDAREIterations;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
+void SteadyStateKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::setDARESolverType(
+    DARESolverType dareSolverType)
+{
+    dareSolverType_ = dareSolverType;
+}
+
 }  // namespace optcon
 }  // namespace ct
@@ -42,7 +42,8 @@ public:
         const state_matrix_t& Q,
         const output_matrix_t& R,
         const state_vector_t& x0 = state_vector_t::Zero(),
-        size_t maxDAREIterations = 1000);
+        size_t maxDAREIterations = 1000,
+        DARESolverType dareSolverType = FIXED_POINT_ITERATION);
 
     //! Constructor from settings.
     SteadyStateKalmanFilter(std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
@@ -60,8 +61,12 @@ public:
     //! Limit number of iterations of the DARE solver.
     void setMaxDAREIterations(size_t maxDAREIterations);
 
+    //! Select the algorithm for solving the DARE.
+    void setDARESolverType(DARESolverType dareSolverType);
+
 private:
     size_t maxDAREIterations_;
+    DARESolverType dareSolverType_;
     state_matrix_t P_;  //! Covariance estimate.
     state_matrix_t A_;  //! Computed linearized system matrix
     output_matrix_t R_;
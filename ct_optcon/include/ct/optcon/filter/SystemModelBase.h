@@ -24,6 +24,7 @@ public:
     using state_vector_t = ct::core::StateVector<STATE_DIM, SCALAR>;
     using state_matrix_t = ct::core::StateMatrix<STATE_DIM, SCALAR>;
     using control_vector_t = ct::core::ControlVector<CONTROL_DIM, SCALAR>;
+    using state_batch_t = Eigen::Matrix<SCALAR, STATE_DIM, Eigen::Dynamic>;
     using Time_t = SCALAR;
 
     //! Virtual destructor.
@@ -35,6 +36,21 @@ public:
         const Time_t dt,
         Time_t t) = 0;
 
+    /*!
+     * \brief Propagates a batch of states, stored column-wise, with the same control input.
+     *
+     * Used by the sigma point filters. The default implementation calls computeDynamics() for every column, system
+     * models which can propagate several states more efficiently at once should override it.
+     */
+    virtual void computeDynamicsBatch(Eigen::Ref<state_batch_t> states,
+        const control_vector_t& control,
+        const Time_t dt,
+        Time_t t)
+    {
+        for (Eigen::Index i = 0; i < states.cols(); ++i)
+            states.col(i) = computeDynamics(states.col(i), control, dt, t);
+    }
+
     //! Computes the derivative w.r.t state.
     virtual state_matrix_t computeDerivativeState(const state_vector_t& state,
         const control_vector_t& control,
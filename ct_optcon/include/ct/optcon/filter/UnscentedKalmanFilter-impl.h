@@ -8,49 +8,6 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 namespace ct {
 namespace optcon {
 
-template <typename _MatrixType, int _UpLo>
-Cholesky<_MatrixType, _UpLo>::Cholesky() : Eigen::LLT<_MatrixType, _UpLo>()
-{
-}
-
-template <typename _MatrixType, int _UpLo>
-Cholesky<_MatrixType, _UpLo>::Cholesky(const _MatrixType& m) : Eigen::LLT<_MatrixType, _UpLo>(m)
-{
-}
-
-template <typename _MatrixType, int _UpLo>
-Cholesky<_MatrixType, _UpLo>& Cholesky<_MatrixType, _UpLo>::setIdentity()
-{
-    this->m_matrix.setIdentity();
-    this->m_isInitialized = true;
-    return *this;
-}
-
-template <typename _MatrixType, int _UpLo>
-bool Cholesky<_MatrixType, _UpLo>::isIdentity() const
-{
-    eigen_assert(this->m_isInitialized && "LLT is not initialized.");
-    return this->m_matrix.isIdentity();
-}
-
-template <typename _MatrixType, int _UpLo>
-template <typename Derived>
-Cholesky<_MatrixType, _UpLo>& Cholesky<_MatrixType, _UpLo>::setL(const Eigen::MatrixBase<Derived>& matrix)
-{
-    this->m_matrix = matrix.template triangularView<Eigen::Lower>();
-    this->m_isInitialized = true;
-    return *this;
-}
-
-template <typename _MatrixType, int _UpLo>
-template <typename Derived>
-Cholesky<_MatrixType, _UpLo>& Cholesky<_MatrixType, _UpLo>::setU(const Eigen::MatrixBase<Derived>& matrix)
-{
-    this->m_matrix = matrix.template triangularView<Eigen::Upper>().adjoint();
-    this->m_isInitialized = true;
-    return *this;
-}
-
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
 UnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::UnscentedKalmanFilter(
     std::shared_ptr<SystemModelBase<STATE_DIM, CONTROL_DIM, SCALAR>> f,
@@ -244,10 +201,7 @@ void UnscentedKalmanFilter<STATE_DIM, CONTROL_DIM, OUTPUT_DIM, SCALAR>::computeS
     const ct::core::Time& dt,
     const ct::core::Time& t)
 {
-    for (size_t i = 0; i < SigmaPointCount; ++i)
-    {
-        sigmaStatePoints_.col(i) = this->f_->computeDynamics(sigmaStatePoints_.col(i), u, dt, t);
-    }
+    this->f_->computeDynamicsBatch(sigmaStatePoints_, u, dt, t);
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t OUTPUT_DIM, typename SCALAR>
@@ -6,47 +6,11 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #pragma once
 
 #include "EstimatorBase.h"
+#include "Cholesky.h"
 
 namespace ct {
 namespace optcon {
 
-/*!
- * \ingroup Filter
- *
- * \brief Cholesky square root decomposition of a symmetric positive-definite matrix.
- *
- * @tparam MatrixType The matrix type
- * @tparam UpLo Square root form (Eigen::Lower or Eigen::Upper)
- */
-template <typename MatrixType, int UpLo = Eigen::Lower>
-class Cholesky : public Eigen::LLT<MatrixType, UpLo>
-{
-public:
-    //! Constructor.
-    Cholesky();
-    //! Construct cholesky square root decomposition from matrix
-    Cholesky(const MatrixType& m);
-    //! Set decomposition to identity
-    Cholesky& setIdentity();
-
-    //! Check whether the decomposed matrix is the identity matrix
-    bool isIdentity() const;
-
-    /*!
-     * \brief Set lower triangular part of the decomposition
-     * @param matrix The lower part stored in a full matrix
-     */
-    template <typename Derived>
-    Cholesky& setL(const Eigen::MatrixBase<Derived>& matrix);
-
-    /*!
-     * \brief Set upper triangular part of the decomposition
-     * @param matrix The upper part stored in a full matrix
-     */
-    template <typename Derived>
-    Cholesky& setU(const Eigen::MatrixBase<Derived>& matrix);
-};
-
 template <size_t STATE_DIM, typename SCALAR>
 struct UnscentedKalmanFilterSettings;
 
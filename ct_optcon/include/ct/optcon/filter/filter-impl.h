@@ -5,6 +5,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include "Cholesky-impl.h"
 #include "CTSystemModel-impl.h"
 #include "DisturbedSystem-impl.h"
 #include "InputDisturbedSystem-impl.h"
@@ -12,4 +13,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "LTIMeasurementModel-impl.h"
 #include "ExtendedKalmanFilter-impl.h"
 #include "SteadyStateKalmanFilter-impl.h"
+#include "SquareRootExtendedKalmanFilter-impl.h"
+#include "SquareRootUnscentedKalmanFilter-impl.h"
+#include "InformationFilter-impl.h"
 #include "UnscentedKalmanFilter-impl.h"
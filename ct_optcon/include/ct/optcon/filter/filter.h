@@ -5,6 +5,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include "Cholesky.h"
 #include "CTSystemModel.h"
 #include "DisturbedSystem.h"
 #include "DisturbedSystemController.h"
@@ -12,9 +13,12 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "ExtendedKalmanFilter.h"
 #include "EstimatorBase.h"
 #include "FilterSettings.h"
+#include "InformationFilter.h"
 #include "LinearMeasurementModel.h"
 #include "LTIMeasurementModel.h"
 #include "MeasurementModelBase.h"
+#include "SquareRootExtendedKalmanFilter.h"
+#include "SquareRootUnscentedKalmanFilter.h"
 #include "SteadyStateKalmanFilter.h"
 #include "SystemModelBase.h"
 #include "UnscentedKalmanFilter.h"
@@ -9,10 +9,22 @@ namespace ct {
 namespace optcon {
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
-DARE<STATE_DIM, CONTROL_DIM, SCALAR>::DARE()
+DARE<STATE_DIM, CONTROL_DIM, SCALAR>::DARE(DARESolverType solverType) : solverType_(solverType), numIterations_(0)
 {
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void DARE<STATE_DIM, CONTROL_DIM, SCALAR>::setSolverType(DARESolverType solverType)
+{
+    solverType_ = solverType;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+size_t DARE<STATE_DIM, CONTROL_DIM, SCALAR>::getNumIterations() const
+{
+    return numIterations_;
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 typename DARE<STATE_DIM, CONTROL_DIM, SCALAR>::state_matrix_t
 DARE<STATE_DIM, CONTROL_DIM, SCALAR>::computeSteadyStateRiccatiMatrix(const state_matrix_t& Q,
@@ -39,32 +51,127 @@ DARE<STATE_DIM, CONTROL_DIM, SCALAR>::computeSteadyStateRiccatiMatrix(const stat
     bool verbose,
     const SCALAR eps,
     size_t maxIter)
+{
+    switch (solverType_)
+    {
+        case FIXED_POINT_ITERATION:
+            P = solveFixedPointIteration(Q, R, A, B, P, eps, maxIter);
+            break;
+        case DOUBLING:
+            P = solveDoubling(Q, R, A, B, eps, maxIter);
+            break;
+        default:
+            throw std::runtime_error("DARE : unknown solver type.");
+    }
+
+    // the feedback for the converged P
+    control_matrix_t H = R;
+    H.noalias() += B.transpose() * P * B;
+    K = -H.ldlt().solve(B.transpose() * P * A);
+
+    if (!K.allFinite())
+        throw std::runtime_error("DARE : Failed to converge - K is unstable.");
+
+    if (verbose)
+    {
+        std::cout << "DARE : converged after " << numIterations_ << " iterations out of a maximum of " << maxIter
+                  << std::endl;
+        std::cout << "Resulting K: " << K << std::endl;
+    }
+
+    return P;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename DARE<STATE_DIM, CONTROL_DIM, SCALAR>::state_matrix_t
+DARE<STATE_DIM, CONTROL_DIM, SCALAR>::solveFixedPointIteration(const state_matrix_t& Q,
+    const control_matrix_t& R,
+    const state_matrix_t& A,
+    const control_gain_matrix_t& B,
+    state_matrix_t P,
+    const SCALAR eps,
+    size_t maxIter)
 {
     state_matrix_t P_prev;
-    size_t numIter = 0;
+    control_feedback_t K;
+    numIterations_ = 0;
 
     SCALAR diff = 1;
 
-    while (diff >= eps && numIter < maxIter)
+    while (diff >= eps && numIterations_ < maxIter)
     {
         P_prev = P;
         dynamicRDE_.iterateRobust(Q, R, A, B, P, K);
         diff = (P - P_prev).cwiseAbs().maxCoeff();
         if (!K.allFinite())
             throw std::runtime_error("DARE : Failed to converge - K is unstable.");
-        numIter++;
+        numIterations_++;
     }
 
     if (diff >= eps)
         throw std::runtime_error("DARE : Failed to converge - maximum number of iterations reached.");
 
-    if (verbose)
+    return P;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+typename DARE<STATE_DIM, CONTROL_DIM, SCALAR>::state_matrix_t
+DARE<STATE_DIM, CONTROL_DIM, SCALAR>::solveDoubling(const state_matrix_t& Q,
+    const control_matrix_t& R,
+    const state_matrix_t& A,
+    const control_gain_matrix_t& B,
+    const SCALAR eps,
+    size_t maxIter)
+{
+    // after k iterations, H_k is the solution of the Riccati recursion over 2^k steps starting at P = Q
+    // see Chu, Fan, Lin, "A structure-preserving doubling algorithm for discrete-time algebraic Riccati equations"
+    Eigen::LLT<control_matrix_t> R_llt(R);
+    if (R_llt.info() != Eigen::Success)
+        throw std::runtime_error("DARE : doubling requires a positive definite R.");
+
+    state_matrix_t A_k = A;
+    state_matrix_t G_k = B * R_llt.solve(B.transpose());
+    state_matrix_t H_k = Q;
+
+    state_matrix_t W;
+    state_matrix_t Winv_A;
+    state_matrix_t Winv_G;
+    Eigen::PartialPivLU<state_matrix_t> W_lu;
+    numIterations_ = 0;
+
+    SCALAR diff = 1;
+
+    while (diff >= eps && numIterations_ < maxIter)
     {
-        std::cout << "DARE : converged after " << numIter << " iterations out of a maximum of " << maxIter << std::endl;
-        std::cout << "Resulting K: " << K << std::endl;
+        W = state_matrix_t::Identity();
+        W.noalias() += G_k * H_k;
+        W_lu.compute(W);
+        Winv_A = W_lu.solve(A_k);
+        Winv_G = W_lu.solve(G_k);
+
+        // H_{k+1} = H_k + A_k^T H_k (I + G_k H_k)^-1 A_k
+        state_matrix_t H_delta = A_k.transpose() * H_k * Winv_A;
+        H_delta = (H_delta + H_delta.transpose()).eval() / 2.0;
+        H_k += H_delta;
+
+        // G_{k+1} = G_k + A_k (I + G_k H_k)^-1 G_k A_k^T
+        G_k.noalias() += A_k * Winv_G * A_k.transpose();
+        G_k = (G_k + G_k.transpose()).eval() / 2.0;
+
+        // A_{k+1} = A_k (I + G_k H_k)^-1 A_k
+        A_k = (A_k * Winv_A).eval();
+
+        if (!H_k.allFinite())
+            throw std::runtime_error("DARE : Failed to converge - doubling diverged.");
+
+        diff = H_delta.cwiseAbs().maxCoeff();
+        numIterations_++;
     }
 
-    return P;
+    if (diff >= eps)
+        throw std::runtime_error("DARE : Failed to converge - maximum number of iterations reached.");
+
+    return H_k;
 }
 
 }  // namespace optcon
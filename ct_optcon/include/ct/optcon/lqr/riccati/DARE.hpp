@@ -10,6 +10,13 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 namespace ct {
 namespace optcon {
 
+//! solution methods for the discrete-time algebraic Riccati equation
+enum DARESolverType
+{
+    FIXED_POINT_ITERATION = 0,  //! iterate the dynamic Riccati equation, converges linearly
+    DOUBLING                    //! structure-preserving doubling algorithm, converges quadratically
+};
+
 /*!
  * \ingroup LQR
  *+
@@ -17,6 +24,11 @@ namespace optcon {
  *
  * solves the discrete-time Infinite-Horizon Algebraic Riccati Equation iteratively
  *
+ * Two solvers are available, see DARESolverType. The fixed-point iteration repeatedly applies the dynamic Riccati
+ * equation and can be warm-started. The structure-preserving doubling algorithm doubles the horizon covered by the
+ * solution in every iteration, which requires far fewer iterations for lightly damped systems. It requires R to be
+ * positive definite and ignores a warm-start.
+ *
  * @tparam STATE_DIM system state dimension
  * @tparam CONTROL_DIM system control input dimension
  */
@@ -32,7 +44,17 @@ public:
     typedef Eigen::Matrix<SCALAR, STATE_DIM, CONTROL_DIM> control_gain_matrix_t;
     typedef Eigen::Matrix<SCALAR, CONTROL_DIM, STATE_DIM> control_feedback_t;
 
-    DARE();
+    /*!
+     * constructor
+     * @param solverType the solution method
+     */
+    DARE(DARESolverType solverType = FIXED_POINT_ITERATION);
+
+    //! set the solution method
+    void setSolverType(DARESolverType solverType);
+
+    //! the number of iterations of the last call to computeSteadyStateRiccatiMatrix()
+    size_t getNumIterations() const;
 
     /*! compute the discrete-time steady state Riccati-Matrix
      * this method iterates over the time-varying discrete-time Riccati Equation to compute the steady-state solution.
@@ -59,7 +81,7 @@ public:
      * @param R control weight
      * @param A discrete-time linear system matrix A
      * @param B discrete-time linear system matrix B
-     * @param P warm initialized P matrix
+     * @param P warm initialized P matrix, only used by the fixed-point iteration
      * @param verbose print additional information
      * @param eps treshold to stop iterating
      * @return steady state riccati matrix P
@@ -76,6 +98,26 @@ public:
 
 
 private:
+    //! iterate the dynamic Riccati equation until convergence
+    state_matrix_t solveFixedPointIteration(const state_matrix_t& Q,
+        const control_matrix_t& R,
+        const state_matrix_t& A,
+        const control_gain_matrix_t& B,
+        state_matrix_t P,
+        const SCALAR eps,
+        size_t maxIter);
+
+    //! structure-preserving doubling algorithm
+    state_matrix_t solveDoubling(const state_matrix_t& Q,
+        const control_matrix_t& R,
+        const state_matrix_t& A,
+        const control_gain_matrix_t& B,
+        const SCALAR eps,
+        size_t maxIter);
+
+    DARESolverType solverType_;
+    size_t numIterations_;
+
     DynamicRiccatiEquation<STATE_DIM, CONTROL_DIM> dynamicRDE_;
 };
 
@@ -42,7 +42,7 @@ MPC<OPTCON_SOLVER>::MPC(const OptConProblem_t& problem,
             {
                 // default policy handler for standard discrete-time iLQG implementation
                 policyHandler_ = std::shared_ptr<PolicyHandler<Policy_t, STATE_DIM, CONTROL_DIM, Scalar_t>>(
-                    new StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, Scalar_t>(solverSettings.dt));
+                    new StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, Scalar_t>(solverSettings));
             }
             else
             {
@@ -262,10 +262,60 @@ bool MPC<OPTCON_SOLVER>::finishIteration(const core::StateVector<STATE_DIM, Scal
         firstRun_ = false;
     }
 
+    logToBinaryLogger(x, x_start, x_ts, newPolicy_ts, solveSuccessful);
+
     return solveSuccessful;
 }
 
 
+template <typename OPTCON_SOLVER>
+void MPC<OPTCON_SOLVER>::setBinaryLogger(const std::shared_ptr<core::BinaryLogger>& logger, const std::string& prefix)
+{
+    binaryLogger_ = logger;
+    if (!binaryLogger_)
+        return;
+
+    binaryLogChannelX_ = binaryLogger_->addChannel(prefix + "/x");
+    binaryLogChannelXStart_ = binaryLogger_->addChannel(prefix + "/x_start");
+    binaryLogChannelStatus_ = binaryLogger_->addChannel(prefix + "/status");
+    binaryLogChannelXRef_ = binaryLogger_->addChannel(prefix + "/x_ref");
+    binaryLogChannelUff_ = binaryLogger_->addChannel(prefix + "/u_ff");
+    binaryLogChannelK_ = binaryLogger_->addChannel(prefix + "/K");
+}
+
+
+template <typename OPTCON_SOLVER>
+void MPC<OPTCON_SOLVER>::logToBinaryLogger(const core::StateVector<STATE_DIM, Scalar_t>& x,
+    const core::StateVector<STATE_DIM, Scalar_t>& x_start,
+    const Scalar_t x_ts,
+    const Scalar_t newPolicy_ts,
+    const bool solveSuccessful)
+{
+    if (!binaryLogger_)
+        return;
+
+    const double time = binaryLogger_->now();
+    binaryLogger_->logMatrix(binaryLogChannelX_, runCallCounter_, time, x);
+    binaryLogger_->logMatrix(binaryLogChannelXStart_, runCallCounter_, time, x_start);
+
+    const double status[4] = {static_cast<double>(x_ts), static_cast<double>(newPolicy_ts),
+        solveSuccessful ? 1.0 : 0.0, static_cast<double>(timeKeeper_.getMeasuredDelay())};
+    binaryLogger_->log(binaryLogChannelStatus_, runCallCounter_, time, status, 4, 1);
+
+    logPolicy(currentPolicy_, time);
+}
+
+
+template <typename OPTCON_SOLVER>
+void MPC<OPTCON_SOLVER>::logPolicy(const core::StateFeedbackController<STATE_DIM, CONTROL_DIM, Scalar_t>& policy,
+    double time)
+{
+    binaryLogger_->logTrajectory(binaryLogChannelXRef_, runCallCounter_, time, policy.x_ref());
+    binaryLogger_->logTrajectory(binaryLogChannelUff_, runCallCounter_, time, policy.uff());
+    binaryLogger_->logTrajectory(binaryLogChannelK_, runCallCounter_, time, policy.K());
+}
+
+
 template <typename OPTCON_SOLVER>
 void MPC<OPTCON_SOLVER>::resetMpc(const Scalar_t& newTimeHorizon)
 {
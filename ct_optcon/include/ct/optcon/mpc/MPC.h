@@ -193,6 +193,16 @@ public:
     void printMpcSummary();
 
 
+    //! stream the data of every MPC cycle to a binary logger, nullptr disables it
+    /*!
+     * Registers the channels "<prefix>/x" (measured state), "<prefix>/x_start" (forward integrated start state) and
+     * "<prefix>/status" (state time stamp, policy time stamp, success flag and measured delay), and for state feedback
+     * policies also "<prefix>/x_ref", "<prefix>/u_ff" and "<prefix>/K". Records are indexed with the MPC cycle.
+     * Use getSolver().setBinaryLogger() to additionally log every solver iteration.
+     */
+    void setBinaryLogger(const std::shared_ptr<core::BinaryLogger>& logger, const std::string& prefix = "mpc");
+
+
 private:
     //! state forward propagation (for delay compensation)
     /*!
@@ -214,6 +224,21 @@ private:
 
     void checkSettings(const mpc_settings& settings);
 
+    //! log the data of one cycle, see setBinaryLogger()
+    void logToBinaryLogger(const core::StateVector<STATE_DIM, Scalar_t>& x,
+        const core::StateVector<STATE_DIM, Scalar_t>& x_start,
+        const Scalar_t x_ts,
+        const Scalar_t newPolicy_ts,
+        const bool solveSuccessful);
+
+    //! policies which are not state feedback controllers are not logged
+    template <typename POLICY>
+    void logPolicy(const POLICY& policy, double time)
+    {
+    }
+
+    void logPolicy(const core::StateFeedbackController<STATE_DIM, CONTROL_DIM, Scalar_t>& policy, double time);
+
     //! timings for pre-integration
     Scalar_t t_forward_start_;
     Scalar_t t_forward_stop_;
@@ -247,6 +272,15 @@ private:
 
     //! time keeper
     tpl::MpcTimeKeeper<Scalar_t> timeKeeper_;
+
+    //! optional streaming logger and its channel ids
+    std::shared_ptr<core::BinaryLogger> binaryLogger_;
+    size_t binaryLogChannelX_;
+    size_t binaryLogChannelXStart_;
+    size_t binaryLogChannelStatus_;
+    size_t binaryLogChannelXRef_;
+    size_t binaryLogChannelUff_;
+    size_t binaryLogChannelK_;
 };
 
 
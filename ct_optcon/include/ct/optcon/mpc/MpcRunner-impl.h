@@ -0,0 +1,204 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <typename OPTCON_SOLVER>
+MpcRunner<OPTCON_SOLVER>::MpcRunner(std::shared_ptr<MPC_t> mpc)
+    : mpc_(mpc), running_(false), stop_(false), x_ts_(0.0), newState_(false), numCycles_(0)
+{
+    if (!mpc_)
+        throw std::runtime_error("MpcRunner: MPC instance is nullptr.");
+}
+
+
+template <typename OPTCON_SOLVER>
+MpcRunner<OPTCON_SOLVER>::~MpcRunner()
+{
+    joinThread();
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::start(const Scalar_t& ext_ts)
+{
+    if (running_)
+        throw std::runtime_error("MpcRunner: already started.");
+
+    // the thread may have ended on its own, i.e. the time horizon was reached or an exception was thrown
+    if (thread_.joinable())
+        thread_.join();
+    rethrowException();
+
+    stop_ = false;
+    newState_ = false;
+    running_ = true;
+    thread_ = std::thread(&MpcRunner::run, this, ext_ts);
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::stop()
+{
+    joinThread();
+    rethrowException();
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::joinThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stop_ = true;
+    }
+    stateCondition_.notify_one();
+
+    if (thread_.joinable())
+        thread_.join();
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::rethrowException()
+{
+    if (exception_)
+    {
+        std::exception_ptr e = exception_;
+        exception_ = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+
+template <typename OPTCON_SOLVER>
+bool MpcRunner<OPTCON_SOLVER>::isRunning() const
+{
+    return running_;
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::setState(const core::StateVector<STATE_DIM, Scalar_t>& x, const Scalar_t& x_ts)
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        x_ = x;
+        x_ts_ = x_ts;
+        stateArrival_ = std::chrono::steady_clock::now();
+        newState_ = true;
+    }
+    stateCondition_.notify_one();
+}
+
+
+template <typename OPTCON_SOLVER>
+bool MpcRunner<OPTCON_SOLVER>::updatePolicy()
+{
+    return policyBuffer_.update();
+}
+
+
+template <typename OPTCON_SOLVER>
+const typename MpcRunner<OPTCON_SOLVER>::PublishedPolicy& MpcRunner<OPTCON_SOLVER>::getPolicy() const
+{
+    return policyBuffer_.readBuffer();
+}
+
+
+template <typename OPTCON_SOLVER>
+size_t MpcRunner<OPTCON_SOLVER>::getNumCycles() const
+{
+    return numCycles_;
+}
+
+
+template <typename OPTCON_SOLVER>
+std::vector<double> MpcRunner<OPTCON_SOLVER>::getLatencies() const
+{
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    return latencies_;
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::printLatencySummary() const
+{
+    const std::vector<double> latencies = getLatencies();
+
+    std::cout << std::endl;
+    std::cout << "============ MPC Runner Summary =============" << std::endl;
+    std::cout << "Number of MPC cycles:\t\t\t" << latencies.size() << std::endl;
+
+    if (!latencies.empty())
+    {
+        const double sum = std::accumulate(latencies.begin(), latencies.end(), 0.0);
+        std::cout << "Max measured latency [sec]:\t\t" << *std::max_element(latencies.begin(), latencies.end())
+                  << std::endl;
+        std::cout << "Min measured latency [sec]:\t\t" << *std::min_element(latencies.begin(), latencies.end())
+                  << std::endl;
+        std::cout << "Average measured latency [sec]:\t\t" << sum / latencies.size() << std::endl;
+    }
+
+    std::cout << "================ End Summary ================" << std::endl;
+    std::cout << std::endl;
+}
+
+
+template <typename OPTCON_SOLVER>
+void MpcRunner<OPTCON_SOLVER>::run(Scalar_t ext_ts)
+{
+    try
+    {
+        while (true)
+        {
+            // prepare the next iteration while the current policy is executed
+            mpc_->prepareIteration(ext_ts);
+
+            // wait for the next state measurement
+            std::unique_lock<std::mutex> lock(stateMutex_);
+            stateCondition_.wait(lock, [this] { return newState_ || stop_; });
+            if (stop_)
+                break;
+
+            const core::StateVector<STATE_DIM, Scalar_t> x = x_;
+            const Scalar_t x_ts = x_ts_;
+            const std::chrono::steady_clock::time_point stateArrival = stateArrival_;
+            newState_ = false;
+            lock.unlock();
+
+            // finish the iteration directly into the write buffer and publish it
+            PublishedPolicy& published = policyBuffer_.writeBuffer();
+            published.success = mpc_->finishIteration(x, x_ts, published.policy, published.policy_ts);
+            published.cycle = numCycles_ + 1;
+            published.latency =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - stateArrival).count();
+            policyBuffer_.publish();
+
+            {
+                std::lock_guard<std::mutex> latencyLock(latencyMutex_);
+                latencies_.push_back(published.latency);
+            }
+            numCycles_++;
+
+            if (mpc_->timeHorizonReached())
+                break;
+
+            ext_ts = x_ts;
+        }
+    } catch (...)
+    {
+        // handed over to the caller by the next call to stop() or start()
+        exception_ = std::current_exception();
+    }
+
+    running_ = false;
+}
+
+}  // namespace optcon
+}  // namespace ct
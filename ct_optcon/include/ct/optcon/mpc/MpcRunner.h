@@ -0,0 +1,162 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+#include "MPC.h"
+#include "TripleBuffer.h"
+
+namespace ct {
+namespace optcon {
+
+/**
+ * \ingroup MPC
+ *
+ * \brief Asynchronous MPC runner
+ *
+ * Runs an MPC instance in a background thread, such that the preparation of an MPC iteration overlaps with the
+ * execution of the current policy. As soon as an iteration is finished, the runner starts to prepare the next one
+ * and then waits for the next state measurement.
+ *
+ * The control thread hands over state measurements through setState() and obtains the policies through
+ * updatePolicy() and getPolicy(). Policies are published in a lock-free triple buffer, hence reading a policy never
+ * blocks the control thread and does not copy it.
+ *
+ * For every cycle, the end-to-end latency from the arrival of the state measurement to the publication of the
+ * corresponding policy is measured.
+ *
+ * An exception thrown in the background thread ends the thread. It is rethrown to the caller by the next call to
+ * stop() or start(), isRunning() returns false in the meantime.
+ *
+ * \warning the MPC instance must not be accessed by the user while the runner is active.
+ *
+ * @param OPTCON_SOLVER
+ *	the optimal control solver to be employed, for example SLQ or DMS
+ */
+template <typename OPTCON_SOLVER>
+class MpcRunner
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const size_t STATE_DIM = OPTCON_SOLVER::STATE_D;
+    static const size_t CONTROL_DIM = OPTCON_SOLVER::CONTROL_D;
+
+    using MPC_t = MPC<OPTCON_SOLVER>;
+    using Scalar_t = typename OPTCON_SOLVER::Scalar_t;
+    using Policy_t = typename OPTCON_SOLVER::Policy_t;
+
+    //! a policy as published by the runner
+    struct PublishedPolicy
+    {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        Policy_t policy;     //! the new policy
+        Scalar_t policy_ts;  //! time stamp of the policy, see MPC::finishIteration()
+        bool success;        //! true if the solve was successful
+        size_t cycle;        //! number of the MPC cycle, starting at 1
+        double latency;      //! time from arrival of the state measurement to publication of the policy [sec]
+    };
+
+    //! constructor
+    /*!
+     * @param mpc the MPC instance to run, needs to be initialized (initial guess, settings)
+     */
+    MpcRunner(std::shared_ptr<MPC_t> mpc);
+
+    //! destructor, stops the background thread
+    ~MpcRunner();
+
+    //! start the background thread, which immediately prepares the first MPC iteration
+    /*!
+     * The runner can be started again after stop() or after the thread has ended on its own.
+     * @param ext_ts the current external time, passed to the first MPC::prepareIteration()
+     * @throw the exception thrown by a previous run of the background thread, if any was not yet rethrown
+     */
+    void start(const Scalar_t& ext_ts);
+
+    //! stop the background thread, an iteration in progress is completed first
+    /*!
+     * @throw the exception which ended the background thread, if any
+     */
+    void stop();
+
+    //! true while the background thread is active, false after stop() or once the time horizon was reached
+    bool isRunning() const;
+
+    //! hand over a new state measurement (control thread)
+    /*!
+     * If the runner is still busy with the previous measurement, the measurement is replaced, i.e. only the
+     * most recent state is used for the next iteration.
+     * @param x current system state
+     * @param x_ts time stamp of the state (external time in seconds)
+     */
+    void setState(const core::StateVector<STATE_DIM, Scalar_t>& x, const Scalar_t& x_ts);
+
+    //! take the most recently published policy (control thread, non-blocking)
+    /*!
+     * @return true if a new policy was published since the last call
+     */
+    bool updatePolicy();
+
+    //! the policy obtained by the last call to updatePolicy() (control thread)
+    /*!
+     * the reference remains valid until the next call to updatePolicy()
+     */
+    const PublishedPolicy& getPolicy() const;
+
+    //! the number of finished MPC cycles
+    size_t getNumCycles() const;
+
+    //! end-to-end latencies of all finished cycles [sec]
+    std::vector<double> getLatencies() const;
+
+    //! printout statistics of the measured latencies
+    void printLatencySummary() const;
+
+private:
+    //! the loop run by the background thread
+    void run(Scalar_t ext_ts);
+
+    //! signal the background thread to stop and wait for it to finish
+    void joinThread();
+
+    //! rethrow and clear the exception which ended the background thread, if any
+    void rethrowException();
+
+    std::shared_ptr<MPC_t> mpc_;
+
+    std::thread thread_;
+    std::atomic<bool> running_;
+    bool stop_;
+    std::exception_ptr exception_;  //! written by the background thread, read after joining it
+
+    //! most recent state measurement, guarded by stateMutex_
+    std::mutex stateMutex_;
+    std::condition_variable stateCondition_;
+    core::StateVector<STATE_DIM, Scalar_t> x_;
+    Scalar_t x_ts_;
+    std::chrono::steady_clock::time_point stateArrival_;
+    bool newState_;
+
+    TripleBuffer<PublishedPolicy> policyBuffer_;
+
+    std::atomic<size_t> numCycles_;
+
+    mutable std::mutex latencyMutex_;
+    std::vector<double> latencies_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,74 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include <Eigen/Core>
+
+namespace ct {
+namespace optcon {
+
+//! Lock-free triple buffer for passing data from a single writer thread to a single reader thread
+/*!
+ * The writer fills the back buffer and publishes it, the reader takes the latest published buffer. Neither side
+ * ever blocks or waits for the other: the buffers are exchanged by swapping indices through a single atomic, and
+ * the reader always holds a consistent buffer while the writer produces the next one.
+ *
+ * \warning there must be exactly one writer and one reader thread.
+ *
+ * @tparam T the data type to be passed
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    TripleBuffer() : backIndex_(0), frontIndex_(1), middle_(2) {}
+
+    //! the buffer the writer may fill (writer thread only)
+    T& writeBuffer() { return buffers_[backIndex_]; }
+
+    //! publish the write buffer, it becomes available to the reader (writer thread only)
+    void publish()
+    {
+        const uint8_t previousMiddle = middle_.exchange(backIndex_ | FRESH_BIT, std::memory_order_acq_rel);
+        backIndex_ = previousMiddle & INDEX_MASK;
+    }
+
+    //! take the latest published buffer, if any (reader thread only)
+    /*!
+     * @return true if a new buffer was published since the last call
+     */
+    bool update()
+    {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH_BIT))
+            return false;
+
+        const uint8_t previousMiddle = middle_.exchange(frontIndex_, std::memory_order_acq_rel);
+        frontIndex_ = previousMiddle & INDEX_MASK;
+        return true;
+    }
+
+    //! the buffer obtained by the last call to update() (reader thread only)
+    const T& readBuffer() const { return buffers_[frontIndex_]; }
+
+private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH_BIT = 0x4;
+
+    std::array<T, 3> buffers_;
+
+    uint8_t backIndex_;             //! owned by the writer
+    uint8_t frontIndex_;            //! owned by the reader
+    std::atomic<uint8_t> middle_;  //! exchanged between writer and reader, flagged if not yet read
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -10,6 +10,14 @@ namespace optcon {
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, SCALAR>::StateFeedbackPolicyHandler(const SCALAR& dt) : dt_(dt)
+{
+    settings_.dt = dt;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, SCALAR>::StateFeedbackPolicyHandler(
+    const NLOptConSettings& settings)
+    : dt_(settings.dt), settings_(settings)
 {
 }
 
@@ -23,6 +31,12 @@ void StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, SCALAR>::designWarmStart
     const SCALAR& newTimeHorizon,
     StateFeedbackController_t& policy)
 {
+    if (!settings_.hasUniformTimeGrid())
+    {
+        designWarmStartingPolicyNonUniform(delay, newTimeHorizon, policy);
+        return;
+    }
+
     // get the current reference trajectories from the StateFeedbackController
     core::FeedbackTrajectory<STATE_DIM, CONTROL_DIM, SCALAR>& FeedbackTraj = policy.getFeedbackTrajectory();
     core::ControlTrajectory<CONTROL_DIM, SCALAR>& FeedForwardTraj = policy.getFeedforwardTrajectory();
@@ -99,7 +113,11 @@ void StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, SCALAR>::truncateSolutio
     size_t num_di = policy.getFeedforwardTrajectory().getIndexFromTime(delay);
     num_di = std::min(num_di, currentSize - 1);
 
-    effectivelyTruncated = num_di * dt_;
+    if (settings_.hasUniformTimeGrid())
+        effectivelyTruncated = num_di * dt_;
+    else
+        effectivelyTruncated = policy.getFeedforwardTrajectory().getTimeFromIndex(num_di) -
+                               policy.getFeedforwardTrajectory().getTimeFromIndex(0);
 
 #ifdef DEBUG_POLICYHANDLER
     std::cout << "DEBUG_WARMSTART: Current Controller Size:  " << currentSize << " elements." << std::endl;
@@ -116,5 +134,44 @@ void StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, SCALAR>::truncateSolutio
     }
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void StateFeedbackPolicyHandler<STATE_DIM, CONTROL_DIM, SCALAR>::designWarmStartingPolicyNonUniform(
+    const SCALAR& delay,
+    const SCALAR& newTimeHorizon,
+    StateFeedbackController_t& policy)
+{
+    // the grid starts at the current time, hence the stages do not move along with the policy when shifting it
+    const int Kn_new = settings_.computeK(newTimeHorizon);
+    const core::tpl::TimeArray<SCALAR> t_new = settings_.template computeTimeGrid<SCALAR>(Kn_new);
+
+    core::FeedbackTrajectory<STATE_DIM, CONTROL_DIM, SCALAR>& FeedbackTraj = policy.getFeedbackTrajectory();
+    core::ControlTrajectory<CONTROL_DIM, SCALAR>& FeedForwardTraj = policy.getFeedforwardTrajectory();
+    core::StateTrajectory<STATE_DIM, SCALAR>& StateRefTraj = policy.getReferenceStateTrajectory();
+
+    core::FeedbackArray<STATE_DIM, CONTROL_DIM, SCALAR> L(Kn_new);
+    core::ControlVectorArray<CONTROL_DIM, SCALAR> u_ff(Kn_new);
+    core::StateVectorArray<STATE_DIM, SCALAR> x_ref(Kn_new + 1);
+
+    // interpolate the old policy at the shifted grid points, it is held constant beyond its end
+    for (int k = 0; k <= Kn_new; k++)
+    {
+        const SCALAR t = delay + t_new[k];
+        x_ref[k] = StateRefTraj.eval(t);
+        if (k < Kn_new)
+        {
+            L[k] = FeedbackTraj.eval(t);
+            u_ff[k] = FeedForwardTraj.eval(t);
+        }
+    }
+
+#ifdef DEBUG_POLICYHANDLER
+    std::cout << "DEBUG_POLICYHANDLER: Controller resampling: " << std::endl
+              << "delay: " << delay << "  newT: " << newTimeHorizon << std::endl
+              << " new Discrete Controller has " << Kn_new << " control elements." << std::endl;
+#endif
+
+    policy.update(x_ref, u_ff, L, t_new);
+}
+
 }  // namespace optcon
 }  // namespace ct
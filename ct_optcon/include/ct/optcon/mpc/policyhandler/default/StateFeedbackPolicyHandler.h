@@ -20,8 +20,12 @@ public:
 
     typedef core::StateFeedbackController<STATE_DIM, CONTROL_DIM, SCALAR> StateFeedbackController_t;
 
+    //! constructor for a uniform time grid with sampling time dt
     StateFeedbackPolicyHandler(const SCALAR& dt);
 
+    //! constructor for the (possibly non-uniform) time grid of an NLOptCon solver
+    StateFeedbackPolicyHandler(const NLOptConSettings& settings);
+
     virtual ~StateFeedbackPolicyHandler();
 
     virtual void designWarmStartingPolicy(const SCALAR& delay,
@@ -40,7 +44,13 @@ public:
         SCALAR& effectivelyTruncated) override;
 
 private:
+    //! warm start on a non-uniform time grid, interpolates the shifted policy at the points of the new grid
+    void designWarmStartingPolicyNonUniform(const SCALAR& delay,
+        const SCALAR& newTimeHorizon,
+        StateFeedbackController_t& policy);
+
     SCALAR dt_;
+    NLOptConSettings settings_;  //! defines the time grid
 };
 
 }  // namespace optcon
@@ -55,7 +55,8 @@ NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCB
       inputBoxConstraints_(settings.nThreads + 1, nullptr),  // initialize constraints with null
       stateBoxConstraints_(settings.nThreads + 1, nullptr),  // initialize constraints with null
       generalConstraints_(settings.nThreads + 1, nullptr),   // initialize constraints with null
-      lqpCounter_(0)
+      lqpCounter_(0),
+      traceRecorder_(settings.nThreads)
 {
     Eigen::initParallel();
 
@@ -174,9 +175,17 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         L_.resize(K_);
     }
 
+    // with move blocking, all stages of a control block share the control of the first stage of the block
+    if (settings_.lqoc_solver_settings.hasControlBlocks())
+    {
+        const std::vector<int> blockStarts = settings_.lqoc_solver_settings.computeBlockStarts(K_);
+        for (int k = 0; k < K_; k++)
+            u_ff_[k] = u_ff_[blockStarts[k]];
+    }
+
     initialized_ = true;
 
-    t_ = TimeArray(settings_.dt, x_.size(), 0.0);
+    updateTimeGrid();
 
     reset();
 
@@ -195,9 +204,31 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     if (numStages < 1)
         throw std::runtime_error("negative or zero time steps specified");
 
-    K_ = numStages;
+    // when the horizon shrinks, the stages are removed at the front (as in MPC with fixed final time), hence the
+    // cached LQ approximations are shifted. Stages which do not match anymore are detected by the change test.
+    // The shifted stages are evaluated at a different time, hence this is only valid for time-invariant problems.
+    // On a non-uniform grid, the stage durations do not move with the stages, hence the cache cannot be shifted.
+    const bool shiftLQApproximationCache = settings_.incrementalLinearization &&
+                                           settings_.incrementalLinearizationTimeInvariant &&
+                                           settings_.hasUniformTimeGrid() && numStages < K_;
+    if (shiftLQApproximationCache)
+    {
+        const size_t numRemoved = K_ - numStages;
+        t_lin_.erase(t_lin_.begin(), t_lin_.begin() + numRemoved);
+        x_lin_.eraseFront(numRemoved);
+        u_lin_.eraseFront(numRemoved);
+        A_lin_.eraseFront(numRemoved);
+        B_lin_.eraseFront(numRemoved);
+        Q_lin_.eraseFront(numRemoved);
+        R_lin_.eraseFront(numRemoved);
+        P_lin_.eraseFront(numRemoved);
+        C_lin_.eraseFront(numRemoved);
+        D_lin_.eraseFront(numRemoved);
+        lqApproximationCached_.erase(lqApproximationCached_.begin(), lqApproximationCached_.begin() + numRemoved);
+        lqApproximationSkipped_.assign(numStages, 0);
+    }
 
-    t_ = TimeArray(settings_.dt, K_ + 1, 0.0);
+    K_ = numStages;
 
     x_.resize(K_ + 1);
     x_prev_.resize(K_ + 1);
@@ -219,10 +250,15 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 
     systemInterface_->changeNumStages(K_);
 
+    updateTimeGrid();
+
     lqocProblem_->changeNumStages(K_);
     lqocProblem_->setZero();
 
     lqocSolver_->setProblem(lqocProblem_);
+
+    if (!shiftLQApproximationCache)
+        resetLQApproximationCache();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -242,7 +278,17 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         x_.resize(1);
 
     x_[0] = x0;
-    reset();  // since initial state changed, we have to start fresh, i.e. with a rollout
+
+    // since initial state changed, we have to start fresh, i.e. with a rollout. For split MPC iterations, the defects
+    // are kept, as the rollouts overwrite them anyway and the ones of later shots stem from the preparation.
+    if (settings_.splitMPCIteration)
+    {
+        const StateVectorArray d_prepared = d_;
+        reset();
+        d_ = d_prepared;
+    }
+    else
+        reset();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -260,6 +306,8 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         costFunctions_[i] = typename OptConProblem_t::CostFunctionPtr_t(cf->clone());
     }
 
+    resetLQApproximationCache();
+
     // recompute cost if line search is active
     // TODO: this should be multi-threaded to save time
     if (iteration_ > 0 && (settings_.lineSearchSettings.type != LineSearchSettings::TYPE::NONE))
@@ -271,6 +319,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     const typename OptConProblem_t::DynamicsPtr_t& dyn)
 {
     systemInterface_->changeNonlinearSystem(dyn);
+    resetLQApproximationCache();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -336,7 +385,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     // intermediate stages
     for (int i = 0; i < K_; i++)
     {
-        generalConstraints_[settings_.nThreads]->setCurrentStateAndControl(x_[i], u_ff_[i], i * settings_.dt);
+        generalConstraints_[settings_.nThreads]->setCurrentStateAndControl(x_[i], u_ff_[i], t_[i]);
 
         lqocProblem_->ng_[i] = generalConstraints_[settings_.nThreads]->getIntermediateConstraintsCount();
 
@@ -355,6 +404,8 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 
     lqocSolver_->setProblem(lqocProblem_);
 
+    resetLQApproximationCache();
+
     // TODO can we do this multi-threaded?
     if (iteration_ > 0 && (settings_.lineSearchSettings.type != LineSearchSettings::TYPE::NONE))
         computeGeneralConstraintErrorOfTrajectory(settings_.nThreads, x_, u_ff_, e_gen_norm_);
@@ -365,6 +416,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     const typename OptConProblem_t::LinearPtr_t& lin)
 {
     systemInterface_->changeLinearSystem(lin);
+    resetLQApproximationCache();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
@@ -399,18 +451,35 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     // select the linear quadratic solver based on settings file
     if (settings.lqocp_solver == NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER)
     {
-        lqocSolver_ = std::shared_ptr<GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>>(
-            new GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>());
+        // optionally factorize in double precision, if SCALAR is of lower precision
+        if (settings.lqoc_solver_settings.double_precision && !std::is_same<SCALAR, double>::value)
+            lqocSolver_ = wrapDoublePrecisionLQOCSolver(
+                std::shared_ptr<GNRiccatiSolver<STATE_DIM, CONTROL_DIM, double>>(
+                    new GNRiccatiSolver<STATE_DIM, CONTROL_DIM, double>()));
+        else
+            lqocSolver_ = std::shared_ptr<GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>>(
+                new GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>());
     }
     else if (settings.lqocp_solver == NLOptConSettings::LQOCP_SOLVER::HPIPM_SOLVER)
     {
 #ifdef HPIPM
-        lqocSolver_ =
-            std::shared_ptr<HPIPMInterface<STATE_DIM, CONTROL_DIM>>(new HPIPMInterface<STATE_DIM, CONTROL_DIM>());
+        // HPIPM is double precision only
+        lqocSolver_ = wrapDoublePrecisionLQOCSolver(
+            std::shared_ptr<HPIPMInterface<STATE_DIM, CONTROL_DIM>>(new HPIPMInterface<STATE_DIM, CONTROL_DIM>()));
 #else
         throw std::runtime_error("HPIPM selected but not built.");
 #endif
     }
+    else if (settings.lqocp_solver == NLOptConSettings::LQOCP_SOLVER::CONDENSING_SOLVER)
+    {
+        if (settings.lqoc_solver_settings.double_precision && !std::is_same<SCALAR, double>::value)
+            lqocSolver_ = wrapDoublePrecisionLQOCSolver(
+                std::shared_ptr<CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, double>>(
+                    new CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, double>()));
+        else
+            lqocSolver_ = std::shared_ptr<CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>>(
+                new CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>());
+    }
     else
         throw std::runtime_error("Solver for Linear Quadratic Optimal Control Problem wrongly specified.");
 
@@ -427,11 +496,26 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 
     settings_ = settings;
 
+    // the time grid depends on the settings, it is set up in changeTimeHorizon() when the backend is constructed
+    if (K_ > 0)
+        updateTimeGrid();
+
     reset();
 
+    resetLQApproximationCache();
+
     configured_ = true;
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::updateTimeGrid()
+{
+    t_ = settings_.template computeTimeGrid<SCALAR>(K_);
+
+    // the discretizers keep their uniform time discretization if all stages last dt
+    systemInterface_->changeTimeGrid(settings_.hasUniformTimeGrid() ? TimeArray() : t_);
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::rolloutSingleShot(const size_t threadId,
     const size_t k,  //! the starting index of the shot
@@ -459,6 +543,11 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     if (K_stop > K_local)
         K_stop = K_local;
 
+    //! with move blocking, the stages inside a block hold the closed-loop control of the first stage of the block
+    const bool holdBlocks = settings_.closedLoopShooting() && settings_.lqoc_solver_settings.hasControlBlocks();
+    const std::vector<int> blockStarts =
+        holdBlocks ? settings_.lqoc_solver_settings.computeBlockStarts(K_local) : std::vector<int>();
+
     // for each control step
     for (int i = (int)k; i < K_stop; i++)
     {
@@ -471,7 +560,12 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         }
 
         if (settings_.closedLoopShooting())  // overwrite control
-            u_local[i] += L_[i] * (xShot[i] - x_ref_lqr_local[i]);
+        {
+            if (!blockStarts.empty() && i > (int)k && blockStarts[i] != i)
+                u_local[i] = u_local[i - 1];
+            else
+                u_local[i] += L_[i] * (xShot[i] - x_ref_lqr_local[i]);
+        }
 
         //! @todo: here we override the state trajectory directly (as passed by reference). This is bad.
         if (i > (int)k)
@@ -581,14 +675,13 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     for (size_t k = 0; k < (size_t)K_; k++)
     {
         // feed current state and control to cost function
-        costFunctions_[threadId]->setCurrentStateAndControl(x_local[k], u_local[k], settings_.dt * k);
+        costFunctions_[threadId]->setCurrentStateAndControl(x_local[k], u_local[k], t_[k]);
 
         // derivative of cost with respect to state
-        intermediateCost += costFunctions_[threadId]->evaluateIntermediate();
+        intermediateCost += costFunctions_[threadId]->evaluateIntermediate() * getStageDuration(k);
     }
-    intermediateCost *= settings_.dt;
 
-    costFunctions_[threadId]->setCurrentStateAndControl(x_local[K_], control_vector_t::Zero(), settings_.dt * K_);
+    costFunctions_[threadId]->setCurrentStateAndControl(x_local[K_], control_vector_t::Zero(), t_[K_]);
     finalCost = costFunctions_[threadId]->evaluateTerminal();
 }
 
@@ -608,34 +701,30 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         {
             if (inputBoxConstraints_[threadId]->getIntermediateConstraintsCount() > 0)
             {
-                inputBoxConstraints_[threadId]->setCurrentStateAndControl(x_local[k], u_local[k], settings_.dt * k);
+                inputBoxConstraints_[threadId]->setCurrentStateAndControl(x_local[k], u_local[k], t_[k]);
                 Eigen::Matrix<SCALAR, -1, 1> box_err =
                     inputBoxConstraints_[threadId]->getTotalBoundsViolationIntermediate();
-                e_tot += box_err.template lpNorm<1>();
+                e_tot += box_err.template lpNorm<1>() * getStageDuration(k);
             }
         }
         if (stateBoxConstraints_[threadId] != nullptr)
         {
             if (stateBoxConstraints_[threadId]->getIntermediateConstraintsCount() > 0)
             {
-                stateBoxConstraints_[threadId]->setCurrentStateAndControl(x_local[k], u_local[k], settings_.dt * k);
+                stateBoxConstraints_[threadId]->setCurrentStateAndControl(x_local[k], u_local[k], t_[k]);
                 Eigen::Matrix<SCALAR, -1, 1> box_err =
                     stateBoxConstraints_[threadId]->getTotalBoundsViolationIntermediate();
-                e_tot += box_err.template lpNorm<1>();
+                e_tot += box_err.template lpNorm<1>() * getStageDuration(k);
             }
         }
     }
 
-    // normalize integrated violation by time
-    e_tot *= settings_.dt;
-
     // terminal constraint violation
     if (stateBoxConstraints_[threadId] != nullptr)
     {
         if (stateBoxConstraints_[threadId]->getTerminalConstraintsCount() > 0)
         {
-            stateBoxConstraints_[threadId]->setCurrentStateAndControl(
-                x_local[K_], control_vector_t::Zero(), settings_.dt * K_);
+            stateBoxConstraints_[threadId]->setCurrentStateAndControl(x_local[K_], control_vector_t::Zero(), t_[K_]);
             Eigen::Matrix<SCALAR, -1, 1> box_err = stateBoxConstraints_[threadId]->getTotalBoundsViolationTerminal();
             e_tot += box_err.template lpNorm<1>();
         }
@@ -658,23 +747,19 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
         {
             if (generalConstraints_[threadId]->getIntermediateConstraintsCount() > 0)
             {
-                generalConstraints_[threadId]->setCurrentStateAndControl(x_local[k], u_local[k], settings_.dt * k);
+                generalConstraints_[threadId]->setCurrentStateAndControl(x_local[k], u_local[k], t_[k]);
                 Eigen::Matrix<SCALAR, -1, 1> gen_err =
                     generalConstraints_[threadId]->getTotalBoundsViolationIntermediate();
-                e_tot += gen_err.template lpNorm<1>();
+                e_tot += gen_err.template lpNorm<1>() * getStageDuration(k);
             }
         }
     }
 
-    // normalize integrated violation by time
-    e_tot *= settings_.dt;
-
     if (generalConstraints_[threadId] != nullptr)
     {
         if (generalConstraints_[threadId]->getTerminalConstraintsCount() > 0)
         {
-            generalConstraints_[threadId]->setCurrentStateAndControl(
-                x_local[K_], control_vector_t::Zero(), settings_.dt * K_);
+            generalConstraints_[threadId]->setCurrentStateAndControl(x_local[K_], control_vector_t::Zero(), t_[K_]);
             Eigen::Matrix<SCALAR, -1, 1> gen_err = generalConstraints_[threadId]->getTotalBoundsViolationTerminal();
             e_tot += gen_err.template lpNorm<1>();
         }
@@ -686,7 +771,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     size_t k)
 {
     LQOCProblem_t& p = *lqocProblem_;
-    const scalar_t& dt = settings_.dt;
+    const scalar_t dt = getStageDuration(k);
 
     assert(lqocProblem_ != nullptr);
 
@@ -695,31 +780,110 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     assert(lqocProblem_->b_.size() > k);
 
 
+    // in incremental mode, stages which did not move since their last linearization reuse the cached approximation
+    const bool reuse = settings_.incrementalLinearization && lqApproximationIsCurrent(k);
+    lqApproximationSkipped_[k] = reuse;
+
     //! @warning it is important that the calculations are done with local variables x_ and u_ff_, they will only later be stored in the LQOCProblem
     // compute A_n and B_n
-    systemInterface_->setSubstepTrajectoryReference(substepsX_, substepsU_, threadId);
-    systemInterface_->getAandB(x_[k], u_ff_[k], xShot_[k], (int)k, settings_.K_sim, p.A_[k], p.B_[k], threadId);
+    if (reuse)
+    {
+        p.A_[k] = A_lin_[k];
+        p.B_[k] = B_lin_[k];
+    }
+    else
+    {
+        systemInterface_->setSubstepTrajectoryReference(substepsX_, substepsU_, threadId);
+        systemInterface_->getAandB(x_[k], u_ff_[k], xShot_[k], (int)k, settings_.K_sim, p.A_[k], p.B_[k], threadId);
+    }
 
     // compute dynamics offset term b_n
     p.b_[k] = d_[k];
 
-    // feed current state and control to cost function
-    costFunctions_[threadId]->setCurrentStateAndControl(x_[k], u_ff_[k], dt * k);
-
-    // By using the following order of evaluations, we avoid caching matrices
-    // second derivative w.r.t state
-    p.Q_[k] = costFunctions_[threadId]->stateSecondDerivativeIntermediate() * dt;
-    // second derivative w.r.t control
-    p.R_[k] = costFunctions_[threadId]->controlSecondDerivativeIntermediate() * dt;
-    // cross terms
-    p.P_[k] = costFunctions_[threadId]->stateControlDerivativeIntermediate() * dt;
+    // in horizon mode, the cost approximation was already computed by computeQuadraticCostsHorizon()
+    if (!settings_.horizonCostEvaluation)
+    {
+        // feed current state and control to cost function
+        costFunctions_[threadId]->setCurrentStateAndControl(x_[k], u_ff_[k], t_[k]);
 
-    // derivative of cost with respect to state
-    p.qv_[k] = costFunctions_[threadId]->stateDerivativeIntermediate() * dt;
-    // derivative of cost with respect to control
-    p.rv_[k] = costFunctions_[threadId]->controlDerivativeIntermediate() * dt;
+        if (reuse)
+        {
+            p.Q_[k] = Q_lin_[k];
+            p.R_[k] = R_lin_[k];
+            p.P_[k] = P_lin_[k];
+
+            // derivative of cost with respect to state
+            p.qv_[k] = costFunctions_[threadId]->stateDerivativeIntermediate() * dt;
+            // derivative of cost with respect to control
+            p.rv_[k] = costFunctions_[threadId]->controlDerivativeIntermediate() * dt;
+        }
+        else
+        {
+            // all first and second order derivatives in a single pass over the cost terms
+            costFunctions_[threadId]->quadratizeIntermediate(p.qv_[k], p.Q_[k], p.rv_[k], p.R_[k], p.P_[k]);
+            p.qv_[k] *= dt;
+            p.Q_[k] *= dt;
+            p.rv_[k] *= dt;
+            p.R_[k] *= dt;
+            p.P_[k] *= dt;
+        }
+    }
 
     // p.q_[k] = ... // not evaluated since we don't need it in GNMS/iLQR -- WARNING, potentially implement when using a different QP solver
+
+    // store the new linearization point and approximation
+    if (settings_.incrementalLinearization && !reuse)
+    {
+        t_lin_[k] = t_[k];
+        x_lin_[k] = x_[k];
+        u_lin_[k] = u_ff_[k];
+        A_lin_[k] = p.A_[k];
+        B_lin_[k] = p.B_[k];
+        Q_lin_[k] = p.Q_[k];
+        R_lin_[k] = p.R_[k];
+        P_lin_[k] = p.P_[k];
+        C_lin_[k].resize(0, STATE_DIM);
+        D_lin_[k].resize(0, CONTROL_DIM);
+        lqApproximationCached_[k] = true;
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::lqApproximationIsCurrent(
+    size_t k) const
+{
+    if (!lqApproximationCached_[k])
+        return false;
+
+    // unless the problem is declared time-invariant, the stage time is part of the linearization point
+    if (!settings_.incrementalLinearizationTimeInvariant && t_lin_[k] != t_[k])
+        return false;
+
+    const SCALAR tol = settings_.incrementalLinearizationTol;
+    return ((x_[k] - x_lin_[k]).template lpNorm<Eigen::Infinity>() <= tol &&
+            (u_ff_[k] - u_lin_[k]).template lpNorm<Eigen::Infinity>() <= tol);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::resetLQApproximationCache()
+{
+    // the approximations are only stored if the incremental re-linearization is active
+    const size_t K_cache = settings_.incrementalLinearization ? K_ : 0;
+    t_lin_.resize(K_cache);
+    x_lin_.resize(K_cache);
+    u_lin_.resize(K_cache);
+    A_lin_.resize(K_cache);
+    B_lin_.resize(K_cache);
+    Q_lin_.resize(K_cache);
+    R_lin_.resize(K_cache);
+    P_lin_.resize(K_cache);
+    C_lin_.resize(K_cache);
+    D_lin_.resize(K_cache);
+
+    lqApproximationCached_.assign(K_, 0);
+    lqApproximationSkipped_.assign(K_, 0);
 }
 
 
@@ -795,16 +959,30 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     if (generalConstraints_[threadId] != nullptr)
     {
         LQOCProblem_t& p = *lqocProblem_;
-        const scalar_t& dt = settings_.dt;
 
         // treat general constraints
-        generalConstraints_[threadId]->setCurrentStateAndControl(x_[k], u_ff_[k], dt * k);
+        generalConstraints_[threadId]->setCurrentStateAndControl(x_[k], u_ff_[k], t_[k]);
 
         p.ng_[k] = generalConstraints_[threadId]->getIntermediateConstraintsCount();
         if (p.ng_[k] > 0)
         {
-            p.C_[k] = generalConstraints_[threadId]->jacobianStateIntermediate();
-            p.D_[k] = generalConstraints_[threadId]->jacobianInputIntermediate();
+            // the constraint jacobians are part of the cached stage approximation
+            if (lqApproximationSkipped_[k])
+            {
+                p.C_[k] = C_lin_[k];
+                p.D_[k] = D_lin_[k];
+            }
+            else
+            {
+                p.C_[k] = generalConstraints_[threadId]->jacobianStateIntermediate();
+                p.D_[k] = generalConstraints_[threadId]->jacobianInputIntermediate();
+
+                if (settings_.incrementalLinearization)
+                {
+                    C_lin_[k] = p.C_[k];
+                    D_lin_[k] = p.D_[k];
+                }
+            }
 
             Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> g_eval = generalConstraints_[threadId]->evaluateIntermediate();
 
@@ -815,13 +993,47 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     }
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeQuadraticCostsHorizon(
+    size_t firstIndex,
+    size_t lastIndex)
+{
+    LQOCProblem_t& p = *lqocProblem_;
+
+    ct::core::tpl::TimeArray<SCALAR> times(t_);
+    times.pop_back();
+
+    // the cost function only re-evaluates time-varying terms if the horizon changed
+    costFunctions_[settings_.nThreads]->prepareHorizon(times);
+
+    if (settings_.hasUniformTimeGrid())
+    {
+        costFunctions_[settings_.nThreads]->quadratizeIntermediateHorizon(
+            x_, u_ff_, firstIndex, lastIndex, settings_.dt, p.qv_, p.Q_, p.rv_, p.R_, p.P_);
+        return;
+    }
+
+    // on a non-uniform grid, every stage is weighted with its own duration
+    costFunctions_[settings_.nThreads]->quadratizeIntermediateHorizon(
+        x_, u_ff_, firstIndex, lastIndex, 1.0, p.qv_, p.Q_, p.rv_, p.R_, p.P_);
+    for (size_t k = firstIndex; k <= lastIndex; k++)
+    {
+        const SCALAR dt = getStageDuration(k);
+        p.qv_[k] *= dt;
+        p.Q_[k] *= dt;
+        p.rv_[k] *= dt;
+        p.R_[k] *= dt;
+        p.P_[k] *= dt;
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::initializeCostToGo()
 {
     LQOCProblem_t& p = *lqocProblem_;
 
     // feed current state and control to cost function
-    costFunctions_[settings_.nThreads]->setCurrentStateAndControl(x_[K_], control_vector_t::Zero(), settings_.dt * K_);
+    costFunctions_[settings_.nThreads]->setCurrentStateAndControl(x_[K_], control_vector_t::Zero(), t_[K_]);
 
     // derivative of terminal cost with respect to state
     p.Q_[K_] = costFunctions_[settings_.nThreads]->stateSecondDerivativeTerminal();
@@ -853,14 +1065,17 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     SCALAR d_norm_l2 = computeDefectsNorm<2>(d_);
     SCALAR totalCost = intermediateCostBest_ + finalCostBest_;
 
-    computeBoxConstraintErrorOfTrajectory(settings_.nThreads, x_, u_ff_, e_box_norm_);
-    computeGeneralConstraintErrorOfTrajectory(settings_.nThreads, x_, u_ff_, e_gen_norm_);
+    {
+        NLOC_TRACE_SCOPE(traceRecorder_, settings_.nThreads, "constraint evaluation");
+        computeBoxConstraintErrorOfTrajectory(settings_.nThreads, x_, u_ff_, e_box_norm_);
+        computeGeneralConstraintErrorOfTrajectory(settings_.nThreads, x_, u_ff_, e_gen_norm_);
+    }
 
     SCALAR totalMerit = intermediateCostBest_ + finalCostBest_ + settings_.meritFunctionRho * d_norm_l1 +
                         settings_.meritFunctionRhoConstraints * (e_box_norm_ + e_gen_norm_);
 
     SCALAR smallestEigenvalue = 0.0;
-    if (settings_.recordSmallestEigenvalue && settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER)
+    if (settings_.recordSmallestEigenvalue && settings_.lqocp_solver != Settings_t::LQOCP_SOLVER::HPIPM_SOLVER)
     {
         smallestEigenvalue = lqocSolver_->getSmallestEigenvalue();
     }
@@ -879,13 +1094,15 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     summaryAllIterations_.merits.push_back(totalMerit);
     summaryAllIterations_.stepSizes.push_back(alphaBest_);
     summaryAllIterations_.smallestEigenvalues.push_back(smallestEigenvalue);
+    summaryAllIterations_.skippedLQApproximations.push_back(getNumSkippedLQApproximations());
+    traceRecorder_.collect(iteration_, summaryAllIterations_.traceEvents);
 
     if (settings_.printSummary)
         summaryAllIterations_.printSummaryLastIteration();
 
     //! @todo the printing of the smallest eigenvalue is hacky
     if (settings_.printSummary && settings_.recordSmallestEigenvalue &&
-        settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::GNRICCATI_SOLVER)
+        settings_.lqocp_solver != Settings_t::LQOCP_SOLVER::HPIPM_SOLVER)
     {
         std::cout << std::setprecision(15) << "smallest eigenvalue this iteration: " << smallestEigenvalue << std::endl;
     }
@@ -942,6 +1159,45 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setBinaryLogger(
+    const std::shared_ptr<core::BinaryLogger>& logger)
+{
+    binaryLogger_ = logger;
+    if (!binaryLogger_)
+        return;
+
+    binaryLogChannelX_ = binaryLogger_->addChannel(settings_.loggingPrefix + "/x");
+    binaryLogChannelU_ = binaryLogger_->addChannel(settings_.loggingPrefix + "/u_ff");
+    binaryLogChannelL_ = binaryLogger_->addChannel(settings_.loggingPrefix + "/L");
+    binaryLogChannelSummary_ = binaryLogger_->addChannel(settings_.loggingPrefix + "/summary");
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::logToBinaryLogger()
+{
+    if (!binaryLogger_)
+        return;
+
+    const double time = binaryLogger_->now();
+    binaryLogger_->logTrajectory(binaryLogChannelX_, iteration_, time, x_);
+    binaryLogger_->logTrajectory(binaryLogChannelU_, iteration_, time, u_ff_);
+    binaryLogger_->logTrajectory(binaryLogChannelL_, iteration_, time, L_);
+
+    // the norms are up to date after printSummary()
+    const SummaryAllIterations<SCALAR>& s = summaryAllIterations_;
+    if (s.iterations.empty())
+        return;
+
+    const double summary[8] = {static_cast<double>(s.iterations.back()), static_cast<double>(s.totalCosts.back()),
+        static_cast<double>(s.defect_l1_norms.back()), static_cast<double>(s.e_box_norms.back()),
+        static_cast<double>(s.e_gen_norms.back()), static_cast<double>(s.lx_norms.back()),
+        static_cast<double>(s.lu_norms.back()), static_cast<double>(s.stepSizes.back())};
+    binaryLogger_->log(binaryLogChannelSummary_, iteration_, time, summary, 8, 1);
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::logInitToMatlab()
 {
@@ -1062,7 +1318,10 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
             std::cout << "[LineSearch]: Merit of last rollout:\t" << lowestCost_ << std::endl;
         }
 
-        alphaBest_ = performLineSearch();
+        {
+            NLOC_TRACE_SCOPE(traceRecorder_, settings_.nThreads, "line search");
+            alphaBest_ = performLineSearch();
+        }
 
         if (settings_.lineSearchSettings.debugPrint)
         {
@@ -1128,6 +1387,8 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
     if (terminationFlag && *terminationFlag)
         return;
 
+    NLOC_TRACE_SCOPE(traceRecorder_, threadId, "line search alpha", 0, K_ - 1, alpha);
+
     // update feedforward with weighting alpha
     u_alpha = delta_u_ff_ * alpha + u_ff_prev_;
 
@@ -1163,6 +1424,7 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
             return;
 
         // compute constraint violations specific to this alpha
+        NLOC_TRACE_SCOPE(traceRecorder_, threadId, "constraint evaluation", -1, -1, alpha);
         if ((inputBoxConstraints_[threadId] != nullptr) | (stateBoxConstraints_[threadId] != nullptr))
             computeBoxConstraintErrorOfTrajectory(threadId, x_alpha, u_alpha, e_box_norm);
 
@@ -1279,10 +1541,13 @@ bool NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::prepareSolveLQProblem(size_t startIndex)
 {
+    NLOC_TRACE_SCOPE(traceRecorder_, settings_.nThreads, "LQ solve prepare", static_cast<int>(startIndex), K_ - 1);
+
     lqpCounter_++;
 
-    // if solver is HPIPM, there's nothing to prepare
-    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER)
+    // if solver is HPIPM or condensing, there's nothing to prepare
+    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER ||
+        settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::CONDENSING_SOLVER)
     {
         // do nothing
     }
@@ -1303,10 +1568,13 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::finishSolveLQProblem(size_t endIndex)
 {
+    NLOC_TRACE_SCOPE(traceRecorder_, settings_.nThreads, "LQ solve finish", 0, static_cast<int>(endIndex));
+
     lqpCounter_++;
 
-    // if solver is HPIPM, solve the full problem
-    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER)
+    // if solver is HPIPM or condensing, solve the full problem
+    if (settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::HPIPM_SOLVER ||
+        settings_.lqocp_solver == Settings_t::LQOCP_SOLVER::CONDENSING_SOLVER)
     {
         solveFullLQProblem();
     }
@@ -1327,6 +1595,8 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::solveFullLQProblem()
 {
+    NLOC_TRACE_SCOPE(traceRecorder_, settings_.nThreads, "LQ solve", 0, K_ - 1);
+
     lqpCounter_++;
 
     lqocSolver_->setProblem(lqocProblem_);
@@ -1461,6 +1731,12 @@ void NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+size_t NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getNumSkippedLQApproximations() const
+{
+    return std::accumulate(lqApproximationSkipped_.begin(), lqApproximationSkipped_.end(), size_t(0));
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 const SummaryAllIterations<SCALAR>&
 NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getSummary() const
@@ -1646,7 +1922,7 @@ NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getGe
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 SCALAR NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getTimeHorizon()
 {
-    return K_ * settings_.dt;
+    return t_.back();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
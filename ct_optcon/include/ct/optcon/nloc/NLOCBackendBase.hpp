@@ -6,6 +6,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #pragma once
 
 #include <atomic>
+#include <numeric>
 
 #include <ct/optcon/costfunction/CostFunctionQuadratic.hpp>
 #include <ct/optcon/solver/OptConSolver.h>
@@ -14,6 +15,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <ct/optcon/solver/lqp/GNRiccatiSolver.hpp>
 #include <ct/optcon/solver/lqp/HPIPMInterface.hpp>
+#include <ct/optcon/solver/lqp/CondensingLQOCSolver.hpp>
+#include <ct/optcon/solver/lqp/MixedPrecisionLQOCSolver.hpp>
 
 #include <ct/optcon/solver/NLOptConSettings.hpp>
 
@@ -161,32 +164,32 @@ public:
     /*!
      * \brief Change the cost function
      */
-    void changeCostFunction(const typename OptConProblem_t::CostFunctionPtr_t& cf);
+    virtual void changeCostFunction(const typename OptConProblem_t::CostFunctionPtr_t& cf);
 
     /*!
      * \brief Change the nonlinear system
      */
-    void changeNonlinearSystem(const typename OptConProblem_t::DynamicsPtr_t& dyn);
+    virtual void changeNonlinearSystem(const typename OptConProblem_t::DynamicsPtr_t& dyn);
 
     /*!
      * \brief Change the linear system
      */
-    void changeLinearSystem(const typename OptConProblem_t::LinearPtr_t& lin);
+    virtual void changeLinearSystem(const typename OptConProblem_t::LinearPtr_t& lin);
 
     /*!
      * \brief Change the input box constraints
      */
-    void changeInputBoxConstraints(const typename OptConProblem_t::ConstraintPtr_t& con);
+    virtual void changeInputBoxConstraints(const typename OptConProblem_t::ConstraintPtr_t& con);
 
     /*!
      * \brief Change the state box constraints
      */
-    void changeStateBoxConstraints(const typename OptConProblem_t::ConstraintPtr_t& con);
+    virtual void changeStateBoxConstraints(const typename OptConProblem_t::ConstraintPtr_t& con);
 
     /*!
      * \brief Change the general constraints
      */
-    void changeGeneralConstraints(const typename OptConProblem_t::ConstraintPtr_t& con);
+    virtual void changeGeneralConstraints(const typename OptConProblem_t::ConstraintPtr_t& con);
 
     /*!
      * \brief Direct accessor to the system instances
@@ -275,6 +278,17 @@ public:
     //! log the initial guess to Matlab
     void logInitToMatlab();
 
+    //! stream the trajectories and the summary of every iteration to a binary logger, nullptr disables it
+    /*!
+     * Registers the channels "<loggingPrefix>/x", "/u_ff", "/L" and "/summary", the latter containing iteration,
+     * total cost, defect l1-norm, box and general constraint violation, lx-norm, lu-norm and step size.
+     * The logger copies the data into its ring buffer, the file is written by its background thread.
+     */
+    void setBinaryLogger(const std::shared_ptr<core::BinaryLogger>& logger);
+
+    //! push the current iteration to the binary logger, if one is set
+    void logToBinaryLogger();
+
     //! return the cost of the solution of the current iteration
     SCALAR getCost() const;
 
@@ -382,6 +396,9 @@ public:
 
     const SummaryAllIterations<SCALAR>& getSummary() const;
 
+    //! return the number of stages whose LQ approximation was reused in the most recent LQ approximation
+    size_t getNumSkippedLQApproximations() const;
+
 protected:
     //! integrate the individual shots
     bool rolloutSingleShot(const size_t threadId,
@@ -420,6 +437,18 @@ protected:
     void executeLQApproximation(size_t threadId, size_t k);
 
 
+    //! Computes the quadratic cost approximation for a range of stages at once
+    /*!
+      Used instead of the per-stage cost approximation in executeLQApproximation() if
+      NLOptConSettings::horizonCostEvaluation is set. The time-varying data of the cost function is precomputed
+      for the whole horizon, which is only repeated if the horizon changes.
+
+      \param firstIndex first stage
+      \param lastIndex last stage
+    */
+    void computeQuadraticCostsHorizon(size_t firstIndex, size_t lastIndex);
+
+
     //! Computes the linearized general constraints at a specific point of the trajectory
     /*!
       This function calculates the linearization, i.e. matrices d, C and D in \f$ d_{lb} \leq C \delta x + D \delta u \leq d_{ub}\f$
@@ -432,6 +461,29 @@ protected:
     */
     void computeLinearizedConstraints(size_t threadId, size_t k);
 
+    //! check if the cached LQ approximation of stage k can be reused
+    /*!
+     * A stage is not re-linearized if neither its state nor its control moved by more than
+     * NLOptConSettings::incrementalLinearizationTol (inf-norm) since the cached approximation was computed, and if
+     * it is evaluated at the same stage time. The time is ignored if the problem is declared time-invariant.
+     * The affine terms, i.e. the defect, the cost gradients and the constraint bounds, are always updated.
+     *
+     * \param k step k
+     */
+    bool lqApproximationIsCurrent(size_t k) const;
+
+    //! invalidate the cached LQ approximations of all stages, required whenever the problem changes
+    void resetLQApproximationCache();
+
+    //! recompute the time grid for the current number of stages and pass it on to the system interface
+    void updateTimeGrid();
+
+    //! the duration of stage k, the cost and constraint violation of the stage are weighted with it
+    SCALAR getStageDuration(size_t k) const
+    {
+        return settings_.hasUniformTimeGrid() ? (SCALAR)settings_.dt : t_[k + 1] - t_[k];
+    }
+
     //! Initializes cost to go
     /*!
      * This function initializes the cost-to-go function at time K.
@@ -549,6 +601,21 @@ protected:
     template <size_t ORDER = 1>
     SCALAR computeDefectsNorm(const StateVectorArray& d) const;
 
+    //! use a double precision LQ solver, wrapping it for SCALAR types other than double
+    template <typename S = SCALAR>
+    typename std::enable_if<std::is_same<S, double>::value, std::shared_ptr<LQOCSolver_t>>::type
+    wrapDoublePrecisionLQOCSolver(const std::shared_ptr<LQOCSolver<STATE_DIM, CONTROL_DIM, double>>& solver)
+    {
+        return solver;
+    }
+
+    template <typename S = SCALAR>
+    typename std::enable_if<!std::is_same<S, double>::value, std::shared_ptr<LQOCSolver_t>>::type
+    wrapDoublePrecisionLQOCSolver(const std::shared_ptr<LQOCSolver<STATE_DIM, CONTROL_DIM, double>>& solver)
+    {
+        return std::shared_ptr<LQOCSolver_t>(new MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>(solver));
+    }
+
     bool initialized_;
     bool configured_;
 
@@ -619,6 +686,33 @@ protected:
 
     SummaryAllIterations<SCALAR> summaryAllIterations_;
 
+    //! optional streaming logger and its channel ids
+    std::shared_ptr<core::BinaryLogger> binaryLogger_;
+    size_t binaryLogChannelX_;
+    size_t binaryLogChannelU_;
+    size_t binaryLogChannelL_;
+    size_t binaryLogChannelSummary_;
+
+    //! per-thread recorder of the timed phases, only used when compiled with NLOC_TRACE
+    mutable NLOCTraceRecorder traceRecorder_;
+
+    /*!
+     * cache for the incremental re-linearization: the points at which the stages were last linearized and the
+     * corresponding LQ approximations. Flags are stored as int since the stages are written by concurrent threads.
+     */
+    std::vector<scalar_t> t_lin_;
+    StateVectorArray x_lin_;
+    ControlVectorArray u_lin_;
+    StateMatrixArray A_lin_;
+    StateControlMatrixArray B_lin_;
+    StateMatrixArray Q_lin_;
+    ControlMatrixArray R_lin_;
+    FeedbackArray P_lin_;
+    typename LQOCProblem_t::constr_state_jac_array_t C_lin_;
+    typename LQOCProblem_t::constr_control_jac_array_t D_lin_;
+    std::vector<int> lqApproximationCached_;   //! stage has a valid cached approximation
+    std::vector<int> lqApproximationSkipped_;  //! stage reused its cached approximation in the last LQ approximation
+
     //! if building with MATLAB support, include matfile
 #ifdef MATLAB
     matlab::MatFile matFile_;
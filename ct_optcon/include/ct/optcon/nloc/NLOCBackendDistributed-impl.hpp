@@ -0,0 +1,708 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <cstdio>
+#include <ctime>
+#include <csignal>
+#include <fstream>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+namespace ct {
+namespace optcon {
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCBackendDistributed(
+    const OptConProblem_t& optConProblem,
+    const NLOptConSettings& settings)
+    : Base(optConProblem, settings), workersK_(-1), workersIteration_(0)
+{
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOCBackendDistributed(
+    const OptConProblem_t& optConProblem,
+    const std::string& settingsFile,
+    bool verbose,
+    const std::string& ns)
+    : Base(optConProblem, settingsFile, verbose, ns), workersK_(-1), workersIteration_(0)
+{
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::~NLOCBackendDistributed()
+{
+    shutdownWorkers();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::configure(
+    const NLOptConSettings& settings)
+{
+    Base::configure(settings);
+
+    // the workers hold a copy of the settings, they get restarted on demand
+    shutdownWorkers();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::changeCostFunction(
+    const typename OptConProblem_t::CostFunctionPtr_t& cf)
+{
+    Base::changeCostFunction(cf);
+    shutdownWorkers();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::changeNonlinearSystem(
+    const typename OptConProblem_t::DynamicsPtr_t& dyn)
+{
+    Base::changeNonlinearSystem(dyn);
+    shutdownWorkers();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::changeLinearSystem(
+    const typename OptConProblem_t::LinearPtr_t& lin)
+{
+    Base::changeLinearSystem(lin);
+    shutdownWorkers();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::changeInputBoxConstraints(
+    const typename OptConProblem_t::ConstraintPtr_t& con)
+{
+    Base::changeInputBoxConstraints(con);
+    shutdownWorkers();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::changeStateBoxConstraints(
+    const typename OptConProblem_t::ConstraintPtr_t& con)
+{
+    Base::changeStateBoxConstraints(con);
+    shutdownWorkers();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::changeGeneralConstraints(
+    const typename OptConProblem_t::ConstraintPtr_t& con)
+{
+    Base::changeGeneralConstraints(con);
+    shutdownWorkers();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeLQApproximation(
+    size_t firstIndex,
+    size_t lastIndex)
+{
+    NLOC_TRACE_SCOPE(this->traceRecorder_, this->settings_.nThreads, "LQ approximation", static_cast<int>(firstIndex),
+        static_cast<int>(lastIndex));
+
+    if (lastIndex == static_cast<size_t>(this->K_) - 1)
+        this->initializeCostToGo();
+
+    ensureWorkers();
+    writeTrajectories(firstIndex, lastIndex, this->u_ff_, this->x_, this->x_ref_lqr_, this->xShot_, this->d_);
+
+    if (!dispatch(COMPUTE_LQ_PROBLEM, firstIndex, lastIndex))
+        throw std::runtime_error("NLOCBackendDistributed: computing the LQ approximation failed in a worker.");
+
+    typename Base::LQOCProblem_t& p = *this->lqocProblem_;
+    fromShared(A, p.A_, firstIndex, lastIndex);
+    fromShared(B, p.B_, firstIndex, lastIndex);
+    fromShared(B_OFFSET, p.b_, firstIndex, lastIndex);
+
+    // in horizon mode, the workers skip the cost approximation
+    if (this->settings_.horizonCostEvaluation)
+        this->computeQuadraticCostsHorizon(firstIndex, lastIndex);
+    else
+    {
+        fromShared(Q, p.Q_, firstIndex, lastIndex);
+        fromShared(P, p.P_, firstIndex, lastIndex);
+        fromShared(R, p.R_, firstIndex, lastIndex);
+        fromShared(QV, p.qv_, firstIndex, lastIndex);
+        fromShared(RV, p.rv_, firstIndex, lastIndex);
+    }
+
+    const SCALAR* skipped = sharedMemory_->template get<SCALAR>(sharedOffsets_[LQ_SKIPPED]);
+    for (size_t k = firstIndex; k <= lastIndex && k < this->lqApproximationSkipped_.size(); k++)
+        this->lqApproximationSkipped_[k] = static_cast<int>(skipped[k]);
+
+    // the general constraints are linearized by the coordinator
+    if (this->generalConstraints_[this->settings_.nThreads] != nullptr)
+        for (size_t k = firstIndex; k <= lastIndex; k++)
+            this->computeLinearizedConstraints(this->settings_.nThreads, k);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::rolloutShots(size_t firstIndex,
+    size_t lastIndex)
+{
+    NLOC_TRACE_SCOPE(this->traceRecorder_, this->settings_.nThreads, "rollout", static_cast<int>(firstIndex),
+        static_cast<int>(lastIndex));
+
+    ensureWorkers();
+    writeTrajectories(firstIndex, lastIndex, this->u_ff_, this->x_, this->x_ref_lqr_, this->xShot_, this->d_);
+    if (!dispatch(ROLLOUT_SHOTS, firstIndex, lastIndex))
+        throw std::runtime_error("NLOCBackendDistributed: rolling out the shots failed in a worker.");
+    readTrajectories(firstIndex, lastIndex, this->u_ff_, this->x_, this->xShot_, this->d_);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+SCALAR NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::performLineSearch()
+{
+    // we start with extrapolation
+    double alpha = this->settings_.lineSearchSettings.alpha_0;
+    double alphaBest = 0.0;
+    size_t iterations = 0;
+
+    this->lx_norm_ = 0.0;
+    this->lu_norm_ = 0.0;
+
+    ensureWorkers();
+
+    while (iterations < this->settings_.lineSearchSettings.maxIterations)
+    {
+        if (this->settings_.lineSearchSettings.debugPrint)
+            std::cout << "[LineSearch]: Iteration: " << iterations << ", try alpha: " << alpha << " out of maximum "
+                      << this->settings_.lineSearchSettings.maxIterations << " iterations. " << std::endl;
+
+        iterations++;
+
+        SCALAR cost = std::numeric_limits<SCALAR>::max();
+        SCALAR intermediateCost = std::numeric_limits<SCALAR>::max();
+        SCALAR finalCost = std::numeric_limits<SCALAR>::max();
+        SCALAR defectNorm = std::numeric_limits<SCALAR>::max();
+        SCALAR e_box_norm = std::numeric_limits<SCALAR>::max();
+        SCALAR e_gen_norm = std::numeric_limits<SCALAR>::max();
+
+        ct::core::StateVectorArray<STATE_DIM, SCALAR> x_search(this->K_ + 1);
+        ct::core::StateVectorArray<STATE_DIM, SCALAR> x_shot_search(this->K_ + 1);
+        ct::core::StateVectorArray<STATE_DIM, SCALAR> defects_recorded(
+            this->K_ + 1, ct::core::StateVector<STATE_DIM, SCALAR>::Zero());
+        ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> u_recorded(this->K_);
+
+        executeDistributedLineSearch(alpha, x_search, x_shot_search, defects_recorded, u_recorded, intermediateCost,
+            finalCost, defectNorm, e_box_norm, e_gen_norm);
+
+        // compute new merit and check for step acceptance
+        bool stepAccepted = this->acceptStep(
+            alpha, intermediateCost, finalCost, defectNorm, e_box_norm, e_gen_norm, this->lowestCost_, cost);
+
+        // catch the case that a rollout might be unstable
+        if (!stepAccepted)
+        {
+            if (this->settings_.lineSearchSettings.debugPrint)
+            {
+                std::cout << "[LineSearch]: No better cost/merit found at alpha " << alpha << ":" << std::endl;
+                std::cout << "[LineSearch]: Cost:\t" << intermediateCost + finalCost << std::endl;
+                std::cout << "[LineSearch]: Defect:\t" << defectNorm << std::endl;
+                std::cout << "[LineSearch]: Merit:\t" << cost << std::endl;
+            }
+
+            // compute new alpha
+            alpha = alpha * this->settings_.lineSearchSettings.n_alpha;
+        }
+        else
+        {
+            // step accepted
+
+            if (this->settings_.lineSearchSettings.debugPrint)
+            {
+                std::cout << "Lower cost/merit found at alpha: " << alpha << ":" << std::endl;
+                std::cout << "[LineSearch]: Cost:\t" << intermediateCost + finalCost << std::endl;
+                std::cout << "[LineSearch]: Defect:\t" << defectNorm << std::endl;
+                std::cout << "[LineSearch]: Merit:\t" << cost << std::endl;
+            }
+
+            // compute update norms separately, as they are typically different from pure lqoc solver updates
+            this->lu_norm_ =
+                this->template computeDiscreteArrayNorm<ct::core::ControlVectorArray<CONTROL_DIM, SCALAR>, 2>(
+                    u_recorded, this->u_ff_prev_);
+            this->lx_norm_ = this->template computeDiscreteArrayNorm<ct::core::StateVectorArray<STATE_DIM, SCALAR>, 2>(
+                x_search, this->x_prev_);
+
+            alphaBest = alpha;
+            this->intermediateCostBest_ = intermediateCost;
+            this->finalCostBest_ = finalCost;
+            this->d_norm_ = defectNorm;
+            this->e_box_norm_ = e_box_norm;
+            this->e_gen_norm_ = e_gen_norm;
+            this->x_prev_ = x_search;
+            this->lowestCost_ = cost;
+            this->x_.swap(x_search);
+            this->xShot_.swap(x_shot_search);
+            this->u_ff_.swap(u_recorded);
+            this->d_.swap(defects_recorded);
+
+            // the workers keep the substeps of the accepted rollout
+            dispatch(ACCEPT_LINE_SEARCH, 0, this->K_ - 1);
+            break;
+        }
+    }  // end while
+
+    return alphaBest;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::executeDistributedLineSearch(
+    const SCALAR alpha,
+    typename Base::StateVectorArray& x_alpha,
+    typename Base::StateVectorArray& x_shot_alpha,
+    typename Base::StateVectorArray& defects_recorded,
+    typename Base::ControlVectorArray& u_alpha,
+    SCALAR& intermediateCost,
+    SCALAR& finalCost,
+    SCALAR& defectNorm,
+    SCALAR& e_box_norm,
+    SCALAR& e_gen_norm)
+{
+    intermediateCost = std::numeric_limits<SCALAR>::max();
+    finalCost = std::numeric_limits<SCALAR>::max();
+    defectNorm = std::numeric_limits<SCALAR>::max();
+    e_box_norm = 0.0;
+    e_gen_norm = 0.0;
+
+    NLOC_TRACE_SCOPE(this->traceRecorder_, this->settings_.nThreads, "line search alpha", 0, this->K_ - 1, alpha);
+
+    const size_t threadId = this->settings_.nThreads;
+    const size_t lastIndex = this->K_ - 1;
+
+    // update feedforward, state decision variables and lqr reference with weighting alpha
+    u_alpha = this->delta_u_ff_ * alpha + this->u_ff_prev_;
+    x_alpha = this->delta_x_ * alpha + this->x_prev_;
+    typename Base::StateVectorArray x_ref_lqr = this->delta_x_ref_lqr_ * alpha + this->x_prev_;
+
+    writeTrajectories(0, lastIndex, u_alpha, x_alpha, x_ref_lqr, x_shot_alpha, defects_recorded);
+    bool dynamicsGood = dispatch(LINE_SEARCH, 0, lastIndex);
+    readTrajectories(0, lastIndex, u_alpha, x_alpha, x_shot_alpha, defects_recorded);
+
+    //! compute costs and constraint violations in the coordinator
+    if (dynamicsGood)
+    {
+        defectNorm = this->template computeDefectsNorm<1>(defects_recorded);
+
+        this->computeCostsOfTrajectory(threadId, x_alpha, u_alpha, intermediateCost, finalCost);
+
+        if ((this->inputBoxConstraints_[threadId] != nullptr) | (this->stateBoxConstraints_[threadId] != nullptr))
+            this->computeBoxConstraintErrorOfTrajectory(threadId, x_alpha, u_alpha, e_box_norm);
+
+        if (this->generalConstraints_[threadId] != nullptr)
+            this->computeGeneralConstraintErrorOfTrajectory(threadId, x_alpha, u_alpha, e_gen_norm);
+    }
+    else if (this->settings_.debugPrint)
+    {
+        std::cout << "dynamics not good in distributed line search" << std::endl;
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::ensureWorkers()
+{
+    // a reset of the iteration counter indicates a new solve, possibly of a modified problem
+    const bool newSolve = this->iteration_ < workersIteration_;
+
+    if (!sharedMemory_ || workersK_ != this->K_ || newSolve)
+    {
+        shutdownWorkers();
+        startWorkers();
+    }
+
+    workersIteration_ = this->iteration_;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::startWorkers()
+{
+    const int K = this->K_;
+    const int K_shot = this->getNumStepsPerShot();
+    const int nWorkers = this->settings_.nProcesses;
+
+    // partition the shots into contiguous ranges, a stage is always handled by the same worker
+    const int nShots = (K + K_shot - 1) / K_shot;
+    workerFirstIndex_.resize(nWorkers);
+    workerLastIndex_.resize(nWorkers);
+    for (int w = 0; w < nWorkers; w++)
+    {
+        workerFirstIndex_[w] = (w * nShots / nWorkers) * K_shot;
+        workerLastIndex_[w] = std::min(((w + 1) * nShots / nWorkers) * K_shot, K) - 1;
+    }
+
+    // layout of the segment: worker slots followed by the shared arrays, each with K+1 entries
+    const size_t n = STATE_DIM;
+    const size_t m = CONTROL_DIM;
+    const std::array<size_t, NUM_SHARED_ARRAYS> entrySize = {
+        {n, n, n, n, m, m * n, n * n, n * m, n, n * n, m * n, m * m, n, m, 1}};
+
+    auto align = [](size_t bytes) { return (bytes + 63) / 64 * 64; };
+    size_t bytes = align(nWorkers * sizeof(WorkerSlot));
+    for (int i = 0; i < NUM_SHARED_ARRAYS; i++)
+    {
+        sharedOffsets_[i] = bytes;
+        bytes += align((K + 1) * entrySize[i] * sizeof(SCALAR));
+    }
+
+    checkSingleThreaded();
+
+    sharedMemory_.reset(new SharedMemorySegment(bytes));
+
+    for (int w = 0; w < nWorkers; w++)
+    {
+        if (::sem_init(&slot(w).start, 1, 0) != 0 || ::sem_init(&slot(w).done, 1, 0) != 0)
+            throw std::runtime_error("NLOCBackendDistributed: could not initialize semaphores.");
+    }
+
+    // do not duplicate buffered output in the workers
+    std::cout.flush();
+    std::fflush(nullptr);
+
+    for (int w = 0; w < nWorkers; w++)
+    {
+        pid_t pid = ::fork();
+        if (pid < 0)
+        {
+            shutdownWorkers();
+            throw std::runtime_error("NLOCBackendDistributed: could not fork worker process.");
+        }
+        if (pid == 0)
+            workerLoop(w);
+
+        workerPids_.push_back(pid);
+    }
+
+    workersK_ = K;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::shutdownWorkers()
+{
+    if (!sharedMemory_)
+        return;
+
+    for (size_t w = 0; w < workerPids_.size(); w++)
+    {
+        slot(w).task = SHUTDOWN;
+        ::sem_post(&slot(w).start);
+    }
+
+    // workers which terminated unexpectedly have been reaped already
+    for (pid_t pid : workerPids_)
+        if (pid > 0)
+            ::waitpid(pid, nullptr, 0);
+
+    for (size_t w = 0; w < workerFirstIndex_.size(); w++)
+    {
+        ::sem_destroy(&slot(w).start);
+        ::sem_destroy(&slot(w).done);
+    }
+
+    workerPids_.clear();
+    sharedMemory_.reset();
+    workersK_ = -1;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::checkSingleThreaded() const
+{
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 8, "Threads:") == 0 && std::stoi(line.substr(8)) > 1)
+            throw std::runtime_error(
+                "NLOCBackendDistributed: cannot fork the workers from a multi-threaded process, the solver has to "
+                "run in a single-threaded process.");
+    }
+#endif
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::workerLoop(size_t workerId)
+{
+#ifdef __linux__
+    // terminate together with the coordinator
+    ::prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+
+    WorkerSlot& s = slot(workerId);
+
+    while (true)
+    {
+        if (::sem_wait(&s.start) != 0)
+        {
+            if (errno == EINTR)
+                continue;
+            ::_exit(EXIT_FAILURE);
+        }
+
+        if (s.task == SHUTDOWN)
+            break;
+
+        bool success = false;
+        try
+        {
+            success = executeWorkerTask(s.task, s.firstIndex, s.lastIndex);
+        } catch (const std::exception& e)
+        {
+            std::cerr << "NLOCBackendDistributed worker " << workerId << ": " << e.what() << std::endl;
+        }
+
+        s.success = success;
+        ::sem_post(&s.done);
+    }
+
+    // never return into the code of the coordinator
+    ::_exit(EXIT_SUCCESS);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::executeWorkerTask(int task,
+    int firstIndex,
+    int lastIndex)
+{
+    const size_t threadId = this->settings_.nThreads;
+
+    if (task == ACCEPT_LINE_SEARCH)
+    {
+        if (lineSearchSubstepsX_)
+        {
+            this->substepsX_ = lineSearchSubstepsX_;
+            this->substepsU_ = lineSearchSubstepsU_;
+        }
+        return true;
+    }
+
+    // no stages of this worker are involved
+    if (firstIndex > lastIndex)
+        return true;
+
+    // the defect of the last shot requires the first state of the next shot
+    fromShared(X, this->x_, firstIndex, std::min(lastIndex + 1, this->K_));
+    fromShared(X_SHOT, this->xShot_, firstIndex, lastIndex);
+    fromShared(DEFECTS, this->d_, firstIndex, lastIndex);
+    fromShared(U_FF, this->u_ff_, firstIndex, lastIndex);
+
+    switch (task)
+    {
+        case ROLLOUT_SHOTS:
+        case LINE_SEARCH:
+        {
+            fromShared(X_REF_LQR, this->x_ref_lqr_, firstIndex, lastIndex);
+            fromShared(FEEDBACK, this->L_, firstIndex, lastIndex);
+
+            if (task == LINE_SEARCH)
+            {
+                lineSearchSubstepsX_.reset(new typename Base::StateSubsteps(this->K_ + 1));
+                lineSearchSubstepsU_.reset(new typename Base::ControlSubsteps(this->K_ + 1));
+            }
+
+            bool dynamicsGood = this->rolloutShotsSingleThreaded(threadId, firstIndex, lastIndex, this->u_ff_,
+                this->x_, this->x_ref_lqr_, this->xShot_, this->d_,
+                task == LINE_SEARCH ? *lineSearchSubstepsX_ : *this->substepsX_,
+                task == LINE_SEARCH ? *lineSearchSubstepsU_ : *this->substepsU_);
+
+            toShared(X, this->x_, firstIndex, lastIndex);
+            if (lastIndex == this->K_ - 1)
+                toShared(X, this->x_, this->K_, this->K_);
+            toShared(X_SHOT, this->xShot_, firstIndex, lastIndex);
+            toShared(DEFECTS, this->d_, firstIndex, lastIndex);
+            toShared(U_FF, this->u_ff_, firstIndex, lastIndex);
+            return dynamicsGood;
+        }
+        case COMPUTE_LQ_PROBLEM:
+        {
+            for (int k = firstIndex; k <= lastIndex; k++)
+                this->executeLQApproximation(threadId, k);
+
+            typename Base::LQOCProblem_t& p = *this->lqocProblem_;
+            toShared(A, p.A_, firstIndex, lastIndex);
+            toShared(B, p.B_, firstIndex, lastIndex);
+            toShared(B_OFFSET, p.b_, firstIndex, lastIndex);
+            toShared(Q, p.Q_, firstIndex, lastIndex);
+            toShared(P, p.P_, firstIndex, lastIndex);
+            toShared(R, p.R_, firstIndex, lastIndex);
+            toShared(QV, p.qv_, firstIndex, lastIndex);
+            toShared(RV, p.rv_, firstIndex, lastIndex);
+
+            SCALAR* skipped = sharedMemory_->template get<SCALAR>(sharedOffsets_[LQ_SKIPPED]);
+            for (int k = firstIndex; k <= lastIndex && k < static_cast<int>(this->lqApproximationSkipped_.size()); k++)
+                skipped[k] = static_cast<SCALAR>(this->lqApproximationSkipped_[k]);
+            return true;
+        }
+        default:
+            throw std::runtime_error("NLOCBackendDistributed: unknown worker task.");
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+bool NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::dispatch(WORKER_TASK task,
+    size_t firstIndex,
+    size_t lastIndex)
+{
+    for (size_t w = 0; w < workerPids_.size(); w++)
+    {
+        WorkerSlot& s = slot(w);
+        s.task = task;
+        s.firstIndex = std::max(static_cast<int>(firstIndex), workerFirstIndex_[w]);
+        s.lastIndex = std::min(static_cast<int>(lastIndex), workerLastIndex_[w]);
+        s.success = false;
+        ::sem_post(&s.start);
+    }
+
+    bool success = true;
+    for (size_t w = 0; w < workerPids_.size(); w++)
+    {
+        waitForWorker(w);
+        success = success && slot(w).success;
+    }
+    return success;
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::waitForWorker(size_t workerId)
+{
+    while (true)
+    {
+        timespec timeout;
+        ::clock_gettime(CLOCK_REALTIME, &timeout);
+        timeout.tv_nsec += 100000000;  // check the worker every 100 ms
+        if (timeout.tv_nsec >= 1000000000)
+        {
+            timeout.tv_sec += 1;
+            timeout.tv_nsec -= 1000000000;
+        }
+
+        if (::sem_timedwait(&slot(workerId).done, &timeout) == 0)
+            return;
+
+        if (errno == EINTR)
+            continue;
+
+        if (errno != ETIMEDOUT)
+            throw std::runtime_error("NLOCBackendDistributed: waiting for worker failed.");
+
+        if (::waitpid(workerPids_[workerId], nullptr, WNOHANG) == workerPids_[workerId])
+        {
+            // the worker was reaped, do not wait for it during shutdown
+            workerPids_[workerId] = -1;
+            shutdownWorkers();
+            throw std::runtime_error("NLOCBackendDistributed: worker process terminated unexpectedly.");
+        }
+    }
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::writeTrajectories(
+    size_t firstIndex,
+    size_t lastIndex,
+    const typename Base::ControlVectorArray& u,
+    const typename Base::StateVectorArray& x,
+    const typename Base::StateVectorArray& x_ref_lqr,
+    const typename Base::StateVectorArray& xShot,
+    const typename Base::StateVectorArray& d)
+{
+    toShared(X, x, firstIndex, std::min(lastIndex + 1, static_cast<size_t>(this->K_)));
+    toShared(X_SHOT, xShot, firstIndex, lastIndex);
+    toShared(DEFECTS, d, firstIndex, lastIndex);
+    toShared(X_REF_LQR, x_ref_lqr, firstIndex, lastIndex);
+    toShared(U_FF, u, firstIndex, lastIndex);
+    toShared(FEEDBACK, this->L_, firstIndex, lastIndex);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::readTrajectories(
+    size_t firstIndex,
+    size_t lastIndex,
+    typename Base::ControlVectorArray& u,
+    typename Base::StateVectorArray& x,
+    typename Base::StateVectorArray& xShot,
+    typename Base::StateVectorArray& d)
+{
+    fromShared(X, x, firstIndex, lastIndex);
+    if (lastIndex == static_cast<size_t>(this->K_) - 1)
+        fromShared(X, x, this->K_, this->K_);
+    fromShared(X_SHOT, xShot, firstIndex, lastIndex);
+    fromShared(DEFECTS, d, firstIndex, lastIndex);
+    fromShared(U_FF, u, firstIndex, lastIndex);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+template <typename ARRAY>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::toShared(SHARED_ARRAY field,
+    const ARRAY& array,
+    size_t firstIndex,
+    size_t lastIndex)
+{
+    typedef typename std::decay<decltype(array[0])>::type Entry;
+    typedef Eigen::Matrix<SCALAR, Entry::RowsAtCompileTime, Entry::ColsAtCompileTime> Matrix;
+
+    SCALAR* data = sharedMemory_->template get<SCALAR>(sharedOffsets_[field]);
+    for (size_t k = firstIndex; k <= lastIndex; k++)
+        Eigen::Map<Matrix>(data + k * Matrix::SizeAtCompileTime) = array[k];
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+template <typename ARRAY>
+void NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::fromShared(SHARED_ARRAY field,
+    ARRAY& array,
+    size_t firstIndex,
+    size_t lastIndex)
+{
+    typedef typename std::decay<decltype(array[0])>::type Entry;
+    typedef Eigen::Matrix<SCALAR, Entry::RowsAtCompileTime, Entry::ColsAtCompileTime> Matrix;
+
+    const SCALAR* data = sharedMemory_->template get<SCALAR>(sharedOffsets_[field]);
+    for (size_t k = firstIndex; k <= lastIndex; k++)
+        array[k] = Eigen::Map<const Matrix>(data + k * Matrix::SizeAtCompileTime);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+typename NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::WorkerSlot&
+NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::slot(size_t workerId)
+{
+    return sharedMemory_->template get<WorkerSlot>(0)[workerId];
+}
+
+
+}  // namespace optcon
+}  // namespace ct
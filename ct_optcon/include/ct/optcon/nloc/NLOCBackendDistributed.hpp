@@ -0,0 +1,207 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <semaphore.h>
+#include <sys/types.h>
+
+#include "NLOCBackendBase.hpp"
+#include "SharedMemorySegment.hpp"
+#include <ct/optcon/solver/NLOptConSettings.hpp>
+
+namespace ct {
+namespace optcon {
+
+
+/*!
+ * NLOC Backend for distributed multiple shooting with several worker processes on the same host
+ *
+ * The stages are partitioned into NLOptConSettings::nProcesses contiguous ranges of shots, one per worker process.
+ * The workers roll out their shots, including the line-search rollouts, and compute the LQ approximation of their
+ * stages. The trajectories, defects and LQ blocks are exchanged through POSIX shared memory. The coordinator (the
+ * process owning this backend) evaluates costs and constraints and solves the LQ problem.
+ *
+ * The workers are forked from the coordinator when they are first needed and restarted for every new solve (i.e.
+ * after setInitialGuess() or reset()), after configure(), after a change of the cost function, the systems or the
+ * constraints and when the number of stages changes.
+ *
+ * \warning the workers are forked during the solve and continue to run the code of the coordinator, which is only
+ * safe if the coordinator process has a single thread at that time. The backend hence refuses to start workers from a
+ * multi-threaded process (checked on Linux only), e.g. it cannot be combined with an MpcRunner.
+ *
+ * \note the state and control substeps for the sensitivity integrator are kept in the worker process which rolled
+ * out the corresponding shot, they are not available in the coordinator.
+ */
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t P_DIM,
+    size_t V_DIM,
+    typename SCALAR = double,
+    bool CONTINUOUS = true>
+class NLOCBackendDistributed final : public NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef NLOCBackendBase<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS> Base;
+    typedef typename Base::OptConProblem_t OptConProblem_t;
+
+    NLOCBackendDistributed(const OptConProblem_t& optConProblem, const NLOptConSettings& settings);
+
+    NLOCBackendDistributed(const OptConProblem_t& optConProblem,
+        const std::string& settingsFile,
+        bool verbose = true,
+        const std::string& ns = "alg");
+
+    //! destructor, shuts down the worker processes
+    virtual ~NLOCBackendDistributed();
+
+    //! configure the backend, the workers are restarted with the new settings
+    virtual void configure(const NLOptConSettings& settings) override;
+
+    //! the following setters shut down the workers, which are restarted with the modified problem on demand
+    virtual void changeCostFunction(const typename OptConProblem_t::CostFunctionPtr_t& cf) override;
+    virtual void changeNonlinearSystem(const typename OptConProblem_t::DynamicsPtr_t& dyn) override;
+    virtual void changeLinearSystem(const typename OptConProblem_t::LinearPtr_t& lin) override;
+    virtual void changeInputBoxConstraints(const typename OptConProblem_t::ConstraintPtr_t& con) override;
+    virtual void changeStateBoxConstraints(const typename OptConProblem_t::ConstraintPtr_t& con) override;
+    virtual void changeGeneralConstraints(const typename OptConProblem_t::ConstraintPtr_t& con) override;
+
+    //! get the process ids of the currently running workers, -1 for a worker which terminated unexpectedly
+    const std::vector<pid_t>& getWorkerPids() const { return workerPids_; }
+
+protected:
+    virtual void computeLQApproximation(size_t firstIndex, size_t lastIndex) override;
+
+    virtual void rolloutShots(size_t firstIndex, size_t lastIndex) override;
+
+    SCALAR performLineSearch() override;
+
+private:
+    enum WORKER_TASK
+    {
+        ROLLOUT_SHOTS = 0,
+        LINE_SEARCH,
+        ACCEPT_LINE_SEARCH,
+        COMPUTE_LQ_PROBLEM,
+        SHUTDOWN
+    };
+
+    //! the trajectories and LQ blocks in shared memory, all with K+1 entries
+    enum SHARED_ARRAY
+    {
+        X = 0,
+        X_SHOT,
+        DEFECTS,
+        X_REF_LQR,
+        U_FF,
+        FEEDBACK,
+        A,
+        B,
+        B_OFFSET,
+        Q,
+        P,
+        R,
+        QV,
+        RV,
+        LQ_SKIPPED,
+        NUM_SHARED_ARRAYS
+    };
+
+    //! synchronization and task description of a worker, placed at the beginning of the shared memory segment
+    struct WorkerSlot
+    {
+        sem_t start;
+        sem_t done;
+        int task;
+        int firstIndex;
+        int lastIndex;
+        int success;
+    };
+
+    //! fork the workers if they are not running or the problem changed since they were started
+    void ensureWorkers();
+
+    void startWorkers();
+
+    //! shut down the workers, they are restarted with the current problem on demand
+    void shutdownWorkers();
+
+    //! check that forking the workers is safe, throws if the coordinator process runs several threads
+    void checkSingleThreaded() const;
+
+    //! main function of a worker process, never returns
+    void workerLoop(size_t workerId);
+
+    //! execute a task in a worker process on the stages firstIndex to lastIndex
+    bool executeWorkerTask(int task, int firstIndex, int lastIndex);
+
+    //! assign a task for the stages firstIndex to lastIndex to all workers and wait for them to finish
+    bool dispatch(WORKER_TASK task, size_t firstIndex, size_t lastIndex);
+
+    //! wait for a worker to finish its task, throws if the worker process died
+    void waitForWorker(size_t workerId);
+
+    //! distributed counterpart of NLOCBackendBase::executeLineSearch(), the workers roll out the shots
+    void executeDistributedLineSearch(const SCALAR alpha,
+        typename Base::StateVectorArray& x_alpha,
+        typename Base::StateVectorArray& x_shot_alpha,
+        typename Base::StateVectorArray& defects_recorded,
+        typename Base::ControlVectorArray& u_alpha,
+        SCALAR& intermediateCost,
+        SCALAR& finalCost,
+        SCALAR& defectNorm,
+        SCALAR& e_box_norm,
+        SCALAR& e_gen_norm);
+
+    //! copy the trajectory data of the stages firstIndex to lastIndex to shared memory
+    void writeTrajectories(size_t firstIndex,
+        size_t lastIndex,
+        const typename Base::ControlVectorArray& u,
+        const typename Base::StateVectorArray& x,
+        const typename Base::StateVectorArray& x_ref_lqr,
+        const typename Base::StateVectorArray& xShot,
+        const typename Base::StateVectorArray& d);
+
+    //! copy the result of a rollout of the stages firstIndex to lastIndex from shared memory
+    void readTrajectories(size_t firstIndex,
+        size_t lastIndex,
+        typename Base::ControlVectorArray& u,
+        typename Base::StateVectorArray& x,
+        typename Base::StateVectorArray& xShot,
+        typename Base::StateVectorArray& d);
+
+    template <typename ARRAY>
+    void toShared(SHARED_ARRAY field, const ARRAY& array, size_t firstIndex, size_t lastIndex);
+
+    template <typename ARRAY>
+    void fromShared(SHARED_ARRAY field, ARRAY& array, size_t firstIndex, size_t lastIndex);
+
+    WorkerSlot& slot(size_t workerId);
+
+    std::unique_ptr<SharedMemorySegment> sharedMemory_;
+    std::array<size_t, NUM_SHARED_ARRAYS> sharedOffsets_;  //! byte offsets of the shared arrays
+
+    std::vector<pid_t> workerPids_;
+    std::vector<int> workerFirstIndex_;  //! first stage of each worker
+    std::vector<int> workerLastIndex_;   //! last stage of each worker
+
+    int workersK_;             //! number of stages the workers were started with
+    size_t workersIteration_;  //! iteration of the most recent task, used to detect a new solve
+
+    //! substeps of the most recent line-search rollout in a worker, taken over if the step is accepted
+    typename Base::StateSubstepsPtr lineSearchSubstepsX_;
+    typename Base::ControlSubstepsPtr lineSearchSubstepsU_;
+};
+
+
+}  // namespace optcon
+}  // namespace ct
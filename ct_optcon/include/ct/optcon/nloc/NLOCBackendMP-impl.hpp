@@ -212,10 +212,17 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, type
 void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeLQApproximation(size_t firstIndex,
     size_t lastIndex)
 {
+    NLOC_TRACE_SCOPE(this->traceRecorder_, this->settings_.nThreads, "LQ approximation", static_cast<int>(firstIndex),
+        static_cast<int>(lastIndex));
+
     // fill terminal cost
     if (lastIndex == (static_cast<size_t>(this->K_) - 1))
         this->initializeCostToGo();
 
+    // the horizon-level cost approximation is done by the calling thread before distributing the stages
+    if (this->settings_.horizonCostEvaluation)
+        this->computeQuadraticCostsHorizon(firstIndex, lastIndex);
+
     /*
 	 * In special cases, this function may be called for a single index, e.g. for the unconstrained GNMS real-time iteration scheme.
 	 * Then, don't wake up workers, but do single-threaded computation for that single index, and return.
@@ -274,6 +281,9 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::co
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeLQProblemWorker(size_t threadId)
 {
+    NLOC_TRACE_SCOPE(this->traceRecorder_, threadId, "LQ approximation worker", static_cast<int>(KMin_),
+        static_cast<int>(KMax_));
+
     while (true)
     {
         const size_t k = kTaken_++;
@@ -373,6 +383,9 @@ void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::ro
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 void NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::rolloutShotWorker(size_t threadId)
 {
+    NLOC_TRACE_SCOPE(
+        this->traceRecorder_, threadId, "rollout worker", static_cast<int>(KMin_), static_cast<int>(KMax_));
+
     while (true)
     {
         size_t k = kTaken_++;
@@ -39,9 +39,15 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, type
 void NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::computeLQApproximation(size_t firstIndex,
     size_t lastIndex)
 {
+    NLOC_TRACE_SCOPE(this->traceRecorder_, this->settings_.nThreads, "LQ approximation", static_cast<int>(firstIndex),
+        static_cast<int>(lastIndex));
+
     if (lastIndex == static_cast<size_t>(this->K_) - 1)
         this->initializeCostToGo();
 
+    if (this->settings_.horizonCostEvaluation)
+        this->computeQuadraticCostsHorizon(firstIndex, lastIndex);
+
     for (size_t k = firstIndex; k <= lastIndex; k++)
     {
         this->executeLQApproximation(this->settings_.nThreads, k);
@@ -55,6 +61,9 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, type
 void NLOCBackendST<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::rolloutShots(size_t firstIndex,
     size_t lastIndex)
 {
+    NLOC_TRACE_SCOPE(this->traceRecorder_, this->settings_.nThreads, "rollout", static_cast<int>(firstIndex),
+        static_cast<int>(lastIndex));
+
     for (size_t k = firstIndex; k <= lastIndex; k = k + this->getNumStepsPerShot())
     {
         // rollout the shot
@@ -5,6 +5,8 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #pragma once
 
+#include "NLOCTrace.hpp"
+
 #ifdef MATLAB
 #include <ct/optcon/matlab.hpp>
 #endif
@@ -42,6 +44,12 @@ struct SummaryAllIterations
     //! smallest eigenvalues
     std::vector<SCALAR> smallestEigenvalues;
 
+    //! number of stages which reused their cached LQ approximation
+    std::vector<size_t> skippedLQApproximations;
+
+    //! timed phases of all iterations, only recorded when compiled with NLOC_TRACE
+    std::vector<ct::optcon::NLOCTraceEvent> traceEvents;
+
     //! print summary of the last iteration with desired numeric precision
     template <int NUM_PRECISION = 12>
     void printSummaryLastIteration()
@@ -60,11 +68,19 @@ struct SummaryAllIterations
         std::cout << std::setprecision(NUM_PRECISION) << "total lx norm:\t" << lx_norms.back() << std::endl;
         std::cout << std::setprecision(NUM_PRECISION) << "total lu norm:\t" << lu_norms.back() << std::endl;
         std::cout << std::setprecision(NUM_PRECISION) << "step-size:\t" << stepSizes.back() << std::endl;
+        std::cout << "skipped LQ stages:\t" << skippedLQApproximations.back() << std::endl;
         std::cout << "                   ===========" << std::endl;
         std::cout << std::endl;
     }
 
 
+    //! export the timed phases as Chrome trace event JSON, to be viewed in chrome://tracing or Perfetto
+    void exportTrace(const std::string& fileName) const
+    {
+        std::ofstream file(fileName);
+        ct::optcon::writeChromeTrace(traceEvents, file);
+    }
+
     void logToMatlab(const std::string& fileName)
     {
 #ifdef MATLAB
@@ -84,6 +100,7 @@ struct SummaryAllIterations
         matFile_.put("merits", merits);
         matFile_.put("stepSizes", stepSizes);
         matFile_.put("smallestEigenvalues", smallestEigenvalues);
+        matFile_.put("skippedLQApproximations", skippedLQApproximations);
         matFile_.close();
 #endif
     }
@@ -0,0 +1,175 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/*!
+ * Instrumentation of the NLOC backends. The phases of an iteration are only timed if compiled with NLOC_TRACE
+ * (cmake option NLOC_TRACE), otherwise NLOC_TRACE_SCOPE expands to nothing and no trace events are recorded.
+ */
+#ifdef NLOC_TRACE
+#define NLOC_TRACE_CONCAT_IMPL(a, b) a##b
+#define NLOC_TRACE_CONCAT(a, b) NLOC_TRACE_CONCAT_IMPL(a, b)
+//! times the enclosing scope, arguments are forwarded to the constructor of ct::optcon::NLOCTraceScope
+#define NLOC_TRACE_SCOPE(...) ::ct::optcon::NLOCTraceScope NLOC_TRACE_CONCAT(nlocTraceScope_, __LINE__)(__VA_ARGS__)
+#else
+#define NLOC_TRACE_SCOPE(...)
+#endif
+
+namespace ct {
+namespace optcon {
+
+//! a timed phase of an NLOC iteration
+struct NLOCTraceEvent
+{
+    const char* name;    //!< name of the phase, a string literal
+    size_t threadId;     //!< thread that executed the phase, the calling thread has id nThreads
+    size_t iteration;    //!< NLOC iteration the phase belongs to
+    double start;        //!< start time in microseconds, relative to the creation of the recorder
+    double duration;     //!< duration in microseconds
+    int firstIndex;      //!< first stage index of the phase, -1 if not applicable
+    int lastIndex;       //!< last stage index of the phase, -1 if not applicable
+    double alpha;        //!< line search step size of the phase, NaN if not applicable
+};
+
+/*!
+ * \brief Records trace events with one buffer per thread
+ *
+ * Every thread only appends to its own buffer, the lock of a buffer is therefore only contended while the calling
+ * thread collects the events, e.g. while a line search worker finishes an obsolete step size.
+ */
+class NLOCTraceRecorder
+{
+public:
+    typedef std::chrono::steady_clock clock_t;
+
+    NLOCTraceRecorder(size_t nThreads = 1) : origin_(clock_t::now()) { setNumThreads(nThreads); }
+    //! resize to nThreads workers plus the calling thread, must not be called while recording
+    void setNumThreads(size_t nThreads)
+    {
+        buffers_.resize(nThreads + 1);
+        for (std::unique_ptr<Buffer>& buffer : buffers_)
+            if (!buffer)
+                buffer.reset(new Buffer());
+    }
+
+    void record(size_t threadId,
+        const char* name,
+        const clock_t::time_point& start,
+        const clock_t::time_point& end,
+        int firstIndex,
+        int lastIndex,
+        double alpha)
+    {
+        const double startUs = std::chrono::duration<double, std::micro>(start - origin_).count();
+        const double durationUs = std::chrono::duration<double, std::micro>(end - start).count();
+
+        Buffer& buffer = *buffers_[threadId];
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.events.push_back({name, threadId, 0, startUs, durationUs, firstIndex, lastIndex, alpha});
+    }
+
+    //! moves all recorded events to events and tags them with the given iteration
+    void collect(size_t iteration, std::vector<NLOCTraceEvent>& events)
+    {
+        for (std::unique_ptr<Buffer>& buffer : buffers_)
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            for (NLOCTraceEvent& event : buffer->events)
+            {
+                event.iteration = iteration;
+                events.push_back(event);
+            }
+            buffer->events.clear();
+        }
+    }
+
+private:
+    struct Buffer
+    {
+        std::mutex mutex;
+        std::vector<NLOCTraceEvent> events;
+    };
+
+    clock_t::time_point origin_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+//! records the lifetime of this object as a trace event
+class NLOCTraceScope
+{
+public:
+    NLOCTraceScope(NLOCTraceRecorder& recorder,
+        size_t threadId,
+        const char* name,
+        int firstIndex = -1,
+        int lastIndex = -1,
+        double alpha = std::numeric_limits<double>::quiet_NaN())
+        : recorder_(recorder),
+          threadId_(threadId),
+          name_(name),
+          firstIndex_(firstIndex),
+          lastIndex_(lastIndex),
+          alpha_(alpha),
+          start_(NLOCTraceRecorder::clock_t::now())
+    {
+    }
+
+    ~NLOCTraceScope()
+    {
+        recorder_.record(threadId_, name_, start_, NLOCTraceRecorder::clock_t::now(), firstIndex_, lastIndex_, alpha_);
+    }
+
+    NLOCTraceScope(const NLOCTraceScope&) = delete;
+    NLOCTraceScope& operator=(const NLOCTraceScope&) = delete;
+
+private:
+    NLOCTraceRecorder& recorder_;
+    size_t threadId_;
+    const char* name_;
+    int firstIndex_;
+    int lastIndex_;
+    double alpha_;
+    NLOCTraceRecorder::clock_t::time_point start_;
+};
+
+/*!
+ * \brief Writes trace events in the Chrome trace event format
+ *
+ * The output can be loaded in chrome://tracing or https://ui.perfetto.dev, every thread is shown as a separate track.
+ */
+inline void writeChromeTrace(const std::vector<NLOCTraceEvent>& events, std::ostream& out)
+{
+    const std::streamsize precision = out.precision(15);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const NLOCTraceEvent& e = events[i];
+        out << (i == 0 ? "" : ",") << "\n{\"name\":\"" << e.name << "\",\"cat\":\"nloc\",\"ph\":\"X\",\"pid\":0"
+            << ",\"tid\":" << e.threadId << ",\"ts\":" << e.start << ",\"dur\":" << e.duration
+            << ",\"args\":{\"iteration\":" << e.iteration;
+        if (e.firstIndex >= 0)
+            out << ",\"first\":" << e.firstIndex << ",\"last\":" << e.lastIndex;
+        if (!std::isnan(e.alpha))
+            out << ",\"alpha\":" << e.alpha;
+        out << "}}";
+    }
+    out << "\n]}" << std::endl;
+
+    out.precision(precision);
+}
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,85 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ct {
+namespace optcon {
+
+
+/*!
+ * A POSIX shared memory segment, which is shared with all processes forked after its creation.
+ *
+ * The segment is created with a unique name and unlinked right after it is mapped, such that it
+ * cannot leak if one of the processes terminates unexpectedly.
+ */
+class SharedMemorySegment
+{
+public:
+    //! create and map a zero-initialized segment of the given size in bytes
+    explicit SharedMemorySegment(size_t size) : size_(size), data_(nullptr)
+    {
+        static std::atomic_int segmentCount(0);
+        const std::string name =
+            "/ct_optcon_" + std::to_string(::getpid()) + "_" + std::to_string(segmentCount.fetch_add(1));
+
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        if (fd < 0)
+            throw std::runtime_error("SharedMemorySegment: shm_open failed: " + std::string(std::strerror(errno)));
+
+        if (::ftruncate(fd, size_) != 0)
+        {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw std::runtime_error("SharedMemorySegment: ftruncate failed: " + std::string(std::strerror(errno)));
+        }
+
+        void* data = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+
+        if (data == MAP_FAILED)
+            throw std::runtime_error("SharedMemorySegment: mmap failed: " + std::string(std::strerror(errno)));
+
+        data_ = static_cast<char*>(data);
+    }
+
+    SharedMemorySegment(const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+    ~SharedMemorySegment()
+    {
+        if (data_)
+            ::munmap(data_, size_);
+    }
+
+    //! get a pointer to the given byte offset in the segment
+    template <typename T>
+    T* get(size_t offset)
+    {
+        return reinterpret_cast<T*>(data_ + offset);
+    }
+
+    size_t size() const { return size_; }
+
+private:
+    size_t size_;
+    char* data_;
+};
+
+
+}  // namespace optcon
+}  // namespace ct
@@ -153,6 +153,8 @@ bool MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
     this->backend_->logToMatlab(this->backend_->iteration());
 #endif  //MATLAB_FULL_LOG
 
+    this->backend_->logToBinaryLogger();
+
     this->backend_->iteration()++;
 
     return foundBetter;
@@ -254,9 +256,13 @@ bool MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
                   << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
 
 
-    //! update solutions
+    //! update solutions, either by a full step or, for split MPC iterations, by a line search over the merit function
     start = std::chrono::steady_clock::now();
-    this->backend_->doFullStepUpdate();
+    if (!this->backend_->getSettings().splitMPCIteration ||
+        this->backend_->getSettings().lineSearchSettings.type == LineSearchSettings::TYPE::NONE)
+        this->backend_->doFullStepUpdate();
+    else
+        this->backend_->lineSearch();
 
     end = std::chrono::steady_clock::now();
     diff = end - start;
@@ -278,6 +284,8 @@ bool MultipleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>:
     this->backend_->logToMatlab(this->backend_->iteration());
 #endif  //MATLAB_FULL_LOG
 
+    this->backend_->logToBinaryLogger();
+
     this->backend_->iteration()++;
 
     return true;  // note: will always return foundBetter
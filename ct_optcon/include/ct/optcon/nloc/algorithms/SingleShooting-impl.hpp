@@ -127,6 +127,8 @@ bool SingleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::f
     this->backend_->logToMatlab(this->backend_->iteration());
 #endif
 
+    this->backend_->logToBinaryLogger();
+
     this->backend_->iteration()++;
 
     return foundBetter;
@@ -136,12 +138,106 @@ template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, type
 void SingleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::prepareMPCIteration()
 {
     prepareIteration();
+
+    // without the split, SingleShooting is purely sequential and cannot prepare anything prior to solving
+    if (!this->backend_->getSettings().splitMPCIteration)
+        return;
+
+    int K = this->backend_->getNumSteps();
+
+    bool debugPrint = this->backend_->getSettings().debugPrint;
+
+    auto startPrepare = std::chrono::steady_clock::now();
+
+    // rollout the warm-start from the predicted initial state
+    if (!this->backend_->nominalRollout())
+        throw std::runtime_error("Rollout failed. System became unstable");
+
+    auto start = std::chrono::steady_clock::now();
+    this->backend_->setInputBoxConstraintsForLQOCProblem();
+    this->backend_->setStateBoxConstraintsForLQOCProblem();
+    if (K > 1)
+        this->backend_->computeLQApproximation(1, K - 1);
+    auto end = std::chrono::steady_clock::now();
+    auto diff = end - start;
+    if (debugPrint)
+        std::cout << "[SingleShooting-MPC]: computing LQ approximation from index 1 to N-1 took "
+                  << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    this->backend_->prepareSolveLQProblem(1);
+    end = std::chrono::steady_clock::now();
+    diff = end - start;
+    if (debugPrint)
+        std::cout << "[SingleShooting-MPC]: Prepare phase of LQOC problem took "
+                  << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
+
+    auto endPrepare = std::chrono::steady_clock::now();
+    if (debugPrint)
+        std::cout << "[SingleShooting-MPC]: prepareIteration() took "
+                  << std::chrono::duration<double, std::milli>(endPrepare - startPrepare).count() << " ms" << std::endl;
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 bool SingleShooting<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::finishMPCIteration()
 {
-    finishIteration();
+    if (!this->backend_->getSettings().splitMPCIteration)
+    {
+        finishIteration();
+        return true;  //! \todo : in MPC always returning true. Unclear how user wants to deal with varying costs, etc.
+    }
+
+    bool debugPrint = this->backend_->getSettings().debugPrint;
+
+    auto startFinish = std::chrono::steady_clock::now();
+
+    // the initial state changed since the preparation. The stages 1 to K-1 remain linearized around the predicted
+    // trajectory, deviations are corrected by the feedback of the line-search rollouts.
+    if (!this->backend_->nominalRollout())
+        throw std::runtime_error("Rollout failed. System became unstable");
+
+    this->backend_->updateCosts();
+
+#ifdef MATLAB_FULL_LOG
+    if (this->backend_->iteration() == 0)
+        this->backend_->logInitToMatlab();
+#endif
+
+    auto start = std::chrono::steady_clock::now();
+    this->backend_->computeLQApproximation(0, 0);
+    this->backend_->finishSolveLQProblem(0);
+    this->backend_->extractSolution();
+    auto end = std::chrono::steady_clock::now();
+    auto diff = end - start;
+    if (debugPrint)
+        std::cout << "[SingleShooting-MPC]: Finish solving LQOC problem took "
+                  << std::chrono::duration<double, std::milli>(diff).count() << " ms" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    this->backend_->lineSearch();
+    end = std::chrono::steady_clock::now();
+    diff = end - start;
+    if (debugPrint)
+        std::cout << "[SingleShooting-MPC]: Line search took " << std::chrono::duration<double, std::milli>(diff).count()
+                  << " ms" << std::endl;
+
+    if (debugPrint)
+    {
+        auto endFinish = std::chrono::steady_clock::now();
+        std::cout << "[SingleShooting-MPC]: finishIteration() took "
+                  << std::chrono::duration<double, std::milli>(endFinish - startFinish).count() << " ms" << std::endl;
+    }
+
+    this->backend_->printSummary();
+
+#ifdef MATLAB_FULL_LOG
+    this->backend_->logToMatlab(this->backend_->iteration());
+#endif
+
+    this->backend_->logToBinaryLogger();
+
+    this->backend_->iteration()++;
+
     return true;  //! \todo : in MPC always returning true. Unclear how user wants to deal with varying costs, etc.
 }
 
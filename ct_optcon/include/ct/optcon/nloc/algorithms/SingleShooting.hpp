@@ -70,13 +70,21 @@ public:
 
 
     /*!
-     * for SingleShooting, as it is a purely sequential approach, we cannot prepare anything prior to solving,
+     * for SingleShooting, as it is a purely sequential approach, we cannot prepare anything prior to solving.
+     *
+     * With NLOptConSettings::splitMPCIteration, the warm-start is rolled out from the predicted initial state and
+     * linearized for stages 1 to K-1. The Riccati backward pass is prepared down to stage 1, such that only the first
+     * stage depends on the measurement.
      */
     virtual void prepareMPCIteration() override;
 
 
     /*!
      * for SingleShooting, finishIteration contains the whole main SingleShooting iteration.
+     *
+     * With NLOptConSettings::splitMPCIteration, the warm-start is rolled out from the measured initial state, the first
+     * stage is linearized, and the solve of the LQ problem is finished. Stages 1 to K-1 keep the linearization around
+     * the predicted trajectory, which is inexact if the measurement deviates from the prediction.
      * @return
      */
     virtual bool finishMPCIteration() override;
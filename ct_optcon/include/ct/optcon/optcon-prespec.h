@@ -28,12 +28,16 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "nloc/NLOCBackendBase.hpp"
 #include "nloc/NLOCBackendST.hpp"
 #include "nloc/NLOCBackendMP.hpp"
+#include "nloc/NLOCBackendDistributed.hpp"
 #include "nloc/algorithms/MultipleShooting.hpp"
 #include "nloc/algorithms/SingleShooting.hpp"
 
 #include "solver/OptConSolver.h"
 #include "solver/lqp/HPIPMInterface.hpp"
 #include "solver/lqp/GNRiccatiSolver.hpp"
+#include "solver/lqp/MixedPrecisionLQOCSolver.hpp"
+#include "solver/lqp/CondensingLQOCSolver.hpp"
+#include "solver/lqp/LQOCPartialCondensing.hpp"
 #include "solver/NLOptConSolver.hpp"
 #include "solver/NLOptConSettings.hpp"
 
@@ -46,6 +50,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include "mpc/MpcSettings.h"
 #include "mpc/MPC.h"
+#include "mpc/MpcRunner.h"
 #include "mpc/timehorizon/MpcTimeHorizon.h"
 #include "mpc/policyhandler/PolicyHandler.h"
 #include "mpc/policyhandler/default/StateFeedbackPolicyHandler.h"
@@ -25,13 +25,18 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "nloc/NLOCBackendBase.hpp"
 #include "nloc/NLOCBackendST.hpp"
 #include "nloc/NLOCBackendMP.hpp"
+#include "nloc/NLOCBackendDistributed.hpp"
 #include "nloc/algorithms/MultipleShooting.hpp"
 #include "nloc/algorithms/SingleShooting.hpp"
 
 #include "solver/OptConSolver.h"
 #include "solver/lqp/HPIPMInterface.hpp"
 #include "solver/lqp/GNRiccatiSolver.hpp"
+#include "solver/lqp/MixedPrecisionLQOCSolver.hpp"
+#include "solver/lqp/CondensingLQOCSolver.hpp"
+#include "solver/lqp/LQOCPartialCondensing.hpp"
 #include "solver/NLOptConSolver.hpp"
+#include "solver/NLOptConSolverPool.hpp"
 
 #include "lqr/riccati/CARE.hpp"
 #include "lqr/riccati/DARE.hpp"
@@ -42,6 +47,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include "mpc/MpcSettings.h"
 #include "mpc/MPC.h"
+#include "mpc/MpcRunner.h"
 #include "mpc/timehorizon/MpcTimeHorizon.h"
 #include "mpc/policyhandler/PolicyHandler.h"
 #include "mpc/policyhandler/default/StateFeedbackPolicyHandler.h"
@@ -60,8 +66,13 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "problem/LQOCProblem-impl.hpp"
 
 #include "solver/lqp/GNRiccatiSolver-impl.hpp"
+#include "solver/lqp/MixedPrecisionLQOCSolver-impl.hpp"
+#include "solver/lqp/LQOCCondenser-impl.hpp"
+#include "solver/lqp/CondensingLQOCSolver-impl.hpp"
+#include "solver/lqp/LQOCPartialCondensing-impl.hpp"
 #include "solver/lqp/HPIPMInterface-impl.hpp"
 #include "solver/NLOptConSolver-impl.hpp"
+#include "solver/NLOptConSolverPool-impl.hpp"
 
 #include "lqr/riccati/CARE-impl.hpp"
 #include "lqr/riccati/DARE-impl.hpp"
@@ -71,10 +82,12 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include "nloc/NLOCBackendBase-impl.hpp"
 #include "nloc/NLOCBackendST-impl.hpp"
 #include "nloc/NLOCBackendMP-impl.hpp"
+#include "nloc/NLOCBackendDistributed-impl.hpp"
 #include "nloc/algorithms/MultipleShooting-impl.hpp"
 #include "nloc/algorithms/SingleShooting-impl.hpp"
 
 #include "mpc/MPC-impl.h"
+#include "mpc/MpcRunner-impl.h"
 #include "mpc/timehorizon/MpcTimeHorizon-impl.h"
 #include "mpc/policyhandler/PolicyHandler-impl.h"
 #include "mpc/policyhandler/default/StateFeedbackPolicyHandler-impl.h"
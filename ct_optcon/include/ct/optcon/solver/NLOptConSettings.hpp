@@ -154,16 +154,51 @@ struct LineSearchSettings
 struct LQOCSolverSettings
 {
 public:
-    LQOCSolverSettings() : lqoc_debug_print(false), num_lqoc_iterations(10) {}
+    LQOCSolverSettings()
+        : lqoc_debug_print(false), num_lqoc_iterations(10), double_precision(false), control_blocks()
+    {
+    }
 
     bool lqoc_debug_print;
     int num_lqoc_iterations;  //! number of allowed sub-iterations of LQOC solver per NLOC main iteration
+    bool double_precision;    //! solve the LQ subproblems in double precision if the NLOC SCALAR type is not double
+
+    //! move blocking: number of consecutive stages sharing one control, the last entry is repeated
+    std::vector<int> control_blocks;
+
+    //! true if the controls are blocked, i.e. several stages share one control
+    bool hasControlBlocks() const
+    {
+        for (int length : control_blocks)
+            if (length > 1)
+                return true;
+        return false;
+    }
+
+    //! get the index of the first stage of the control block which contains stage k, for a problem with N stages
+    std::vector<int> computeBlockStarts(int N) const
+    {
+        std::vector<int> blockStarts(std::max(N, 0));
+        int start = 0;
+        for (size_t i = 0; start < N; i++)
+        {
+            const int length = control_blocks.empty()
+                                   ? 1
+                                   : std::max(control_blocks[std::min(i, control_blocks.size() - 1)], 1);
+            for (int k = start; k < std::min(start + length, N); k++)
+                blockStarts[k] = start;
+            start += length;
+        }
+        return blockStarts;
+    }
 
     void print() const
     {
         std::cout << "======================= LQOCSolverSettings =====================" << std::endl;
         std::cout << "num_lqoc_iterations: \t" << num_lqoc_iterations << std::endl;
         std::cout << "lqoc_debug_print: \t" << lqoc_debug_print << std::endl;
+        std::cout << "double_precision: \t" << double_precision << std::endl;
+        std::cout << "number of control_blocks: \t" << control_blocks.size() << std::endl;
     }
 
     void load(const std::string& filename, bool verbose = true, const std::string& ns = "lqoc_solver_settings")
@@ -186,6 +221,12 @@ public:
         } catch (...)
         {
         }
+        try
+        {
+            double_precision = pt.get<bool>(ns + ".double_precision");
+        } catch (...)
+        {
+        }
     }
 };
 
@@ -215,7 +256,17 @@ public:
     enum LQOCP_SOLVER
     {
         GNRICCATI_SOLVER = 0,
-        HPIPM_SOLVER = 1
+        HPIPM_SOLVER = 1,
+        CONDENSING_SOLVER = 2  //! dense condensing, for short horizons and systems with many states
+    };
+
+    //! the time grid of the control problem
+    enum TIME_GRID
+    {
+        UNIFORM_GRID = 0,   //! all stages last dt
+        GEOMETRIC_GRID,     //! the first stage lasts dt, every following stage is timeGridGrowthFactor times longer
+        USER_DEFINED_GRID,  //! the stages last stageDurations, the last entry is repeated to fill the horizon
+        NUM_TIME_GRIDS
     };
 
     using APPROXIMATION = typename core::SensitivityApproximationSettings::APPROXIMATION;
@@ -230,6 +281,9 @@ public:
           timeVaryingDiscretization(false),
           nlocp_algorithm(GNMS),
           lqocp_solver(GNRICCATI_SOLVER),
+          timeGrid(UNIFORM_GRID),
+          timeGridGrowthFactor(1.1),
+          stageDurations(),
           loggingPrefix("alg"),
           epsilon(1e-5),
           dt(0.001),
@@ -244,10 +298,16 @@ public:
           recordSmallestEigenvalue(false),
           nThreads(4),
           nThreadsEigen(4),
+          nProcesses(1),
           lineSearchSettings(),
           debugPrint(false),
           printSummary(true),
           useSensitivityIntegrator(false),
+          incrementalLinearization(false),
+          incrementalLinearizationTol(1e-6),
+          incrementalLinearizationTimeInvariant(false),
+          horizonCostEvaluation(false),
+          splitMPCIteration(false),
           logToMatlab(false)
     {
     }
@@ -257,6 +317,9 @@ public:
     bool timeVaryingDiscretization;
     NLOCP_ALGORITHM nlocp_algorithm;  //! which nonlinear optimal control algorithm is to be used
     LQOCP_SOLVER lqocp_solver;        //! the solver for the linear-quadratic optimal control problem
+    TIME_GRID timeGrid;               //! the time grid, non-uniform grids allow for long horizons with few stages
+    double timeGridGrowthFactor;      //! ratio between the durations of two consecutive stages on a geometric grid
+    std::vector<double> stageDurations;  //! stage durations for the user-defined grid (seconds)
     std::string loggingPrefix;        //! the prefix to be stored before the matfile name for logging
     double epsilon;                   //! Eigenvalue correction factor for Hessian regularization
     double dt;                        //! sampling time for the control input (seconds)
@@ -272,11 +335,17 @@ public:
     int nThreads;                   //! number of threads, for MP version
     size_t
         nThreadsEigen;  //! number of threads for eigen parallelization (applies both to MP and ST) Note. in order to activate Eigen parallelization, compile with '-fopenmp'
+    int nProcesses;     //! number of worker processes for distributed multiple shooting, 1 disables it
     LineSearchSettings lineSearchSettings;  //! the line search settings
     LQOCSolverSettings lqoc_solver_settings;
     bool debugPrint;
     bool printSummary;
     bool useSensitivityIntegrator;
+    bool incrementalLinearization;       //! reuse the LQ approximation of stages which did not move significantly
+    double incrementalLinearizationTol;  //! max. state/control change (inf-norm) for which a stage is not re-linearized
+    bool incrementalLinearizationTimeInvariant;  //! declare the problem time-invariant, cached stages may be shifted in time
+    bool horizonCostEvaluation;  //! quadratize the intermediate cost for all stages at once, see CostFunctionQuadratic
+    bool splitMPCIteration;  //! in MPC, linearize the predicted trajectory before the state measurement arrives
     bool logToMatlab;  //! log to matlab (true/false)
 
 
@@ -293,9 +362,61 @@ public:
         {
             throw std::runtime_error("time Horizon is negative");
         }
-        return std::max(1, (int)std::lround(timeHorizon / dt));
+
+        if (timeGrid == UNIFORM_GRID)
+            return std::max(1, (int)std::lround(timeHorizon / dt));
+
+        // a shrinking geometric grid converges to a finite length dt / (1 - timeGridGrowthFactor)
+        if (timeGrid == GEOMETRIC_GRID && timeGridGrowthFactor < 1.0 &&
+            timeHorizon >= dt / (1.0 - timeGridGrowthFactor))
+        {
+            throw std::runtime_error(
+                "computeK: the geometric time grid with timeGridGrowthFactor < 1 cannot cover the time horizon.");
+        }
+
+        // add stages as long as the horizon is closer to the end of the next stage than to its start
+        int K = 0;
+        double t = 0.0;
+        while (t + 0.5 * getStageDuration(K) < timeHorizon)
+        {
+            if (getStageDuration(K) <= 0.0)
+                throw std::runtime_error("computeK: the time grid contains a stage with non-positive duration.");
+            t += getStageDuration(K++);
+        }
+
+        return std::max(1, K);
+    }
+
+    //! the duration of stage k of the time grid (seconds)
+    double getStageDuration(int k) const
+    {
+        switch (timeGrid)
+        {
+            case GEOMETRIC_GRID:
+                return dt * std::pow(timeGridGrowthFactor, k);
+            case USER_DEFINED_GRID:
+                return stageDurations.empty() ? dt : stageDurations[std::min<size_t>(k, stageDurations.size() - 1)];
+            default:
+                return dt;
+        }
+    }
+
+    //! compute the K+1 stage boundaries of the time grid, starting at zero
+    template <typename SCALAR = double>
+    ct::core::tpl::TimeArray<SCALAR> computeTimeGrid(int K) const
+    {
+        if (timeGrid == UNIFORM_GRID)
+            return ct::core::tpl::TimeArray<SCALAR>(dt, K + 1, 0.0);
+
+        ct::core::tpl::TimeArray<SCALAR> t(static_cast<size_t>(K + 1), SCALAR(0));
+        for (int k = 0; k < K; k++)
+            t[k + 1] = t[k] + getStageDuration(k);
+        return t;
     }
 
+    //! return if all stages have the same duration dt
+    bool hasUniformTimeGrid() const { return timeGrid == UNIFORM_GRID; }
+
     //! compute the simulation timestep
     double getSimulationTimestep() const { return (dt / (double)K_sim); }
 
@@ -315,7 +436,12 @@ public:
         std::cout << "time varying discretization: " << timeVaryingDiscretization << std::endl;
         std::cout << "nonlinear OCP algorithm: " << nlocAlgorithmToString.at(nlocp_algorithm) << std::endl;
         std::cout << "linear-quadratic OCP solver: " << lqocSolverToString.at(lqocp_solver) << std::endl;
+        std::cout << "time grid: " << timeGridToString.at(timeGrid) << std::endl;
         std::cout << "dt:\t" << dt << std::endl;
+        if (timeGrid == GEOMETRIC_GRID)
+            std::cout << "timeGridGrowthFactor:\t" << timeGridGrowthFactor << std::endl;
+        if (timeGrid == USER_DEFINED_GRID)
+            std::cout << "number of stageDurations:\t" << stageDurations.size() << std::endl;
         std::cout << "K_sim:\t" << K_sim << std::endl;
         std::cout << "K_shot:\t" << K_shot << std::endl;
         std::cout << "maxIter:\t" << max_iterations << std::endl;
@@ -328,10 +454,16 @@ public:
         std::cout << "epsilon:\t" << epsilon << std::endl;
         std::cout << "nThreads:\t" << nThreads << std::endl;
         std::cout << "nThreadsEigen:\t" << nThreadsEigen << std::endl;
+        std::cout << "nProcesses:\t" << nProcesses << std::endl;
         std::cout << "loggingPrefix:\t" << loggingPrefix << std::endl;
         std::cout << "debugPrint:\t" << debugPrint << std::endl;
         std::cout << "printSummary:\t" << printSummary << std::endl;
         std::cout << "useSensitivityIntegrator:\t" << useSensitivityIntegrator << std::endl;
+        std::cout << "incrementalLinearization:\t" << incrementalLinearization << std::endl;
+        std::cout << "incrementalLinearizationTol:\t" << incrementalLinearizationTol << std::endl;
+        std::cout << "incrementalLinearizationTimeInvariant:\t" << incrementalLinearizationTimeInvariant << std::endl;
+        std::cout << "horizonCostEvaluation:\t" << horizonCostEvaluation << std::endl;
+        std::cout << "splitMPCIteration:\t" << splitMPCIteration << std::endl;
         std::cout << "logToMatlab:\t" << logToMatlab << std::endl;
         std::cout << std::endl;
 
@@ -355,6 +487,45 @@ public:
             return false;
         }
 
+        if (timeGrid == GEOMETRIC_GRID && timeGridGrowthFactor <= 0)
+        {
+            std::cout << "Invalid parameter timeGridGrowthFactor in NLOptConSettings, needs to be > 0." << std::endl;
+            return false;
+        }
+
+        for (double duration : stageDurations)
+        {
+            if (timeGrid == USER_DEFINED_GRID && duration <= 0)
+            {
+                std::cout << "Invalid stageDurations in NLOptConSettings, all durations need to be > 0." << std::endl;
+                return false;
+            }
+        }
+
+        for (int length : lqoc_solver_settings.control_blocks)
+        {
+            if (length <= 0)
+            {
+                std::cout << "Invalid control_blocks in LQOCSolverSettings, all block lengths need to be >= 1."
+                          << std::endl;
+                return false;
+            }
+        }
+
+        if (lqoc_solver_settings.hasControlBlocks() && lqocp_solver != GNRICCATI_SOLVER)
+        {
+            std::cout << "Invalid parameter: control_blocks are only supported by the GNRICCATI_SOLVER." << std::endl;
+            return false;
+        }
+
+        if (lqoc_solver_settings.hasControlBlocks() && closedLoopShooting() && !isSingleShooting())
+        {
+            std::cout << "Invalid parameter: control_blocks cannot be combined with closed-loop multiple shooting, "
+                         "the shots would split the blocks."
+                      << std::endl;
+            return false;
+        }
+
         if (K_sim <= 0)
         {
             std::cout << "Invalid parameter K_sim in NLOptConSettings, needs to be >= 1. K_sim currently is " << K_sim
@@ -377,11 +548,31 @@ public:
             return false;
         }
 
+        if (incrementalLinearizationTol < 0)
+        {
+            std::cout << "Invalid parameter incrementalLinearizationTol in NLOptConSettings, needs to be >= 0."
+                      << std::endl;
+            return false;
+        }
+
         if (nThreads > 100 || nThreadsEigen > 100)
         {
             std::cout << "Number of threads should not exceed 100." << std::endl;
             return false;
         }
+
+        if (nProcesses < 1)
+        {
+            std::cout << "Invalid parameter nProcesses in NLOptConSettings, needs to be >= 1." << std::endl;
+            return false;
+        }
+
+        if (nProcesses > 1 && (isSingleShooting() || nThreads > 1))
+        {
+            std::cout << "Invalid parameter: nProcesses > 1 requires a multiple-shooting algorithm and nThreads = 1."
+                      << std::endl;
+            return false;
+        }
         return (lineSearchSettings.parametersOk());
     }
 
@@ -474,6 +665,36 @@ public:
         {
         }
         try
+        {
+            incrementalLinearization = pt.get<bool>(ns + ".incrementalLinearization");
+        } catch (...)
+        {
+        }
+        try
+        {
+            incrementalLinearizationTol = pt.get<double>(ns + ".incrementalLinearizationTol");
+        } catch (...)
+        {
+        }
+        try
+        {
+            incrementalLinearizationTimeInvariant = pt.get<bool>(ns + ".incrementalLinearizationTimeInvariant");
+        } catch (...)
+        {
+        }
+        try
+        {
+            horizonCostEvaluation = pt.get<bool>(ns + ".horizonCostEvaluation");
+        } catch (...)
+        {
+        }
+        try
+        {
+            splitMPCIteration = pt.get<bool>(ns + ".splitMPCIteration");
+        } catch (...)
+        {
+        }
+        try
         {
             logToMatlab = pt.get<bool>(ns + ".logToMatlab");
         } catch (...)
@@ -486,6 +707,22 @@ public:
         {
         }
         try
+        {
+            timeGridGrowthFactor = pt.get<double>(ns + ".timeGridGrowthFactor");
+        } catch (...)
+        {
+        }
+        try
+        {
+            // one entry per stage in the given order, see nlocSolver.info
+            std::vector<double> durations;
+            for (const auto& entry : pt.get_child(ns + ".stageDurations"))
+                durations.push_back(entry.second.get_value<double>());
+            stageDurations = durations;
+        } catch (...)
+        {
+        }
+        try
         {
             K_sim = pt.get<int>(ns + ".K_sim");
         } catch (...)
@@ -504,6 +741,12 @@ public:
         {
         }
         try
+        {
+            nProcesses = pt.get<int>(ns + ".nProcesses");
+        } catch (...)
+        {
+        }
+        try
         {
             recordSmallestEigenvalue = pt.get<bool>(ns + ".recordSmallestEigenvalue");
         } catch (...)
@@ -606,6 +849,28 @@ public:
         {
         }
 
+        try
+        {
+            std::string timeGridStr = pt.get<std::string>(ns + ".timeGrid");
+            if (stringToTimeGrid.find(timeGridStr) != stringToTimeGrid.end())
+            {
+                timeGrid = stringToTimeGrid[timeGridStr];
+            }
+            else
+            {
+                std::cout << "Invalid timeGrid specified in config, should be one of the following:" << std::endl;
+
+                for (auto it = stringToTimeGrid.begin(); it != stringToTimeGrid.end(); it++)
+                {
+                    std::cout << it->first << std::endl;
+                }
+
+                exit(-1);
+            }
+        } catch (...)
+        {
+        }
+
         if (verbose)
         {
             std::cout << "Loaded NLOptCon config from " << filename << ": " << std::endl;
@@ -677,11 +942,18 @@ private:
         {SS_OL, true}, {SS_CL, true}, {GNMS_M_OL, false}, {GNMS_M_CL, false}};
 
     //! mappings for linear-quadratic solver types
-    std::map<LQOCP_SOLVER, std::string> lqocSolverToString = {
-        {GNRICCATI_SOLVER, "GNRICCATI_SOLVER"}, {HPIPM_SOLVER, "HPIPM_SOLVER"}};
+    std::map<LQOCP_SOLVER, std::string> lqocSolverToString = {{GNRICCATI_SOLVER, "GNRICCATI_SOLVER"},
+        {HPIPM_SOLVER, "HPIPM_SOLVER"}, {CONDENSING_SOLVER, "CONDENSING_SOLVER"}};
+
+    std::map<std::string, LQOCP_SOLVER> stringToLqocSolver = {{"GNRICCATI_SOLVER", GNRICCATI_SOLVER},
+        {"HPIPM_SOLVER", HPIPM_SOLVER}, {"CONDENSING_SOLVER", CONDENSING_SOLVER}};
+
+    //! mappings for time grid types
+    std::map<TIME_GRID, std::string> timeGridToString = {
+        {UNIFORM_GRID, "UNIFORM_GRID"}, {GEOMETRIC_GRID, "GEOMETRIC_GRID"}, {USER_DEFINED_GRID, "USER_DEFINED_GRID"}};
 
-    std::map<std::string, LQOCP_SOLVER> stringToLqocSolver = {
-        {"GNRICCATI_SOLVER", GNRICCATI_SOLVER}, {"HPIPM_SOLVER", HPIPM_SOLVER}};
+    std::map<std::string, TIME_GRID> stringToTimeGrid = {
+        {"UNIFORM_GRID", UNIFORM_GRID}, {"GEOMETRIC_GRID", GEOMETRIC_GRID}, {"USER_DEFINED_GRID", USER_DEFINED_GRID}};
 };
 }  // namespace optcon
 }  // namespace ct
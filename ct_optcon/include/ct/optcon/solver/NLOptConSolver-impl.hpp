@@ -47,7 +47,10 @@ void NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::i
     const OptConProblem_t& optConProblem,
     const Settings_t& settings)
 {
-    if (settings.nThreads > 1)
+    if (settings.nProcesses > 1)
+        nlocBackend_ = std::shared_ptr<Backend_t>(new NLOCBackendDistributed<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM,
+            SCALAR, CONTINUOUS>(optConProblem, settings));
+    else if (settings.nThreads > 1)
         nlocBackend_ = std::shared_ptr<Backend_t>(
             new NLOCBackendMP<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>(optConProblem, settings));
     else
@@ -64,6 +67,9 @@ void NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::c
     if (nlocBackend_->getSettings().nThreads != settings.nThreads)
         throw std::runtime_error("cannot switch from ST to MT or vice versa. Please call initialize.");
 
+    if ((nlocBackend_->getSettings().nProcesses > 1) != (settings.nProcesses > 1))
+        throw std::runtime_error("cannot switch to or from distributed multiple shooting. Please call initialize.");
+
     nlocBackend_->configure(settings);
 
     setAlgorithm(settings);
@@ -217,6 +223,30 @@ void NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::c
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::changeInputBoxConstraints(
+    const typename OptConProblem_t::ConstraintPtr_t con)
+{
+    nlocBackend_->changeInputBoxConstraints(con);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::changeStateBoxConstraints(
+    const typename OptConProblem_t::ConstraintPtr_t con)
+{
+    nlocBackend_->changeStateBoxConstraints(con);
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::changeGeneralConstraints(
+    const typename OptConProblem_t::ConstraintPtr_t con)
+{
+    nlocBackend_->changeGeneralConstraints(con);
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
 SCALAR NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getCost() const
 {
@@ -354,5 +384,12 @@ void NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::l
     nlocBackend_->logSummaryToMatlab(fileName);
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setBinaryLogger(
+    const std::shared_ptr<core::BinaryLogger>& logger)
+{
+    nlocBackend_->setBinaryLogger(logger);
+}
+
 }  // namespace optcon
 }  // namespace ct
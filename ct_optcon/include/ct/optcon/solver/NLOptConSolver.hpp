@@ -9,6 +9,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 
 #include <ct/optcon/nloc/NLOCBackendST.hpp>
 #include <ct/optcon/nloc/NLOCBackendMP.hpp>
+#include <ct/optcon/nloc/NLOCBackendDistributed.hpp>
 
 #include <ct/optcon/nloc/algorithms/SingleShooting.hpp>
 #include <ct/optcon/nloc/algorithms/MultipleShooting.hpp>
@@ -195,6 +196,15 @@ public:
 	 */
     virtual void changeLinearSystem(const typename OptConProblem_t::LinearPtr_t& lin) override;
 
+    //! change the input box constraints
+    virtual void changeInputBoxConstraints(const typename OptConProblem_t::ConstraintPtr_t con) override;
+
+    //! change the state box constraints
+    virtual void changeStateBoxConstraints(const typename OptConProblem_t::ConstraintPtr_t con) override;
+
+    //! change the general constraints
+    virtual void changeGeneralConstraints(const typename OptConProblem_t::ConstraintPtr_t con) override;
+
     virtual SCALAR getCost() const override;
 
     //! get a reference to the current settings
@@ -242,6 +252,9 @@ public:
     //! logging a short summary to matlab
     void logSummaryToMatlab(const std::string& fileName);
 
+    //! stream the trajectories and the summary of every iteration to a binary logger, see NLOCBackendBase
+    void setBinaryLogger(const std::shared_ptr<core::BinaryLogger>& logger);
+
 protected:
     //! the backend holding all the math operations
     std::shared_ptr<Backend_t> nlocBackend_;
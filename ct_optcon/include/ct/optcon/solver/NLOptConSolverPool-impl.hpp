@@ -0,0 +1,193 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+NLOptConSolverPool<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::NLOptConSolverPool(
+    const Settings_t& settings,
+    size_t nThreads)
+    : settingsVersion_(0),
+      problems_(nullptr),
+      initialGuesses_(nullptr),
+      results_(nullptr),
+      nextProblem_(0),
+      batch_(0),
+      activeWorkers_(0),
+      stop_(false)
+{
+    // hardware_concurrency() may return 0 if unknown
+    nThreads = std::max(nThreads, size_t(1));
+
+    setSettings(settings);
+
+    solvers_.resize(nThreads);
+    solverSettingsVersion_.resize(nThreads, 0);
+
+    for (size_t i = 0; i < nThreads; i++)
+        workers_.push_back(std::thread(&NLOptConSolverPool::workerLoop, this, i));
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+NLOptConSolverPool<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::~NLOptConSolverPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    batchStarted_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConSolverPool<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::configure(
+    const Settings_t& settings)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // the workers read the settings without locking while a batch is running
+    batchFinished_.wait(lock, [this]() { return activeWorkers_ == 0; });
+
+    setSettings(settings);
+    settingsVersion_++;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+auto NLOptConSolverPool<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::getSettings() -> Settings_t
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return settings_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConSolverPool<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::setSettings(
+    const Settings_t& settings)
+{
+    settings_ = settings;
+
+    // every worker solves one problem at a time, and forking worker processes is not safe with threads running
+    settings_.nThreads = 1;
+    settings_.nThreadsEigen = 1;
+    settings_.nProcesses = 1;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConSolverPool<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::solve(const ProblemArray_t& problems,
+    const PolicyArray_t& initialGuesses,
+    ResultArray_t& results)
+{
+    if (problems.size() != initialGuesses.size())
+        throw std::runtime_error("NLOptConSolverPool: number of problems and initial guesses do not match.");
+
+    results.resize(problems.size());
+    if (problems.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    problems_ = &problems;
+    initialGuesses_ = &initialGuesses;
+    results_ = &results;
+    nextProblem_.store(0);
+    exception_ = nullptr;
+    activeWorkers_ = workers_.size();
+    batch_++;
+    batchStarted_.notify_all();
+
+    batchFinished_.wait(lock, [this]() { return activeWorkers_ == 0; });
+
+    problems_ = nullptr;
+    initialGuesses_ = nullptr;
+    results_ = nullptr;
+
+    if (exception_)
+        std::rethrow_exception(exception_);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+auto NLOptConSolverPool<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::solve(const ProblemArray_t& problems,
+    const PolicyArray_t& initialGuesses) -> ResultArray_t
+{
+    ResultArray_t results;
+    solve(problems, initialGuesses, results);
+    return results;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConSolverPool<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::workerLoop(size_t worker)
+{
+    size_t lastBatch = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            batchStarted_.wait(lock, [&]() { return stop_ || batch_ != lastBatch; });
+            if (stop_)
+                return;
+            lastBatch = batch_;
+        }
+
+        // take problems until the batch is exhausted
+        size_t problem;
+        while ((problem = nextProblem_.fetch_add(1)) < problems_->size())
+        {
+            try
+            {
+                solveProblem(worker, problem);
+            } catch (...)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (!exception_)
+                    exception_ = std::current_exception();
+            }
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            // wakes up solve() and a configure() waiting for the batch
+            if (--activeWorkers_ == 0)
+                batchFinished_.notify_all();
+        }
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR, bool CONTINUOUS>
+void NLOptConSolverPool<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS>::solveProblem(size_t worker,
+    size_t problem)
+{
+    const OptConProblem_t& optConProblem = (*problems_)[problem];
+    optConProblem.verify();
+
+    std::unique_ptr<Solver_t>& solver = solvers_[worker];
+
+    if (!solver)
+    {
+        solver.reset(new Solver_t(optConProblem, settings_));
+    }
+    else
+    {
+        // reuse the workspace of the worker, settings and problems do not change while a batch is running
+        if (solverSettingsVersion_[worker] != settingsVersion_)
+            solver->configure(settings_);
+        solver->setProblem(optConProblem);
+    }
+    solverSettingsVersion_[worker] = settingsVersion_;
+
+    solver->setInitialGuess((*initialGuesses_)[problem]);
+
+    Result& result = (*results_)[problem];
+    result.success = solver->solve();
+    result.cost = solver->getCost();
+    result.policy = solver->getSolution();
+    result.worker = worker;
+}
+
+}  // namespace optcon
+}  // namespace ct
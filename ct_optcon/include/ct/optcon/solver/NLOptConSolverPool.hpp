@@ -0,0 +1,146 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "NLOptConSolver.hpp"
+
+namespace ct {
+namespace optcon {
+
+/**
+ * \ingroup OptConSolver
+ *
+ * \brief Solves batches of independent optimal control problems on a fixed pool of threads
+ *
+ * Intended for many small problems per control cycle, e.g. one per agent or per sampled scenario. Every worker
+ * thread owns a single-threaded NLOptConSolver, which is created for the first problem the worker solves and reused
+ * for all later problems. Problems of a batch are handed out dynamically, hence the load is balanced if the problems
+ * take different amounts of time. Running N problems on a pool with M threads uses M threads in total, instead of
+ * N solvers each with their own threads.
+ *
+ * All problems solved by a pool should share their structure: the dimensions, the time step and, for the reuse of
+ * the workspaces to pay off, the number of stages. If a problem has constraints, all problems must have constraints
+ * of the same kind, since constraints are replaced but never removed from a worker's solver.
+ *
+ * \warning systems or cost functions using CppAD need CppAD to be set up for multi-threading,
+ * see ct::core::CppadParallel.
+ */
+template <size_t STATE_DIM,
+    size_t CONTROL_DIM,
+    size_t P_DIM = STATE_DIM / 2,
+    size_t V_DIM = STATE_DIM / 2,
+    typename SCALAR = double,
+    bool CONTINUOUS = true>
+class NLOptConSolverPool
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef NLOptConSolver<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR, CONTINUOUS> Solver_t;
+    typedef typename Solver_t::OptConProblem_t OptConProblem_t;
+    typedef typename Solver_t::Policy_t Policy_t;
+    typedef NLOptConSettings Settings_t;
+
+    //! the outcome of solving one problem of a batch
+    struct Result
+    {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        bool success;     //! return value of NLOptConSolver::solve()
+        SCALAR cost;      //! cost of the solution
+        Policy_t policy;  //! the optimized policy
+        size_t worker;    //! index of the worker thread which solved the problem
+    };
+
+    typedef std::vector<OptConProblem_t, Eigen::aligned_allocator<OptConProblem_t>> ProblemArray_t;
+    typedef std::vector<Policy_t, Eigen::aligned_allocator<Policy_t>> PolicyArray_t;
+    typedef std::vector<Result, Eigen::aligned_allocator<Result>> ResultArray_t;
+
+    //! constructor, starts the worker threads
+    /*!
+     * @param settings solver settings for all problems. The number of threads and processes is overwritten with 1,
+     * since the parallelism comes from solving several problems at once.
+     * @param nThreads number of worker threads, defaults to the number of hardware threads
+     */
+    NLOptConSolverPool(const Settings_t& settings, size_t nThreads = std::thread::hardware_concurrency());
+
+    //! destructor, stops the worker threads
+    ~NLOptConSolverPool();
+
+    NLOptConSolverPool(const NLOptConSolverPool&) = delete;
+    NLOptConSolverPool& operator=(const NLOptConSolverPool&) = delete;
+
+    //! solve a batch of problems, blocks until all problems are solved
+    /*!
+     * @param problems the problems to solve
+     * @param initialGuesses one initial guess per problem
+     * @param results the results, in the order of the problems. The memory is reused if it is passed again.
+     *
+     * If solving any of the problems throws, the first exception is rethrown after the batch has finished.
+     */
+    void solve(const ProblemArray_t& problems, const PolicyArray_t& initialGuesses, ResultArray_t& results);
+
+    //! solve a batch of problems and return the results, see above
+    ResultArray_t solve(const ProblemArray_t& problems, const PolicyArray_t& initialGuesses);
+
+    //! change the settings of all solvers
+    /*!
+     * If a batch is running, this waits until the batch has finished. The new settings apply from the next batch on.
+     * The number of threads and processes is overwritten with 1, see the constructor.
+     */
+    void configure(const Settings_t& settings);
+
+    //! the settings used by the solvers of the pool
+    Settings_t getSettings();
+
+    //! number of worker threads
+    size_t getNumberOfThreads() const { return workers_.size(); }
+
+private:
+    //! store the settings with multi-threading and multi-processing disabled, mutex_ must be locked
+    void setSettings(const Settings_t& settings);
+
+    //! main loop of a worker thread
+    void workerLoop(size_t worker);
+
+    //! solve one problem of the current batch on the given worker
+    void solveProblem(size_t worker, size_t problem);
+
+    Settings_t settings_;
+
+    //! one solver per worker, created lazily
+    std::vector<std::unique_ptr<Solver_t>> solvers_;
+    //! version of settings_, incremented by configure()
+    size_t settingsVersion_;
+    //! version of the settings each worker's solver was configured with
+    std::vector<size_t> solverSettingsVersion_;
+
+    std::vector<std::thread> workers_;
+
+    //! the current batch
+    const ProblemArray_t* problems_;
+    const PolicyArray_t* initialGuesses_;
+    ResultArray_t* results_;
+    std::atomic<size_t> nextProblem_;
+    std::exception_ptr exception_;
+
+    std::mutex mutex_;
+    std::condition_variable batchStarted_;
+    std::condition_variable batchFinished_;
+    size_t batch_;          //! number of the current batch, wakes up the workers
+    size_t activeWorkers_;  //! workers which did not finish the current batch yet
+    bool stop_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,383 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::CondensingLQOCSolver(
+    const std::shared_ptr<LQOCProblem_t>& lqocProblem)
+    : LQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>(lqocProblem),
+      N_(-1),
+      smallestEigenvalue_(std::numeric_limits<SCALAR>::infinity()),
+      activeSetIterations_(0),
+      feedbackValid_(false)
+{
+    if (lqocProblem)
+        setProblemImpl(lqocProblem);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::configure(const NLOptConSettings& settings)
+{
+    settings_ = settings;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+bool CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::configureInputBoxConstraints(
+    std::shared_ptr<LQOCProblem<STATE_DIM, CONTROL_DIM>> lqocProblem)
+{
+    // the bounds are read from the problem in every solve
+    return false;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::initializeAndAllocate()
+{
+    // do nothing, the condensed matrices are allocated in the first solve
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::setProblemImpl(std::shared_ptr<LQOCProblem_t> lqocProblem)
+{
+    if (lqocProblem->isStateBoxConstrained() || lqocProblem->isGeneralConstrained())
+    {
+        throw std::runtime_error(
+            "Selected wrong solver - CondensingLQOCSolver only handles input box constraints. Use HPIPM instead.");
+    }
+
+    changeNumberOfStages(lqocProblem->getNumberOfStages());
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::changeNumberOfStages(int N)
+{
+    if (N <= 0)
+        return;
+
+    if (N_ == N)
+        return;
+
+    this->lv_.resize(N);
+    this->L_.resize(N);
+
+    this->x_sol_.resize(N + 1);
+    this->u_sol_.resize(N);
+
+    N_ = N;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solve()
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+
+    // eliminate the states, the initial state is fixed to zero
+    condenser_.condense(p, 0, N_, false, true);
+
+    factorizeHessian();
+
+    activeSetIterations_ = 0;
+    if (p.isInputBoxConstrained())
+    {
+        setupBounds();
+        solveActiveSet();
+    }
+    else
+    {
+        U_ = -condenser_.h_;
+        llt_.solveInPlace(U_);
+    }
+
+    computeStatesAndControls();
+
+    // until compute_lv() is called, the feedforward is the open-loop control
+    this->lv_ = this->u_sol_;
+    feedbackValid_ = false;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+SCALAR CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::minEigenvalue(const VectorX& lambda) const
+{
+    // eigenvalues below the rounding error of SCALAR are not meaningful, e.g. when running in single precision
+    const SCALAR precisionLimit = Eigen::NumTraits<SCALAR>::epsilon() * lambda.cwiseAbs().maxCoeff();
+    return std::max(static_cast<SCALAR>(settings_.epsilon), precisionLimit);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::factorizeHessian()
+{
+    Hreg_ = condenser_.H_;
+    smallestEigenvalue_ = std::numeric_limits<SCALAR>::infinity();
+
+    if (settings_.fixedHessianCorrection)
+    {
+        if (settings_.epsilon > 1e-10)
+            Hreg_.diagonal().array() += settings_.epsilon;
+
+        if (settings_.recordSmallestEigenvalue)
+        {
+            eigenvalueSolver_.compute(Hreg_, Eigen::EigenvaluesOnly);
+            smallestEigenvalue_ = eigenvalueSolver_.eigenvalues().minCoeff();
+        }
+
+        llt_.compute(Hreg_);
+        if (llt_.info() == Eigen::Success)
+            return;
+
+        // not positive definite, fall back to the eigenvalue correction below
+        Hreg_ = condenser_.H_;
+    }
+
+    // make the Hessian positive definite by clamping its eigenvalues
+    eigenvalueSolver_.compute(Hreg_, Eigen::ComputeEigenvectors);
+    const VectorX& lambda = eigenvalueSolver_.eigenvalues();
+    if (settings_.recordSmallestEigenvalue)
+        smallestEigenvalue_ = std::min(smallestEigenvalue_, lambda.minCoeff());
+
+    const MatrixX& V = eigenvalueSolver_.eigenvectors();
+    Hreg_.noalias() = V * lambda.cwiseMax(minEigenvalue(lambda)).asDiagonal() * V.transpose();
+    llt_.compute(Hreg_);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::setupBounds()
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+    const int nU = condenser_.getNumberOfVariables();
+
+    lb_.setConstant(nU, -std::numeric_limits<SCALAR>::infinity());
+    ub_.setConstant(nU, std::numeric_limits<SCALAR>::infinity());
+
+    for (int k = 0; k < N_; k++)
+    {
+        for (int i = 0; i < p.nbu_[k]; i++)
+        {
+            const int idx = condenser_.controlIndex(k) + p.u_I_[k](i);
+            lb_(idx) = p.u_lb_[k](i);
+            ub_(idx) = p.u_ub_[k](i);
+        }
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solveActiveSet()
+{
+    const int nU = condenser_.getNumberOfVariables();
+
+    // start from the feasible point closest to the nominal controls
+    U_ = VectorX::Zero(nU).cwiseMax(lb_).cwiseMin(ub_);
+
+    int nBounds = 0;
+    active_.resize(nU);
+    for (int i = 0; i < nU; i++)
+    {
+        if (std::isfinite(lb_(i)) || std::isfinite(ub_(i)))
+            nBounds++;
+
+        if (lb_(i) >= ub_(i))
+            active_(i) = 2;  // equality, never released
+        else if (U_(i) == lb_(i) && lb_(i) > 0)
+            active_(i) = -1;
+        else if (U_(i) == ub_(i) && ub_(i) < 0)
+            active_(i) = 1;
+        else
+            active_(i) = 0;
+    }
+
+    // without degeneracy, every bound is added and released at most once in the typical case
+    const int maxIterations = 3 * nBounds + 10;
+    const SCALAR tolerance = std::sqrt(Eigen::NumTraits<SCALAR>::epsilon());
+
+    while (activeSetIterations_ < maxIterations)
+    {
+        activeSetIterations_++;
+
+        if (computeFreeStep())
+        {
+            // go as far as possible towards the minimum on the current working set
+            SCALAR alpha = 1.0;
+            int blocking = -1;
+            int side = 0;
+            for (int i : free_)
+            {
+                if (step_(i) < 0 && std::isfinite(lb_(i)) && (lb_(i) - U_(i)) > alpha * step_(i))
+                {
+                    alpha = (lb_(i) - U_(i)) / step_(i);
+                    blocking = i;
+                    side = -1;
+                }
+                else if (step_(i) > 0 && std::isfinite(ub_(i)) && (ub_(i) - U_(i)) < alpha * step_(i))
+                {
+                    alpha = (ub_(i) - U_(i)) / step_(i);
+                    blocking = i;
+                    side = 1;
+                }
+            }
+
+            U_.noalias() += alpha * step_;
+
+            if (blocking >= 0)
+            {
+                U_(blocking) = (side < 0) ? lb_(blocking) : ub_(blocking);
+                active_(blocking) = side;
+            }
+            continue;
+        }
+
+        // minimum on the current working set, release the bound with the most negative multiplier
+        gradient_ = condenser_.h_;
+        gradient_.noalias() += Hreg_.template selfadjointView<Eigen::Lower>() * U_;
+
+        int release = -1;
+        SCALAR worst = tolerance * (1.0 + condenser_.h_.cwiseAbs().maxCoeff());
+        for (int i = 0; i < nU; i++)
+        {
+            const SCALAR violation = (active_(i) == -1) ? -gradient_(i) : (active_(i) == 1 ? gradient_(i) : 0.0);
+            if (violation > worst)
+            {
+                worst = violation;
+                release = i;
+            }
+        }
+
+        if (release < 0)
+            return;
+
+        active_(release) = 0;
+    }
+
+    if (settings_.lqoc_solver_settings.lqoc_debug_print)
+        std::cout << "CondensingLQOCSolver: active-set method did not converge in " << maxIterations
+                  << " iterations, using the last feasible iterate." << std::endl;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+bool CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeFreeStep()
+{
+    const int nU = condenser_.getNumberOfVariables();
+
+    free_.clear();
+    for (int i = 0; i < nU; i++)
+        if (active_(i) == 0)
+            free_.push_back(i);
+
+    step_.setZero(nU);
+    if (free_.empty())
+        return false;
+
+    gradient_ = condenser_.h_;
+    gradient_.noalias() += Hreg_.template selfadjointView<Eigen::Lower>() * U_;
+
+    if (static_cast<int>(free_.size()) == nU)
+    {
+        // no bound in the working set, reuse the factorization of the full Hessian
+        step_ = -gradient_;
+        llt_.solveInPlace(step_);
+    }
+    else
+    {
+        // reduced Newton system on the free variables, free_ is sorted, so (a, b) with a >= b is in the lower triangle
+        const int nFree = static_cast<int>(free_.size());
+        Hff_.resize(nFree, nFree);
+        rhs_.resize(nFree);
+        for (int a = 0; a < nFree; a++)
+        {
+            rhs_(a) = -gradient_(free_[a]);
+            for (int b = 0; b <= a; b++)
+                Hff_(a, b) = Hreg_(free_[a], free_[b]);
+        }
+
+        Eigen::LLT<MatrixX, Eigen::Lower> llt(Hff_);
+        llt.solveInPlace(rhs_);
+
+        for (int a = 0; a < nFree; a++)
+            step_(free_[a]) = rhs_(a);
+    }
+
+    const SCALAR tolerance = std::sqrt(Eigen::NumTraits<SCALAR>::epsilon());
+    return step_.cwiseAbs().maxCoeff() > tolerance * (1.0 + U_.cwiseAbs().maxCoeff());
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeStatesAndControls()
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+
+    this->x_sol_[0].setZero();  // should always be zero (fixed init state)
+
+    for (int k = 0; k < N_; k++)
+    {
+        this->u_sol_[k] = U_.template segment<CONTROL_DIM>(condenser_.controlIndex(k));
+
+        //! state update rule in diff coordinates
+        this->x_sol_[k + 1] = p.A_[k] * this->x_sol_[k] + p.B_[k] * this->u_sol_[k] + p.b_[k];
+    }
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeFeedbackMatrices()
+{
+    if (feedbackValid_)
+        return;
+
+    LQOCProblem_t& p = *this->lqocProblem_;
+
+    // unconstrained Riccati backward pass, only the feedback matrices are needed
+    StateMatrix S = p.Q_[N_];
+    for (int k = N_ - 1; k >= 0; k--)
+    {
+        ControlMatrix H = p.R_[k];
+        H.noalias() += p.B_[k].transpose() * S * p.B_[k];
+
+        FeedbackMatrix G = p.P_[k];
+        G.noalias() += p.B_[k].transpose() * S * p.A_[k];
+
+        if (settings_.fixedHessianCorrection)
+        {
+            if (settings_.epsilon > 1e-10)
+                H.diagonal().array() += settings_.epsilon;
+            this->L_[k] = -H.template selfadjointView<Eigen::Lower>().llt().solve(G);
+        }
+        else
+        {
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix<SCALAR, CONTROL_DIM, CONTROL_DIM>> eigenvalueSolver(H);
+            const ControlMatrix& V = eigenvalueSolver.eigenvectors();
+            const auto& lambda = eigenvalueSolver.eigenvalues();
+            const SCALAR lambdaMin = std::max(static_cast<SCALAR>(settings_.epsilon),
+                Eigen::NumTraits<SCALAR>::epsilon() * lambda.cwiseAbs().maxCoeff());
+            this->L_[k] = -V * lambda.cwiseMax(lambdaMin).cwiseInverse().asDiagonal() * V.transpose() * G;
+        }
+
+        // S = Q + A^T S A - L^T H L, with H L = -G
+        const StateMatrix Snext = S;
+        S = p.Q_[k];
+        S.noalias() += p.A_[k].transpose() * Snext * p.A_[k];
+        S.noalias() += this->L_[k].transpose() * G;
+        S = 0.5 * (S + S.transpose()).eval();
+    }
+
+    feedbackValid_ = true;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::compute_lv()
+{
+    computeFeedbackMatrices();
+
+    for (int k = 0; k < N_; k++)
+        this->lv_[k] = this->u_sol_[k] - this->L_[k] * this->x_sol_[k];
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+SCALAR CondensingLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::getSmallestEigenvalue()
+{
+    return smallestEigenvalue_;
+}
+
+}  // namespace optcon
+}  // namespace ct
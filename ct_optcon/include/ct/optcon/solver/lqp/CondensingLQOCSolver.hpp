@@ -0,0 +1,121 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "LQOCSolver.hpp"
+#include "LQOCCondenser.hpp"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * Solves an LQOCProblem by condensing: the states are eliminated by forward substitution and the resulting dense
+ * QP in the controls of all stages is solved with a Cholesky factorization. The states are recovered by a forward
+ * simulation.
+ *
+ * Condensing costs \f$ O(N^2) \f$ in the horizon length but only \f$ O(m^3 N^3) \f$ in the factorization, whereas
+ * the Riccati recursion scales with \f$ O(N n^3) \f$. It is therefore faster for short horizons and systems with many
+ * more states than controls.
+ *
+ * Input box constraints are handled with a primal active-set method on the dense QP, which works well for the small
+ * number of constraints typical for short horizons. State box constraints and general constraints are not supported,
+ * use HPIPM (optionally on a partially condensed problem, see LQOCPartialCondensing) for those.
+ *
+ * The feedback matrices are those of the unconstrained problem and are computed by a Riccati backward pass on demand.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class CondensingLQOCSolver : public LQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const int state_dim = STATE_DIM;
+    static const int control_dim = CONTROL_DIM;
+
+    typedef LQOCProblem<STATE_DIM, CONTROL_DIM, SCALAR> LQOCProblem_t;
+    typedef LQOCCondenser<STATE_DIM, CONTROL_DIM, SCALAR> Condenser_t;
+    typedef typename Condenser_t::MatrixX MatrixX;
+    typedef typename Condenser_t::VectorX VectorX;
+
+    typedef ct::core::StateMatrix<STATE_DIM, SCALAR> StateMatrix;
+    typedef ct::core::ControlMatrix<CONTROL_DIM, SCALAR> ControlMatrix;
+    typedef ct::core::FeedbackMatrix<STATE_DIM, CONTROL_DIM, SCALAR> FeedbackMatrix;
+
+    CondensingLQOCSolver(const std::shared_ptr<LQOCProblem_t>& lqocProblem = nullptr);
+
+    virtual void configure(const NLOptConSettings& settings) override;
+
+    virtual bool configureInputBoxConstraints(
+        std::shared_ptr<LQOCProblem<STATE_DIM, CONTROL_DIM>> lqocProblem) override;
+
+    virtual void initializeAndAllocate() override;
+
+    virtual void solve() override;
+
+    virtual void computeStatesAndControls() override;
+
+    virtual void computeFeedbackMatrices() override;
+
+    virtual void compute_lv() override;
+
+    virtual SCALAR getSmallestEigenvalue() override;
+
+    //! number of active-set iterations of the last solve, zero for unconstrained problems
+    int getNumberOfActiveSetIterations() const { return activeSetIterations_; }
+
+protected:
+    virtual void setProblemImpl(std::shared_ptr<LQOCProblem_t> lqocProblem) override;
+
+    void changeNumberOfStages(int N);
+
+    //! regularize the condensed Hessian and factorize it, the lower triangle of Hreg_ is valid afterwards
+    void factorizeHessian();
+
+    //! lower bound for the eigenvalues of the regularized Hessian, at least epsilon and the precision of SCALAR
+    SCALAR minEigenvalue(const VectorX& lambda) const;
+
+    //! collect the input box constraints of all stages as bounds on the condensed variables
+    void setupBounds();
+
+    //! solve the box-constrained QP on the condensed variables with a primal active-set method
+    void solveActiveSet();
+
+    //! Newton step on the free variables from the current iterate, returns false if the step is zero
+    bool computeFreeStep();
+
+    NLOptConSettings settings_;
+
+    Condenser_t condenser_;
+
+    int N_;
+
+    //! regularized condensed Hessian
+    MatrixX Hreg_;
+    Eigen::LLT<MatrixX, Eigen::Lower> llt_;
+    Eigen::SelfAdjointEigenSolver<MatrixX> eigenvalueSolver_;
+    SCALAR smallestEigenvalue_;
+
+    //! condensed solution, the controls of all stages
+    VectorX U_;
+
+    //! active-set data
+    VectorX lb_;
+    VectorX ub_;
+    //! -1 at the lower bound, 1 at the upper bound, 2 lower and upper bound coincide, 0 free
+    Eigen::VectorXi active_;
+    std::vector<int> free_;
+    VectorX step_;
+    VectorX gradient_;
+    MatrixX Hff_;
+    VectorX rhs_;
+    int activeSetIterations_;
+
+    //! whether L_ belongs to the last solved problem
+    bool feedbackValid_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -40,6 +40,19 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solveSingleStage(int N)
 
     designController(N);
 
+    if (blockStarts_[N] != N)
+    {
+        computeBlockCostToGo(N);
+        return;
+    }
+
+    // the stages inside the block hold the control of its first stage, they must not add feedback of their own
+    for (size_t k = N + 1; k < blockStarts_.size() && blockStarts_[k] == N; k++)
+    {
+        this->L_[k].setZero();
+        this->lv_[k] = this->lv_[N];
+    }
+
     if (N > 0)
         computeCostToGo(N);
 }
@@ -50,6 +63,7 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::configure(const NLOptConSe
 {
     settings_ = settings;
     H_corrFix_ = settings_.epsilon * ControlMatrix::Identity();
+    updateControlBlocks();
 }
 
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
@@ -61,8 +75,11 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeStatesAndControls()
 
     for (int k = 0; k < this->lqocProblem_->getNumberOfStages(); k++)
     {
-        //! control update rule in diff coordinates
-        this->u_sol_[k] = this->lv_[k] + this->L_[k] * this->x_sol_[k];
+        //! control update rule in diff coordinates, stages inside a control block hold the control of the block
+        if (blockStarts_[k] == k)
+            this->u_sol_[k] = this->lv_[k] + this->L_[k] * this->x_sol_[k];
+        else
+            this->u_sol_[k] = this->u_sol_[blockStarts_[k]];
 
         //! state update rule in diff coordinates
         this->x_sol_[k + 1] = p.A_[k] * this->x_sol_[k] + p.B_[k] * (this->u_sol_[k]) + p.b_[k];
@@ -125,6 +142,15 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::changeNumberOfStages(int N
     S_.resize(N + 1);
 
     N_ = N;
+
+    updateControlBlocks();
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::updateControlBlocks()
+{
+    blockStarts_ = settings_.lqoc_solver_settings.computeBlockStarts(N_);
 }
 
 
@@ -161,6 +187,32 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeCostToGo(size_t k)
 }
 
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeBlockCostToGo(size_t k)
+{
+    LQOCProblem_t& p = *this->lqocProblem_;
+
+    // the control is shared with the previous stage, its cross terms are kept in G_[k], H_[k] and gv_[k]
+    S_[k] = p.Q_[k];
+    S_[k].noalias() += p.A_[k].transpose() * S_[k + 1] * p.A_[k];
+
+    S_[k] = 0.5 * (S_[k] + S_[k].transpose()).eval();
+
+    sv_[k] = p.qv_[k];
+    sv_[k].noalias() += p.A_[k].transpose() * sv_[k + 1];
+    sv_[k].noalias() += p.A_[k].transpose() * S_[k + 1] * p.b_[k];
+}
+
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+SCALAR GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::minEigenvalue(const ControlVector& lambda) const
+{
+    // eigenvalues below the rounding error of SCALAR are not meaningful, e.g. when running in single precision
+    const SCALAR precisionLimit = Eigen::NumTraits<SCALAR>::epsilon() * lambda.cwiseAbs().maxCoeff();
+    return std::max(static_cast<SCALAR>(settings_.epsilon), precisionLimit);
+}
+
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
 void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
 {
@@ -178,6 +230,23 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
     //H_[k].noalias() += B_[k].transpose() * S_[k+1] * B_[k];
     H_[k].noalias() += p.B_[k].transpose() * S_[k + 1].template selfadjointView<Eigen::Lower>() * p.B_[k];
 
+    // add the terms of the following stages of the same control block, which share the control of stage k
+    if (k + 1 < blockStarts_.size() && blockStarts_[k + 1] == blockStarts_[k])
+    {
+        gv_[k].noalias() += G_[k + 1] * p.b_[k];
+        gv_[k] += gv_[k + 1];
+
+        G_[k].noalias() += G_[k + 1] * p.A_[k];
+
+        H_[k].noalias() += G_[k + 1] * p.B_[k];
+        H_[k].noalias() += p.B_[k].transpose() * G_[k + 1].transpose();
+        H_[k] += H_[k + 1];
+    }
+
+    // the control of a block is designed at its first stage
+    if (blockStarts_[k] != static_cast<int>(k))
+        return;
+
     if (settings_.fixedHessianCorrection)
     {
         if (settings_.epsilon > 1e-10)
@@ -197,7 +266,7 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
             // Corrected Eigenvalue Matrix
             ControlMatrix D = ControlMatrix::Zero();
             // make D positive semi-definite (as described in IV. B.)
-            D.diagonal() = lambda.cwiseMax(settings_.epsilon);
+            D.diagonal() = lambda.cwiseMax(minEigenvalue(lambda));
 
             // reconstruct H
             ControlMatrix Hi_regular = V * D * V.transpose();
@@ -240,7 +309,7 @@ void GNRiccatiSolver<STATE_DIM, CONTROL_DIM, SCALAR>::designController(size_t k)
         // Corrected Eigenvalue Matrix
         ControlMatrix D = ControlMatrix::Zero();
         // make D positive semi-definite (as described in IV. B.)
-        D.diagonal() = lambda.cwiseMax(settings_.epsilon);
+        D.diagonal() = lambda.cwiseMax(minEigenvalue(lambda));
 
         // reconstruct H
         Hi_[k].noalias() = V * D * V.transpose();
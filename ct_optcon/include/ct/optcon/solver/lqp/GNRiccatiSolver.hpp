@@ -17,6 +17,10 @@ namespace optcon {
 /*!
  * This class implements an general Riccati backward pass for solving an unconstrained
  *  linear-quadratic Optimal Control problem
+ *
+ * With move blocking (see LQOCSolverSettings::control_blocks), consecutive stages share one control. The
+ * recursion then carries the terms coupling the state and the shared control through the block and only
+ * factorizes one control Hessian per block, the problem is never expanded to the full number of controls.
  */
 template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
 class GNRiccatiSolver : public LQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>
@@ -73,8 +77,17 @@ protected:
 
     void computeCostToGo(size_t k);
 
+    //! cost-to-go of a stage inside a control block, the control of the block is not yet eliminated
+    void computeBlockCostToGo(size_t k);
+
+    //! assign the stages to control blocks
+    void updateControlBlocks();
+
     void designController(size_t k);
 
+    //! lower bound for the eigenvalues of the regularized Hessian, at least epsilon and the precision of SCALAR
+    SCALAR minEigenvalue(const ControlVector& lambda) const;
+
     void logToMatlab();
 
     NLOptConSettings settings_;
@@ -92,6 +105,9 @@ protected:
 
     int N_;
 
+    //! the first stage of the control block containing each stage
+    std::vector<int> blockStarts_;
+
     SCALAR smallestEigenvalue_;
 
     //! Eigenvalue solver, used for inverting the Hessian and for regularization
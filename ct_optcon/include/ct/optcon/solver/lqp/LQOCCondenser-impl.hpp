@@ -0,0 +1,127 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+LQOCCondenser<STATE_DIM, CONTROL_DIM, SCALAR>::LQOCCondenser() : c_(0.0), nStages_(-1), nx0_(-1)
+{
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void LQOCCondenser<STATE_DIM, CONTROL_DIM, SCALAR>::resize(int nStages, int nx0)
+{
+    if (nStages == nStages_ && nx0 == nx0_)
+        return;
+
+    nStages_ = nStages;
+    nx0_ = nx0;
+
+    const int nz = getNumberOfVariables();
+
+    H_.resize(nz, nz);
+    h_.resize(nz);
+
+    Gamma_.resize(nStages + 1);
+    for (size_t l = 0; l < Gamma_.size(); l++)
+        Gamma_[l].resize(STATE_DIM, nz);
+    g_.resize(nStages + 1);
+
+    V_.resize(STATE_DIM, nz);
+    Vnext_.resize(STATE_DIM, nz);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void LQOCCondenser<STATE_DIM, CONTROL_DIM, SCALAR>::condense(LQOCProblem_t& p,
+    int start,
+    int end,
+    bool withInitialState,
+    bool withTerminalCost)
+{
+    const int N = p.getNumberOfStages();
+    if (start < 0 || end > N || end <= start)
+        throw std::runtime_error("LQOCCondenser: invalid range of stages.");
+    if (withTerminalCost && end != N)
+        throw std::runtime_error("LQOCCondenser: the terminal cost can only be added to the last stage.");
+
+    const int m = static_cast<int>(CONTROL_DIM);
+    const int L = end - start;
+    resize(L, withInitialState ? static_cast<int>(STATE_DIM) : 0);
+    const int nz = getNumberOfVariables();
+
+    // forward substitution of the dynamics, the state at stage l only depends on the first controlIndex(l) variables
+    Gamma_[0].setZero();
+    if (withInitialState)
+        Gamma_[0].leftCols(STATE_DIM).setIdentity();
+    g_[0].setZero();
+
+    for (int l = 0; l < L; l++)
+    {
+        const int k = start + l;
+        const int w = controlIndex(l);
+
+        Gamma_[l + 1].leftCols(w).noalias() = p.A_[k] * Gamma_[l].leftCols(w);
+        Gamma_[l + 1].middleCols(w, m) = p.B_[k];
+        Gamma_[l + 1].rightCols(nz - w - m).setZero();
+
+        g_[l + 1] = p.b_[k];
+        g_[l + 1].noalias() += p.A_[k] * g_[l];
+    }
+
+    H_.setZero();
+    c_ = 0.0;
+
+    if (withTerminalCost)
+    {
+        V_.noalias() = p.Q_[N] * Gamma_[L];
+        lambda_ = p.qv_[N];
+        lambda_.noalias() += p.Q_[N] * g_[L];
+        c_ += p.q_[N] + p.qv_[N].dot(g_[L]) + 0.5 * g_[L].dot(p.Q_[N] * g_[L]);
+    }
+    else
+    {
+        V_.setZero();
+        lambda_.setZero();
+    }
+
+    // backward pass, fills the lower triangle row block by row block
+    for (int l = L - 1; l >= 0; l--)
+    {
+        const int k = start + l;
+        const int w = controlIndex(l);
+
+        H_.block(w, 0, m, w + m).noalias() = p.B_[k].transpose() * V_.leftCols(w + m);
+        H_.block(w, 0, m, w).noalias() += p.P_[k] * Gamma_[l].leftCols(w);
+        H_.block(w, w, m, m) += p.R_[k];
+
+        h_.segment(w, m) = p.rv_[k];
+        h_.segment(w, m).noalias() += p.P_[k] * g_[l];
+        h_.segment(w, m).noalias() += p.B_[k].transpose() * lambda_;
+
+        // only the columns of earlier variables are needed from here on
+        Vnext_.leftCols(w).noalias() = p.Q_[k] * Gamma_[l].leftCols(w);
+        Vnext_.leftCols(w).noalias() += p.A_[k].transpose() * V_.leftCols(w);
+        V_.swap(Vnext_);
+
+        const ct::core::StateVector<STATE_DIM, SCALAR> lambdaNext = lambda_;
+        lambda_ = p.qv_[k];
+        lambda_.noalias() += p.Q_[k] * g_[l];
+        lambda_.noalias() += p.A_[k].transpose() * lambdaNext;
+
+        c_ += p.q_[k] + p.qv_[k].dot(g_[l]) + 0.5 * g_[l].dot(p.Q_[k] * g_[l]);
+    }
+
+    if (withInitialState)
+    {
+        H_.topLeftCorner(STATE_DIM, STATE_DIM) = V_.leftCols(STATE_DIM);
+        h_.head(STATE_DIM) = lambda_;
+    }
+}
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,84 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <ct/optcon/problem/LQOCProblem.hpp>
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * Eliminates the states of a range of stages [start, end) of an LQOCProblem by forward substitution.
+ *
+ * The states are expressed as affine functions of the condensed variables
+ * \f$ z = [\delta x_{start}; \delta u_{start}; \ldots; \delta u_{end-1}] \f$
+ * with \f$ \delta x_{start+l} = \Gamma_l z + g_l \f$, and the cost of the stages becomes the dense quadratic
+ * \f$ \frac{1}{2} z^\top H z + h^\top z + c \f$. If the initial state is not a decision variable, it is zero and is
+ * dropped from z.
+ *
+ * The Hessian is assembled with a backward recursion over the stages and costs
+ * \f$ O(N^2 n^2 m) \f$ for N stages, which pays off for short horizons.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = double>
+class LQOCCondenser
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef LQOCProblem<STATE_DIM, CONTROL_DIM, SCALAR> LQOCProblem_t;
+
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic> MatrixX;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> VectorX;
+    typedef ct::core::DiscreteArray<MatrixX> MatrixXArray;
+    typedef ct::core::StateVectorArray<STATE_DIM, SCALAR> StateVectorArray;
+
+    LQOCCondenser();
+
+    /*!
+     * condense the stages [start, end) of an LQOCProblem
+     * @param p the problem
+     * @param start first stage
+     * @param end stage after the last stage, its state is the final state of the block
+     * @param withInitialState if true, the state at stage start is a decision variable, otherwise it is zero
+     * @param withTerminalCost if true, the terminal cost of the problem is added to the final state of the block
+     */
+    void condense(LQOCProblem_t& p, int start, int end, bool withInitialState, bool withTerminalCost);
+
+    //! number of stages of the last condensed block
+    int getNumberOfStages() const { return nStages_; }
+    //! number of condensed variables
+    int getNumberOfVariables() const { return nx0_ + nStages_ * CONTROL_DIM; }
+    //! offset of the control of stage start+l in z
+    int controlIndex(int l) const { return nx0_ + l * static_cast<int>(CONTROL_DIM); }
+
+    //! condensed Hessian, only the lower triangle is valid
+    MatrixX H_;
+    //! condensed gradient
+    VectorX h_;
+    //! constant cost
+    SCALAR c_;
+
+    //! sensitivities of the states of the block w.r.t. z, size nStages + 1
+    MatrixXArray Gamma_;
+    //! free response of the states of the block, size nStages + 1
+    StateVectorArray g_;
+
+private:
+    void resize(int nStages, int nx0);
+
+    int nStages_;
+    int nx0_;
+
+    //! backward recursion of the Hessian, V_l = Q_l Gamma_l + A_l^T V_{l+1} on the columns of the previous stages
+    MatrixX V_;
+    MatrixX Vnext_;
+
+    //! backward recursion of the gradient
+    ct::core::StateVector<STATE_DIM, SCALAR> lambda_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,166 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t BLOCK_SIZE, typename SCALAR>
+void LQOCPartialCondensing<STATE_DIM, CONTROL_DIM, BLOCK_SIZE, SCALAR>::condense(LQOCProblem_t& problem,
+    CondensedProblem_t& condensed)
+{
+    typedef typename Condenser_t::MatrixX MatrixX;
+
+    const int n = static_cast<int>(STATE_DIM);
+    const int m = static_cast<int>(CONTROL_DIM);
+    const int mc = static_cast<int>(condensed_control_dim);
+
+    const int N = problem.getNumberOfStages();
+    const int Nc = getNumberOfCondensedStages(N);
+
+    if (condensed.getNumberOfStages() != Nc)
+        condensed.changeNumStages(Nc);
+
+    for (int b = 0; b < Nc; b++)
+    {
+        const int start = b * static_cast<int>(BLOCK_SIZE);
+        const int end = std::min(start + static_cast<int>(BLOCK_SIZE), N);
+        const int L = end - start;
+        const int mL = L * m;
+
+        condenser_.condense(problem, start, end, true, false);
+        const MatrixX& H = condenser_.H_;
+        const MatrixX& Gamma = condenser_.Gamma_[L];
+
+        // cost, the padded controls of a short last block get unit cost
+        condensed.Q_[b] = H.topLeftCorner(n, n);
+        condensed.P_[b].setZero();
+        condensed.P_[b].topRows(mL) = H.block(n, 0, mL, n);
+        const MatrixX Huu = H.bottomRightCorner(mL, mL).template selfadjointView<Eigen::Lower>();
+        condensed.R_[b].setIdentity();
+        condensed.R_[b].topLeftCorner(mL, mL) = Huu;
+        condensed.qv_[b] = condenser_.h_.head(n);
+        condensed.rv_[b].setZero();
+        condensed.rv_[b].head(mL) = condenser_.h_.tail(mL);
+        condensed.q_[b] = condenser_.c_;
+
+        // dynamics from the first state of the block to the first state of the next block
+        condensed.A_[b] = Gamma.leftCols(n);
+        condensed.B_[b].setZero();
+        condensed.B_[b].leftCols(mL) = Gamma.rightCols(mL);
+        condensed.b_[b] = condenser_.g_[L];
+
+        // input box constraints are stacked
+        int nbu = 0;
+        for (int l = 0; l < L; l++)
+        {
+            const int k = start + l;
+            for (int i = 0; i < problem.nbu_[k]; i++, nbu++)
+            {
+                condensed.u_I_[b](nbu) = l * m + problem.u_I_[k](i);
+                condensed.u_lb_[b](nbu) = problem.u_lb_[k](i);
+                condensed.u_ub_[b](nbu) = problem.u_ub_[k](i);
+            }
+        }
+        condensed.nbu_[b] = nbu;
+
+        // state box constraints on the first state of the block remain box constraints
+        condensed.nbx_[b] = problem.nbx_[start];
+        condensed.x_I_[b] = problem.x_I_[start];
+        condensed.x_lb_[b] = problem.x_lb_[start];
+        condensed.x_ub_[b] = problem.x_ub_[start];
+
+        // general constraints of the block and state box constraints inside the block become general constraints
+        int ng = 0;
+        for (int l = 0; l < L; l++)
+            ng += problem.ng_[start + l] + (l > 0 ? problem.nbx_[start + l] : 0);
+
+        condensed.ng_[b] = ng;
+        condensed.C_[b].setZero(ng, n);
+        condensed.D_[b].setZero(ng, mc);
+        condensed.d_lb_[b].resize(ng, 1);
+        condensed.d_ub_[b].resize(ng, 1);
+
+        int row = 0;
+        for (int l = 0; l < L; l++)
+        {
+            const int k = start + l;
+            const MatrixX& Gamma_l = condenser_.Gamma_[l];
+            const ct::core::StateVector<STATE_DIM, SCALAR>& g_l = condenser_.g_[l];
+
+            const int ngk = problem.ng_[k];
+            if (ngk > 0)
+            {
+                condensed.C_[b].middleRows(row, ngk).noalias() = problem.C_[k] * Gamma_l.leftCols(n);
+                condensed.D_[b].block(row, 0, ngk, mL).noalias() = problem.C_[k] * Gamma_l.rightCols(mL);
+                condensed.D_[b].block(row, l * m, ngk, m) += problem.D_[k];
+                condensed.d_lb_[b].middleRows(row, ngk) = problem.d_lb_[k] - problem.C_[k] * g_l;
+                condensed.d_ub_[b].middleRows(row, ngk) = problem.d_ub_[k] - problem.C_[k] * g_l;
+                row += ngk;
+            }
+
+            for (int i = 0; l > 0 && i < problem.nbx_[k]; i++, row++)
+            {
+                const int idx = problem.x_I_[k](i);
+                condensed.C_[b].row(row) = Gamma_l.row(idx).leftCols(n);
+                condensed.D_[b].row(row).leftCols(mL) = Gamma_l.row(idx).rightCols(mL);
+                condensed.d_lb_[b](row) = problem.x_lb_[k](i) - g_l(idx);
+                condensed.d_ub_[b](row) = problem.x_ub_[k](i) - g_l(idx);
+            }
+        }
+    }
+
+    // the final stage is not condensed
+    condensed.Q_[Nc] = problem.Q_[N];
+    condensed.qv_[Nc] = problem.qv_[N];
+    condensed.q_[Nc] = problem.q_[N];
+    condensed.b_[Nc].setZero();
+
+    condensed.nbx_[Nc] = problem.nbx_[N];
+    condensed.x_I_[Nc] = problem.x_I_[N];
+    condensed.x_lb_[Nc] = problem.x_lb_[N];
+    condensed.x_ub_[Nc] = problem.x_ub_[N];
+
+    condensed.ng_[Nc] = problem.ng_[N];
+    condensed.C_[Nc] = problem.C_[N];
+    condensed.D_[Nc].setZero(problem.ng_[N], mc);
+    condensed.d_lb_[Nc] = problem.d_lb_[N];
+    condensed.d_ub_[Nc] = problem.d_ub_[N];
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t BLOCK_SIZE, typename SCALAR>
+void LQOCPartialCondensing<STATE_DIM, CONTROL_DIM, BLOCK_SIZE, SCALAR>::expandSolution(LQOCProblem_t& problem,
+    const StateVectorArray& x_condensed,
+    const CondensedControlVectorArray& u_condensed,
+    StateVectorArray& x,
+    ControlVectorArray& u) const
+{
+    const int N = problem.getNumberOfStages();
+    const int Nc = getNumberOfCondensedStages(N);
+
+    if (static_cast<int>(x_condensed.size()) != Nc + 1 || static_cast<int>(u_condensed.size()) != Nc)
+        throw std::runtime_error("LQOCPartialCondensing: solution does not match the condensed problem.");
+
+    x.resize(N + 1);
+    u.resize(N);
+
+    // simulate from the first state of every block with the controls of the block
+    for (int b = 0; b < Nc; b++)
+    {
+        const int start = b * static_cast<int>(BLOCK_SIZE);
+        const int end = std::min(start + static_cast<int>(BLOCK_SIZE), N);
+
+        x[start] = x_condensed[b];
+        for (int k = start; k < end; k++)
+        {
+            u[k] = u_condensed[b].template segment<CONTROL_DIM>((k - start) * CONTROL_DIM);
+            x[k + 1] = problem.A_[k] * x[k] + problem.B_[k] * u[k] + problem.b_[k];
+        }
+    }
+}
+
+}  // namespace optcon
+}  // namespace ct
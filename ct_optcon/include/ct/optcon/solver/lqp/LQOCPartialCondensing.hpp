@@ -0,0 +1,71 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "LQOCCondenser.hpp"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * Partial condensing of an LQOCProblem into a problem with a shorter horizon.
+ *
+ * Blocks of BLOCK_SIZE consecutive stages are condensed into a single stage whose control stacks the controls of
+ * the block. The states at the block boundaries stay decision variables, hence the condensed problem is again an
+ * LQOCProblem and can be handed to any LQOCSolver, typically HPIPMInterface<STATE_DIM, CONTROL_DIM * BLOCK_SIZE>.
+ * This trades the horizon length against the control dimension, which pays off for structure-exploiting solvers
+ * when the horizon is long and the number of controls is small.
+ *
+ * Input box constraints are stacked, state box constraints at the block boundaries stay box constraints and state
+ * box constraints inside a block become general constraints. If the horizon is not a multiple of BLOCK_SIZE, the
+ * last block is padded with controls which do not enter the dynamics and have unit cost.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t BLOCK_SIZE, typename SCALAR = double>
+class LQOCPartialCondensing
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static const size_t condensed_control_dim = CONTROL_DIM * BLOCK_SIZE;
+
+    typedef LQOCProblem<STATE_DIM, CONTROL_DIM, SCALAR> LQOCProblem_t;
+    typedef LQOCProblem<STATE_DIM, CONTROL_DIM * BLOCK_SIZE, SCALAR> CondensedProblem_t;
+    typedef LQOCCondenser<STATE_DIM, CONTROL_DIM, SCALAR> Condenser_t;
+
+    typedef ct::core::StateVectorArray<STATE_DIM, SCALAR> StateVectorArray;
+    typedef ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> ControlVectorArray;
+    typedef ct::core::ControlVectorArray<CONTROL_DIM * BLOCK_SIZE, SCALAR> CondensedControlVectorArray;
+
+    //! number of stages of the condensed problem for a problem with N stages
+    static int getNumberOfCondensedStages(int N) { return (N + BLOCK_SIZE - 1) / BLOCK_SIZE; }
+
+    /*!
+     * condense a problem
+     * @param problem the problem with N stages
+     * @param condensed the condensed problem, resized to getNumberOfCondensedStages(N) stages if required
+     */
+    void condense(LQOCProblem_t& problem, CondensedProblem_t& condensed);
+
+    /*!
+     * map the solution of the condensed problem back to the stages of the original problem
+     * @param problem the original problem
+     * @param x_condensed states of the condensed problem, i.e. at the block boundaries
+     * @param u_condensed stacked controls of the condensed problem
+     * @param x the states of all stages
+     * @param u the controls of all stages
+     */
+    void expandSolution(LQOCProblem_t& problem,
+        const StateVectorArray& x_condensed,
+        const CondensedControlVectorArray& u_condensed,
+        StateVectorArray& x,
+        ControlVectorArray& u) const;
+
+private:
+    Condenser_t condenser_;
+};
+
+}  // namespace optcon
+}  // namespace ct
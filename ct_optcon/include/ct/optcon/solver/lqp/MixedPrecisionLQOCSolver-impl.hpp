@@ -0,0 +1,133 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+#pragma once
+
+namespace ct {
+namespace optcon {
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::MixedPrecisionLQOCSolver(
+    const std::shared_ptr<LQOCSolverDouble_t>& solver,
+    const std::shared_ptr<LQOCProblem_t>& lqocProblem)
+    : LQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>(lqocProblem), solver_(solver), problemDouble_(new LQOCProblemDouble_t)
+{
+    if (!solver_)
+        throw std::runtime_error("MixedPrecisionLQOCSolver: double precision solver is a nullptr.");
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::configure(const NLOptConSettings& settings)
+{
+    solver_->configure(settings);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::initializeAndAllocate()
+{
+    solver_->initializeAndAllocate();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solve()
+{
+    solver_->solve();
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::solveSingleStage(int N)
+{
+    solver_->solveSingleStage(N);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeStatesAndControls()
+{
+    solver_->computeStatesAndControls();
+    castArray(solver_->getSolutionState(), this->x_sol_);
+    castArray(solver_->getSolutionControl(), this->u_sol_);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::computeFeedbackMatrices()
+{
+    solver_->computeFeedbackMatrices();
+    castArray(solver_->getSolutionFeedback(), this->L_);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::compute_lv()
+{
+    solver_->compute_lv();
+    castArray(solver_->get_lv(), this->lv_);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+auto MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::get_lv() -> const ControlVectorArray&
+{
+    // solvers like the Riccati solver update lv during the backward pass, without call to compute_lv()
+    castArray(solver_->get_lv(), this->lv_);
+    return this->lv_;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+SCALAR MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::getSmallestEigenvalue()
+{
+    return static_cast<SCALAR>(solver_->getSmallestEigenvalue());
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+void MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::setProblemImpl(
+    std::shared_ptr<LQOCProblem_t> lqocProblem)
+{
+    const LQOCProblem_t& p = *lqocProblem;
+    LQOCProblemDouble_t& pd = *problemDouble_;
+
+    if (pd.getNumberOfStages() != lqocProblem->getNumberOfStages())
+        pd.changeNumStages(lqocProblem->getNumberOfStages());
+
+    // affine dynamics and quadratic cost
+    castArray(p.A_, pd.A_);
+    castArray(p.B_, pd.B_);
+    castArray(p.b_, pd.b_);
+    for (size_t k = 0; k < p.q_.size(); k++)
+        pd.q_[k] = static_cast<double>(p.q_[k]);
+    castArray(p.qv_, pd.qv_);
+    castArray(p.Q_, pd.Q_);
+    castArray(p.rv_, pd.rv_);
+    castArray(p.R_, pd.R_);
+    castArray(p.P_, pd.P_);
+
+    // constraints
+    castArray(p.u_lb_, pd.u_lb_);
+    castArray(p.u_ub_, pd.u_ub_);
+    castArray(p.x_lb_, pd.x_lb_);
+    castArray(p.x_ub_, pd.x_ub_);
+    pd.u_I_ = p.u_I_;
+    pd.x_I_ = p.x_I_;
+    pd.nbu_ = p.nbu_;
+    pd.nbx_ = p.nbx_;
+    castArray(p.d_lb_, pd.d_lb_);
+    castArray(p.d_ub_, pd.d_ub_);
+    castArray(p.C_, pd.C_);
+    castArray(p.D_, pd.D_);
+    pd.ng_ = p.ng_;
+
+    solver_->setProblem(problemDouble_);
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR>
+template <typename IN_ARRAY, typename OUT_ARRAY>
+void MixedPrecisionLQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>::castArray(const IN_ARRAY& in, OUT_ARRAY& out)
+{
+    typedef typename OUT_ARRAY::value_type::Scalar OutScalar;
+
+    out.resize(in.size());
+    for (size_t k = 0; k < in.size(); k++)
+        out[k] = in[k].template cast<OutScalar>();
+}
+
+}  // namespace optcon
+}  // namespace ct
@@ -0,0 +1,76 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include "LQOCSolver.hpp"
+
+namespace ct {
+namespace optcon {
+
+/*!
+ * Solves an LQOCProblem of scalar type SCALAR (e.g. float) with a double precision LQOCSolver.
+ *
+ * This allows running rollouts and linearizations of NLOC in single precision while the factorizations of the
+ * Riccati backward pass (or of HPIPM, which only supports double) are carried out in double precision.
+ * The problem data is converted to double when the problem is set, the solution is converted back to SCALAR
+ * when it is retrieved.
+ */
+template <size_t STATE_DIM, size_t CONTROL_DIM, typename SCALAR = float>
+class MixedPrecisionLQOCSolver : public LQOCSolver<STATE_DIM, CONTROL_DIM, SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef LQOCProblem<STATE_DIM, CONTROL_DIM, SCALAR> LQOCProblem_t;
+    typedef LQOCProblem<STATE_DIM, CONTROL_DIM, double> LQOCProblemDouble_t;
+    typedef LQOCSolver<STATE_DIM, CONTROL_DIM, double> LQOCSolverDouble_t;
+
+    typedef ct::core::ControlVectorArray<CONTROL_DIM, SCALAR> ControlVectorArray;
+
+    /*!
+     * Constructor
+     * @param solver the double precision solver doing the actual work
+     * @param lqocProblem the problem to be solved, can also be set later with setProblem()
+     */
+    MixedPrecisionLQOCSolver(const std::shared_ptr<LQOCSolverDouble_t>& solver,
+        const std::shared_ptr<LQOCProblem_t>& lqocProblem = nullptr);
+
+    virtual void configure(const NLOptConSettings& settings) override;
+
+    virtual void initializeAndAllocate() override;
+
+    virtual void solve() override;
+
+    virtual void solveSingleStage(int N) override;
+
+    virtual void computeStatesAndControls() override;
+
+    virtual void computeFeedbackMatrices() override;
+
+    virtual void compute_lv() override;
+
+    virtual const ControlVectorArray& get_lv() override;
+
+    virtual SCALAR getSmallestEigenvalue() override;
+
+    //! the double precision solver
+    const std::shared_ptr<LQOCSolverDouble_t>& getDoublePrecisionSolver() const { return solver_; }
+
+protected:
+    //! converts the complete problem to double and hands it over to the double precision solver
+    virtual void setProblemImpl(std::shared_ptr<LQOCProblem_t> lqocProblem) override;
+
+    //! element-wise conversion of an array of Eigen types
+    template <typename IN_ARRAY, typename OUT_ARRAY>
+    static void castArray(const IN_ARRAY& in, OUT_ARRAY& out);
+
+    std::shared_ptr<LQOCSolverDouble_t> solver_;
+
+    std::shared_ptr<LQOCProblemDouble_t> problemDouble_;
+};
+
+}  // namespace optcon
+}  // namespace ct
@@ -21,6 +21,19 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
 {
 }
 
+template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
+void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::changeTimeGrid(
+    const ct::core::tpl::TimeArray<SCALAR>& timeGrid)
+{
+    timeGrid_ = timeGrid;
+
+    for (size_t i = 0; i < discretizers_.size(); i++)
+    {
+        discretizers_[i]->setTimeGrid(timeGrid_);
+        sensitivity_[i]->setTimeGrid(timeGrid_);
+    }
+}
+
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
 void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALAR>::changeNonlinearSystem(
     const typename optConProblem_t::DynamicsPtr_t& dyn)
@@ -36,6 +49,7 @@ void OptconContinuousSystemInterface<STATE_DIM, CONTROL_DIM, P_DIM, V_DIM, SCALA
         discretizers_.at(i) = system_discretizer_ptr_t(new discretizer_t(
             this->systems_.at(i), this->settings_.dt, this->settings_.integrator, this->settings_.K_sim));
         discretizers_.at(i)->initialize();
+        discretizers_.at(i)->setTimeGrid(timeGrid_);
     }
 }
 template <size_t STATE_DIM, size_t CONTROL_DIM, size_t P_DIM, size_t V_DIM, typename SCALAR>
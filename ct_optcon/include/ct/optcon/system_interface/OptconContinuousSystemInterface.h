@@ -107,6 +107,9 @@ public:
     //! set the number of stages/time steps
     virtual void changeNumStages(const int numStages) override;
 
+    //! set the stage boundaries of a non-uniform time grid, passed on to the discretizers and sensitivities
+    virtual void changeTimeGrid(const ct::core::tpl::TimeArray<SCALAR>& timeGrid) override;
+
     virtual void getSubstates(StateVectorArrayPtr& subStepsX, const size_t threadId) override;
     virtual void getSubcontrols(ControlVectorArrayPtr& subStepsU, const size_t threadId) override;
 
@@ -120,6 +123,8 @@ private:
 
     std::vector<SensitivityPtr, Eigen::aligned_allocator<SensitivityPtr>>
         sensitivity_;  //! the ct sensitivity integrators
+
+    ct::core::tpl::TimeArray<SCALAR> timeGrid_;  //! the non-uniform time grid, empty for a uniform grid
 };
 
 }  // namespace optcon
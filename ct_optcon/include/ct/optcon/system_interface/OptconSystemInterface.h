@@ -98,6 +98,8 @@ public:
 
     //! set the number of stages/time steps
     virtual void changeNumStages(const int numStages) {}
+    //! set the K+1 stage boundaries of a non-uniform time grid, an empty grid stands for the uniform grid with dt
+    virtual void changeTimeGrid(const ct::core::tpl::TimeArray<SCALAR>& timeGrid) {}
     const optConProblem_t& getOptConProblem() { return optConProblem_; };
     std::vector<typename optConProblem_t::DynamicsPtr_t>& getNonlinearSystemsInstances() { return systems_; }
     std::vector<typename optConProblem_t::LinearPtr_t>& getLinearSystemsInstances() { return linearSystems_; }
@@ -0,0 +1,613 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <ct/optcon/optcon.h>
+
+#include "../testSystems/LinearOscillator.h"
+
+const size_t state_dim = 12;
+const size_t control_dim = 4;
+
+using namespace ct::core;
+using namespace ct::optcon;
+
+/*!
+ * Create an analytical cost function with a mix of term types and time activations
+ */
+std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> createMixedCostFunction()
+{
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction(
+        new CostFunctionAnalytical<state_dim, control_dim>());
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        Eigen::Matrix<double, state_dim, state_dim> Q = Eigen::Matrix<double, state_dim, state_dim>::Random();
+        Eigen::Matrix<double, control_dim, control_dim> R = Eigen::Matrix<double, control_dim, control_dim>::Random();
+        std::shared_ptr<TermQuadratic<state_dim, control_dim>> quadTerm(new TermQuadratic<state_dim, control_dim>(
+            Q, R, StateVector<state_dim>::Random(), ControlVector<control_dim>::Random()));
+
+        // smooth time activation, such that the term weight differs from one
+        quadTerm->setTimeActivation(std::shared_ptr<ct::core::tpl::ActivationBase<double>>(
+            new ct::core::tpl::RBFGaussActivation<double>(0.5 * i, 1.0)));
+        costFunction->addIntermediateTerm(quadTerm);
+    }
+
+    // a term which is only active in a time window
+    std::shared_ptr<TermQuadratic<state_dim, control_dim>> windowTerm(
+        new TermQuadratic<state_dim, control_dim>(Eigen::Matrix<double, state_dim, state_dim>::Identity(),
+            Eigen::Matrix<double, control_dim, control_dim>::Identity()));
+    windowTerm->setTimeActivation(
+        std::shared_ptr<ct::core::tpl::ActivationBase<double>>(new ct::core::tpl::SingleActivation<double>(1.0, 2.0)));
+    costFunction->addIntermediateTerm(windowTerm);
+
+    costFunction->addIntermediateTerm(std::shared_ptr<TermLinear<state_dim, control_dim>>(new TermLinear<state_dim,
+        control_dim>(StateVector<state_dim>::Random(), ControlVector<control_dim>::Random())));
+
+    ControlVector<control_dim> u_ref = ControlVector<control_dim>::Random();
+    costFunction->addIntermediateTerm(
+        std::shared_ptr<TermMixed<state_dim, control_dim>>(new TermMixed<state_dim, control_dim>(
+            Eigen::Matrix<double, control_dim, state_dim>::Random(), StateVector<state_dim>::Random(), u_ref)));
+
+    costFunction->addIntermediateTerm(
+        std::shared_ptr<TermSmoothAbs<state_dim, control_dim>>(new TermSmoothAbs<state_dim, control_dim>(
+            Eigen::Matrix<double, state_dim, 1>::Random(), Eigen::Matrix<double, state_dim, 1>::Random(),
+            Eigen::Matrix<double, control_dim, 1>::Random(), Eigen::Matrix<double, control_dim, 1>::Random(), 0.5)));
+
+    return costFunction;
+}
+
+/*!
+ * Test that the fused quadratization matches the individual derivative methods
+ */
+TEST(CostFunctionQuadratizeTest, FusedMatchesIndividualDerivatives)
+{
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction = createMixedCostFunction();
+
+    StateVector<state_dim> q;
+    StateMatrix<state_dim> Q;
+    ControlVector<control_dim> r;
+    ControlMatrix<control_dim> R;
+    FeedbackMatrix<state_dim, control_dim> P;
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        // covers times with and without the time window term being active
+        double t = 0.03 * i;
+        costFunction->setCurrentStateAndControl(
+            StateVector<state_dim>::Random(), ControlVector<control_dim>::Random(), t);
+
+        costFunction->quadratizeIntermediate(q, Q, r, R, P);
+
+        ASSERT_TRUE(q.isApprox(costFunction->stateDerivativeIntermediate(), 1e-10));
+        ASSERT_TRUE(Q.isApprox(costFunction->stateSecondDerivativeIntermediate(), 1e-10));
+        ASSERT_TRUE(r.isApprox(costFunction->controlDerivativeIntermediate(), 1e-10));
+        ASSERT_TRUE(R.isApprox(costFunction->controlSecondDerivativeIntermediate(), 1e-10));
+        ASSERT_TRUE(P.isApprox(costFunction->stateControlDerivativeIntermediate(), 1e-10));
+    }
+}
+
+/*!
+ * Test that the default implementation of the fused quadratization is used by cost functions which do not override it
+ */
+TEST(CostFunctionQuadratizeTest, DefaultQuadratize)
+{
+    Eigen::Matrix<double, state_dim, state_dim> Q_weight = Eigen::Matrix<double, state_dim, state_dim>::Identity();
+    Eigen::Matrix<double, control_dim, control_dim> R_weight =
+        Eigen::Matrix<double, control_dim, control_dim>::Identity();
+    StateVector<state_dim> x_nom = StateVector<state_dim>::Random();
+    ControlVector<control_dim> u_nom = ControlVector<control_dim>::Random();
+
+    CostFunctionQuadraticSimple<state_dim, control_dim> costFunction(
+        Q_weight, R_weight, x_nom, u_nom, StateVector<state_dim>::Zero(), Q_weight);
+
+    StateVector<state_dim> q;
+    StateMatrix<state_dim> Q;
+    ControlVector<control_dim> r;
+    ControlMatrix<control_dim> R;
+    FeedbackMatrix<state_dim, control_dim> P;
+
+    costFunction.setCurrentStateAndControl(StateVector<state_dim>::Random(), ControlVector<control_dim>::Random(), 0.0);
+    costFunction.quadratizeIntermediate(q, Q, r, R, P);
+
+    ASSERT_TRUE(q.isApprox(costFunction.stateDerivativeIntermediate()));
+    ASSERT_TRUE(Q.isApprox(costFunction.stateSecondDerivativeIntermediate()));
+    ASSERT_TRUE(r.isApprox(costFunction.controlDerivativeIntermediate()));
+    ASSERT_TRUE(R.isApprox(costFunction.controlSecondDerivativeIntermediate()));
+    ASSERT_TRUE(P.isZero());
+}
+
+/*!
+ * Test the terminal cost of the simple quadratic cost function for a one-dimensional state
+ */
+TEST(CostFunctionQuadratizeTest, SimpleTerminalCostOneDimensional)
+{
+    Eigen::Matrix<double, 1, 1> Q, R, Q_final;
+    Q << 1.0;
+    R << 1.0;
+    Q_final << 4.0;
+    StateVector<1> x_final;
+    x_final << 0.5;
+
+    CostFunctionQuadraticSimple<1, 1> costFunction(
+        Q, R, StateVector<1>::Zero(), ControlVector<1>::Zero(), x_final, Q_final);
+
+    StateVector<1> x;
+    x << 2.0;
+    costFunction.setCurrentStateAndControl(x, ControlVector<1>::Zero(), 1.0);
+
+    ASSERT_NEAR(costFunction.evaluateTerminal(), 0.5 * 4.0 * 1.5 * 1.5, 1e-12);
+}
+
+/*!
+ * Create an analytical cost function with tracking terms and time activations
+ */
+std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> createTrackingCostFunction(bool trackControl)
+{
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction = createMixedCostFunction();
+
+    StateTrajectory<state_dim> stateTraj;
+    ControlTrajectory<control_dim> controlTraj;
+    for (size_t i = 0; i < 50; ++i)
+    {
+        stateTraj.push_back(StateVector<state_dim>::Random(), 0.1 * i, true);
+        controlTraj.push_back(ControlVector<control_dim>::Random(), 0.1 * i, true);
+    }
+
+    std::shared_ptr<TermQuadTracking<state_dim, control_dim>> trackingTerm(
+        new TermQuadTracking<state_dim, control_dim>(Eigen::Matrix<double, state_dim, state_dim>::Random(),
+            Eigen::Matrix<double, control_dim, control_dim>::Random(), InterpolationType::LIN, InterpolationType::ZOH,
+            trackControl));
+    trackingTerm->setName("tracking");
+    trackingTerm->setStateAndControlReference(stateTraj, controlTraj);
+    trackingTerm->setTimeActivation(std::shared_ptr<ct::core::tpl::ActivationBase<double>>(
+        new ct::core::tpl::RBFGaussActivation<double>(2.0, 1.0)));
+    costFunction->addIntermediateTerm(trackingTerm);
+
+    return costFunction;
+}
+
+/*!
+ * Test that the horizon-level quadratization matches the quadratization of the individual stages
+ */
+TEST(CostFunctionQuadratizeTest, HorizonMatchesStagewise)
+{
+    const size_t K = 100;
+    const double dt = 0.04;
+    const double tShift = 0.3;
+
+    TimeArray times(K);
+    StateVectorArray<state_dim> x(K + 1);
+    ControlVectorArray<control_dim> u(K);
+    for (size_t k = 0; k < K; k++)
+    {
+        times[k] = dt * k;
+        x[k].setRandom();
+        u[k].setRandom();
+    }
+
+    StateVectorArray<state_dim> q(K);
+    StateMatrixArray<state_dim> Q(K);
+    ControlVectorArray<control_dim> r(K);
+    ControlMatrixArray<control_dim> R(K);
+    FeedbackArray<state_dim, control_dim> P(K);
+
+    StateVector<state_dim> q_k;
+    StateMatrix<state_dim> Q_k;
+    ControlVector<control_dim> r_k;
+    ControlMatrix<control_dim> R_k;
+    FeedbackMatrix<state_dim, control_dim> P_k;
+
+    for (int trackControl = 0; trackControl <= 1; trackControl++)
+    {
+        std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction =
+            createTrackingCostFunction(bool(trackControl));
+        costFunction->shiftTime(tShift);
+
+        costFunction->prepareHorizon(times);
+
+        // quadratize in two chunks, as done by the solvers in the MPC case
+        costFunction->quadratizeIntermediateHorizon(x, u, 1, K - 1, dt, q, Q, r, R, P);
+        costFunction->quadratizeIntermediateHorizon(x, u, 0, 0, dt, q, Q, r, R, P);
+
+        for (size_t k = 0; k < K; k++)
+        {
+            costFunction->setCurrentStateAndControl(x[k], u[k], times[k]);
+            costFunction->quadratizeIntermediate(q_k, Q_k, r_k, R_k, P_k);
+
+            ASSERT_TRUE(q[k].isApprox(dt * q_k, 1e-10));
+            ASSERT_TRUE(Q[k].isApprox(dt * Q_k, 1e-10));
+            ASSERT_TRUE(r[k].isApprox(dt * r_k, 1e-10));
+            ASSERT_TRUE(R[k].isApprox(dt * R_k, 1e-10));
+            ASSERT_TRUE(P[k].isApprox(dt * P_k, 1e-10));
+        }
+
+        // a new reference needs to be picked up by the next preparation
+        std::shared_ptr<TermQuadTracking<state_dim, control_dim>> trackingTerm =
+            std::static_pointer_cast<TermQuadTracking<state_dim, control_dim>>(
+                costFunction->getIntermediateTermByName("tracking"));
+        StateTrajectory<state_dim> stateTraj(
+            StateVectorArray<state_dim>(50, StateVector<state_dim>::Ones()), 0.1, 0.0, InterpolationType::LIN);
+        ControlTrajectory<control_dim> controlTraj(
+            ControlVectorArray<control_dim>(50, ControlVector<control_dim>::Ones()), 0.1, 0.0, InterpolationType::ZOH);
+        trackingTerm->setStateAndControlReference(stateTraj, controlTraj);
+
+        costFunction->prepareHorizon(times);
+        costFunction->quadratizeIntermediateHorizon(x, u, 0, K - 1, dt, q, Q, r, R, P);
+
+        for (size_t k = 0; k < K; k++)
+        {
+            costFunction->setCurrentStateAndControl(x[k], u[k], times[k]);
+            costFunction->quadratizeIntermediate(q_k, Q_k, r_k, R_k, P_k);
+            ASSERT_TRUE(q[k].isApprox(dt * q_k, 1e-10));
+            ASSERT_TRUE(r[k].isApprox(dt * r_k, 1e-10));
+        }
+    }
+}
+
+/*!
+ * Test that clones share the reference trajectories of the tracking term but are not affected by a new reference
+ */
+TEST(CostFunctionQuadratizeTest, TrackingCloneSharesReference)
+{
+    std::shared_ptr<CostFunctionAnalytical<state_dim, control_dim>> costFunction = createTrackingCostFunction(true);
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> clone(costFunction->clone());
+
+    std::vector<StateVector<state_dim>, Eigen::aligned_allocator<StateVector<state_dim>>> x(20);
+    std::vector<ControlVector<control_dim>, Eigen::aligned_allocator<ControlVector<control_dim>>> u(20);
+    std::vector<double> cost(20);
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        x[i].setRandom();
+        u[i].setRandom();
+        costFunction->setCurrentStateAndControl(x[i], u[i], 0.23 * i);
+        clone->setCurrentStateAndControl(x[i], u[i], 0.23 * i);
+        cost[i] = costFunction->evaluateIntermediate();
+        ASSERT_NEAR(cost[i], clone->evaluateIntermediate(), 1e-12);
+        ASSERT_TRUE(costFunction->stateDerivativeIntermediate().isApprox(clone->stateDerivativeIntermediate()));
+        ASSERT_TRUE(costFunction->controlDerivativeIntermediate().isApprox(clone->controlDerivativeIntermediate()));
+    }
+
+    // the clone keeps tracking the previous reference
+    std::shared_ptr<TermQuadTracking<state_dim, control_dim>> trackingTerm =
+        std::static_pointer_cast<TermQuadTracking<state_dim, control_dim>>(
+            costFunction->getIntermediateTermByName("tracking"));
+    StateTrajectory<state_dim> stateTraj(
+        StateVectorArray<state_dim>(50, StateVector<state_dim>::Ones()), 0.1, 0.0, InterpolationType::LIN);
+    ControlTrajectory<control_dim> controlTraj(
+        ControlVectorArray<control_dim>(50, ControlVector<control_dim>::Ones()), 0.1, 0.0, InterpolationType::ZOH);
+    trackingTerm->setStateAndControlReference(stateTraj, controlTraj);
+
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        clone->setCurrentStateAndControl(x[i], u[i], 0.23 * i);
+        ASSERT_NEAR(cost[i], clone->evaluateIntermediate(), 1e-12);
+    }
+
+    costFunction->setCurrentStateAndControl(x[5], u[5], 0.23 * 5);
+    ASSERT_GT(std::abs(cost[5] - costFunction->evaluateIntermediate()), 1e-6);
+}
+
+/*!
+ * Test that the solvers give the same result with and without the horizon-level cost evaluation
+ */
+TEST(CostFunctionQuadratizeTest, HorizonCostEvaluationInSolver)
+{
+    using namespace ct::optcon::example;
+    const size_t osc_state_dim = ct::optcon::example::state_dim;
+    const size_t osc_control_dim = ct::optcon::example::control_dim;
+    typedef NLOptConSolver<osc_state_dim, osc_control_dim> Solver_t;
+
+    const double tf = 2.0;
+
+    // a sinusoidal state reference
+    StateTrajectory<osc_state_dim> stateTraj;
+    ControlTrajectory<osc_control_dim> controlTraj;
+    for (size_t i = 0; i <= 40; ++i)
+    {
+        StateVector<osc_state_dim> x_ref;
+        x_ref << std::sin(0.25 * i), 0.25 * std::cos(0.25 * i);
+        stateTraj.push_back(x_ref, 0.1 * i, true);
+        controlTraj.push_back(ControlVector<osc_control_dim>::Zero(), 0.1 * i, true);
+    }
+
+    std::shared_ptr<TermQuadTracking<osc_state_dim, osc_control_dim>> trackingTerm(
+        new TermQuadTracking<osc_state_dim, osc_control_dim>(StateMatrix<osc_state_dim>::Identity(),
+            0.1 * ControlMatrix<osc_control_dim>::Identity(), InterpolationType::LIN, InterpolationType::ZOH, true));
+    trackingTerm->setStateAndControlReference(stateTraj, controlTraj);
+    trackingTerm->setTimeActivation(std::shared_ptr<ct::core::tpl::ActivationBase<double>>(
+        new ct::core::tpl::RBFGaussActivation<double>(1.0, 0.5)));
+
+    std::shared_ptr<CostFunctionAnalytical<osc_state_dim, osc_control_dim>> costFunction(
+        new CostFunctionAnalytical<osc_state_dim, osc_control_dim>());
+    costFunction->addIntermediateTerm(trackingTerm);
+    costFunction->addIntermediateTerm(std::shared_ptr<TermQuadratic<osc_state_dim, osc_control_dim>>(
+        new TermQuadratic<osc_state_dim, osc_control_dim>(0.01 * StateMatrix<osc_state_dim>::Identity(),
+            ControlMatrix<osc_control_dim>::Identity())));
+    costFunction->addFinalTerm(std::shared_ptr<TermQuadratic<osc_state_dim, osc_control_dim>>(
+        new TermQuadratic<osc_state_dim, osc_control_dim>(StateMatrix<osc_state_dim>::Identity(),
+            ControlMatrix<osc_control_dim>::Zero())));
+
+    std::shared_ptr<ControlledSystem<osc_state_dim, osc_control_dim>> system(new LinearOscillator());
+    std::shared_ptr<LinearSystem<osc_state_dim, osc_control_dim>> linearSystem(new LinearOscillatorLinear());
+    StateVector<osc_state_dim> x0;
+    x0 << 0.5, 0.0;
+    ContinuousOptConProblem<osc_state_dim, osc_control_dim> optConProblem(tf, x0, system, costFunction, linearSystem);
+
+    NLOptConSettings settings;
+    settings.dt = 0.01;
+    settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    settings.printSummary = false;
+    settings.max_iterations = 3;
+
+    const size_t K = settings.computeK(tf);
+    Solver_t::Policy_t initController(StateVectorArray<osc_state_dim>(K + 1, x0),
+        ControlVectorArray<osc_control_dim>(K, ControlVector<osc_control_dim>::Zero()),
+        FeedbackArray<osc_state_dim, osc_control_dim>(K, FeedbackMatrix<osc_state_dim, osc_control_dim>::Zero()),
+        settings.dt);
+
+    for (int algorithm = 0; algorithm <= 1; algorithm++)
+    {
+        settings.nlocp_algorithm = algorithm == 0 ? NLOptConSettings::NLOCP_ALGORITHM::GNMS
+                                                  : NLOptConSettings::NLOCP_ALGORITHM::ILQR;
+
+        for (size_t nThreads = 1; nThreads <= 3; nThreads += 2)
+        {
+            settings.nThreads = nThreads;
+
+            std::vector<Solver_t::Policy_t> solutions;
+            for (int horizon = 0; horizon <= 1; horizon++)
+            {
+                settings.horizonCostEvaluation = bool(horizon);
+                Solver_t solver(optConProblem, settings);
+                solver.setInitialGuess(initController);
+                solver.solve();
+                solutions.push_back(solver.getSolution());
+            }
+
+            for (size_t k = 0; k < K; k++)
+            {
+                ASSERT_TRUE(solutions[0].x_ref()[k].isApprox(solutions[1].x_ref()[k], 1e-8));
+                ASSERT_TRUE(solutions[0].uff()[k].isApprox(solutions[1].uff()[k], 1e-8));
+            }
+        }
+    }
+}
+
+
+/*!
+ * Test that a statically composed cost function matches the analytical cost function with the same terms
+ */
+TEST(CostFunctionQuadratizeTest, StaticMatchesAnalytical)
+{
+    typedef TermQuadratic<state_dim, control_dim> Quad_t;
+    typedef TermSmoothAbs<state_dim, control_dim> Abs_t;
+    typedef TermMixed<state_dim, control_dim> Mixed_t;
+    typedef StaticCostFunction<state_dim, control_dim, std::tuple<Quad_t, Abs_t, Mixed_t>, std::tuple<Quad_t>>
+        StaticCost_t;
+
+    Quad_t quadTerm(Eigen::Matrix<double, state_dim, state_dim>::Random(),
+        Eigen::Matrix<double, control_dim, control_dim>::Random(), StateVector<state_dim>::Random(),
+        ControlVector<control_dim>::Random());
+    Abs_t absTerm(Eigen::Matrix<double, state_dim, 1>::Random(), Eigen::Matrix<double, state_dim, 1>::Random(),
+        Eigen::Matrix<double, control_dim, 1>::Random(), Eigen::Matrix<double, control_dim, 1>::Random(), 0.5);
+    ControlVector<control_dim> u_ref = ControlVector<control_dim>::Random();
+    Mixed_t mixedTerm(Eigen::Matrix<double, control_dim, state_dim>::Random(), StateVector<state_dim>::Random(), u_ref);
+    Quad_t finalTerm(Eigen::Matrix<double, state_dim, state_dim>::Random(),
+        Eigen::Matrix<double, control_dim, control_dim>::Random(), StateVector<state_dim>::Random(),
+        ControlVector<control_dim>::Random());
+
+    CostFunctionAnalytical<state_dim, control_dim> analytical;
+    analytical.addIntermediateTerm(std::shared_ptr<Quad_t>(new Quad_t(quadTerm)));
+    analytical.addIntermediateTerm(std::shared_ptr<Abs_t>(new Abs_t(absTerm)));
+    analytical.addIntermediateTerm(std::shared_ptr<Mixed_t>(new Mixed_t(mixedTerm)));
+    analytical.addFinalTerm(std::shared_ptr<Quad_t>(new Quad_t(finalTerm)));
+
+    StaticCost_t staticCost(std::make_tuple(quadTerm, absTerm, mixedTerm), std::make_tuple(finalTerm));
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> staticClone(staticCost.clone());
+
+    ASSERT_THROW(staticCost.addIntermediateTerm(std::shared_ptr<Quad_t>(new Quad_t(quadTerm))), std::runtime_error);
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        StateVector<state_dim> x = StateVector<state_dim>::Random();
+        ControlVector<control_dim> u = ControlVector<control_dim>::Random();
+        double t = 0.3 * i;
+
+        analytical.setCurrentStateAndControl(x, u, t);
+        staticClone->setCurrentStateAndControl(x, u, t);
+
+        ASSERT_NEAR(analytical.evaluateIntermediate(), staticClone->evaluateIntermediate(), 1e-9);
+        ASSERT_NEAR(analytical.evaluateTerminal(), staticClone->evaluateTerminal(), 1e-9);
+        ASSERT_TRUE(analytical.stateDerivativeTerminal().isApprox(staticClone->stateDerivativeTerminal()));
+        ASSERT_TRUE(analytical.stateSecondDerivativeTerminal().isApprox(staticClone->stateSecondDerivativeTerminal()));
+        ASSERT_TRUE(analytical.controlDerivativeTerminal().isApprox(staticClone->controlDerivativeTerminal()));
+
+        StateVector<state_dim> q_ana, q_stat;
+        StateMatrix<state_dim> Q_ana, Q_stat;
+        ControlVector<control_dim> r_ana, r_stat;
+        ControlMatrix<control_dim> R_ana, R_stat;
+        FeedbackMatrix<state_dim, control_dim> P_ana, P_stat;
+        analytical.quadratizeIntermediate(q_ana, Q_ana, r_ana, R_ana, P_ana);
+        staticClone->quadratizeIntermediate(q_stat, Q_stat, r_stat, R_stat, P_stat);
+
+        ASSERT_TRUE(q_ana.isApprox(q_stat));
+        ASSERT_TRUE(Q_ana.isApprox(Q_stat));
+        ASSERT_TRUE(r_ana.isApprox(r_stat));
+        ASSERT_TRUE(R_ana.isApprox(R_stat));
+        ASSERT_TRUE(P_ana.isApprox(P_stat));
+
+        ASSERT_TRUE(q_stat.isApprox(staticClone->stateDerivativeIntermediate()));
+        ASSERT_TRUE(Q_stat.isApprox(staticClone->stateSecondDerivativeIntermediate()));
+        ASSERT_TRUE(r_stat.isApprox(staticClone->controlDerivativeIntermediate()));
+        ASSERT_TRUE(R_stat.isApprox(staticClone->controlSecondDerivativeIntermediate()));
+        ASSERT_TRUE(P_stat.isApprox(staticClone->stateControlDerivativeIntermediate()));
+    }
+
+    // the terms are accessible and references are forwarded to them
+    StateVector<state_dim> x_final = StateVector<state_dim>::Random();
+    staticCost.updateFinalState(x_final);
+    ASSERT_TRUE(staticCost.getFinalTerm<0>().getReferenceState().isApprox(x_final));
+}
+
+/*!
+ * Test that the time activation is applied exactly once, both in the analytical and the static cost function
+ */
+TEST(CostFunctionQuadratizeTest, StaticMatchesAnalyticalWithActivation)
+{
+    typedef TermQuadratic<state_dim, control_dim> Quad_t;
+    typedef StaticCostFunction<state_dim, control_dim, std::tuple<Quad_t>, std::tuple<>> StaticCost_t;
+
+    Quad_t quadTerm(Eigen::Matrix<double, state_dim, state_dim>::Random(),
+        Eigen::Matrix<double, control_dim, control_dim>::Random(), StateVector<state_dim>::Random(),
+        ControlVector<control_dim>::Random());
+    quadTerm.setTimeActivation(std::shared_ptr<ct::core::tpl::ActivationBase<double>>(
+        new ct::core::tpl::RBFGaussActivation<double>(1.0, 0.5)));
+
+    CostFunctionAnalytical<state_dim, control_dim> analytical;
+    analytical.addIntermediateTerm(std::shared_ptr<Quad_t>(new Quad_t(quadTerm)));
+    StaticCost_t staticCost(std::make_tuple(quadTerm), std::make_tuple());
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        StateVector<state_dim> x = StateVector<state_dim>::Random();
+        ControlVector<control_dim> u = ControlVector<control_dim>::Random();
+        double t = 0.3 * i;
+
+        const double activation = quadTerm.computeActivation(t);
+        ASSERT_NE(activation, 1.0);
+        const double expected = activation * quadTerm.evaluate(x, u, t);
+
+        analytical.setCurrentStateAndControl(x, u, t);
+        staticCost.setCurrentStateAndControl(x, u, t);
+
+        ASSERT_NEAR(analytical.evaluateIntermediate(), expected, 1e-9);
+        ASSERT_NEAR(staticCost.evaluateIntermediate(), expected, 1e-9);
+    }
+}
+
+/*!
+ * Test the analytical derivatives of the state barrier term against finite differences
+ */
+TEST(CostFunctionQuadratizeTest, StateBarrierDerivatives)
+{
+    typedef TermStateBarrier<state_dim, control_dim> Barrier_t;
+
+    Barrier_t barrierTerm(Eigen::Matrix<double, state_dim, 1>::Ones(), -Eigen::Matrix<double, state_dim, 1>::Ones(),
+        Eigen::Matrix<double, state_dim, 1>::Random().cwiseAbs() + Eigen::Matrix<double, state_dim, 1>::Ones());
+    std::shared_ptr<Barrier_t> barrierClone(barrierTerm.clone());
+
+    ASSERT_TRUE(barrierTerm.hasAnalyticalDerivatives());
+
+    const double eps = 1e-6;
+    for (size_t i = 0; i < 10; i++)
+    {
+        StateVector<state_dim> x = 1.5 * StateVector<state_dim>::Random();
+        ControlVector<control_dim> u = ControlVector<control_dim>::Random();
+        double t = 0.3 * i;
+
+        ASSERT_NEAR(barrierTerm.evaluate(x, u, t), barrierClone->evaluateAnalytical(x, u, t), 1e-9);
+
+        StateVector<state_dim> dx = barrierClone->stateDerivative(x, u, t);
+        StateMatrix<state_dim> ddx = barrierClone->stateSecondDerivative(x, u, t);
+        for (size_t j = 0; j < state_dim; j++)
+        {
+            StateVector<state_dim> xp = x, xm = x;
+            xp(j) += eps;
+            xm(j) -= eps;
+            const double dxFD = (barrierTerm.evaluate(xp, u, t) - barrierTerm.evaluate(xm, u, t)) / (2 * eps);
+            const StateVector<state_dim> ddxFD =
+                (barrierTerm.stateDerivative(xp, u, t) - barrierTerm.stateDerivative(xm, u, t)) / (2 * eps);
+
+            ASSERT_NEAR(dx(j), dxFD, 1e-5 * std::max(1.0, std::abs(dxFD)));
+            ASSERT_TRUE(ddx.col(j).isApprox(ddxFD, 1e-5));
+        }
+
+        ASSERT_TRUE(barrierClone->controlDerivative(x, u, t).isZero());
+        ASSERT_TRUE(barrierClone->controlSecondDerivative(x, u, t).isZero());
+        ASSERT_TRUE(barrierClone->stateControlDerivative(x, u, t).isZero());
+    }
+}
+
+/*!
+ * Test that the solver gives the same result for a static and an analytical cost function
+ */
+TEST(CostFunctionQuadratizeTest, StaticCostFunctionInSolver)
+{
+    using namespace ct::optcon::example;
+    const size_t osc_state_dim = ct::optcon::example::state_dim;
+    const size_t osc_control_dim = ct::optcon::example::control_dim;
+    typedef NLOptConSolver<osc_state_dim, osc_control_dim> Solver_t;
+    typedef TermQuadratic<osc_state_dim, osc_control_dim> Quad_t;
+    typedef TermSmoothAbs<osc_state_dim, osc_control_dim> Abs_t;
+    typedef TermStateBarrier<osc_state_dim, osc_control_dim> Barrier_t;
+
+    const double tf = 2.0;
+
+    Quad_t quadTerm(0.1 * StateMatrix<osc_state_dim>::Identity(), ControlMatrix<osc_control_dim>::Identity());
+    Abs_t absTerm(Eigen::Matrix<double, osc_state_dim, 1>::Ones(), Eigen::Matrix<double, osc_state_dim, 1>::Zero(),
+        Eigen::Matrix<double, osc_control_dim, 1>::Zero(), Eigen::Matrix<double, osc_control_dim, 1>::Zero(), 0.1);
+    Barrier_t barrierTerm(Eigen::Matrix<double, osc_state_dim, 1>::Ones(),
+        -Eigen::Matrix<double, osc_state_dim, 1>::Ones(), 5.0 * Eigen::Matrix<double, osc_state_dim, 1>::Ones());
+    Quad_t finalTerm(10.0 * StateMatrix<osc_state_dim>::Identity(), ControlMatrix<osc_control_dim>::Zero());
+
+    std::shared_ptr<CostFunctionAnalytical<osc_state_dim, osc_control_dim>> analytical(
+        new CostFunctionAnalytical<osc_state_dim, osc_control_dim>());
+    analytical->addIntermediateTerm(std::shared_ptr<Quad_t>(new Quad_t(quadTerm)));
+    analytical->addIntermediateTerm(std::shared_ptr<Abs_t>(new Abs_t(absTerm)));
+    analytical->addIntermediateTerm(std::shared_ptr<Barrier_t>(new Barrier_t(barrierTerm)));
+    analytical->addFinalTerm(std::shared_ptr<Quad_t>(new Quad_t(finalTerm)));
+
+    std::shared_ptr<CostFunctionQuadratic<osc_state_dim, osc_control_dim>> staticCost(
+        new StaticCostFunction<osc_state_dim, osc_control_dim, std::tuple<Quad_t, Abs_t, Barrier_t>,
+            std::tuple<Quad_t>>(std::make_tuple(quadTerm, absTerm, barrierTerm), std::make_tuple(finalTerm)));
+
+    std::shared_ptr<ControlledSystem<osc_state_dim, osc_control_dim>> system(new LinearOscillator());
+    std::shared_ptr<LinearSystem<osc_state_dim, osc_control_dim>> linearSystem(new LinearOscillatorLinear());
+    StateVector<osc_state_dim> x0;
+    x0 << 0.5, 0.0;
+
+    NLOptConSettings settings;
+    settings.dt = 0.01;
+    settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    settings.printSummary = false;
+    settings.max_iterations = 5;
+    settings.nThreads = 2;
+
+    const size_t K = settings.computeK(tf);
+    Solver_t::Policy_t initController(StateVectorArray<osc_state_dim>(K + 1, x0),
+        ControlVectorArray<osc_control_dim>(K, ControlVector<osc_control_dim>::Zero()),
+        FeedbackArray<osc_state_dim, osc_control_dim>(K, FeedbackMatrix<osc_state_dim, osc_control_dim>::Zero()),
+        settings.dt);
+
+    std::vector<Solver_t::Policy_t> solutions;
+    for (auto costFunction : {std::static_pointer_cast<CostFunctionQuadratic<osc_state_dim, osc_control_dim>>(
+                                  analytical),
+             staticCost})
+    {
+        ContinuousOptConProblem<osc_state_dim, osc_control_dim> optConProblem(
+            tf, x0, system, costFunction, linearSystem);
+        Solver_t solver(optConProblem, settings);
+        solver.setInitialGuess(initController);
+        solver.solve();
+        solutions.push_back(solver.getSolution());
+    }
+
+    for (size_t k = 0; k < K; k++)
+    {
+        ASSERT_TRUE(solutions[0].x_ref()[k].isApprox(solutions[1].x_ref()[k], 1e-8));
+        ASSERT_TRUE(solutions[0].uff()[k].isApprox(solutions[1].uff()[k], 1e-8));
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
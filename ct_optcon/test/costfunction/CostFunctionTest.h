@@ -396,6 +396,74 @@ TEST(CostFunctionTest, TermSmoothAbsTest)
 }
 
 
+/*!
+ * Test that excluding the terms with analytical derivatives from the generated code does not change the result
+ */
+TEST(CostFunctionTest, ADHybridTest)
+{
+    typedef CostFunctionAD<state_dim, control_dim>::CGScalar CGScalar;
+
+    // the first cost function generates code for all terms, the second one evaluates them analytically
+    CostFunctionAD<state_dim, control_dim> costFunctionGenerated;
+    CostFunctionAD<state_dim, control_dim> costFunctionHybrid;
+    costFunctionHybrid.setUseAnalyticalDerivatives(true);
+
+    Eigen::Matrix<double, state_dim, state_dim> Q = Eigen::Matrix<double, state_dim, state_dim>::Random();
+    Eigen::Matrix<double, control_dim, control_dim> R = Eigen::Matrix<double, control_dim, control_dim>::Random();
+    core::StateVector<state_dim> x_ref = core::StateVector<state_dim>::Random();
+    core::ControlVector<control_dim> u_ref = core::ControlVector<control_dim>::Random();
+    core::StateVector<state_dim> ub = core::StateVector<state_dim>::Constant(2.0);
+    core::StateVector<state_dim> lb = core::StateVector<state_dim>::Constant(-2.0);
+    core::StateVector<state_dim> alpha = core::StateVector<state_dim>::Ones();
+
+    for (auto costFunction : {&costFunctionGenerated, &costFunctionHybrid})
+    {
+        costFunction->addIntermediateADTerm(std::shared_ptr<TermQuadratic<state_dim, control_dim, double, CGScalar>>(
+            new TermQuadratic<state_dim, control_dim, double, CGScalar>(Q, R, x_ref, u_ref)));
+        costFunction->addIntermediateADTerm(std::shared_ptr<TermSmoothAbs<state_dim, control_dim, double, CGScalar>>(
+            new TermSmoothAbs<state_dim, control_dim, double, CGScalar>(x_ref, x_ref, u_ref, u_ref, 0.5)));
+        costFunction->addIntermediateADTerm(
+            std::shared_ptr<TermStateBarrier<state_dim, control_dim, double, CGScalar>>(
+                new TermStateBarrier<state_dim, control_dim, double, CGScalar>(ub, lb, alpha)));
+        costFunction->addFinalADTerm(std::shared_ptr<TermQuadratic<state_dim, control_dim, double, CGScalar>>(
+            new TermQuadratic<state_dim, control_dim, double, CGScalar>(Q, R, x_ref, u_ref)));
+        costFunction->setProfiling(true);
+        costFunction->initialize();
+    }
+
+    std::shared_ptr<CostFunctionAD<state_dim, control_dim>> hybridClone(costFunctionHybrid.clone());
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        core::StateVector<state_dim> x = core::StateVector<state_dim>::Random();
+        core::ControlVector<control_dim> u = core::ControlVector<control_dim>::Random();
+
+        costFunctionGenerated.setCurrentStateAndControl(x, u, 0.0);
+        costFunctionHybrid.setCurrentStateAndControl(x, u, 0.0);
+        hybridClone->setCurrentStateAndControl(x, u, 0.0);
+
+        compareCostFunctionOutput(costFunctionGenerated, costFunctionHybrid);
+        compareCostFunctionOutput(costFunctionGenerated, *hybridClone);
+
+        core::StateVector<state_dim> q_gen, q_hyb;
+        core::StateMatrix<state_dim> Q_gen, Q_hyb;
+        core::ControlVector<control_dim> r_gen, r_hyb;
+        core::ControlMatrix<control_dim> R_gen, R_hyb;
+        core::FeedbackMatrix<state_dim, control_dim> P_gen, P_hyb;
+        costFunctionGenerated.quadratizeIntermediate(q_gen, Q_gen, r_gen, R_gen, P_gen);
+        costFunctionHybrid.quadratizeIntermediate(q_hyb, Q_hyb, r_hyb, R_hyb, P_hyb);
+
+        ASSERT_TRUE(q_gen.isApprox(q_hyb));
+        ASSERT_TRUE(Q_gen.isApprox(Q_hyb));
+        ASSERT_TRUE(r_gen.isApprox(r_hyb));
+        ASSERT_TRUE(R_gen.isApprox(R_hyb));
+        ASSERT_TRUE(P_gen.isApprox(P_hyb));
+    }
+
+    costFunctionGenerated.printProfiling();
+    costFunctionHybrid.printProfiling();
+}
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
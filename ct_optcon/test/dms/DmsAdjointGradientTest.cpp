@@ -0,0 +1,166 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This unit test checks that the adjoint cost gradient of the DMS problem coincides with the gradient obtained from
+ * forward sensitivities, for all splines, integrators and several checkpoint intervals.
+ */
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+#include "../testSystems/MIMOIntegrator.h"
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+//! a Van der Pol oscillator with a state-dependent input gain
+class VanDerPol : public core::ControlledSystem<2, 1>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    VanDerPol() = default;
+    VanDerPol(const VanDerPol& other) : core::ControlledSystem<2, 1>(other) {}
+    VanDerPol* clone() const override { return new VanDerPol(*this); }
+    void computeControlledDynamics(const core::StateVector<2>& x,
+        const core::Time& t,
+        const core::ControlVector<1>& u,
+        core::StateVector<2>& dxdt) override
+    {
+        dxdt(0) = x(1);
+        dxdt(1) = (1.0 - x(0) * x(0)) * x(1) - x(0) + (1.0 + 0.5 * x(0) * x(0)) * u(0);
+    }
+};
+
+class VanDerPolLinear : public core::LinearSystem<2, 1>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    VanDerPolLinear* clone() const override { return new VanDerPolLinear(*this); }
+    const state_matrix_t& getDerivativeState(const core::StateVector<2>& x,
+        const core::ControlVector<1>& u,
+        const double t = 0.0) override
+    {
+        A_ << 0.0, 1.0, -2.0 * x(0) * x(1) - 1.0 + x(0) * u(0), 1.0 - x(0) * x(0);
+        return A_;
+    }
+
+    const state_control_matrix_t& getDerivativeControl(const core::StateVector<2>& x,
+        const core::ControlVector<1>& u,
+        const double t = 0.0) override
+    {
+        B_ << 0.0, 1.0 + 0.5 * x(0) * x(0);
+        return B_;
+    }
+
+private:
+    state_matrix_t A_;
+    state_control_matrix_t B_;
+};
+
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+Eigen::VectorXd evaluateCostGradient(const DmsSettings& settings,
+    const std::shared_ptr<core::ControlledSystem<STATE_DIM, CONTROL_DIM>>& system,
+    const std::shared_ptr<core::LinearSystem<STATE_DIM, CONTROL_DIM>>& linearSystem,
+    const std::shared_ptr<CostFunctionQuadratic<STATE_DIM, CONTROL_DIM>>& costFunction,
+    const core::StateVector<STATE_DIM>& x0,
+    const Eigen::VectorXd& w)
+{
+    std::vector<std::shared_ptr<core::ControlledSystem<STATE_DIM, CONTROL_DIM>>> systems;
+    std::vector<std::shared_ptr<core::LinearSystem<STATE_DIM, CONTROL_DIM>>> linearSystems;
+    std::vector<std::shared_ptr<CostFunctionQuadratic<STATE_DIM, CONTROL_DIM>>> costFunctions;
+    for (size_t i = 0; i < settings.N_; i++)
+    {
+        systems.push_back(std::shared_ptr<core::ControlledSystem<STATE_DIM, CONTROL_DIM>>(system->clone()));
+        linearSystems.push_back(std::shared_ptr<core::LinearSystem<STATE_DIM, CONTROL_DIM>>(linearSystem->clone()));
+        costFunctions.push_back(std::shared_ptr<CostFunctionQuadratic<STATE_DIM, CONTROL_DIM>>(costFunction->clone()));
+    }
+
+    DmsProblem<STATE_DIM, CONTROL_DIM> dmsProblem(settings, systems, linearSystems, costFunctions, {}, {}, {}, x0);
+
+    const size_t n = dmsProblem.getVarCount();
+    Eigen::Map<const Eigen::VectorXd> wMap(w.data(), n);
+    dmsProblem.extractOptimizationVars(wMap, true);
+
+    Eigen::VectorXd grad(n);
+    Eigen::Map<Eigen::VectorXd> gradMap(grad.data(), n);
+    dmsProblem.evaluateCostGradient(n, gradMap);
+    return grad;
+}
+
+template <size_t STATE_DIM, size_t CONTROL_DIM>
+void testAdjointGradient(const std::shared_ptr<core::ControlledSystem<STATE_DIM, CONTROL_DIM>>& system,
+    const std::shared_ptr<core::LinearSystem<STATE_DIM, CONTROL_DIM>>& linearSystem,
+    const std::shared_ptr<CostFunctionQuadratic<STATE_DIM, CONTROL_DIM>>& costFunction)
+{
+    DmsSettings settings;
+    settings.N_ = 4;
+    settings.T_ = 1.0;
+    settings.dt_sim_ = 0.01;
+    settings.costEvaluationType_ = DmsSettings::FULL;
+
+    core::StateVector<STATE_DIM> x0 = core::StateVector<STATE_DIM>::Zero();
+
+    for (auto integrator : {DmsSettings::EULER, DmsSettings::RK4})
+        for (auto spline : {DmsSettings::ZERO_ORDER_HOLD, DmsSettings::PIECEWISE_LINEAR})
+        {
+            settings.integrationType_ = integrator;
+            settings.splineType_ = spline;
+
+            const size_t nVars = (settings.N_ + 1) * (STATE_DIM + CONTROL_DIM);
+            Eigen::VectorXd w = 0.2 * Eigen::VectorXd::Random(nVars);
+
+            settings.costGradientType_ = DmsSettings::FORWARD;
+            Eigen::VectorXd gradForward = evaluateCostGradient(settings, system, linearSystem, costFunction, x0, w);
+
+            settings.costGradientType_ = DmsSettings::ADJOINT;
+            for (size_t checkpointInterval : {0, 1, 7, 1000})
+            {
+                settings.adjointCheckpointInterval_ = checkpointInterval;
+                Eigen::VectorXd gradAdjoint =
+                    evaluateCostGradient(settings, system, linearSystem, costFunction, x0, w);
+                ASSERT_LT((gradAdjoint - gradForward).norm(), 1e-10 * std::max(1.0, gradForward.norm()));
+            }
+        }
+}
+
+TEST(DmsAdjointGradientTest, VanDerPol)
+{
+    Eigen::Matrix2d Q, Qf;
+    Q << 1.0, 0.2, 0.2, 1.0;
+    Qf << 10.0, 0.0, 0.0, 10.0;
+    Eigen::Matrix<double, 1, 1> R;
+    R << 0.1;
+    core::StateVector<2> xFinal;
+    xFinal << 1.0, 0.0;
+    std::shared_ptr<CostFunctionQuadratic<2, 1>> costFunction(
+        new CostFunctionQuadraticSimple<2, 1>(Q, R, xFinal, core::ControlVector<1>::Zero(), xFinal, Qf));
+
+    testAdjointGradient<2, 1>(std::shared_ptr<core::ControlledSystem<2, 1>>(new VanDerPol()),
+        std::shared_ptr<core::LinearSystem<2, 1>>(new VanDerPolLinear()), costFunction);
+}
+
+TEST(DmsAdjointGradientTest, MIMOIntegrator)
+{
+    core::StateVector<4> xFinal;
+    xFinal << 1.0, -1.0, 0.5, 0.0;
+    testAdjointGradient<4, 3>(std::shared_ptr<core::ControlledSystem<4, 3>>(new MIMOIntegrator<4, 3>()),
+        std::shared_ptr<core::LinearSystem<4, 3>>(new MIMOIntegratorLinear<4, 3>()),
+        createMIMOIntegratorCostFunction<4, 3>(xFinal));
+}
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
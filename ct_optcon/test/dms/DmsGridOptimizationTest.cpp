@@ -0,0 +1,227 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This unit test checks the time grid optimization of the DMS problem. The constraint jacobian and the cost gradient,
+ * including the derivatives w.r.t. the time segments h_i, are compared against finite differences and the sparsity
+ * pattern of the jacobian is required to stay fixed when the time grid changes.
+ */
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+//! a damped pendulum with a state-dependent input gain, such that all second derivatives are non-zero
+class Pendulum : public ct::core::ControlledSystem<2, 1>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    Pendulum() = default;
+    Pendulum(const Pendulum& other) : ct::core::ControlledSystem<2, 1>(other) {}
+    Pendulum* clone() const override { return new Pendulum(*this); }
+    void computeControlledDynamics(const ct::core::StateVector<2>& x,
+        const core::Time& t,
+        const ct::core::ControlVector<1>& u,
+        ct::core::StateVector<2>& dxdt) override
+    {
+        dxdt(0) = x(1);
+        dxdt(1) = -9.81 * std::sin(x(0)) - 0.1 * x(1) + std::cos(x(0)) * u(0);
+    }
+};
+
+class PendulumLinear : public ct::core::LinearSystem<2, 1>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    PendulumLinear* clone() const override { return new PendulumLinear(*this); }
+    const state_matrix_t& getDerivativeState(const ct::core::StateVector<2>& x,
+        const ct::core::ControlVector<1>& u,
+        const double t = 0.0) override
+    {
+        A_ << 0.0, 1.0, -9.81 * std::cos(x(0)) - std::sin(x(0)) * u(0), -0.1;
+        return A_;
+    }
+
+    const state_control_matrix_t& getDerivativeControl(const ct::core::StateVector<2>& x,
+        const ct::core::ControlVector<1>& u,
+        const double t = 0.0) override
+    {
+        B_ << 0.0, std::cos(x(0));
+        return B_;
+    }
+
+private:
+    state_matrix_t A_;
+    state_control_matrix_t B_;
+};
+
+
+Eigen::VectorXd evaluateConstraints(tpl::Nlp<double>& nlp, const Eigen::VectorXd& w)
+{
+    Eigen::Map<const Eigen::VectorXd> wMap(w.data(), w.rows());
+    nlp.extractOptimizationVars(wMap, true);
+    Eigen::VectorXd g(nlp.getConstraintsCount());
+    Eigen::Map<Eigen::VectorXd> gMap(g.data(), g.rows());
+    nlp.evaluateConstraints(gMap);
+    return g;
+}
+
+double evaluateCost(tpl::Nlp<double>& nlp, const Eigen::VectorXd& w)
+{
+    Eigen::Map<const Eigen::VectorXd> wMap(w.data(), w.rows());
+    nlp.extractOptimizationVars(wMap, true);
+    return nlp.evaluateCostFun();
+}
+
+
+void testGridOptimization(DmsSettings settings, const double tolerance)
+{
+    settings.N_ = 5;
+    settings.T_ = 1.0;
+    settings.nThreads_ = 1;
+    settings.dt_sim_ = 0.01;
+    settings.h_min_ = 0.05;
+    settings.objectiveType_ = DmsSettings::OPTIMIZE_GRID;
+
+    ct::core::StateVector<2> x0;
+    x0 << 0.2, 0.0;
+    ct::core::StateVector<2> xFinal;
+    xFinal << 1.0, 0.0;
+    Eigen::Matrix2d Q, Qf;
+    Q << 1.0, 0.2, 0.2, 1.0;
+    Qf << 10.0, 0.0, 0.0, 10.0;
+    Eigen::Matrix<double, 1, 1> R;
+    R << 0.1;
+    ct::core::ControlVector<1> uNom = ct::core::ControlVector<1>::Zero();
+    std::shared_ptr<CostFunctionQuadratic<2, 1>> costFunction(
+        new CostFunctionQuadraticSimple<2, 1>(Q, R, xFinal, uNom, xFinal, Qf));
+
+    std::vector<std::shared_ptr<ct::core::ControlledSystem<2, 1>>> systems;
+    std::vector<std::shared_ptr<ct::core::LinearSystem<2, 1>>> linearSystems;
+    std::vector<std::shared_ptr<CostFunctionQuadratic<2, 1>>> costFunctions;
+    for (size_t i = 0; i < settings.N_; i++)
+    {
+        systems.push_back(std::shared_ptr<ct::core::ControlledSystem<2, 1>>(new Pendulum()));
+        linearSystems.push_back(std::shared_ptr<ct::core::LinearSystem<2, 1>>(new PendulumLinear()));
+        costFunctions.push_back(std::shared_ptr<CostFunctionQuadratic<2, 1>>(costFunction->clone()));
+    }
+
+    DmsProblem<2, 1> dmsProblem(settings, systems, linearSystems, costFunctions, {}, {}, {}, x0);
+
+    // the time segments are appended to the state-control pairs
+    const size_t n = dmsProblem.getVarCount();
+    const size_t m = dmsProblem.getConstraintsCount();
+    const size_t nPairs = (settings.N_ + 1) * 3;
+    ASSERT_EQ(n, nPairs + settings.N_);
+    ASSERT_EQ(m, (settings.N_ + 1) * 2 + 1);
+
+    const size_t nJac = dmsProblem.getNonZeroJacobianCount();
+    Eigen::VectorXi iRowJac(nJac), jColJac(nJac);
+    Eigen::Map<Eigen::VectorXi> iRowJacMap(iRowJac.data(), nJac), jColJacMap(jColJac.data(), nJac);
+    dmsProblem.getSparsityPatternJacobian(nJac, iRowJacMap, jColJacMap);
+
+    Eigen::VectorXd w = 0.5 * Eigen::VectorXd::Random(n);
+    w.tail(settings.N_) = Eigen::VectorXd::Constant(settings.N_, settings.T_ / settings.N_) +
+                          0.05 * Eigen::VectorXd::Random(settings.N_);
+
+    // analytic derivatives
+    Eigen::Map<const Eigen::VectorXd> wMap(w.data(), n);
+    dmsProblem.extractOptimizationVars(wMap, true);
+    Eigen::VectorXd jacValues(nJac);
+    Eigen::Map<Eigen::VectorXd> jacMap(jacValues.data(), nJac);
+    dmsProblem.evaluateConstraintJacobian(nJac, jacMap);
+    Eigen::VectorXd grad(n);
+    Eigen::Map<Eigen::VectorXd> gradMap(grad.data(), n);
+    dmsProblem.evaluateCostGradient(n, gradMap);
+
+    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(m, n);
+    for (size_t i = 0; i < nJac; i++)
+        J(iRowJac(i), jColJac(i)) += jacValues(i);
+
+    // finite differences, the time segments included
+    Eigen::MatrixXd J_fd(m, n);
+    Eigen::VectorXd grad_fd(n);
+    const double h = 1e-6;
+    for (size_t j = 0; j < n; j++)
+    {
+        Eigen::VectorXd wPlus = w, wMinus = w;
+        wPlus(j) += h;
+        wMinus(j) -= h;
+        J_fd.col(j) = (evaluateConstraints(dmsProblem, wPlus) - evaluateConstraints(dmsProblem, wMinus)) / (2.0 * h);
+        grad_fd(j) = (evaluateCost(dmsProblem, wPlus) - evaluateCost(dmsProblem, wMinus)) / (2.0 * h);
+    }
+
+    ASSERT_LT((J - J_fd).norm(), tolerance * J_fd.norm());
+    ASSERT_LT((grad - grad_fd).norm(), tolerance * grad_fd.norm());
+    ASSERT_GT(J_fd.rightCols(settings.N_).norm(), 0.0);
+
+    // the horizon constraint is linear in the time segments
+    ASSERT_NEAR(evaluateConstraints(dmsProblem, w)(m - 1), w.tail(settings.N_).sum() - settings.T_, 1e-12);
+
+    // a different time grid must not alter the sparsity pattern
+    Eigen::VectorXi iRowJac2(nJac), jColJac2(nJac);
+    Eigen::Map<Eigen::VectorXi> iRowJacMap2(iRowJac2.data(), nJac), jColJacMap2(jColJac2.data(), nJac);
+    w.tail(settings.N_).reverseInPlace();
+    dmsProblem.extractOptimizationVars(wMap, true);
+    ASSERT_EQ(dmsProblem.getNonZeroJacobianCount(), nJac);
+    dmsProblem.getSparsityPatternJacobian(nJac, iRowJacMap2, jColJacMap2);
+    ASSERT_TRUE(iRowJac == iRowJac2);
+    ASSERT_TRUE(jColJac == jColJac2);
+}
+
+
+TEST(DmsGridOptimizationTest, DerivativesMatchFiniteDifferences)
+{
+    DmsSettings settings;
+    for (auto integrator : {DmsSettings::EULER, DmsSettings::RK4})
+        for (auto spline : {DmsSettings::ZERO_ORDER_HOLD, DmsSettings::PIECEWISE_LINEAR})
+            for (auto costEval : {DmsSettings::SIMPLE, DmsSettings::FULL})
+                for (auto costGrad : {DmsSettings::FORWARD, DmsSettings::ADJOINT})
+                {
+                    settings.integrationType_ = integrator;
+                    settings.splineType_ = spline;
+                    settings.costEvaluationType_ = costEval;
+                    settings.costGradientType_ = costGrad;
+                    testGridOptimization(settings, 1e-5);
+                }
+}
+
+TEST(DmsGridOptimizationTest, ExactHessianIsRejected)
+{
+    DmsSettings settings;
+    settings.N_ = 5;
+    settings.objectiveType_ = DmsSettings::OPTIMIZE_GRID;
+    settings.solverSettings_.ipoptSettings_.hessian_approximation_ = "exact";
+
+    std::vector<std::shared_ptr<ct::core::ControlledSystem<2, 1>>> systems;
+    std::vector<std::shared_ptr<ct::core::LinearSystem<2, 1>>> linearSystems;
+    std::vector<std::shared_ptr<CostFunctionQuadratic<2, 1>>> costFunctions;
+    for (size_t i = 0; i < settings.N_; i++)
+    {
+        systems.push_back(std::shared_ptr<ct::core::ControlledSystem<2, 1>>(new Pendulum()));
+        linearSystems.push_back(std::shared_ptr<ct::core::LinearSystem<2, 1>>(new PendulumLinear()));
+        costFunctions.push_back(std::shared_ptr<CostFunctionQuadratic<2, 1>>(new CostFunctionQuadraticSimple<2, 1>()));
+    }
+
+    const ct::core::StateVector<2> x0 = ct::core::StateVector<2>::Zero();
+    typedef DmsProblem<2, 1> DmsProblem_t;
+    ASSERT_ANY_THROW(DmsProblem_t(settings, systems, linearSystems, costFunctions, {}, {}, {}, x0));
+}
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
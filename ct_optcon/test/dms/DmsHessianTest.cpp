@@ -0,0 +1,208 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+/*!
+ * This unit test compares the exact Lagrangian Hessian of the DMS problem against finite differences of the
+ * Lagrangian gradient, for all combinations of splines, cost evaluators and integrators.
+ */
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+
+namespace ct {
+namespace optcon {
+namespace example {
+
+//! a damped pendulum with a state-dependent input gain, such that all second derivatives are non-zero
+class Pendulum : public ct::core::ControlledSystem<2, 1>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    Pendulum() = default;
+    Pendulum(const Pendulum& other) : ct::core::ControlledSystem<2, 1>(other) {}
+    Pendulum* clone() const override { return new Pendulum(*this); }
+    void computeControlledDynamics(const ct::core::StateVector<2>& x,
+        const core::Time& t,
+        const ct::core::ControlVector<1>& u,
+        ct::core::StateVector<2>& dxdt) override
+    {
+        dxdt(0) = x(1);
+        dxdt(1) = -9.81 * std::sin(x(0)) - 0.1 * x(1) + std::cos(x(0)) * u(0);
+    }
+};
+
+class PendulumLinear : public ct::core::LinearSystem<2, 1>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    PendulumLinear* clone() const override { return new PendulumLinear(*this); }
+    const state_matrix_t& getDerivativeState(const ct::core::StateVector<2>& x,
+        const ct::core::ControlVector<1>& u,
+        const double t = 0.0) override
+    {
+        A_ << 0.0, 1.0, -9.81 * std::cos(x(0)) - std::sin(x(0)) * u(0), -0.1;
+        return A_;
+    }
+
+    const state_control_matrix_t& getDerivativeControl(const ct::core::StateVector<2>& x,
+        const ct::core::ControlVector<1>& u,
+        const double t = 0.0) override
+    {
+        B_ << 0.0, std::cos(x(0));
+        return B_;
+    }
+
+private:
+    state_matrix_t A_;
+    state_control_matrix_t B_;
+};
+
+
+Eigen::MatrixXd evaluateLagrangianGradient(tpl::Nlp<double>& nlp,
+    const Eigen::VectorXd& w,
+    const Eigen::VectorXd& lambda,
+    const double omega,
+    const Eigen::VectorXi& iRowJac,
+    const Eigen::VectorXi& jColJac)
+{
+    const size_t n = w.rows();
+    Eigen::Map<const Eigen::VectorXd> wMap(w.data(), n);
+    nlp.extractOptimizationVars(wMap, true);
+
+    Eigen::VectorXd grad(n);
+    Eigen::Map<Eigen::VectorXd> gradMap(grad.data(), n);
+    nlp.evaluateCostGradient(n, gradMap);
+
+    Eigen::VectorXd jac(iRowJac.rows());
+    Eigen::Map<Eigen::VectorXd> jacMap(jac.data(), jac.rows());
+    nlp.evaluateConstraintJacobian(jac.rows(), jacMap);
+
+    Eigen::VectorXd gradL = omega * grad;
+    for (int i = 0; i < jac.rows(); i++)
+        gradL(jColJac(i)) += lambda(iRowJac(i)) * jac(i);
+    return gradL;
+}
+
+
+void testHessian(DmsSettings settings, const double tolerance)
+{
+    settings.N_ = 5;
+    settings.T_ = 1.0;
+    settings.nThreads_ = 1;
+    settings.dt_sim_ = 0.01;
+    settings.solverSettings_.ipoptSettings_.hessian_approximation_ = "exact";
+
+    ct::core::StateVector<2> x0;
+    x0 << 0.2, 0.0;
+    ct::core::StateVector<2> xFinal;
+    xFinal << 1.0, 0.0;
+    Eigen::Matrix2d Q, Qf;
+    Q << 1.0, 0.2, 0.2, 1.0;
+    Qf << 10.0, 0.0, 0.0, 10.0;
+    Eigen::Matrix<double, 1, 1> R;
+    R << 0.1;
+    ct::core::ControlVector<1> uNom = ct::core::ControlVector<1>::Zero();
+    std::shared_ptr<CostFunctionQuadratic<2, 1>> costFunction(
+        new CostFunctionQuadraticSimple<2, 1>(Q, R, xFinal, uNom, xFinal, Qf));
+
+    std::vector<std::shared_ptr<ct::core::ControlledSystem<2, 1>>> systems;
+    std::vector<std::shared_ptr<ct::core::LinearSystem<2, 1>>> linearSystems;
+    std::vector<std::shared_ptr<CostFunctionQuadratic<2, 1>>> costFunctions;
+    for (size_t i = 0; i < settings.N_; i++)
+    {
+        systems.push_back(std::shared_ptr<ct::core::ControlledSystem<2, 1>>(new Pendulum()));
+        linearSystems.push_back(std::shared_ptr<ct::core::LinearSystem<2, 1>>(new PendulumLinear()));
+        costFunctions.push_back(std::shared_ptr<CostFunctionQuadratic<2, 1>>(costFunction->clone()));
+    }
+
+    DmsProblem<2, 1> dmsProblem(settings, systems, linearSystems, costFunctions, {}, {}, {}, x0);
+
+    const size_t n = dmsProblem.getVarCount();
+    const size_t m = dmsProblem.getConstraintsCount();
+    const size_t nJac = dmsProblem.getNonZeroJacobianCount();
+    const size_t nHes = dmsProblem.getNonZeroHessianCount();
+
+    Eigen::VectorXi iRowJac(nJac), jColJac(nJac), iRowHes(nHes), jColHes(nHes);
+    Eigen::Map<Eigen::VectorXi> iRowJacMap(iRowJac.data(), nJac), jColJacMap(jColJac.data(), nJac);
+    Eigen::Map<Eigen::VectorXi> iRowHesMap(iRowHes.data(), nHes), jColHesMap(jColHes.data(), nHes);
+    dmsProblem.getSparsityPatternJacobian(nJac, iRowJacMap, jColJacMap);
+    dmsProblem.getSparsityPatternHessian(nHes, iRowHesMap, jColHesMap);
+
+    Eigen::VectorXd w = 0.5 * Eigen::VectorXd::Random(n);
+    Eigen::VectorXd lambda = Eigen::VectorXd::Random(m);
+    const double omega = 0.7;
+
+    // exact Hessian, stored as lower triangle
+    Eigen::Map<const Eigen::VectorXd> wMap(w.data(), n);
+    dmsProblem.extractOptimizationVars(wMap, true);
+    Eigen::VectorXd hesValues(nHes);
+    Eigen::Map<Eigen::VectorXd> hesMap(hesValues.data(), nHes);
+    Eigen::Map<const Eigen::VectorXd> lambdaMap(lambda.data(), m);
+    dmsProblem.evaluateHessian(nHes, hesMap, omega, lambdaMap);
+
+    Eigen::MatrixXd H = Eigen::MatrixXd::Zero(n, n);
+    for (size_t i = 0; i < nHes; i++)
+    {
+        ASSERT_GE(iRowHes(i), jColHes(i));
+        H(iRowHes(i), jColHes(i)) = hesValues(i);
+    }
+
+    // finite-difference Hessian of the Lagrangian
+    Eigen::MatrixXd H_fd(n, n);
+    const double h = 1e-6;
+    for (size_t j = 0; j < n; j++)
+    {
+        Eigen::VectorXd wPlus = w, wMinus = w;
+        wPlus(j) += h;
+        wMinus(j) -= h;
+        H_fd.col(j) = (evaluateLagrangianGradient(dmsProblem, wPlus, lambda, omega, iRowJac, jColJac) -
+                          evaluateLagrangianGradient(dmsProblem, wMinus, lambda, omega, iRowJac, jColJac)) /
+                      (2.0 * h);
+    }
+    H_fd = (0.5 * (H_fd + H_fd.transpose())).eval();
+
+    Eigen::MatrixXd H_fd_lower = H_fd.triangularView<Eigen::Lower>();
+    ASSERT_LT((H - H_fd_lower).norm(), tolerance * H_fd_lower.norm());
+}
+
+
+TEST(DmsHessianTest, EulerIsExact)
+{
+    DmsSettings settings;
+    settings.integrationType_ = DmsSettings::EULER;
+    for (auto spline : {DmsSettings::ZERO_ORDER_HOLD, DmsSettings::PIECEWISE_LINEAR})
+        for (auto costEval : {DmsSettings::SIMPLE, DmsSettings::FULL})
+        {
+            settings.splineType_ = spline;
+            settings.costEvaluationType_ = costEval;
+            testHessian(settings, 1e-5);
+        }
+}
+
+TEST(DmsHessianTest, RK4IsConsistent)
+{
+    DmsSettings settings;
+    settings.integrationType_ = DmsSettings::RK4;
+    for (auto spline : {DmsSettings::ZERO_ORDER_HOLD, DmsSettings::PIECEWISE_LINEAR})
+        for (auto costEval : {DmsSettings::SIMPLE, DmsSettings::FULL})
+        {
+            settings.splineType_ = spline;
+            settings.costEvaluationType_ = costEval;
+            testHessian(settings, 1e-3);
+        }
+}
+
+}  // namespace example
+}  // namespace optcon
+}  // namespace ct
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,219 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <ct/optcon/optcon.h>
+
+const size_t state_dim = 4;
+const size_t control_dim = 2;
+const size_t output_dim = 3;
+
+using namespace ct::core;
+using namespace ct::optcon;
+
+/*!
+ * A discrete-time linear system x_{n+1} = A x_n + B u_n, for which all Kalman filter variants are exact
+ */
+class LinearSystemModel : public SystemModelBase<state_dim, control_dim>
+{
+public:
+    LinearSystemModel(const state_matrix_t& A, const Eigen::Matrix<double, state_dim, control_dim>& B)
+        : A_(A), B_(B), G_(state_matrix_t::Identity())
+    {
+    }
+
+    state_vector_t computeDynamics(const state_vector_t& x,
+        const control_vector_t& u,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return A_ * x + B_ * u;
+    }
+
+    state_matrix_t computeDerivativeState(const state_vector_t& x,
+        const control_vector_t& u,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return A_;
+    }
+
+    state_matrix_t computeDerivativeNoise(const state_vector_t& x,
+        const control_vector_t& u,
+        const Time_t dt,
+        Time_t t) override
+    {
+        return G_;
+    }
+
+private:
+    state_matrix_t A_;
+    Eigen::Matrix<double, state_dim, control_dim> B_;
+    state_matrix_t G_;
+};
+
+//! a random symmetric positive definite matrix
+template <int DIM>
+Eigen::Matrix<double, DIM, DIM> randomCovariance()
+{
+    Eigen::Matrix<double, DIM, DIM> M = Eigen::Matrix<double, DIM, DIM>::Random();
+    return M * M.transpose() + 0.1 * Eigen::Matrix<double, DIM, DIM>::Identity();
+}
+
+/*!
+ * Runs the extended Kalman filter and a filter variant side by side on a noisy linear system and compares the
+ * estimates and covariances, which need to match since the square-root and information forms are algebraically
+ * equivalent.
+ */
+template <typename FILTER>
+void compareToExtendedKalmanFilter(FILTER& filter,
+    ExtendedKalmanFilter<state_dim, control_dim, output_dim>& ekf,
+    std::shared_ptr<LinearSystemModel> model,
+    std::shared_ptr<LTIMeasurementModel<output_dim, state_dim>> measModel,
+    size_t nSteps,
+    size_t nUpdatesPerStep = 1)
+{
+    const double dt = 0.001;
+    StateVector<state_dim> x = ekf.getEstimate();
+
+    for (size_t i = 0; i < nSteps; i++)
+    {
+        ControlVector<control_dim> u = ControlVector<control_dim>::Random();
+        x = model->computeDynamics(x, u, dt, i * dt) + 0.01 * StateVector<state_dim>::Random();
+
+        ekf.predict(u, dt, i * dt);
+        filter.predict(u, dt, i * dt);
+        ASSERT_LT((ekf.getEstimate() - filter.getEstimate()).array().abs().maxCoeff(), 1e-8);
+
+        for (size_t j = 0; j < nUpdatesPerStep; j++)
+        {
+            OutputVector<output_dim> y =
+                measModel->computeMeasurement(x) + 0.01 * OutputVector<output_dim>::Random();
+            ekf.update(y, dt, i * dt);
+            filter.update(y, dt, i * dt);
+            ASSERT_LT((ekf.getEstimate() - filter.getEstimate()).array().abs().maxCoeff(), 1e-8);
+        }
+
+        const StateMatrix<state_dim>& P_ekf = ekf.getCovarianceMatrix();
+        ASSERT_LT((P_ekf - filter.getCovarianceMatrix()).array().abs().maxCoeff(),
+            1e-8 * P_ekf.array().abs().maxCoeff());
+    }
+}
+
+class KalmanFilterTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::srand(0);
+
+        StateMatrix<state_dim> A = StateMatrix<state_dim>::Identity() + 0.01 * StateMatrix<state_dim>::Random();
+        Eigen::Matrix<double, state_dim, control_dim> B = Eigen::Matrix<double, state_dim, control_dim>::Random();
+        model.reset(new LinearSystemModel(A, B));
+
+        OutputStateMatrix<output_dim, state_dim> C = OutputStateMatrix<output_dim, state_dim>::Random();
+        measModel.reset(new LTIMeasurementModel<output_dim, state_dim>(C, OutputMatrix<output_dim>::Identity()));
+
+        Q = randomCovariance<state_dim>();
+        R = randomCovariance<output_dim>();
+        P0 = randomCovariance<state_dim>();
+        x0 = StateVector<state_dim>::Random();
+    }
+
+    std::shared_ptr<LinearSystemModel> model;
+    std::shared_ptr<LTIMeasurementModel<output_dim, state_dim>> measModel;
+    StateMatrix<state_dim> Q;
+    OutputMatrix<output_dim> R;
+    StateMatrix<state_dim> P0;
+    StateVector<state_dim> x0;
+};
+
+TEST_F(KalmanFilterTest, SquareRootExtendedKalmanFilterTest)
+{
+    ExtendedKalmanFilter<state_dim, control_dim, output_dim> ekf(model, measModel, Q, R, x0, P0);
+    SquareRootExtendedKalmanFilter<state_dim, control_dim, output_dim> srekf(model, measModel, Q, R, x0, P0);
+
+    compareToExtendedKalmanFilter(srekf, ekf, model, measModel, 200);
+
+    // the covariance square root stays lower triangular with positive diagonal
+    const StateMatrix<state_dim> S = srekf.getCovarianceSquareRoot().matrixLLT();
+    ASSERT_TRUE(S.isLowerTriangular());
+    ASSERT_GT(S.diagonal().minCoeff(), 0.0);
+}
+
+TEST_F(KalmanFilterTest, SquareRootExtendedKalmanFilterZeroCovarianceTest)
+{
+    // a zero initial covariance can not be decomposed by a plain LLT
+    ExtendedKalmanFilter<state_dim, control_dim, output_dim> ekf(model, measModel, Q, R, x0);
+    SquareRootExtendedKalmanFilter<state_dim, control_dim, output_dim> srekf(model, measModel, Q, R, x0);
+
+    compareToExtendedKalmanFilter(srekf, ekf, model, measModel, 50);
+}
+
+TEST_F(KalmanFilterTest, SquareRootUnscentedKalmanFilterTest)
+{
+    // for a linear system, the unscented transform is exact. The second set of parameters leads to a negative weight
+    // of the center sigma point
+    const double alphas[2] = {1.0, 0.5};
+
+    for (double alpha : alphas)
+    {
+        ExtendedKalmanFilter<state_dim, control_dim, output_dim> ekf(model, measModel, Q, R, x0, P0);
+        SquareRootUnscentedKalmanFilter<state_dim, control_dim, output_dim> srukf(
+            model, measModel, Q, R, x0, P0, alpha, 2.0, 0.0);
+
+        compareToExtendedKalmanFilter(srukf, ekf, model, measModel, 200, 2);
+    }
+}
+
+TEST_F(KalmanFilterTest, InformationFilterTest)
+{
+    ExtendedKalmanFilter<state_dim, control_dim, output_dim> ekf(model, measModel, Q, R, x0, P0);
+    InformationFilter<state_dim, control_dim, output_dim> eif(model, measModel, Q, R, x0, P0);
+
+    compareToExtendedKalmanFilter(eif, ekf, model, measModel, 200, 3);
+}
+
+TEST(CTSystemModelTest, BatchPropagationTest)
+{
+    const size_t osc_state_dim = SecondOrderSystem::STATE_DIM;
+    const size_t osc_control_dim = SecondOrderSystem::CONTROL_DIM;
+    const size_t nStates = 7;
+
+    const IntegrationType intTypes[5] = {
+        IntegrationType::EULER, IntegrationType::EULERCT, IntegrationType::RK4, IntegrationType::RK4CT,
+        IntegrationType::ODE45};
+
+    Eigen::Matrix<double, osc_state_dim, Eigen::Dynamic> states(osc_state_dim, nStates);
+    states.setRandom();
+    ControlVector<osc_control_dim> u = ControlVector<osc_control_dim>::Random();
+    StateMatrix<osc_state_dim> dFdv = StateMatrix<osc_state_dim>::Identity();
+
+    for (IntegrationType intType : intTypes)
+    {
+        for (size_t nThreads = 1; nThreads <= 3; nThreads += 2)
+        {
+            CTSystemModel<osc_state_dim, osc_control_dim> sysModel(
+                std::shared_ptr<SecondOrderSystem>(new SecondOrderSystem(10.0, 0.1)), nullptr, dFdv, intType);
+            sysModel.setNumBatchThreads(nThreads);
+
+            Eigen::Matrix<double, osc_state_dim, Eigen::Dynamic> batch = states;
+            sysModel.computeDynamicsBatch(batch, u, 0.01, 0.5);
+
+            for (size_t i = 0; i < nStates; i++)
+            {
+                StateVector<osc_state_dim> x = sysModel.computeDynamics(states.col(i), u, 0.01, 0.5);
+                ASSERT_LT((x - batch.col(i)).array().abs().maxCoeff(), 1e-12);
+            }
+        }
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
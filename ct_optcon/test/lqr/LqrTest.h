@@ -48,6 +48,57 @@ TEST(LQRTest, DARETest)
     ASSERT_LT((P - P_test).array().abs().maxCoeff(), 1e-12);
 }
 
+TEST(LQRTest, DAREDoublingTest)
+{
+    const size_t stateDim = 2;
+    const size_t controlDim = 1;
+
+    Eigen::Matrix<double, stateDim, stateDim> A;
+    Eigen::Matrix<double, stateDim, controlDim> B;
+    Eigen::Matrix<double, stateDim, stateDim> Q;
+    Eigen::Matrix<double, controlDim, controlDim> R;
+    Eigen::Matrix<double, controlDim, stateDim> K;
+    Eigen::Matrix<double, controlDim, stateDim> K_doubling;
+
+    A << 1, 1, 1, 0;
+    B << 0, 1;
+    Q << 1, 0, 0, 1;
+    R << 1;
+
+    ct::optcon::DARE<stateDim, controlDim> dare(ct::optcon::DOUBLING);
+    Eigen::Matrix<double, stateDim, stateDim> P = dare.computeSteadyStateRiccatiMatrix(Q, R, A, B, K_doubling);
+    Eigen::Matrix<double, stateDim, stateDim> P_test;
+    P_test << 6.932484752255643, 4.332273119899151, 4.332273119899151, 4.55195134961773;
+    ASSERT_LT((P - P_test).array().abs().maxCoeff(), 1e-4);
+
+    // P_test is the result of the fixed-point iteration, the doubling solution satisfies the DARE to machine precision
+    const double H = (R + B.transpose() * P * B)(0, 0);
+    Eigen::Matrix<double, stateDim, stateDim> residual =
+        A.transpose() * P * A - A.transpose() * P * B * B.transpose() * P * A / H + Q - P;
+    ASSERT_LT(residual.array().abs().maxCoeff(), 1e-12);
+
+    // lightly damped oscillator, slow convergence of the fixed-point iteration
+    const double dt = 0.01;
+    const double omega = 2.0;
+    const double zeta = 0.01;
+    A << 1, dt, -omega * omega * dt, 1 - 2 * zeta * omega * dt;
+    B << 0, dt;
+    Q << 1e-2, 0, 0, 1e-2;
+
+    dare.setSolverType(ct::optcon::FIXED_POINT_ITERATION);
+    Eigen::Matrix<double, stateDim, stateDim> P_fixedPoint =
+        dare.computeSteadyStateRiccatiMatrix(Q, R, A, B, K, false, 1e-10, 100000);
+    const size_t fixedPointIterations = dare.getNumIterations();
+
+    dare.setSolverType(ct::optcon::DOUBLING);
+    P = dare.computeSteadyStateRiccatiMatrix(Q, R, A, B, K_doubling, false, 1e-10, 100);
+    const size_t doublingIterations = dare.getNumIterations();
+
+    ASSERT_LT((P - P_fixedPoint).array().abs().maxCoeff() / P_fixedPoint.array().abs().maxCoeff(), 1e-4);
+    ASSERT_LT((K - K_doubling).array().abs().maxCoeff(), 1e-4);
+    ASSERT_LT(doublingIterations, fixedPointIterations);
+}
+
 
 TEST(LQRTest, quadTest)
 {
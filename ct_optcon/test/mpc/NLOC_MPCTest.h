@@ -350,6 +350,541 @@ TEST(MPCTestB, NLOC_MPC_DoublePrecision)
 }
 
 
+namespace tpl {
+
+//! pendulum with a periodically varying stiffness, nonlinear and time-varying test system
+template <typename SCALAR = double>
+class TimeVaryingPendulum : public ControlledSystem<state_dim, control_dim, SCALAR>
+{
+public:
+    TimeVaryingPendulum() : ControlledSystem<state_dim, control_dim, SCALAR>(SYSTEM_TYPE::GENERAL) {}
+    void computeControlledDynamics(const StateVector<state_dim, SCALAR>& state,
+        const SCALAR& t,
+        const ControlVector<control_dim, SCALAR>& control,
+        StateVector<state_dim, SCALAR>& derivative) override
+    {
+        derivative(0) = state(1);
+        derivative(1) = control(0) - (1.0 + 0.5 * std::sin(2.0 * t)) * std::sin(state(0)) - 0.1 * state(1);
+    }
+
+    TimeVaryingPendulum<SCALAR>* clone() const override { return new TimeVaryingPendulum<SCALAR>(); };
+};
+
+
+template <typename SCALAR = double>
+class TimeVaryingPendulumLinear : public LinearSystem<state_dim, control_dim, SCALAR>
+{
+public:
+    typedef core::StateMatrix<state_dim, SCALAR> state_matrix_t;
+    typedef core::StateControlMatrix<state_dim, control_dim, SCALAR> state_control_matrix_t;
+
+    state_matrix_t A_;
+    state_control_matrix_t B_;
+
+    const state_matrix_t& getDerivativeState(const StateVector<state_dim, SCALAR>& x,
+        const ControlVector<control_dim, SCALAR>& u,
+        const SCALAR t = 0.0) override
+    {
+        A_ << 0, 1, -(1.0 + 0.5 * std::sin(2.0 * t)) * std::cos(x(0)), -0.1;
+        return A_;
+    }
+
+    const state_control_matrix_t& getDerivativeControl(const StateVector<state_dim, SCALAR>& x,
+        const ControlVector<control_dim, SCALAR>& u,
+        const SCALAR t = 0.0) override
+    {
+        B_ << 0, 1;
+        return B_;
+    }
+
+    TimeVaryingPendulumLinear<SCALAR>* clone() const override { return new TimeVaryingPendulumLinear<SCALAR>(); };
+};
+
+}  // namespace tpl
+
+
+/**
+ * Test the incremental re-linearization in MPC. For the linear oscillator with quadratic cost, the LQ approximation
+ * does not depend on the linearization point, hence reusing all cached stages must reproduce the policies obtained
+ * with a full re-linearization.
+ */
+TEST(MPCTestC, IncrementalLinearizationTest)
+{
+    typedef tpl::LinearOscillator<double> LinearOscillator;
+    typedef tpl::LinearOscillatorLinear<double> LinearOscillatorLinear;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+
+    StateVector<state_dim> x0;
+    x0 << 1.0, 0.0;
+
+    ct::core::Time timeHorizon = 3.0;
+
+    shared_ptr<ControlledSystem<state_dim, control_dim>> system(new LinearOscillator);
+    shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear);
+    shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+        tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(system, costFunction, analyticLinearSystem);
+    optConProblem.setTimeHorizon(timeHorizon);
+    optConProblem.setInitialState(x0);
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.dt = 0.01;
+    nloc_settings.K_sim = 1;
+    nloc_settings.K_shot = 1;
+    nloc_settings.max_iterations = 10;
+    nloc_settings.min_cost_improvement = 1e-10;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    nloc_settings.integrator = ct::core::IntegrationType::EULER;
+    nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    nloc_settings.nThreads = 1;
+    nloc_settings.nThreadsEigen = 1;
+    nloc_settings.printSummary = false;
+
+    int K = nloc_settings.computeK(timeHorizon);
+    FeedbackArray<state_dim, control_dim> u0_fb(K, FeedbackMatrix<state_dim, control_dim>::Zero());
+    ControlVectorArray<control_dim> u0_ff(K, ControlVector<control_dim>::Zero());
+    StateVectorArray<state_dim> x_ref(K + 1, x0);
+    ct::core::StateFeedbackController<state_dim, control_dim> initController(x_ref, u0_ff, u0_fb, nloc_settings.dt);
+
+    NLOptConSolver<state_dim, control_dim> initSolver(optConProblem, nloc_settings);
+    initSolver.setInitialGuess(initController);
+    initSolver.solve();
+    ct::core::StateFeedbackController<state_dim, control_dim> initGuess = initSolver.getSolution();
+
+    ct::optcon::mpc_settings settings;
+    settings.stateForwardIntegration_ = true;
+    settings.stateForwardIntegratorType_ = nloc_settings.integrator;
+    settings.stateForwardIntegration_dt_ = nloc_settings.dt;
+    settings.postTruncation_ = false;
+    settings.measureDelay_ = false;
+    settings.fixedDelayUs_ = 100000;
+    settings.mpc_mode = ct::optcon::MPC_MODE::FIXED_FINAL_TIME;
+    settings.coldStart_ = false;
+    settings.useExternalTiming_ = true;
+
+    NLOptConSettings nloc_settings_full = nloc_settings;
+    nloc_settings_full.max_iterations = 1;
+    NLOptConSettings nloc_settings_incremental = nloc_settings_full;
+    nloc_settings_incremental.incrementalLinearization = true;
+    nloc_settings_incremental.incrementalLinearizationTol = 1e10;
+    nloc_settings_incremental.incrementalLinearizationTimeInvariant = true;
+
+    MPC<NLOptConSolver<state_dim, control_dim>> mpcFull(optConProblem, nloc_settings_full, settings);
+    MPC<NLOptConSolver<state_dim, control_dim>> mpcIncremental(optConProblem, nloc_settings_incremental, settings);
+    mpcFull.setInitialGuess(initGuess);
+    mpcIncremental.setInitialGuess(initGuess);
+
+    mpcFull.prepareIteration(0.0);
+    mpcIncremental.prepareIteration(0.0);
+
+    size_t skippedStages = 0;
+    for (int i = 0; i < 20; i++)
+    {
+        const double t = i * 1e-6 * settings.fixedDelayUs_;
+        ct::core::StateFeedbackController<state_dim, control_dim> policyFull, policyIncremental;
+        ct::core::Time tsFull, tsIncremental;
+
+        ASSERT_TRUE(mpcFull.finishIteration(x0, t, policyFull, tsFull));
+        ASSERT_TRUE(mpcIncremental.finishIteration(x0, t, policyIncremental, tsIncremental));
+        ASSERT_EQ(mpcFull.getSolver().getBackend()->getNumSkippedLQApproximations(), 0u);
+        skippedStages += mpcIncremental.getSolver().getBackend()->getNumSkippedLQApproximations();
+
+        ASSERT_EQ(policyFull.uff().size(), policyIncremental.uff().size());
+        for (size_t k = 0; k < policyFull.uff().size(); k++)
+            ASSERT_LT((policyFull.uff()[k] - policyIncremental.uff()[k]).norm(), 1e-8);
+
+        x0 = policyFull.getReferenceStateTrajectory().front();
+
+        if (mpcFull.timeHorizonReached())
+            break;
+
+        mpcFull.prepareIteration(t);
+        mpcIncremental.prepareIteration(t);
+    }
+
+    // apart from the initial linearization, the stages are reused
+    ASSERT_GT(skippedStages, 0u);
+}
+
+
+/**
+ * Test the incremental re-linearization on a nonlinear, time-varying system. With a finite tolerance, stages which
+ * moved are re-linearized while converged stages are reused, and the solution matches the full re-linearization.
+ * In MPC with fixed final time, the shifted cache must not be reused since the stages are evaluated at a new time.
+ */
+TEST(MPCTestC, IncrementalLinearizationTimeVaryingTest)
+{
+    typedef tpl::TimeVaryingPendulum<double> TimeVaryingPendulum;
+    typedef tpl::TimeVaryingPendulumLinear<double> TimeVaryingPendulumLinear;
+
+    Eigen::Vector2d x_final;
+    x_final << 1.0, 0.0;
+
+    StateVector<state_dim> x0;
+    x0 << 0.0, 0.0;
+
+    ct::core::Time timeHorizon = 3.0;
+
+    shared_ptr<ControlledSystem<state_dim, control_dim>> system(new TimeVaryingPendulum);
+    shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new TimeVaryingPendulumLinear);
+    shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+        tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(system, costFunction, analyticLinearSystem);
+    optConProblem.setTimeHorizon(timeHorizon);
+    optConProblem.setInitialState(x0);
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.dt = 0.01;
+    nloc_settings.K_sim = 1;
+    nloc_settings.K_shot = 1;
+    nloc_settings.max_iterations = 20;
+    nloc_settings.min_cost_improvement = 1e-12;
+    nloc_settings.maxDefectSum = 1e-12;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    nloc_settings.integrator = ct::core::IntegrationType::EULER;
+    nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    nloc_settings.nThreads = 1;
+    nloc_settings.nThreadsEigen = 1;
+    nloc_settings.printSummary = false;
+
+    int K = nloc_settings.computeK(timeHorizon);
+    FeedbackArray<state_dim, control_dim> u0_fb(K, FeedbackMatrix<state_dim, control_dim>::Zero());
+    ControlVectorArray<control_dim> u0_ff(K, ControlVector<control_dim>::Zero());
+    StateVectorArray<state_dim> x_ref(K + 1, x0);
+    ct::core::StateFeedbackController<state_dim, control_dim> initController(x_ref, u0_ff, u0_fb, nloc_settings.dt);
+
+    NLOptConSettings nloc_settings_incremental = nloc_settings;
+    nloc_settings_incremental.incrementalLinearization = true;
+    nloc_settings_incremental.incrementalLinearizationTol = 1e-4;
+
+    NLOptConSolver<state_dim, control_dim> solverFull(optConProblem, nloc_settings);
+    NLOptConSolver<state_dim, control_dim> solverIncremental(optConProblem, nloc_settings_incremental);
+    solverFull.setInitialGuess(initController);
+    solverIncremental.setInitialGuess(initController);
+    solverFull.solve();
+    solverIncremental.solve();
+
+    // the first iterations move the trajectory and re-linearize, the final ones reuse the converged stages
+    const std::vector<size_t>& skipped = solverIncremental.getBackend()->getSummary().skippedLQApproximations;
+    ASSERT_GT(skipped.size(), 2u);
+    ASSERT_EQ(skipped.front(), 0u);
+    ASSERT_LT(skipped[1], (size_t)K);
+    ASSERT_GT(std::accumulate(skipped.begin(), skipped.end(), size_t(0)), 0u);
+
+    const StateVectorArray<state_dim>& xFull = solverFull.getSolution().x_ref();
+    const StateVectorArray<state_dim>& xIncremental = solverIncremental.getSolution().x_ref();
+    ASSERT_EQ(xFull.size(), xIncremental.size());
+    for (size_t k = 0; k < xFull.size(); k++)
+        ASSERT_LT((xFull[k] - xIncremental[k]).norm(), 1e-3);
+
+    // MPC with fixed final time: the cache is keyed on the stage time, hence nothing is reused after the shift
+    ct::optcon::mpc_settings settings;
+    settings.stateForwardIntegration_ = true;
+    settings.stateForwardIntegratorType_ = nloc_settings.integrator;
+    settings.stateForwardIntegration_dt_ = nloc_settings.dt;
+    settings.postTruncation_ = false;
+    settings.measureDelay_ = false;
+    settings.fixedDelayUs_ = 100000;
+    settings.mpc_mode = ct::optcon::MPC_MODE::FIXED_FINAL_TIME;
+    settings.coldStart_ = false;
+    settings.useExternalTiming_ = true;
+
+    NLOptConSettings nloc_settings_mpc = nloc_settings;
+    nloc_settings_mpc.max_iterations = 1;
+    NLOptConSettings nloc_settings_mpc_incremental = nloc_settings_mpc;
+    nloc_settings_mpc_incremental.incrementalLinearization = true;
+    nloc_settings_mpc_incremental.incrementalLinearizationTol = 1e10;
+
+    MPC<NLOptConSolver<state_dim, control_dim>> mpcFull(optConProblem, nloc_settings_mpc, settings);
+    MPC<NLOptConSolver<state_dim, control_dim>> mpcIncremental(
+        optConProblem, nloc_settings_mpc_incremental, settings);
+    mpcFull.setInitialGuess(solverFull.getSolution());
+    mpcIncremental.setInitialGuess(solverFull.getSolution());
+
+    mpcFull.prepareIteration(0.0);
+    mpcIncremental.prepareIteration(0.0);
+
+    for (int i = 0; i < 10; i++)
+    {
+        const double t = i * 1e-6 * settings.fixedDelayUs_;
+        ct::core::StateFeedbackController<state_dim, control_dim> policyFull, policyIncremental;
+        ct::core::Time tsFull, tsIncremental;
+
+        ASSERT_TRUE(mpcFull.finishIteration(x0, t, policyFull, tsFull));
+        ASSERT_TRUE(mpcIncremental.finishIteration(x0, t, policyIncremental, tsIncremental));
+        ASSERT_EQ(mpcIncremental.getSolver().getBackend()->getNumSkippedLQApproximations(), 0u);
+
+        ASSERT_EQ(policyFull.uff().size(), policyIncremental.uff().size());
+        for (size_t k = 0; k < policyFull.uff().size(); k++)
+            ASSERT_LT((policyFull.uff()[k] - policyIncremental.uff()[k]).norm(), 1e-8);
+
+        x0 = policyFull.getReferenceStateTrajectory().front();
+
+        if (mpcFull.timeHorizonReached())
+            break;
+
+        mpcFull.prepareIteration(t);
+        mpcIncremental.prepareIteration(t);
+    }
+}
+
+
+/**
+ * Test the asynchronous MPC runner. With external timing and a deterministic sequence of state measurements, the
+ * published policies must be identical to the ones obtained by calling the MPC synchronously.
+ */
+TEST(MPCTestD, MpcRunnerTest)
+{
+    typedef tpl::LinearOscillator<double> LinearOscillator;
+    typedef tpl::LinearOscillatorLinear<double> LinearOscillatorLinear;
+    typedef MPC<NLOptConSolver<state_dim, control_dim>> MPC_t;
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+
+    StateVector<state_dim> x0;
+    x0 << 1.0, 0.0;
+
+    ct::core::Time timeHorizon = 3.0;
+
+    shared_ptr<ControlledSystem<state_dim, control_dim>> system(new LinearOscillator);
+    shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear);
+    shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+        tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(system, costFunction, analyticLinearSystem);
+    optConProblem.setTimeHorizon(timeHorizon);
+    optConProblem.setInitialState(x0);
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.dt = 0.01;
+    nloc_settings.K_sim = 1;
+    nloc_settings.K_shot = 1;
+    nloc_settings.max_iterations = 1;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    nloc_settings.integrator = ct::core::IntegrationType::EULER;
+    nloc_settings.lineSearchSettings.type = LineSearchSettings::TYPE::SIMPLE;
+    nloc_settings.nThreads = 1;
+    nloc_settings.nThreadsEigen = 1;
+    nloc_settings.printSummary = false;
+
+    ct::optcon::mpc_settings settings;
+    settings.stateForwardIntegration_ = true;
+    settings.stateForwardIntegratorType_ = nloc_settings.integrator;
+    settings.stateForwardIntegration_dt_ = nloc_settings.dt;
+    settings.postTruncation_ = false;
+    settings.measureDelay_ = false;
+    settings.fixedDelayUs_ = 100000;
+    settings.mpc_mode = ct::optcon::MPC_MODE::FIXED_FINAL_TIME;
+    settings.coldStart_ = false;
+    settings.useExternalTiming_ = true;
+
+    int K = nloc_settings.computeK(timeHorizon);
+    FeedbackArray<state_dim, control_dim> u0_fb(K, FeedbackMatrix<state_dim, control_dim>::Zero());
+    ControlVectorArray<control_dim> u0_ff(K, ControlVector<control_dim>::Zero());
+    StateVectorArray<state_dim> x_ref(K + 1, x0);
+    ct::core::StateFeedbackController<state_dim, control_dim> initGuess(x_ref, u0_ff, u0_fb, nloc_settings.dt);
+
+    // test the single and the multiple shooting MPC iterations, with and without splitting the iterations
+    for (int variant = 0; variant < 4; variant++)
+    {
+        nloc_settings.nlocp_algorithm = (variant % 2 == 0) ? NLOptConSettings::NLOCP_ALGORITHM::ILQR
+                                                           : NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+        nloc_settings.splitMPCIteration = (variant >= 2);
+
+        MPC_t mpcSync(optConProblem, nloc_settings, settings);
+        std::shared_ptr<MPC_t> mpcAsync(new MPC_t(optConProblem, nloc_settings, settings));
+        mpcSync.setInitialGuess(initGuess);
+        mpcAsync->setInitialGuess(initGuess);
+
+        MpcRunner<NLOptConSolver<state_dim, control_dim>> runner(mpcAsync);
+
+        mpcSync.prepareIteration(0.0);
+        runner.start(0.0);
+
+        ASSERT_FALSE(runner.updatePolicy());
+
+        StateVector<state_dim> x = x0;
+        size_t numCycles = 0;
+        for (int i = 0; i < 10; i++)
+        {
+            const double t = i * 1e-6 * settings.fixedDelayUs_;
+
+            ct::core::StateFeedbackController<state_dim, control_dim> policySync;
+            ct::core::Time tsSync;
+            bool successSync = mpcSync.finishIteration(x, t, policySync, tsSync);
+
+            runner.setState(x, t);
+            while (!runner.updatePolicy())
+                std::this_thread::yield();
+            numCycles++;
+
+            const auto& published = runner.getPolicy();
+            ASSERT_EQ(published.cycle, numCycles);
+            ASSERT_EQ(published.success, successSync);
+            ASSERT_DOUBLE_EQ(published.policy_ts, tsSync);
+            ASSERT_GE(published.latency, 0.0);
+            ASSERT_EQ(published.policy.uff().size(), policySync.uff().size());
+            for (size_t k = 0; k < policySync.uff().size(); k++)
+                ASSERT_LT((published.policy.uff()[k] - policySync.uff()[k]).norm(), 1e-10);
+
+            x = policySync.getReferenceStateTrajectory().front();
+
+            if (mpcSync.timeHorizonReached())
+                break;
+
+            mpcSync.prepareIteration(t);
+        }
+
+        runner.stop();
+        ASSERT_FALSE(runner.isRunning());
+        ASSERT_EQ(runner.getNumCycles(), numCycles);
+        ASSERT_EQ(runner.getLatencies().size(), numCycles);
+    }
+
+    // an exception in the MPC thread ends the thread and is handed over to the caller, the runner can be restarted
+    nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::ILQR;
+    nloc_settings.splitMPCIteration = false;
+    std::shared_ptr<MPC_t> mpc(new MPC_t(optConProblem, nloc_settings, settings));
+    mpc->setInitialGuess(initGuess);
+    MpcRunner<NLOptConSolver<state_dim, control_dim>> runner(mpc);
+
+    runner.start(0.0);
+    runner.setState(StateVector<state_dim>::Constant(std::numeric_limits<double>::quiet_NaN()), 0.0);
+    while (runner.isRunning())
+        std::this_thread::yield();
+    ASSERT_FALSE(runner.updatePolicy());
+    ASSERT_THROW(runner.stop(), std::runtime_error);
+    ASSERT_NO_THROW(runner.stop());
+
+    runner.start(0.0);
+    runner.setState(x0, 0.0);
+    while (!runner.updatePolicy())
+        std::this_thread::yield();
+    ASSERT_TRUE(runner.getPolicy().success);
+    ASSERT_NO_THROW(runner.stop());
+}
+
+
+/**
+ * Test streaming the MPC cycles and the solver iterations to a binary logger and reading them back.
+ */
+TEST(MPCTestE, BinaryLoggerTest)
+{
+    typedef tpl::LinearOscillator<double> LinearOscillator;
+    typedef tpl::LinearOscillatorLinear<double> LinearOscillatorLinear;
+
+    const std::string logFile = "NLOC_MPCTest.ctlog";
+
+    Eigen::Vector2d x_final;
+    x_final << 20, 0;
+
+    StateVector<state_dim> x0;
+    x0 << 1.0, 0.0;
+
+    ct::core::Time timeHorizon = 3.0;
+
+    shared_ptr<ControlledSystem<state_dim, control_dim>> system(new LinearOscillator);
+    shared_ptr<LinearSystem<state_dim, control_dim>> analyticLinearSystem(new LinearOscillatorLinear);
+    shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction =
+        tpl::createCostFunctionLinearOscillator<double>(x_final);
+
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(system, costFunction, analyticLinearSystem);
+    optConProblem.setTimeHorizon(timeHorizon);
+    optConProblem.setInitialState(x0);
+
+    NLOptConSettings nloc_settings;
+    nloc_settings.dt = 0.01;
+    nloc_settings.K_sim = 1;
+    nloc_settings.K_shot = 1;
+    nloc_settings.max_iterations = 1;
+    nloc_settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    nloc_settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    nloc_settings.integrator = ct::core::IntegrationType::EULER;
+    nloc_settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    nloc_settings.nThreads = 1;
+    nloc_settings.nThreadsEigen = 1;
+    nloc_settings.printSummary = false;
+    nloc_settings.loggingPrefix = "gnms";
+
+    ct::optcon::mpc_settings settings;
+    settings.stateForwardIntegration_ = true;
+    settings.stateForwardIntegratorType_ = nloc_settings.integrator;
+    settings.stateForwardIntegration_dt_ = nloc_settings.dt;
+    settings.postTruncation_ = false;
+    settings.measureDelay_ = false;
+    settings.fixedDelayUs_ = 100000;
+    settings.mpc_mode = ct::optcon::MPC_MODE::FIXED_FINAL_TIME;
+    settings.coldStart_ = false;
+    settings.useExternalTiming_ = true;
+
+    int K = nloc_settings.computeK(timeHorizon);
+    FeedbackArray<state_dim, control_dim> u0_fb(K, FeedbackMatrix<state_dim, control_dim>::Zero());
+    ControlVectorArray<control_dim> u0_ff(K, ControlVector<control_dim>::Zero());
+    StateVectorArray<state_dim> x_ref(K + 1, x0);
+    ct::core::StateFeedbackController<state_dim, control_dim> initGuess(x_ref, u0_ff, u0_fb, nloc_settings.dt);
+
+    const size_t nCycles = 5;
+    std::vector<ct::core::StateFeedbackController<state_dim, control_dim>> policies;
+    {
+        std::shared_ptr<ct::core::BinaryLogger> logger(new ct::core::BinaryLogger(logFile));
+
+        MPC<NLOptConSolver<state_dim, control_dim>> mpc(optConProblem, nloc_settings, settings);
+        mpc.setInitialGuess(initGuess);
+        mpc.setBinaryLogger(logger);
+        mpc.getSolver().setBinaryLogger(logger);
+
+        StateVector<state_dim> x = x0;
+        for (size_t i = 0; i < nCycles; i++)
+        {
+            const double t = i * 1e-6 * settings.fixedDelayUs_;
+            mpc.prepareIteration(t);
+
+            ct::core::StateFeedbackController<state_dim, control_dim> policy;
+            ct::core::Time ts;
+            ASSERT_TRUE(mpc.finishIteration(x, t, policy, ts));
+            policies.push_back(policy);
+
+            x = policy.getReferenceStateTrajectory().front();
+        }
+
+        logger->flush();
+        ASSERT_EQ(logger->droppedRecords(), 0u);
+    }
+
+    ct::core::BinaryLogReader reader(logFile);
+
+    const auto& status = reader.records("mpc/status");
+    const auto& uff = reader.records("mpc/u_ff");
+    ASSERT_EQ(status.size(), nCycles);
+    ASSERT_EQ(uff.size(), nCycles);
+    for (size_t i = 0; i < nCycles; i++)
+    {
+        ASSERT_EQ(status[i].index, static_cast<int64_t>(i + 1));
+        ASSERT_EQ(status[i].sample(0)(2), 1.0);
+        ASSERT_EQ(uff[i].samples, policies[i].uff().size());
+        for (size_t k = 0; k < uff[i].samples; k++)
+            ASSERT_EQ(uff[i].sample(k), policies[i].uff()[k]);
+    }
+    ASSERT_EQ(reader.records("mpc/K")[0].rows, control_dim);
+    ASSERT_EQ(reader.records("mpc/K")[0].cols, state_dim);
+
+    // one solver iteration per cycle
+    ASSERT_EQ(reader.records("gnms/x").size(), nCycles);
+    ASSERT_EQ(reader.records("gnms/summary").size(), nCycles);
+    ASSERT_EQ(reader.records("gnms/summary")[0].rows, 8u);
+
+    std::remove(logFile.c_str());
+}
+
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
@@ -0,0 +1,287 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <csignal>
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <ct/optcon/optcon.h>
+
+#include "nonlinear/DiehlSystem.h"
+
+using namespace ct;
+using namespace ct::core;
+using namespace ct::optcon;
+using namespace ct::optcon::example;
+
+typedef NLOptConSolver<state_dim, control_dim> NLOptConSolver_t;
+typedef NLOCBackendDistributed<state_dim, control_dim, state_dim / 2, state_dim / 2> DistributedBackend_t;
+
+
+NLOptConSettings createSettings(NLOptConSettings::NLOCP_ALGORITHM algorithm, int nProcesses)
+{
+    NLOptConSettings settings;
+    settings.nlocp_algorithm = algorithm;
+    settings.integrator = ct::core::IntegrationType::EULERCT;
+    settings.discretization = NLOptConSettings::APPROXIMATION::FORWARD_EULER;
+    settings.useSensitivityIntegrator = true;
+    settings.dt = 0.01;
+    settings.K_sim = 10;
+    settings.K_shot = 7;
+    settings.max_iterations = 15;
+    settings.nThreads = 1;
+    settings.nProcesses = nProcesses;
+    settings.lineSearchSettings.type = LineSearchSettings::TYPE::SIMPLE;
+    settings.printSummary = false;
+    return settings;
+}
+
+
+std::shared_ptr<NLOptConSolver_t> createSolver(const NLOptConSettings& settings, double tf)
+{
+    StateVector<state_dim> x0;
+    x0 << 2.5;
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> system(new Dynamics);
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> linearSystem(new LinearizedSystem);
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+        new CostFunctionQuadraticSimple<state_dim, control_dim>(StateMatrix<state_dim>::Identity(),
+            ControlMatrix<control_dim>::Identity(), StateVector<state_dim>::Zero(), ControlVector<control_dim>::Zero(),
+            StateVector<state_dim>::Zero(), 10.0 * StateMatrix<state_dim>::Identity()));
+
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(tf, x0, system, costFunction, linearSystem);
+
+    return std::shared_ptr<NLOptConSolver_t>(new NLOptConSolver_t(optConProblem, settings));
+}
+
+
+void setInitialGuess(NLOptConSolver_t& solver, const NLOptConSettings& settings, double tf)
+{
+    const size_t K = settings.computeK(tf);
+
+    ControlVector<control_dim> u0;
+    u0 << -3.5 * 2.5;
+
+    NLOptConSolver_t::Policy_t initialGuess(StateVectorArray<state_dim>(K + 1, StateVector<state_dim>::Constant(2.5)),
+        ControlVectorArray<control_dim>(K, u0),
+        FeedbackArray<state_dim, control_dim>(K, FeedbackMatrix<state_dim, control_dim>::Zero()), settings.dt);
+
+    solver.setInitialGuess(initialGuess);
+}
+
+
+bool isRunning(pid_t pid)
+{
+    return ::kill(pid, 0) == 0;
+}
+
+
+TEST(DistributedGNMSTest, SettingsValidity)
+{
+    NLOptConSettings settings = createSettings(NLOptConSettings::NLOCP_ALGORITHM::GNMS, 3);
+    ASSERT_TRUE(settings.parametersOk());
+
+    settings.nProcesses = 0;
+    ASSERT_FALSE(settings.parametersOk());
+
+    // distributed multiple shooting requires a multiple-shooting algorithm and a single thread
+    settings = createSettings(NLOptConSettings::NLOCP_ALGORITHM::ILQR, 3);
+    settings.K_shot = 1;
+    ASSERT_FALSE(settings.parametersOk());
+
+    settings = createSettings(NLOptConSettings::NLOCP_ALGORITHM::GNMS, 3);
+    settings.nThreads = 2;
+    ASSERT_FALSE(settings.parametersOk());
+}
+
+
+/*!
+ * The distributed solve gives the same iterates as the single-process solve, also if there are more processes than
+ * shots in some ranges
+ */
+TEST(DistributedGNMSTest, MatchesSingleProcess)
+{
+    const double tf = 3.0;
+
+    for (auto algorithm : {NLOptConSettings::NLOCP_ALGORITHM::GNMS, NLOptConSettings::NLOCP_ALGORITHM::MS_ILQR})
+    {
+        NLOptConSettings settings = createSettings(algorithm, 1);
+        std::shared_ptr<NLOptConSolver_t> reference = createSolver(settings, tf);
+        setInitialGuess(*reference, settings, tf);
+        reference->solve();
+
+        for (int nProcesses : {2, 3, 50})
+        {
+            settings.nProcesses = nProcesses;
+            std::shared_ptr<NLOptConSolver_t> solver = createSolver(settings, tf);
+            setInitialGuess(*solver, settings, tf);
+            solver->solve();
+
+            ASSERT_NEAR(solver->getCost(), reference->getCost(), 1e-10);
+
+            const StateVectorArray<state_dim>& x = solver->getSolution().x_ref();
+            const StateVectorArray<state_dim>& x_ref = reference->getSolution().x_ref();
+            const ControlVectorArray<control_dim>& u = solver->getSolution().uff();
+            const ControlVectorArray<control_dim>& u_ref = reference->getSolution().uff();
+            ASSERT_EQ(x.size(), x_ref.size());
+            ASSERT_EQ(u.size(), u_ref.size());
+            for (size_t k = 0; k < x.size(); k++)
+                ASSERT_NEAR(x[k](0), x_ref[k](0), 1e-10) << "stage " << k;
+            for (size_t k = 0; k < u.size(); k++)
+                ASSERT_NEAR(u[k](0), u_ref[k](0), 1e-10) << "stage " << k;
+        }
+    }
+}
+
+
+/*!
+ * The workers are restarted for a new solve and shut down together with the solver
+ */
+TEST(DistributedGNMSTest, WorkerLifetime)
+{
+    const double tf = 1.0;
+    NLOptConSettings settings = createSettings(NLOptConSettings::NLOCP_ALGORITHM::GNMS, 3);
+
+    std::shared_ptr<NLOptConSolver_t> solver = createSolver(settings, tf);
+    std::shared_ptr<DistributedBackend_t> backend =
+        std::dynamic_pointer_cast<DistributedBackend_t>(solver->getBackend());
+    ASSERT_TRUE(backend != nullptr);
+    ASSERT_TRUE(backend->getWorkerPids().empty());
+
+    setInitialGuess(*solver, settings, tf);
+    solver->solve();
+    const double cost = solver->getCost();
+
+    const std::vector<pid_t> pids = backend->getWorkerPids();
+    ASSERT_EQ(pids.size(), 3u);
+    for (pid_t pid : pids)
+        ASSERT_TRUE(isRunning(pid));
+
+    // a new solve starts new workers
+    setInitialGuess(*solver, settings, tf);
+    solver->solve();
+    ASSERT_NEAR(solver->getCost(), cost, 1e-12);
+    ASSERT_EQ(backend->getWorkerPids().size(), 3u);
+    for (size_t i = 0; i < pids.size(); i++)
+    {
+        ASSERT_NE(backend->getWorkerPids()[i], pids[i]);
+        ASSERT_FALSE(isRunning(pids[i]));
+    }
+
+    const std::vector<pid_t> lastPids = backend->getWorkerPids();
+    backend.reset();
+    solver.reset();
+    for (pid_t pid : lastPids)
+        ASSERT_FALSE(isRunning(pid));
+}
+
+
+/*!
+ * A worker killed during a solve makes the solve fail with an exception, afterwards the solver can be used again
+ */
+TEST(DistributedGNMSTest, WorkerKilledDuringSolve)
+{
+    const double tf = 1.0;
+    NLOptConSettings settings = createSettings(NLOptConSettings::NLOCP_ALGORITHM::GNMS, 3);
+
+    std::shared_ptr<NLOptConSolver_t> solver = createSolver(settings, tf);
+    std::shared_ptr<DistributedBackend_t> backend =
+        std::dynamic_pointer_cast<DistributedBackend_t>(solver->getBackend());
+
+    setInitialGuess(*solver, settings, tf);
+    solver->runIteration();
+
+    const std::vector<pid_t> pids = backend->getWorkerPids();
+    ASSERT_EQ(pids.size(), 3u);
+    ASSERT_EQ(::kill(pids[1], SIGKILL), 0);
+
+    ASSERT_THROW(solver->runIteration(), std::runtime_error);
+
+    // all workers were shut down, also the ones with a higher index than the killed one
+    ASSERT_TRUE(backend->getWorkerPids().empty());
+    for (pid_t pid : pids)
+        ASSERT_FALSE(isRunning(pid));
+
+    // a new solve starts new workers
+    std::shared_ptr<NLOptConSolver_t> reference = createSolver(settings, tf);
+    setInitialGuess(*reference, settings, tf);
+    reference->solve();
+
+    setInitialGuess(*solver, settings, tf);
+    solver->solve();
+    ASSERT_NEAR(solver->getCost(), reference->getCost(), 1e-12);
+    ASSERT_EQ(backend->getWorkerPids().size(), 3u);
+}
+
+
+/*!
+ * Changing the problem shuts the workers down, they are restarted with the modified problem
+ */
+TEST(DistributedGNMSTest, ProblemChangeRestartsWorkers)
+{
+    const double tf = 1.0;
+    NLOptConSettings settings = createSettings(NLOptConSettings::NLOCP_ALGORITHM::GNMS, 2);
+
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim>> costFunction(
+        new CostFunctionQuadraticSimple<state_dim, control_dim>(10.0 * StateMatrix<state_dim>::Identity(),
+            ControlMatrix<control_dim>::Identity(), StateVector<state_dim>::Zero(), ControlVector<control_dim>::Zero(),
+            StateVector<state_dim>::Zero(), 10.0 * StateMatrix<state_dim>::Identity()));
+
+    std::shared_ptr<NLOptConSolver_t> reference = createSolver(createSettings(settings.nlocp_algorithm, 1), tf);
+    reference->changeCostFunction(costFunction);
+    setInitialGuess(*reference, settings, tf);
+    reference->solve();
+
+    std::shared_ptr<NLOptConSolver_t> solver = createSolver(settings, tf);
+    std::shared_ptr<DistributedBackend_t> backend =
+        std::dynamic_pointer_cast<DistributedBackend_t>(solver->getBackend());
+
+    setInitialGuess(*solver, settings, tf);
+    solver->runIteration();
+    ASSERT_EQ(backend->getWorkerPids().size(), 2u);
+
+    solver->changeCostFunction(costFunction);
+    ASSERT_TRUE(backend->getWorkerPids().empty());
+
+    setInitialGuess(*solver, settings, tf);
+    solver->solve();
+    ASSERT_NEAR(solver->getCost(), reference->getCost(), 1e-10);
+}
+
+
+/*!
+ * The workers are not forked from a multi-threaded process
+ */
+TEST(DistributedGNMSTest, RejectsMultiThreadedProcess)
+{
+#ifdef __linux__
+    const double tf = 1.0;
+    NLOptConSettings settings = createSettings(NLOptConSettings::NLOCP_ALGORITHM::GNMS, 2);
+    std::shared_ptr<NLOptConSolver_t> solver = createSolver(settings, tf);
+    std::shared_ptr<DistributedBackend_t> backend =
+        std::dynamic_pointer_cast<DistributedBackend_t>(solver->getBackend());
+
+    std::promise<void> release;
+    std::thread other([&release]() { release.get_future().wait(); });
+
+    setInitialGuess(*solver, settings, tf);
+    EXPECT_THROW(solver->solve(), std::runtime_error);
+    EXPECT_TRUE(backend->getWorkerPids().empty());
+
+    release.set_value();
+    other.join();
+
+    setInitialGuess(*solver, settings, tf);
+    ASSERT_NO_THROW(solver->solve());
+#endif
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
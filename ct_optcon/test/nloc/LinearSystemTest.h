@@ -6,6 +6,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #pragma once
 
 #include <chrono>
+#include <sstream>
 
 #include <gtest/gtest.h>
 
@@ -156,6 +157,16 @@ TEST(LinearSystemsTest, NLOCSolverTest)
                                 ASSERT_LT(summary.defect_l1_norms.back(), 1e-10);
                                 ASSERT_LT(summary.defect_l2_norms.back(), 1e-10);
 
+#ifdef NLOC_TRACE
+                                //! every iteration records the timed phases of all participating threads
+                                ASSERT_FALSE(summary.traceEvents.empty());
+                                for (const NLOCTraceEvent& event : summary.traceEvents)
+                                {
+                                    ASSERT_LE(event.threadId, nloc_settings.nThreads);
+                                    ASSERT_GE(event.duration, 0.0);
+                                }
+#endif
+
                                 testCounter++;
 
                             }  // toggle integrator type
@@ -171,6 +182,40 @@ TEST(LinearSystemsTest, NLOCSolverTest)
 }  // end TEST
 
 
+TEST(LinearSystemsTest, NLOCTraceExportTest)
+{
+    NLOCTraceRecorder recorder(2);
+    {
+        NLOCTraceScope scope(recorder, 1, "rollout worker", 0, 9);
+    }
+    {
+        NLOCTraceScope scope(recorder, 2, "line search alpha", 0, 9, 0.5);
+    }
+
+    std::vector<NLOCTraceEvent> events;
+    recorder.collect(3, events);
+    ASSERT_EQ(events.size(), 2u);
+    ASSERT_EQ(events[0].iteration, 3u);
+    ASSERT_EQ(events[1].threadId, 2u);
+
+    // the buffers are emptied by collecting
+    std::vector<NLOCTraceEvent> none;
+    recorder.collect(4, none);
+    ASSERT_TRUE(none.empty());
+
+    std::stringstream trace;
+    writeChromeTrace(events, trace);
+    const std::string json = trace.str();
+    ASSERT_NE(json.find("\"traceEvents\""), std::string::npos);
+    ASSERT_NE(json.find("\"name\":\"rollout worker\""), std::string::npos);
+    ASSERT_NE(json.find("\"tid\":2"), std::string::npos);
+    ASSERT_NE(json.find("\"alpha\":0.5"), std::string::npos);
+
+    // only the line search event has a step size
+    ASSERT_EQ(json.find("\"alpha\""), json.rfind("\"alpha\""));
+}
+
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
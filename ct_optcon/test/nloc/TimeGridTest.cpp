@@ -0,0 +1,248 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <ct/optcon/optcon.h>
+
+#include "../testSystems/LinearOscillator.h"
+#include "nloc_test_dir.h"
+
+using namespace ct;
+using namespace ct::core;
+using namespace ct::optcon;
+using namespace ct::optcon::example;
+
+typedef NLOptConSolver<state_dim, control_dim> NLOptConSolver_t;
+
+
+/*!
+ * Solve the linear oscillator problem with the given settings
+ */
+std::shared_ptr<NLOptConSolver_t> solveOscillator(const NLOptConSettings& settings, double tf)
+{
+    StateVector<state_dim> x0;
+    x0 << 0.0, 1.0;
+    Eigen::Vector2d x_final;
+    x_final << 1.0, 0.0;
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim>> system(new LinearOscillator());
+    std::shared_ptr<LinearSystem<state_dim, control_dim>> linearSystem(new LinearOscillatorLinear());
+    ContinuousOptConProblem<state_dim, control_dim> optConProblem(
+        tf, x0, system, example::tpl::createCostFunctionLinearOscillator<double>(x_final), linearSystem);
+
+    const size_t K = settings.computeK(tf);
+
+    NLOptConSolver_t::Policy_t initialGuess(StateVectorArray<state_dim>(K + 1, x0),
+        ControlVectorArray<control_dim>(K, ControlVector<control_dim>::Zero()),
+        FeedbackArray<state_dim, control_dim>(K, FeedbackMatrix<state_dim, control_dim>::Zero()), settings.dt);
+
+    std::shared_ptr<NLOptConSolver_t> solver(new NLOptConSolver_t(optConProblem, settings));
+    solver->setInitialGuess(initialGuess);
+    solver->solve();
+    return solver;
+}
+
+NLOptConSettings createSettings()
+{
+    NLOptConSettings settings;
+    settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    settings.dt = 0.01;
+    settings.K_sim = 2;
+    settings.max_iterations = 10;
+    settings.nThreads = 1;
+    settings.printSummary = false;
+    return settings;
+}
+
+
+/*!
+ * Test the number of stages and stage boundaries of the different time grids
+ */
+TEST(TimeGridTest, GridGeneration)
+{
+    NLOptConSettings settings;
+    settings.dt = 0.1;
+
+    // the uniform grid is unchanged
+    ASSERT_EQ(settings.computeK(1.0), 10);
+    ASSERT_NEAR(settings.computeTimeGrid(10).back(), 1.0, 1e-12);
+
+    // geometric grid, stage durations 0.1, 0.2, 0.4, 0.8, ...
+    settings.timeGrid = NLOptConSettings::TIME_GRID::GEOMETRIC_GRID;
+    settings.timeGridGrowthFactor = 2.0;
+    ASSERT_TRUE(settings.parametersOk());
+    ASSERT_EQ(settings.computeK(1.5), 4);
+    ASSERT_EQ(settings.computeK(0.01), 1);
+
+    TimeArray t = settings.computeTimeGrid(4);
+    ASSERT_EQ(t.size(), 5u);
+    ASSERT_NEAR(t[0], 0.0, 1e-12);
+    ASSERT_NEAR(t[1], 0.1, 1e-12);
+    ASSERT_NEAR(t[3], 0.7, 1e-12);
+    ASSERT_NEAR(t[4], 1.5, 1e-12);
+
+    // user-defined grid, the last duration is repeated
+    settings.timeGrid = NLOptConSettings::TIME_GRID::USER_DEFINED_GRID;
+    settings.stageDurations = {0.05, 0.05, 0.1, 0.2};
+    ASSERT_TRUE(settings.parametersOk());
+    ASSERT_EQ(settings.computeK(1.0), 7);
+    ASSERT_NEAR(settings.computeTimeGrid(7).back(), 1.0, 1e-12);
+
+    settings.stageDurations.push_back(-0.1);
+    ASSERT_FALSE(settings.parametersOk());
+    ASSERT_THROW(settings.computeK(2.0), std::runtime_error);
+
+    // a shrinking geometric grid only covers horizons shorter than dt / (1 - timeGridGrowthFactor) = 0.2
+    settings.timeGrid = NLOptConSettings::TIME_GRID::GEOMETRIC_GRID;
+    settings.timeGridGrowthFactor = 0.5;
+    ASSERT_EQ(settings.computeK(0.15), 2);
+    ASSERT_THROW(settings.computeK(0.2), std::runtime_error);
+    ASSERT_THROW(settings.computeK(1.0), std::runtime_error);
+}
+
+
+/*!
+ * The stage durations of a user-defined grid can be loaded from file
+ */
+TEST(TimeGridTest, LoadStageDurations)
+{
+    NLOptConSettings settings;
+    settings.load(std::string(NLOC_TEST_DIR) + "/timeGrid.info", false, "alg");
+
+    ASSERT_EQ(settings.timeGrid, NLOptConSettings::TIME_GRID::USER_DEFINED_GRID);
+    ASSERT_EQ(settings.stageDurations, std::vector<double>({0.05, 0.05, 0.1, 0.2}));
+    ASSERT_EQ(settings.computeK(1.0), 7);
+}
+
+
+/*!
+ * A user-defined grid with constant stage durations gives the same result as the uniform grid
+ */
+TEST(TimeGridTest, ConstantGridMatchesUniform)
+{
+    const double tf = 0.5;
+
+    NLOptConSettings uniform = createSettings();
+    std::shared_ptr<NLOptConSolver_t> uniformSolver = solveOscillator(uniform, tf);
+
+    NLOptConSettings constant = createSettings();
+    constant.timeGrid = NLOptConSettings::TIME_GRID::USER_DEFINED_GRID;
+    constant.stageDurations = {uniform.dt};
+    std::shared_ptr<NLOptConSolver_t> constantSolver = solveOscillator(constant, tf);
+
+    const size_t K = uniform.computeK(tf);
+    ASSERT_EQ(constantSolver->getSolution().uff().size(), K);
+    ASSERT_NEAR(constantSolver->getCost(), uniformSolver->getCost(), 1e-8 * std::abs(uniformSolver->getCost()));
+    for (size_t k = 0; k < K; k++)
+        ASSERT_TRUE(constantSolver->getSolution().uff()[k].isApprox(uniformSolver->getSolution().uff()[k], 1e-6));
+}
+
+
+/*!
+ * On a geometric grid, the rollout integrates the dynamics over the individual stage durations
+ */
+TEST(TimeGridTest, GeometricGridDynamics)
+{
+    const double tf = 2.0;
+
+    NLOptConSettings settings = createSettings();
+    settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::ILQR;
+    settings.timeGrid = NLOptConSettings::TIME_GRID::GEOMETRIC_GRID;
+    settings.timeGridGrowthFactor = 1.3;
+    settings.K_sim = 20;
+
+    std::shared_ptr<NLOptConSolver_t> solver = solveOscillator(settings, tf);
+
+    const size_t K = settings.computeK(tf);
+    ASSERT_LT(K, 20u);  // much fewer stages than the 200 of the uniform grid
+
+    const TimeArray& t = solver->getTimeArray();
+    ASSERT_EQ(t.size(), K + 1);
+    ASSERT_NEAR(solver->getTimeHorizon(), t.back(), 1e-12);
+
+    const StateVectorArray<state_dim>& x = solver->getSolution().x_ref();
+    const ControlVectorArray<control_dim>& u = solver->getSolution().uff();
+
+    // the stage duration grows with the stage
+    ASSERT_NEAR((t[K] - t[K - 1]) / (t[1] - t[0]), std::pow(settings.timeGridGrowthFactor, K - 1), 1e-9);
+
+    // integrate every stage with the constant control of the stage
+    std::shared_ptr<LinearOscillator> oscillator(new LinearOscillator());
+    std::shared_ptr<ConstantController<state_dim, control_dim>> controller(
+        new ConstantController<state_dim, control_dim>());
+    oscillator->setController(controller);
+    Integrator<state_dim> integrator(oscillator, IntegrationType::RK4);
+
+    for (size_t k = 0; k < K; k++)
+    {
+        controller->setControl(u[k]);
+        StateVector<state_dim> x_next = x[k];
+        const double dt_k = t[k + 1] - t[k];
+        integrator.integrate_n_steps(x_next, t[k], 200, dt_k / 200);
+        ASSERT_TRUE(x_next.isApprox(x[k + 1], 1e-8)) << "stage " << k;
+    }
+}
+
+
+/*!
+ * Warm starting on a non-uniform grid interpolates the policy at the shifted grid points
+ */
+TEST(TimeGridTest, PolicyHandlerShifting)
+{
+    NLOptConSettings settings;
+    settings.dt = 0.1;
+    settings.timeGrid = NLOptConSettings::TIME_GRID::USER_DEFINED_GRID;
+    settings.stageDurations = {0.1, 0.1, 0.2, 0.4};
+
+    const int K = settings.computeK(1.2);
+    ASSERT_EQ(K, 5);
+    const TimeArray t = settings.computeTimeGrid(K);
+
+    // feedforward and state reference are linear in time
+    StateVectorArray<state_dim> x(K + 1);
+    ControlVectorArray<control_dim> u(K);
+    FeedbackArray<state_dim, control_dim> L(K, FeedbackMatrix<state_dim, control_dim>::Zero());
+    for (int k = 0; k <= K; k++)
+    {
+        x[k] << t[k], -t[k];
+        if (k < K)
+            u[k] << t[k];
+    }
+
+    StateFeedbackController<state_dim, control_dim> policy(x, u, L, settings.dt);
+    policy.update(x, u, L, t);
+    policy.getReferenceStateTrajectory().setInterpolationType(InterpolationType::LIN);
+    policy.getFeedforwardTrajectory().setInterpolationType(InterpolationType::LIN);
+
+    StateFeedbackPolicyHandler<state_dim, control_dim, double> handler(settings);
+    const double delay = 0.15;
+    handler.designWarmStartingPolicy(delay, 1.2, policy);
+
+    ASSERT_EQ(policy.getFeedforwardTrajectory().size(), (size_t)K);
+    ASSERT_EQ(policy.getReferenceStateTrajectory().size(), (size_t)K + 1);
+
+    for (int k = 0; k <= K; k++)
+    {
+        // the new grid starts at zero, the old policy is held constant beyond its end
+        const double t_old = std::min(delay + t[k], t[K]);
+        ASSERT_NEAR(policy.getReferenceStateTrajectory().getTimeFromIndex(k), t[k], 1e-12);
+        ASSERT_NEAR(policy.getReferenceStateTrajectory()[k](0), t_old, 1e-12);
+        ASSERT_NEAR(policy.getReferenceStateTrajectory()[k](1), -t_old, 1e-12);
+        if (k < K)
+            ASSERT_NEAR(policy.getFeedforwardTrajectory()[k](0), std::min(delay + t[k], t[K - 1]), 1e-12);
+    }
+
+    // truncation reports the time of the removed stages
+    double truncated;
+    handler.truncateSolutionFront(0.25, policy, truncated);
+    ASSERT_NEAR(truncated, 0.2, 1e-12);
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
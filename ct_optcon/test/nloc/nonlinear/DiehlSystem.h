@@ -16,17 +16,20 @@ const size_t state_dim = 1;
 const size_t control_dim = 1;
 
 
+namespace tpl {
+
 //! Dynamics class for the GNMS unit test, slightly nonlinear dynamics
-class Dynamics : public ControlledSystem<state_dim, control_dim>
+template <typename SCALAR>
+class Dynamics : public ControlledSystem<state_dim, control_dim, SCALAR>
 {
 public:
-    Dynamics() : ControlledSystem<state_dim, control_dim>(SYSTEM_TYPE::SECOND_ORDER) {}
-    void computeControlledDynamics(const StateVector<state_dim>& state,
-        const Time& t,
-        const ControlVector<control_dim>& control,
-        StateVector<state_dim>& derivative) override
+    Dynamics() : ControlledSystem<state_dim, control_dim, SCALAR>(SYSTEM_TYPE::SECOND_ORDER) {}
+    void computeControlledDynamics(const StateVector<state_dim, SCALAR>& state,
+        const SCALAR& t,
+        const ControlVector<control_dim, SCALAR>& control,
+        StateVector<state_dim, SCALAR>& derivative) override
     {
-        derivative(0) = (1.0 + state(0)) * state(0) + control(0);
+        derivative(0) = (SCALAR(1.0) + state(0)) * state(0) + control(0);
     }
 
     Dynamics* clone() const override { return new Dynamics(); };
@@ -34,24 +37,27 @@ public:
 
 
 //! Linear system class for the GNMS unit test
-class LinearizedSystem : public LinearSystem<state_dim, control_dim>
+template <typename SCALAR>
+class LinearizedSystem : public LinearSystem<state_dim, control_dim, SCALAR>
 {
 public:
-    state_matrix_t A_;
-    state_control_matrix_t B_;
+    typedef LinearSystem<state_dim, control_dim, SCALAR> Base;
+
+    typename Base::state_matrix_t A_;
+    typename Base::state_control_matrix_t B_;
 
 
-    const state_matrix_t& getDerivativeState(const StateVector<state_dim>& x,
-        const ControlVector<control_dim>& u,
-        const double t = 0.0) override
+    const typename Base::state_matrix_t& getDerivativeState(const StateVector<state_dim, SCALAR>& x,
+        const ControlVector<control_dim, SCALAR>& u,
+        const SCALAR t = 0.0) override
     {
         A_ << 1 + 2 * x(0);
         return A_;
     }
 
-    const state_control_matrix_t& getDerivativeControl(const StateVector<state_dim>& x,
-        const ControlVector<control_dim>& u,
-        const double t = 0.0) override
+    const typename Base::state_control_matrix_t& getDerivativeControl(const StateVector<state_dim, SCALAR>& x,
+        const ControlVector<control_dim, SCALAR>& u,
+        const SCALAR t = 0.0) override
     {
         B_ << 1;
         return B_;
@@ -59,6 +65,10 @@ public:
 
     LinearizedSystem* clone() const override { return new LinearizedSystem(); }
 };
+}  // namespace tpl
+
+typedef tpl::Dynamics<double> Dynamics;
+typedef tpl::LinearizedSystem<double> LinearizedSystem;
 }
 }
 }
@@ -116,6 +116,122 @@ TEST(NLOCTest, NonlinearSystemAlgorithmComparison)
         ASSERT_NEAR(uRollout_gnms[i](0), uRollout_ilqr[i](0), 1e-4);
     }
 }
+
+
+/*!
+ * solve the nonlinear test problem with scalar type SCALAR, the solution is returned in double precision
+ * @return the wall time of the solve in milliseconds
+ */
+template <typename SCALAR>
+double solveNonlinearSystemProblem(const NLOptConSettings& settings,
+    const double tf,
+    const double x_init,
+    StateVectorArray<state_dim>& x_solution,
+    ControlVectorArray<control_dim>& u_solution)
+{
+    typedef NLOptConSolver<state_dim, control_dim, 1, 0, SCALAR> NLOptConSolver;
+
+    // the same weights as in cost.info
+    Eigen::Matrix<SCALAR, state_dim, state_dim> Q = Eigen::Matrix<SCALAR, state_dim, state_dim>::Identity();
+    Eigen::Matrix<SCALAR, control_dim, control_dim> R = Eigen::Matrix<SCALAR, control_dim, control_dim>::Identity();
+    StateVector<state_dim, SCALAR> x_des = StateVector<state_dim, SCALAR>::Zero();
+    std::shared_ptr<CostFunctionQuadratic<state_dim, control_dim, SCALAR>> costFunction(
+        new CostFunctionQuadraticSimple<state_dim, control_dim, SCALAR>(
+            Q, R, x_des, ControlVector<control_dim, SCALAR>::Zero(), x_des, SCALAR(10.0) * Q));
+
+    std::shared_ptr<ControlledSystem<state_dim, control_dim, SCALAR>> nonlinearSystem(new tpl::Dynamics<SCALAR>);
+    std::shared_ptr<LinearSystem<state_dim, control_dim, SCALAR>> analyticLinearSystem(
+        new tpl::LinearizedSystem<SCALAR>);
+
+    StateVector<state_dim, SCALAR> x0;
+    x0 << SCALAR(x_init);
+
+    ContinuousOptConProblem<state_dim, control_dim, SCALAR> optConProblem(
+        SCALAR(tf), x0, nonlinearSystem, costFunction, analyticLinearSystem);
+
+    size_t nSteps = settings.computeK(tf);
+    ControlVector<control_dim, SCALAR> uff_init_guess;
+    uff_init_guess << -(x0(0) + 1) * x0(0);
+    typename NLOptConSolver::Policy_t initController(StateVectorArray<state_dim, SCALAR>(nSteps + 1, x0),
+        ControlVectorArray<control_dim, SCALAR>(nSteps, uff_init_guess),
+        FeedbackArray<state_dim, control_dim, SCALAR>(nSteps, FeedbackMatrix<state_dim, control_dim, SCALAR>::Zero()),
+        settings.dt);
+
+    NLOptConSolver solver(optConProblem, settings);
+    solver.setInitialGuess(initController);
+
+    auto start = std::chrono::steady_clock::now();
+    solver.solve();
+    auto end = std::chrono::steady_clock::now();
+
+    const StateVectorArray<state_dim, SCALAR>& x = solver.getSolution().x_ref();
+    const ControlVectorArray<control_dim, SCALAR>& u = solver.getSolution().uff();
+    x_solution.resize(x.size());
+    u_solution.resize(u.size());
+    for (size_t i = 0; i < x.size(); i++)
+        x_solution[i] = x[i].template cast<double>();
+    for (size_t i = 0; i < u.size(); i++)
+        u_solution[i] = u[i].template cast<double>();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+
+/*!
+ * compare the solutions of the nonlinear test problem in double, single precision and in single precision with
+ * the LQ problems solved in double precision.
+ */
+TEST(NLOCTest, NonlinearSystemPrecisionComparison)
+{
+    std::string configFile = std::string(NLOC_TEST_DIR) + "/nonlinear/solver.info";
+    std::string costFunctionFile = std::string(NLOC_TEST_DIR) + "/nonlinear/cost.info";
+
+    Eigen::Matrix<double, 1, 1> x_0;
+    ct::core::loadMatrix(costFunctionFile, "x_0", x_0);
+
+    ct::core::Time tf = 3.0;
+    ct::core::loadScalar(configFile, "timeHorizon", tf);
+
+    for (const std::string algorithm : {"gnms", "ilqr"})
+    {
+        NLOptConSettings settings;
+        settings.load(configFile, false, algorithm);
+
+        StateVectorArray<state_dim> x_double, x_float, x_mixed;
+        ControlVectorArray<control_dim> u_double, u_float, u_mixed;
+
+        const double t_double = solveNonlinearSystemProblem<double>(settings, tf, x_0(0), x_double, u_double);
+        const double t_float = solveNonlinearSystemProblem<float>(settings, tf, x_0(0), x_float, u_float);
+        settings.lqoc_solver_settings.double_precision = true;
+        const double t_mixed = solveNonlinearSystemProblem<float>(settings, tf, x_0(0), x_mixed, u_mixed);
+
+        ASSERT_EQ(x_double.size(), x_float.size());
+        ASSERT_EQ(x_double.size(), x_mixed.size());
+
+        double maxErrorFloat = 0.0;
+        double maxErrorMixed = 0.0;
+        for (size_t i = 0; i < x_double.size(); i++)
+        {
+            maxErrorFloat = std::max(maxErrorFloat, std::fabs(x_double[i](0) - x_float[i](0)));
+            maxErrorMixed = std::max(maxErrorMixed, std::fabs(x_double[i](0) - x_mixed[i](0)));
+        }
+        for (size_t i = 0; i < u_double.size(); i++)
+        {
+            maxErrorFloat = std::max(maxErrorFloat, std::fabs(u_double[i](0) - u_float[i](0)));
+            maxErrorMixed = std::max(maxErrorMixed, std::fabs(u_double[i](0) - u_mixed[i](0)));
+        }
+
+        std::cout << algorithm << " double: " << t_double << " ms" << std::endl;
+        std::cout << algorithm << " float: " << t_float << " ms, max. deviation from double: " << maxErrorFloat
+                  << std::endl;
+        std::cout << algorithm << " float, LQ in double: " << t_mixed
+                  << " ms, max. deviation from double: " << maxErrorMixed << std::endl;
+
+        ASSERT_LT(maxErrorFloat, 1e-3);
+        ASSERT_LT(maxErrorMixed, 1e-3);
+    }
+}
+
 }  // namespace example
 }  // namespace optcon
 }  // namespace ct
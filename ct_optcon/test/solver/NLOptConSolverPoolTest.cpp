@@ -0,0 +1,208 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+ **********************************************************************************************************************/
+
+#include <ct/optcon/optcon.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "../testSystems/LinearOscillator.h"
+
+using namespace ct::core;
+using namespace ct::optcon;
+using namespace ct::optcon::example;
+
+typedef NLOptConSolverPool<state_dim, control_dim> Pool_t;
+typedef Pool_t::Solver_t Solver_t;
+
+
+NLOptConSettings createSettings()
+{
+    NLOptConSettings settings;
+    settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    settings.dt = 0.01;
+    settings.max_iterations = 10;
+    settings.printSummary = false;
+    return settings;
+}
+
+/*!
+ * Create problems for the oscillator with different initial and final states
+ */
+void createProblems(size_t nProblems,
+    const NLOptConSettings& settings,
+    Pool_t::ProblemArray_t& problems,
+    Pool_t::PolicyArray_t& initialGuesses)
+{
+    const double tf = 1.0;
+    const size_t K = settings.computeK(tf);
+
+    for (size_t i = 0; i < nProblems; i++)
+    {
+        StateVector<state_dim> x0;
+        x0 << 0.1 * i, 1.0;
+        Eigen::Vector2d x_final;
+        x_final << 1.0 + i, 0.0;
+
+        std::shared_ptr<ControlledSystem<state_dim, control_dim>> system(new LinearOscillator());
+        std::shared_ptr<LinearSystem<state_dim, control_dim>> linearSystem(new LinearOscillatorLinear());
+        problems.push_back(ContinuousOptConProblem<state_dim, control_dim>(
+            tf, x0, system, example::tpl::createCostFunctionLinearOscillator<double>(x_final), linearSystem));
+
+        initialGuesses.push_back(Pool_t::Policy_t(StateVectorArray<state_dim>(K + 1, x0),
+            ControlVectorArray<control_dim>(K, ControlVector<control_dim>::Zero()),
+            FeedbackArray<state_dim, control_dim>(K, FeedbackMatrix<state_dim, control_dim>::Zero()), settings.dt));
+    }
+}
+
+/*!
+ * Test that the pool gives the same results as solving the problems one after the other
+ */
+TEST(NLOptConSolverPoolTest, MatchesSequentialSolves)
+{
+    const NLOptConSettings settings = createSettings();
+
+    Pool_t::ProblemArray_t problems;
+    Pool_t::PolicyArray_t initialGuesses;
+    createProblems(20, settings, problems, initialGuesses);
+
+    Pool_t pool(settings, 3);
+    ASSERT_EQ(pool.getNumberOfThreads(), 3u);
+
+    Pool_t::ResultArray_t results;
+    for (size_t batch = 0; batch < 2; batch++)
+    {
+        // the second batch reuses the solvers of the workers
+        pool.solve(problems, initialGuesses, results);
+        ASSERT_EQ(results.size(), problems.size());
+
+        for (size_t i = 0; i < problems.size(); i++)
+        {
+            Solver_t solver(problems[i], settings);
+            solver.setInitialGuess(initialGuesses[i]);
+            const bool success = solver.solve();
+
+            ASSERT_EQ(results[i].success, success);
+            ASSERT_LT(results[i].worker, 3u);
+            ASSERT_NEAR(results[i].cost, solver.getCost(), 1e-9 * std::max(1.0, std::abs(solver.getCost())));
+
+            const Solver_t::Policy_t& policy = solver.getSolution();
+            for (size_t k = 0; k < policy.uff().size(); k++)
+                ASSERT_TRUE(results[i].policy.uff()[k].isApprox(policy.uff()[k], 1e-8));
+            ASSERT_TRUE(results[i].policy.x_ref().back().isApprox(policy.x_ref().back(), 1e-8));
+        }
+    }
+
+    // a batch with a different horizon
+    const NLOptConSettings coarseSettings = [&]() {
+        NLOptConSettings s = settings;
+        s.dt = 0.02;
+        return s;
+    }();
+    Pool_t::ProblemArray_t coarseProblems;
+    Pool_t::PolicyArray_t coarseGuesses;
+    createProblems(5, coarseSettings, coarseProblems, coarseGuesses);
+    pool.configure(coarseSettings);
+    pool.solve(coarseProblems, coarseGuesses, results);
+    ASSERT_EQ(results.size(), 5u);
+    for (size_t i = 0; i < results.size(); i++)
+        ASSERT_EQ(results[i].policy.uff().size(), coarseSettings.computeK(1.0));
+}
+
+/*!
+ * Test that errors are reported to the caller and that the pool stays usable
+ */
+TEST(NLOptConSolverPoolTest, Errors)
+{
+    const NLOptConSettings settings = createSettings();
+
+    Pool_t::ProblemArray_t problems;
+    Pool_t::PolicyArray_t initialGuesses;
+    createProblems(4, settings, problems, initialGuesses);
+
+    Pool_t pool(settings, 2);
+
+    Pool_t::PolicyArray_t tooFewGuesses(initialGuesses.begin(), initialGuesses.end() - 1);
+    ASSERT_THROW(pool.solve(problems, tooFewGuesses), std::runtime_error);
+
+    // an incomplete problem throws in the worker
+    Pool_t::ProblemArray_t invalidProblems = problems;
+    invalidProblems[2].setCostFunction(nullptr);
+    ASSERT_THROW(pool.solve(invalidProblems, initialGuesses), std::runtime_error);
+
+    ASSERT_EQ(pool.solve(problems, initialGuesses).size(), problems.size());
+    ASSERT_TRUE(pool.solve(Pool_t::ProblemArray_t(), Pool_t::PolicyArray_t()).empty());
+}
+
+/*!
+ * Oscillator which counts the evaluations of its dynamics, to detect that a batch is running
+ */
+std::atomic<size_t> dynamicsEvaluations(0);
+
+class CountingOscillator : public LinearOscillator
+{
+public:
+    void computeControlledDynamics(const StateVector<state_dim>& state,
+        const double& t,
+        const ControlVector<control_dim>& control,
+        StateVector<state_dim>& derivative) override
+    {
+        dynamicsEvaluations++;
+        LinearOscillator::computeControlledDynamics(state, t, control, derivative);
+    }
+
+    CountingOscillator* clone() const override { return new CountingOscillator(); }
+};
+
+/*!
+ * Test that configure() waits for a running batch and that the pool runs its solvers single-threaded
+ */
+TEST(NLOptConSolverPoolTest, ConfigureDuringBatch)
+{
+    NLOptConSettings settings = createSettings();
+    settings.nThreads = 4;
+    settings.nProcesses = 2;
+
+    Pool_t::ProblemArray_t problems;
+    Pool_t::PolicyArray_t initialGuesses;
+    createProblems(30, settings, problems, initialGuesses);
+    for (auto& problem : problems)
+        problem.setNonlinearSystem(std::shared_ptr<ControlledSystem<state_dim, control_dim>>(new CountingOscillator()));
+
+    Pool_t pool(settings, 3);
+    ASSERT_EQ(pool.getSettings().nThreads, 1);
+    ASSERT_EQ(pool.getSettings().nThreadsEigen, 1);
+    ASSERT_EQ(pool.getSettings().nProcesses, 1);
+
+    NLOptConSettings coarseSettings = settings;
+    coarseSettings.dt = 0.02;
+
+    dynamicsEvaluations = 0;
+    Pool_t::ResultArray_t results;
+    std::thread batch([&]() { pool.solve(problems, initialGuesses, results); });
+
+    while (dynamicsEvaluations == 0)
+        std::this_thread::yield();
+
+    // all problems of the running batch must still be solved with the old settings
+    pool.configure(coarseSettings);
+    batch.join();
+
+    ASSERT_EQ(results.size(), problems.size());
+    for (size_t i = 0; i < results.size(); i++)
+        ASSERT_EQ(results[i].policy.uff().size(), settings.computeK(1.0));
+
+    ASSERT_EQ(pool.getSettings().dt, coarseSettings.dt);
+    ASSERT_EQ(pool.getSettings().nThreads, 1);
+    ASSERT_EQ(pool.getSettings().nProcesses, 1);
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,356 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <ct/optcon/optcon.h>
+
+#include "../../testSystems/LinearOscillator.h"
+
+using namespace ct;
+using namespace ct::core;
+using namespace ct::optcon;
+
+const size_t state_dim = 6;
+const size_t control_dim = 2;
+
+typedef LQOCProblem<state_dim, control_dim> LQOCProblem_t;
+typedef CondensingLQOCSolver<state_dim, control_dim> CondensingSolver_t;
+typedef GNRiccatiSolver<state_dim, control_dim> RiccatiSolver_t;
+
+/*!
+ * Create a random LQ problem with a positive definite stage cost
+ */
+std::shared_ptr<LQOCProblem_t> createRandomProblem(int N)
+{
+    std::shared_ptr<LQOCProblem_t> p(new LQOCProblem_t(N));
+    p->setZero();
+
+    for (int k = 0; k <= N; k++)
+    {
+        Eigen::Matrix<double, state_dim + control_dim, state_dim + control_dim> W;
+        W.setRandom();
+        Eigen::Matrix<double, state_dim + control_dim, state_dim + control_dim> H =
+            W * W.transpose() + decltype(W)::Identity();
+
+        p->Q_[k] = H.topLeftCorner<state_dim, state_dim>();
+        p->qv_[k].setRandom();
+        p->q_[k] = 1.0;
+
+        if (k == N)
+            break;
+
+        p->R_[k] = H.bottomRightCorner<control_dim, control_dim>();
+        p->P_[k] = H.bottomLeftCorner<control_dim, state_dim>();
+        p->rv_[k].setRandom();
+
+        p->A_[k] = StateMatrix<state_dim>::Identity() + 0.1 * StateMatrix<state_dim>::Random();
+        p->B_[k].setRandom();
+        p->b_[k] = 0.1 * StateVector<state_dim>::Random();
+    }
+
+    return p;
+}
+
+NLOptConSettings createSettings()
+{
+    NLOptConSettings settings;
+    settings.epsilon = 0.0;
+    return settings;
+}
+
+/*!
+ * Test that the condensing solver gives the same solution and feedback as the Riccati solver
+ */
+TEST(CondensingLQOCSolverTest, MatchesRiccati)
+{
+    for (int N : {1, 5, 12})
+    {
+        std::shared_ptr<LQOCProblem_t> problem = createRandomProblem(N);
+
+        for (bool fixedHessianCorrection : {false, true})
+        {
+            NLOptConSettings settings = createSettings();
+            settings.fixedHessianCorrection = fixedHessianCorrection;
+
+            RiccatiSolver_t riccati;
+            riccati.configure(settings);
+            riccati.setProblem(problem);
+            riccati.solve();
+            riccati.computeStatesAndControls();
+
+            CondensingSolver_t condensing;
+            condensing.configure(settings);
+            condensing.setProblem(problem);
+            condensing.solve();
+            condensing.computeStatesAndControls();
+            condensing.compute_lv();
+            condensing.computeFeedbackMatrices();
+
+            ASSERT_EQ(condensing.getNumberOfActiveSetIterations(), 0);
+
+            for (int k = 0; k < N; k++)
+            {
+                ASSERT_TRUE(condensing.getSolutionControl()[k].isApprox(riccati.getSolutionControl()[k], 1e-8));
+                ASSERT_TRUE(condensing.getSolutionState()[k + 1].isApprox(riccati.getSolutionState()[k + 1], 1e-8));
+                ASSERT_TRUE(condensing.getSolutionFeedback()[k].isApprox(riccati.getSolutionFeedback()[k], 1e-8));
+                ASSERT_TRUE(condensing.get_lv()[k].isApprox(riccati.get_lv()[k], 1e-8));
+            }
+        }
+    }
+}
+
+/*!
+ * Test the active-set method against the optimality conditions of the condensed QP
+ */
+TEST(CondensingLQOCSolverTest, InputBoxConstraints)
+{
+    const int N = 8;
+    std::shared_ptr<LQOCProblem_t> problem = createRandomProblem(N);
+
+    // bounds so wide that they are inactive give the unconstrained solution
+    CondensingSolver_t unconstrained;
+    unconstrained.configure(createSettings());
+    unconstrained.setProblem(problem);
+    unconstrained.solve();
+
+    Eigen::VectorXi sparsity(1);
+    sparsity << 1;
+    ControlVectorArray<control_dim> u_nom(N, ControlVector<control_dim>::Zero());
+
+    problem->setInputBoxConstraints(1, Eigen::VectorXd::Constant(1, -1e3), Eigen::VectorXd::Constant(1, 1e3), sparsity,
+        u_nom);
+    CondensingSolver_t solver;
+    solver.configure(createSettings());
+    solver.setProblem(problem);
+    solver.solve();
+    for (int k = 0; k < N; k++)
+        ASSERT_TRUE(solver.getSolutionControl()[k].isApprox(unconstrained.getSolutionControl()[k], 1e-8));
+
+    // tight bounds on the second control, with a nominal control such that zero is infeasible at some stages
+    for (int k = 0; k < N; k++)
+        u_nom[k](1) = (k % 3 == 0) ? 0.5 : 0.0;
+    const double bound = 0.1;
+    problem->setInputBoxConstraints(
+        1, Eigen::VectorXd::Constant(1, -bound), Eigen::VectorXd::Constant(1, bound), sparsity, u_nom);
+
+    solver.setProblem(problem);
+    solver.solve();
+    ASSERT_GT(solver.getNumberOfActiveSetIterations(), 0);
+
+    LQOCCondenser<state_dim, control_dim> condenser;
+    condenser.condense(*problem, 0, N, false, true);
+    Eigen::VectorXd U(N * control_dim);
+    for (int k = 0; k < N; k++)
+        U.segment<control_dim>(k * control_dim) = solver.getSolutionControl()[k];
+    const Eigen::VectorXd gradient = condenser.H_.selfadjointView<Eigen::Lower>() * U + condenser.h_;
+
+    int nActive = 0;
+    for (int k = 0; k < N; k++)
+    {
+        const double lb = -bound - u_nom[k](1);
+        const double ub = bound - u_nom[k](1);
+        const double u = solver.getSolutionControl()[k](1);
+        ASSERT_GE(u, lb - 1e-12);
+        ASSERT_LE(u, ub + 1e-12);
+
+        // the gradient vanishes for free controls and points into the feasible set at active bounds
+        ASSERT_NEAR(gradient(k * control_dim), 0.0, 1e-7);
+        if (u <= lb + 1e-12)
+        {
+            ASSERT_GE(gradient(k * control_dim + 1), -1e-7);
+            nActive++;
+        }
+        else if (u >= ub - 1e-12)
+        {
+            ASSERT_LE(gradient(k * control_dim + 1), 1e-7);
+            nActive++;
+        }
+        else
+            ASSERT_NEAR(gradient(k * control_dim + 1), 0.0, 1e-7);
+    }
+    ASSERT_GT(nActive, 0);
+
+    // the states are consistent with the controls
+    for (int k = 0; k < N; k++)
+    {
+        const StateVector<state_dim> x_next = problem->A_[k] * solver.getSolutionState()[k] +
+                                              problem->B_[k] * solver.getSolutionControl()[k] + problem->b_[k];
+        ASSERT_TRUE(x_next.isApprox(solver.getSolutionState()[k + 1], 1e-10));
+    }
+
+    // state box constraints are not supported
+    StateVectorArray<state_dim> x_nom(N + 1, StateVector<state_dim>::Zero());
+    problem->setIntermediateStateBoxConstraints(
+        1, Eigen::VectorXd::Constant(1, -1.0), Eigen::VectorXd::Constant(1, 1.0), sparsity, x_nom);
+    ASSERT_THROW(solver.setProblem(problem), std::runtime_error);
+}
+
+/*!
+ * Test that solving the partially condensed problem and expanding the solution gives the full solution
+ */
+TEST(CondensingLQOCSolverTest, PartialCondensing)
+{
+    const size_t blockSize = 3;
+    typedef LQOCPartialCondensing<state_dim, control_dim, blockSize> PartialCondensing_t;
+    typedef PartialCondensing_t::CondensedProblem_t CondensedProblem_t;
+
+    // a horizon which is not a multiple of the block size
+    const int N = 11;
+    std::shared_ptr<LQOCProblem_t> problem = createRandomProblem(N);
+
+    PartialCondensing_t partialCondensing;
+    std::shared_ptr<CondensedProblem_t> condensed(new CondensedProblem_t());
+    partialCondensing.condense(*problem, *condensed);
+    ASSERT_EQ(condensed->getNumberOfStages(), 4);
+    ASSERT_FALSE(condensed->isConstrained());
+
+    GNRiccatiSolver<state_dim, control_dim * blockSize> condensedSolver;
+    condensedSolver.configure(createSettings());
+    condensedSolver.setProblem(condensed);
+    condensedSolver.solve();
+    condensedSolver.computeStatesAndControls();
+
+    StateVectorArray<state_dim> x;
+    ControlVectorArray<control_dim> u;
+    partialCondensing.expandSolution(
+        *problem, condensedSolver.getSolutionState(), condensedSolver.getSolutionControl(), x, u);
+
+    RiccatiSolver_t riccati;
+    riccati.configure(createSettings());
+    riccati.setProblem(problem);
+    riccati.solve();
+    riccati.computeStatesAndControls();
+
+    for (int k = 0; k < N; k++)
+    {
+        ASSERT_TRUE(u[k].isApprox(riccati.getSolutionControl()[k], 1e-8));
+        ASSERT_TRUE(x[k + 1].isApprox(riccati.getSolutionState()[k + 1], 1e-8));
+    }
+    ASSERT_TRUE(x[N].isApprox(condensedSolver.getSolutionState().back(), 1e-8));
+}
+
+/*!
+ * Test that the constraints of the partially condensed problem evaluate to the original constraints
+ */
+TEST(CondensingLQOCSolverTest, PartialCondensingConstraints)
+{
+    const size_t blockSize = 2;
+    typedef LQOCPartialCondensing<state_dim, control_dim, blockSize> PartialCondensing_t;
+    typedef PartialCondensing_t::CondensedProblem_t CondensedProblem_t;
+
+    const int N = 5;
+    std::shared_ptr<LQOCProblem_t> problem = createRandomProblem(N);
+
+    Eigen::VectorXi u_sparsity(1);
+    u_sparsity << 1;
+    problem->setInputBoxConstraints(1, Eigen::VectorXd::Constant(1, -1.0), Eigen::VectorXd::Constant(1, 2.0),
+        u_sparsity, ControlVectorArray<control_dim>(N, ControlVector<control_dim>::Zero()));
+
+    Eigen::VectorXi x_sparsity(2);
+    x_sparsity << 0, 4;
+    Eigen::VectorXd x_lb(2), x_ub(2);
+    x_lb << -1.0, -2.0;
+    x_ub << 1.0, 2.0;
+    problem->setIntermediateStateBoxConstraints(
+        2, x_lb, x_ub, x_sparsity, StateVectorArray<state_dim>(N + 1, StateVector<state_dim>::Zero()));
+
+    PartialCondensing_t partialCondensing;
+    CondensedProblem_t condensed;
+    partialCondensing.condense(*problem, condensed);
+    ASSERT_EQ(condensed.getNumberOfStages(), 3);
+
+    // stacked input bounds, state bounds at the block boundaries and general constraints inside the blocks
+    ASSERT_EQ(condensed.nbu_[0], 2);
+    ASSERT_EQ(condensed.nbu_[2], 1);
+    ASSERT_EQ(condensed.u_I_[0](1), static_cast<int>(control_dim) + 1);
+    ASSERT_EQ(condensed.nbx_[1], 2);
+    ASSERT_EQ(condensed.ng_[0], 2);
+    ASSERT_EQ(condensed.ng_[2], 0);
+
+    // evaluate the constraints along a random trajectory
+    ControlVectorArray<control_dim> u(N);
+    StateVectorArray<state_dim> x(N + 1);
+    x[0].setZero();
+    for (int k = 0; k < N; k++)
+    {
+        u[k].setRandom();
+        x[k + 1] = problem->A_[k] * x[k] + problem->B_[k] * u[k] + problem->b_[k];
+    }
+
+    for (int b = 0; b < 2; b++)
+    {
+        const int start = b * blockSize;
+        Eigen::Matrix<double, control_dim * blockSize, 1> u_block;
+        u_block << u[start], u[start + 1];
+
+        const Eigen::VectorXd g = condensed.C_[b] * x[start] + condensed.D_[b] * u_block;
+        for (int i = 0; i < 2; i++)
+        {
+            const double x_interior = x[start + 1](x_sparsity(i));
+            ASSERT_NEAR(g(i) - condensed.d_lb_[b](i), x_interior - x_lb(i), 1e-10);
+            ASSERT_NEAR(g(i) - condensed.d_ub_[b](i), x_interior - x_ub(i), 1e-10);
+        }
+
+        // the condensed dynamics map to the first state of the next block
+        const StateVector<state_dim> x_next = condensed.A_[b] * x[start] + condensed.B_[b] * u_block + condensed.b_[b];
+        ASSERT_TRUE(x_next.isApprox(x[start + blockSize], 1e-10));
+    }
+}
+
+/*!
+ * Test that NLOC gives the same result with the condensing and the Riccati solver
+ */
+TEST(CondensingLQOCSolverTest, NLOC)
+{
+    using namespace ct::optcon::example;
+
+    NLOptConSettings settings;
+    settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::GNMS;
+    settings.dt = 0.01;
+    settings.max_iterations = 10;
+    settings.printSummary = false;
+
+    const double tf = 0.5;
+    const size_t K = settings.computeK(tf);
+
+    StateVector<example::state_dim> x0;
+    x0 << 0.0, 1.0;
+    Eigen::Vector2d x_final;
+    x_final << 1.0, 0.0;
+
+    std::shared_ptr<ControlledSystem<example::state_dim, example::control_dim>> system(new LinearOscillator());
+    std::shared_ptr<LinearSystem<example::state_dim, example::control_dim>> linearSystem(
+        new LinearOscillatorLinear());
+    ContinuousOptConProblem<example::state_dim, example::control_dim> optConProblem(
+        tf, x0, system, example::tpl::createCostFunctionLinearOscillator<double>(x_final), linearSystem);
+
+    typedef NLOptConSolver<example::state_dim, example::control_dim> NLOptConSolver_t;
+    NLOptConSolver_t::Policy_t initialGuess(StateVectorArray<example::state_dim>(K + 1, x0),
+        ControlVectorArray<example::control_dim>(K, ControlVector<example::control_dim>::Zero()),
+        FeedbackArray<example::state_dim, example::control_dim>(
+            K, FeedbackMatrix<example::state_dim, example::control_dim>::Zero()),
+        settings.dt);
+
+    settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::GNRICCATI_SOLVER;
+    NLOptConSolver_t riccati(optConProblem, settings);
+    riccati.setInitialGuess(initialGuess);
+    riccati.solve();
+
+    settings.lqocp_solver = NLOptConSettings::LQOCP_SOLVER::CONDENSING_SOLVER;
+    NLOptConSolver_t condensing(optConProblem, settings);
+    condensing.setInitialGuess(initialGuess);
+    condensing.solve();
+
+    ASSERT_NEAR(condensing.getCost(), riccati.getCost(), 1e-8 * std::abs(riccati.getCost()));
+    for (size_t k = 0; k < K; k++)
+        ASSERT_TRUE(condensing.getSolution().uff()[k].isApprox(riccati.getSolution().uff()[k], 1e-6));
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
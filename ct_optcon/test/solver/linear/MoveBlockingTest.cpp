@@ -0,0 +1,262 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include <ct/optcon/optcon.h>
+
+#include "../../testSystems/LinearOscillator.h"
+
+using namespace ct;
+using namespace ct::core;
+using namespace ct::optcon;
+
+const size_t state_dim = 4;
+const size_t control_dim = 2;
+
+typedef LQOCProblem<state_dim, control_dim> LQOCProblem_t;
+typedef GNRiccatiSolver<state_dim, control_dim> RiccatiSolver_t;
+
+/*!
+ * Create a random LQ problem with a positive definite stage cost
+ */
+std::shared_ptr<LQOCProblem_t> createRandomProblem(int N)
+{
+    std::shared_ptr<LQOCProblem_t> p(new LQOCProblem_t(N));
+    p->setZero();
+
+    for (int k = 0; k <= N; k++)
+    {
+        Eigen::Matrix<double, state_dim + control_dim, state_dim + control_dim> W;
+        W.setRandom();
+        Eigen::Matrix<double, state_dim + control_dim, state_dim + control_dim> H =
+            W * W.transpose() + decltype(W)::Identity();
+
+        p->Q_[k] = H.topLeftCorner<state_dim, state_dim>();
+        p->qv_[k].setRandom();
+
+        if (k == N)
+            break;
+
+        p->R_[k] = H.bottomRightCorner<control_dim, control_dim>();
+        p->P_[k] = H.bottomLeftCorner<control_dim, state_dim>();
+        p->rv_[k].setRandom();
+
+        p->A_[k] = StateMatrix<state_dim>::Identity() + 0.1 * StateMatrix<state_dim>::Random();
+        p->B_[k].setRandom();
+        p->b_[k] = 0.1 * StateVector<state_dim>::Random();
+    }
+
+    return p;
+}
+
+/*!
+ * Reference solution: write the states as affine function of the block controls and solve the dense problem
+ */
+ControlVectorArray<control_dim> solveDense(LQOCProblem_t& p, const std::vector<int>& blockStarts)
+{
+    const int N = p.getNumberOfStages();
+    const int nz = N * control_dim;  // one control per stage, the unused ones are fixed to zero below
+
+    Eigen::MatrixXd Hz = Eigen::MatrixXd::Zero(nz, nz);
+    Eigen::VectorXd gz = Eigen::VectorXd::Zero(nz);
+
+    // x_k = Ex * z + ex, u_k = Eu * z
+    Eigen::MatrixXd Ex = Eigen::MatrixXd::Zero(state_dim, nz);
+    Eigen::VectorXd ex = Eigen::VectorXd::Zero(state_dim);
+
+    for (int k = 0; k <= N; k++)
+    {
+        Hz += Ex.transpose() * p.Q_[k] * Ex;
+        gz += Ex.transpose() * (p.Q_[k] * ex + p.qv_[k]);
+
+        if (k == N)
+            break;
+
+        Eigen::MatrixXd Eu = Eigen::MatrixXd::Zero(control_dim, nz);
+        Eu.middleCols<control_dim>(blockStarts[k] * control_dim).setIdentity();
+
+        Hz += Eu.transpose() * p.R_[k] * Eu;
+        Hz += Eu.transpose() * p.P_[k] * Ex + Ex.transpose() * p.P_[k].transpose() * Eu;
+        gz += Eu.transpose() * (p.P_[k] * ex + p.rv_[k]);
+
+        ex = (p.A_[k] * ex + p.b_[k]).eval();
+        Ex = (p.A_[k] * Ex + p.B_[k] * Eu).eval();
+    }
+
+    // fix the controls which are not the first of a block to zero
+    for (int k = 0; k < N; k++)
+    {
+        if (blockStarts[k] != k)
+        {
+            Hz.block<control_dim, control_dim>(k * control_dim, k * control_dim).setIdentity();
+            gz.segment<control_dim>(k * control_dim).setZero();
+        }
+    }
+
+    Eigen::VectorXd z = -Hz.ldlt().solve(gz);
+
+    ControlVectorArray<control_dim> u(N);
+    for (int k = 0; k < N; k++)
+        u[k] = z.segment<control_dim>(blockStarts[k] * control_dim);
+    return u;
+}
+
+
+TEST(MoveBlockingTest, BlockStarts)
+{
+    LQOCSolverSettings settings;
+    ASSERT_FALSE(settings.hasControlBlocks());
+    ASSERT_EQ(settings.computeBlockStarts(3), std::vector<int>({0, 1, 2}));
+
+    settings.control_blocks = {3, 2};
+    ASSERT_TRUE(settings.hasControlBlocks());
+    ASSERT_EQ(settings.computeBlockStarts(8), std::vector<int>({0, 0, 0, 3, 3, 5, 5, 7}));
+
+    settings.control_blocks = {1};
+    ASSERT_FALSE(settings.hasControlBlocks());
+
+    NLOptConSettings nlocSettings;
+    nlocSettings.lqoc_solver_settings.control_blocks = {2, 0};
+    ASSERT_FALSE(nlocSettings.parametersOk());
+}
+
+
+/*!
+ * The blocked Riccati recursion gives the solution of the dense problem in the block controls
+ */
+TEST(MoveBlockingTest, MatchesDenseSolution)
+{
+    for (int N : {1, 6, 11})
+    {
+        std::shared_ptr<LQOCProblem_t> problem = createRandomProblem(N);
+
+        for (std::vector<int> blocks : {std::vector<int>{1}, std::vector<int>{3, 2}, std::vector<int>{4}})
+        {
+            for (bool fixedHessianCorrection : {false, true})
+            {
+                NLOptConSettings settings;
+                settings.epsilon = 0.0;
+                settings.fixedHessianCorrection = fixedHessianCorrection;
+                settings.lqoc_solver_settings.control_blocks = blocks;
+                const std::vector<int> blockStarts = settings.lqoc_solver_settings.computeBlockStarts(N);
+
+                RiccatiSolver_t riccati;
+                riccati.configure(settings);
+                riccati.setProblem(problem);
+                riccati.solve();
+                riccati.computeStatesAndControls();
+
+                const ControlVectorArray<control_dim> u_ref = solveDense(*problem, blockStarts);
+
+                for (int k = 0; k < N; k++)
+                {
+                    ASSERT_TRUE(riccati.getSolutionControl()[k].isApprox(u_ref[k], 1e-8)) << "stage " << k;
+
+                    // the feedforward is shared within the block, only its first stage has feedback
+                    ASSERT_TRUE(riccati.get_lv()[k].isApprox(riccati.get_lv()[blockStarts[k]]));
+                    const FeedbackArray<state_dim, control_dim>& L = riccati.getSolutionFeedback();
+                    if (blockStarts[k] != k)
+                        ASSERT_TRUE(L[k].isZero());
+                }
+
+                // the state trajectory is consistent with the dynamics
+                for (int k = 0; k < N; k++)
+                {
+                    StateVector<state_dim> x_next = problem->A_[k] * riccati.getSolutionState()[k] +
+                                                    problem->B_[k] * riccati.getSolutionControl()[k] + problem->b_[k];
+                    ASSERT_TRUE(x_next.isApprox(riccati.getSolutionState()[k + 1], 1e-10));
+                }
+            }
+        }
+    }
+}
+
+
+/*!
+ * Solve the linear oscillator with GNMS and iLQR and a piecewise constant control
+ */
+TEST(MoveBlockingTest, NLOCBlockedOscillator)
+{
+    using namespace ct::optcon::example;
+    typedef NLOptConSolver<example::state_dim, example::control_dim> NLOptConSolver_t;
+
+    const double tf = 0.5;
+    StateVector<example::state_dim> x0;
+    x0 << 0.0, 1.0;
+    Eigen::Vector2d x_final;
+    x_final << 1.0, 0.0;
+
+    for (auto algorithm : {NLOptConSettings::NLOCP_ALGORITHM::GNMS, NLOptConSettings::NLOCP_ALGORITHM::ILQR})
+    {
+        NLOptConSettings settings;
+        settings.nlocp_algorithm = algorithm;
+        settings.dt = 0.01;
+        settings.K_sim = 2;
+        settings.max_iterations = 10;
+        settings.nThreads = 1;
+        settings.printSummary = false;
+
+        const size_t K = settings.computeK(tf);
+
+        std::vector<double> costs;
+        for (std::vector<int> blocks : {std::vector<int>{}, std::vector<int>{5}})
+        {
+            settings.lqoc_solver_settings.control_blocks = blocks;
+            ASSERT_TRUE(settings.parametersOk());
+
+            std::shared_ptr<ControlledSystem<example::state_dim, example::control_dim>> system(new LinearOscillator());
+            std::shared_ptr<LinearSystem<example::state_dim, example::control_dim>> linearSystem(
+                new LinearOscillatorLinear());
+            ContinuousOptConProblem<example::state_dim, example::control_dim> optConProblem(
+                tf, x0, system, example::tpl::createCostFunctionLinearOscillator<double>(x_final), linearSystem);
+
+            // the initial guess is not blocked, it gets projected onto the blocks
+            ControlVectorArray<example::control_dim> u0(K);
+            for (size_t k = 0; k < K; k++)
+                u0[k] << 0.1 * k;
+
+            NLOptConSolver_t::Policy_t initialGuess(StateVectorArray<example::state_dim>(K + 1, x0), u0,
+                FeedbackArray<example::state_dim, example::control_dim>(
+                    K, FeedbackMatrix<example::state_dim, example::control_dim>::Zero()),
+                settings.dt);
+
+            NLOptConSolver_t solver(optConProblem, settings);
+            solver.setInitialGuess(initialGuess);
+            solver.solve();
+
+            // the controls applied in the rollout, including the feedback of closed-loop shooting
+            const ControlVectorArray<example::control_dim>& u = solver.getSolution().uff();
+            const FeedbackArray<example::state_dim, example::control_dim>& L = solver.getSolution().K();
+            ASSERT_EQ(u.size(), K);
+
+            const std::vector<int> blockStarts = settings.lqoc_solver_settings.computeBlockStarts(K);
+            for (size_t k = 0; k < K; k++)
+            {
+                ASSERT_NEAR(u[k](0), u[blockStarts[k]](0), 1e-12) << "stage " << k;
+                if (blockStarts[k] != static_cast<int>(k))
+                    ASSERT_TRUE(L[k].isZero()) << "stage " << k;
+            }
+
+            costs.push_back(solver.getCost());
+        }
+
+        // blocking restricts the controls, the optimal cost can only increase
+        ASSERT_GE(costs[1], costs[0] - 1e-10);
+    }
+
+    // closed-loop multiple shooting would split the blocks at the shots
+    NLOptConSettings settings;
+    settings.nlocp_algorithm = NLOptConSettings::NLOCP_ALGORITHM::MS_ILQR;
+    ASSERT_TRUE(settings.parametersOk());
+    settings.lqoc_solver_settings.control_blocks = {5};
+    ASSERT_FALSE(settings.parametersOk());
+}
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,48 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/AutoDiff>
+
+namespace ct {
+namespace rbd {
+namespace internal {
+
+/*!
+ * \brief Trait defining basic math functions for Eigen's forward mode Auto-Diff types
+ *
+ * Allows to evaluate the RobCoGen generated algorithms with dual numbers, i.e. to propagate directional derivatives
+ * through them without taping or code generation.
+ *
+ * @tparam DER the type of the derivative vector, e.g. Eigen::Matrix<double, N, 1>
+ */
+template <typename DER>
+struct AutoDiffScalarTrait
+{
+    typedef Eigen::AutoDiffScalar<DER> Scalar;
+
+    inline static Scalar sin(const Scalar& x) { return Eigen::sin(x); }
+    inline static Scalar cos(const Scalar& x) { return Eigen::cos(x); }
+    inline static Scalar tan(const Scalar& x) { return Eigen::tan(x); }
+    inline static Scalar sinh(const Scalar& x) { return Eigen::sinh(x); }
+    inline static Scalar cosh(const Scalar& x) { return Eigen::cosh(x); }
+    inline static Scalar tanh(const Scalar& x) { return Eigen::tanh(x); }
+    inline static Scalar exp(const Scalar& x) { return Eigen::exp(x); }
+    inline static Scalar fabs(const Scalar& x) { return Eigen::abs(x); }
+    inline static Scalar sqrt(const Scalar& x) { return Eigen::sqrt(x); }
+    //! Solves a linear system of equations using Eigen's inverse functionality
+    template <int Dims>
+    inline static Eigen::Matrix<Scalar, Dims, 1> solve(const Eigen::Matrix<Scalar, Dims, Dims>& A,
+        const Eigen::Matrix<Scalar, Dims, 1>& b)
+    {
+        return A.inverse() * b;
+    }
+};
+
+}  // namespace internal
+}  // namespace rbd
+}  // namespace ct
@@ -11,12 +11,19 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #ifdef CPPAD
 #include "CppADDoubleTrait.h"
 #endif
+#include "AutoDiffScalarTrait.h"
 #include <iit/rbd/traits/TraitSelector.h>
 
 namespace iit {
 namespace rbd {
 namespace tpl {
 
+template <typename DER>
+struct TraitSelector<Eigen::AutoDiffScalar<DER>>
+{
+    typedef ct::rbd::internal::AutoDiffScalarTrait<DER> Trait;
+};
+
 #ifdef CPPAD
 template <>
 struct TraitSelector<CppAD::AD<double>>
@@ -21,7 +21,10 @@ namespace rbd {
  * \brief A general class for computing Kinematic properties
  *
  * This class implements useful Kinematic quantities. It wraps RobCoGen to
- * have access to efficient transforms and jacobians.
+ * have access to efficient transforms and jacobians. The RobCoGen container
+ * caches the end-effector transforms and jacobians per joint position, so
+ * several queries for the same state (e.g. end-effector position and velocity)
+ * only evaluate the forward kinematics once.
  */
 template <class RBD, size_t N_EE>
 class Kinematics
@@ -35,14 +38,31 @@ public:
         initEndeffectors(endEffectors_);
     }
 
+    //! the copy is independent of other, it has its own inertia properties and RobCoGen workspace
     Kinematics(const Kinematics<RBD, N_EE>& other)
-        : rbdContainer_(new RBD()), endEffectors_(other.endEffectors_), floatingBaseTransforms_(rbdContainer_)
+        : rbdContainer_(new RBD(*other.rbdContainer_)),
+          endEffectors_(other.endEffectors_),
+          floatingBaseTransforms_(rbdContainer_)
     {
     }
 
     virtual ~Kinematics() = default;
 
     Kinematics<RBD, N_EE>* clone() const { return new Kinematics<RBD, N_EE>(*this); }
+
+    /*!
+     * \brief clone which shares the inertia properties with this instance and has its own RobCoGen workspace
+     *
+     * Intended for per-thread copies of the same model. Changes of the inertia properties of either instance apply
+     * to both.
+     */
+    Kinematics<RBD, N_EE>* cloneSharingInertiaProperties() const
+    {
+        Kinematics<RBD, N_EE>* kinematics =
+            new Kinematics<RBD, N_EE>(std::shared_ptr<RBD>(new RBD(rbdContainer_->inertiaPropertiesPtr())));
+        kinematics->endEffectors_ = endEffectors_;
+        return kinematics;
+    }
     static const size_t NUM_EE = N_EE;
     static const size_t NJOINTS = RBD::NJOINTS;
     static const size_t NLINKS = RBD::NLINKS;
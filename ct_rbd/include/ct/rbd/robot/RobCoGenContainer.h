@@ -11,6 +11,10 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <kindr/Core>
 #pragma GCC diagnostic pop
 
+#include <array>
+#include <memory>
+#include <type_traits>
+
 #include <ct/rbd/state/JointState.h>
 
 namespace ct {
@@ -18,6 +22,16 @@ namespace rbd {
 
 /**
  * \brief Container class containing all robcogen classes
+ *
+ * End-effector transforms, end-effector Jacobians and link force transforms are cached for the last joint position
+ * they were requested for. Repeated queries for the same joint position, e.g. the end-effector position and velocity
+ * of a contact model, are then served from the cache instead of re-evaluating the RobCoGen transform chain. The cache
+ * is only active for arithmetic scalar types, for auto-diff scalars every query is recorded as before.
+ *
+ * The inertia properties are model data which does not change during a solve. Copies of a container are independent,
+ * i.e. they get their own copy of the inertia properties. Several containers, e.g. the per-thread clones of a system,
+ * can share the inertia properties explicitly by passing inertiaPropertiesPtr() of one container to the constructor of
+ * the others. Transforms, Jacobians and the dynamics engines are per-container workspace in any case.
  */
 template <class RBDTrait, template <typename> class LinkDataMapT, class U>
 class RobCoGenContainer
@@ -25,15 +39,45 @@ class RobCoGenContainer
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
-    RobCoGenContainer()
+    typedef typename RBDTrait::InertiaProperties InertiaProperties;
+
+    /*!
+     * @param inertiaProperties inertia properties to share with other containers, new ones are created if nullptr
+     */
+    RobCoGenContainer(const std::shared_ptr<InertiaProperties>& inertiaProperties = nullptr)
+        : homogeneousTransforms_(),
+          motionTransforms_(),
+          forceTransforms_(),
+          jacobians_(),
+          inertiaProperties_(inertiaProperties ? inertiaProperties
+                                               : std::allocate_shared<InertiaProperties>(
+                                                     Eigen::aligned_allocator<InertiaProperties>())),
+          jSim_(*inertiaProperties_, forceTransforms_),
+          forwardDynamics_(*inertiaProperties_, motionTransforms_),
+          inverseDynamics_(*inertiaProperties_, motionTransforms_),
+          kinematicsCacheEnabled_(std::is_arithmetic<typename RBDTrait::S>::value)
+    {
+        invalidateKinematicsCache();
+    };
+
+    //! the copy gets its own inertia properties, initialized from other, and its own workspace
+    RobCoGenContainer(const RobCoGenContainer& other)
         : homogeneousTransforms_(),
           motionTransforms_(),
           forceTransforms_(),
           jacobians_(),
-          inertiaProperties_(),
-          jSim_(inertiaProperties_, forceTransforms_),
-          forwardDynamics_(inertiaProperties_, motionTransforms_),
-          inverseDynamics_(inertiaProperties_, motionTransforms_){};
+          inertiaProperties_(std::allocate_shared<InertiaProperties>(
+              Eigen::aligned_allocator<InertiaProperties>(), *other.inertiaProperties_)),
+          jSim_(*inertiaProperties_, forceTransforms_),
+          forwardDynamics_(*inertiaProperties_, motionTransforms_),
+          inverseDynamics_(*inertiaProperties_, motionTransforms_),
+          kinematicsCacheEnabled_(other.kinematicsCacheEnabled_)
+    {
+        invalidateKinematicsCache();
+    }
+
+    //! the dynamics engines refer to the members of this container, hence it cannot be assigned
+    RobCoGenContainer& operator=(const RobCoGenContainer&) = delete;
 
     typedef typename RBDTrait::S SCALAR;
 
@@ -43,6 +87,7 @@ public:
 
     static const size_t NJOINTS = RBDTrait::joints_count;
     static const size_t NLINKS = RBDTrait::links_count;
+    static const size_t N_EE = U::N_EE;
 
     typedef RobCoGenContainer<RBDTrait, LinkDataMapT, UTILS> specialized_t;
     typedef std::shared_ptr<specialized_t> Ptr_t;
@@ -51,7 +96,6 @@ public:
     typedef typename RBDTrait::MotionTransforms MotionTransforms;
     typedef typename RBDTrait::ForceTransforms ForceTransforms;
     typedef typename RBDTrait::Jacobians Jacobians;
-    typedef typename RBDTrait::InertiaProperties InertiaProperties;
     typedef typename RBDTrait::JSIM JSIM;
     typedef typename RBDTrait::FwdDynEngine ForwardDynamics;
     typedef typename RBDTrait::InvDynEngine InverseDynamics;
@@ -78,8 +122,13 @@ public:
     const ForceTransforms& forceTransforms() const { return forceTransforms_; };
     Jacobians& jacobians() { return jacobians_; };
     const Jacobians& jacobians() const { return jacobians_; };
-    InertiaProperties& inertiaProperties() { return inertiaProperties_; };
-    const InertiaProperties& inertiaProperties() const { return inertiaProperties_; };
+    //! the inertia properties, modifications apply to all containers sharing them
+    InertiaProperties& inertiaProperties() { return *inertiaProperties_; };
+    const InertiaProperties& inertiaProperties() const { return *inertiaProperties_; };
+    //! the inertia properties, to be passed to the constructor of containers which should share them
+    const std::shared_ptr<InertiaProperties>& inertiaPropertiesPtr() const { return inertiaProperties_; }
+    //! true if the inertia properties are shared with other containers
+    bool sharesInertiaProperties() const { return inertiaProperties_.use_count() > 1; }
     JSIM& jSim() { return jSim_; }
     const JSIM& jSim() const { return jSim_; }
     ForwardDynamics& forwardDynamics() { return forwardDynamics_; };
@@ -117,7 +166,16 @@ public:
     ForceTransform getForceTransformLinkBaseById(size_t linkId,
         const typename JointState<NJOINTS, SCALAR>::Position& jointPosition)
     {
-        return UTILS::getTransformLinkBaseById(forceTransforms(), linkId, jointPosition);
+        if (!kinematicsCacheEnabled_ || linkId >= NLINKS)
+            return UTILS::getTransformLinkBaseById(forceTransforms(), linkId, jointPosition);
+
+        updateKinematicsCache(jointPosition);
+        if (!linkForceTransformCached_[linkId])
+        {
+            linkForceTransforms_[linkId] = UTILS::getTransformLinkBaseById(forceTransforms(), linkId, jointPosition);
+            linkForceTransformCached_[linkId] = true;
+        }
+        return linkForceTransforms_[linkId];
     }
 
     /**
@@ -134,7 +192,16 @@ public:
     HomogeneousTransform getHomogeneousTransformBaseEEById(size_t eeId,
         const typename JointState<NJOINTS, SCALAR>::Position& jointPosition)
     {
-        return UTILS::getTransformBaseEEById(homogeneousTransforms(), eeId, jointPosition);
+        if (!kinematicsCacheEnabled_ || eeId >= N_EE)
+            return UTILS::getTransformBaseEEById(homogeneousTransforms(), eeId, jointPosition);
+
+        updateKinematicsCache(jointPosition);
+        if (!eeTransformCached_[eeId])
+        {
+            eeTransforms_[eeId] = UTILS::getTransformBaseEEById(homogeneousTransforms(), eeId, jointPosition);
+            eeTransformCached_[eeId] = true;
+        }
+        return eeTransforms_[eeId];
     }
 
 
@@ -146,7 +213,16 @@ public:
 	 */
     Jacobian getJacobianBaseEEbyId(size_t eeId, const typename JointState<NJOINTS, SCALAR>::Position& jointPosition)
     {
-        return UTILS::getJacobianBaseEEbyId(jacobians(), eeId, jointPosition);
+        if (!kinematicsCacheEnabled_ || eeId >= N_EE)
+            return UTILS::getJacobianBaseEEbyId(jacobians(), eeId, jointPosition);
+
+        updateKinematicsCache(jointPosition);
+        if (!eeJacobianCached_[eeId])
+        {
+            eeJacobians_[eeId] = UTILS::getJacobianBaseEEbyId(jacobians(), eeId, jointPosition);
+            eeJacobianCached_[eeId] = true;
+        }
+        return eeJacobians_[eeId];
     }
 
     //	/**
@@ -199,16 +275,65 @@ public:
         return getHomogeneousTransformBaseEEById(eeId, jointPosition).template topLeftCorner<3, 3>();
     }
 
+    /*!
+     * \brief Enable or disable the kinematics cache
+     *
+     * The cache can only be enabled for arithmetic scalar types. Caching values of auto-diff scalars would cut them
+     * from the current recording.
+     */
+    void setKinematicsCacheEnabled(bool enabled)
+    {
+        kinematicsCacheEnabled_ = enabled && std::is_arithmetic<SCALAR>::value;
+        invalidateKinematicsCache();
+    }
+
+    bool kinematicsCacheEnabled() const { return kinematicsCacheEnabled_; }
+    /*!
+     * \brief Discard all cached kinematic quantities
+     *
+     * Needs to be called if the transforms or Jacobians are modified through any path other than the joint position,
+     * e.g. after changing the robot parameters.
+     */
+    void invalidateKinematicsCache()
+    {
+        kinematicsCacheValid_ = false;
+        eeTransformCached_.fill(false);
+        eeJacobianCached_.fill(false);
+        linkForceTransformCached_.fill(false);
+    }
+
 
 private:
+    //! drop all cached quantities if they were computed for a different joint position
+    void updateKinematicsCache(const typename JointState<NJOINTS, SCALAR>::Position& jointPosition)
+    {
+        if (kinematicsCacheValid_ && cachedJointPosition_ == jointPosition)
+            return;
+
+        invalidateKinematicsCache();
+        cachedJointPosition_ = jointPosition;
+        kinematicsCacheValid_ = true;
+    }
+
     HomogeneousTransforms homogeneousTransforms_;
     MotionTransforms motionTransforms_;
     ForceTransforms forceTransforms_;
     Jacobians jacobians_;
-    InertiaProperties inertiaProperties_;
+    std::shared_ptr<InertiaProperties> inertiaProperties_;
     JSIM jSim_;
     ForwardDynamics forwardDynamics_;
     InverseDynamics inverseDynamics_;
+
+    //! kinematics cache, valid for cachedJointPosition_
+    bool kinematicsCacheEnabled_;
+    bool kinematicsCacheValid_;
+    typename JointState<NJOINTS, SCALAR>::Position cachedJointPosition_;
+    std::array<HomogeneousTransform, N_EE> eeTransforms_;
+    std::array<bool, N_EE> eeTransformCached_;
+    std::array<Jacobian, N_EE> eeJacobians_;
+    std::array<bool, N_EE> eeJacobianCached_;
+    std::array<ForceTransform, NLINKS> linkForceTransforms_;
+    std::array<bool, NLINKS> linkForceTransformCached_;
 };
 
 
@@ -0,0 +1,351 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include <ct/rbd/state/RigidBodyPose.h>
+#include <ct/rbd/robot/jacobian/ConstraintJacobian.h>
+
+#include "RBDSystem.h"
+
+namespace ct {
+namespace rbd {
+
+/**
+ * \brief A floating base rigid body system with hard, frictional end-effector contacts, integrated by a velocity-level
+ * contact-implicit time stepper.
+ *
+ * In contrast to FloatingBaseFDSystem with an EEContactModel, contacts are not modelled by stiff penalty forces but
+ * by impulses that are solved for at every step, similar to the time stepping schemes of Stewart-Trinkle and Anitescu.
+ * The system is therefore not stiff and can be stepped with time steps that are limited by the accuracy of the
+ * smooth dynamics only.
+ *
+ * The state is the same as the one of FloatingBaseFDSystem with Euler angles
+ * \f[
+ * 	x = [ {}_W q_B ~ {}_W p_B ~ \theta_J ~ {}_B \omega_B ~ {}_B v_B ~ \dot{\theta}_J ]^T
+ * \f]
+ * and the control input are the joint torques. One step of length \f$ \Delta t \f$ computes the generalized velocity
+ * \f[
+ *  M (\nu^+ - \nu) = \Delta t (S^T \tau - h) + \sum_i J_i^T P_i
+ * \f]
+ *
+ * where \f$ J_i \f$ is the world frame translational Jacobian of end-effector \f$ i \f$ and \f$ P_i \f$ its contact
+ * impulse, followed by a semi-implicit Euler update of the positions with \f$ \nu^+ \f$. For every end-effector that
+ * touches the ground plane \f$ z = z_{offset} \f$ during the step, the impulses satisfy
+ *
+ * - the velocity-level non-penetration constraint \f$ v_{n,i}^+ + b_i \geq 0 \f$ complementary to \f$ P_{n,i} \geq 0
+ *   \f$, where \f$ b_i = \phi_i / \Delta t \f$ allows closing a positive gap \f$ \phi_i \f$ within the step and
+ *   \f$ b_i = \epsilon \phi_i / \Delta t \f$ removes a fraction \f$ \epsilon \f$ of a penetration
+ * - the Coulomb friction cone \f$ \| P_{t,i} \| \leq \mu P_{n,i} \f$
+ *
+ * The resulting cone complementarity problem is solved by projected Gauss-Seidel iterations on the contact space,
+ * regularized by a small constraint force mixing term. Each end-effector enters with a block of three constraints.
+ *
+ * The system is a ct::core::DiscreteControlledSystem. Since the contact impulses are a non-smooth function of the
+ * state, it is linearized by finite differences through ct::core::DiscreteSystemLinearizer.
+ *
+ * \warning assumes flat ground at height \f$ z_{offset} \f$ and point contacts at the end-effectors
+ */
+template <class RBDDynamics>
+class ContactImplicitFDSystem
+    : public RBDSystem<RBDDynamics, false>,
+      public core::DiscreteControlledSystem<RBDDynamics::NSTATE, RBDDynamics::NJOINTS, typename RBDDynamics::SCALAR>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using Dynamics = RBDDynamics;
+    using Kinematics = typename RBDDynamics::Kinematics_t;
+
+    typedef typename RBDDynamics::SCALAR SCALAR;
+
+    const static size_t N_EE = RBDDynamics::N_EE;
+    const static size_t NJOINTS = RBDDynamics::NJOINTS;
+    const static size_t NDOF = NJOINTS + 6;
+    const static size_t STATE_DIM = RBDDynamics::NSTATE;
+    const static size_t CONTROL_DIM = RBDDynamics::NJOINTS;
+
+    typedef core::DiscreteControlledSystem<STATE_DIM, CONTROL_DIM, SCALAR> Base;
+    typedef typename Base::state_vector_t state_vector_t;
+    typedef typename Base::control_vector_t control_vector_t;
+    typedef typename Base::time_t time_t;
+
+    typedef Eigen::Matrix<SCALAR, NDOF, 1> coordinate_vector_t;
+    typedef Eigen::Matrix<SCALAR, NDOF, NDOF> inertia_matrix_t;
+    typedef Eigen::Matrix<SCALAR, 3, 1> Vector3s;
+    typedef std::array<Vector3s, N_EE> EEImpulses;
+    typedef std::array<bool, N_EE> ActiveMap;
+
+    typedef tpl::ConstraintJacobian<Kinematics, 3 * N_EE, NJOINTS, SCALAR> ConstraintJacobian_t;
+
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, Eigen::Dynamic> MatrixXs;
+    typedef Eigen::Matrix<SCALAR, Eigen::Dynamic, 1> VectorXs;
+
+    /*!
+     * \brief Constructor
+     * @param dt time step
+     * @param mu friction coefficient
+     * @param erp fraction of a ground penetration that is corrected per step
+     * @param cfm constraint force mixing, regularizes the contact problem
+     * @param zOffset height of the ground plane
+     * @param maxIterations maximum number of projected Gauss-Seidel iterations
+     * @param tolerance convergence tolerance on the change of the impulses
+     */
+    ContactImplicitFDSystem(const SCALAR& dt = SCALAR(0.01),
+        const SCALAR& mu = SCALAR(0.8),
+        const SCALAR& erp = SCALAR(0.2),
+        const SCALAR& cfm = SCALAR(1e-8),
+        const SCALAR& zOffset = SCALAR(0.0),
+        const size_t maxIterations = 100,
+        const SCALAR& tolerance = SCALAR(1e-10))
+        : Base(core::SYSTEM_TYPE::SECOND_ORDER),
+          dynamics_(),
+          dt_(dt),
+          mu_(mu),
+          erp_(erp),
+          cfm_(cfm),
+          zOffset_(zOffset),
+          maxIterations_(maxIterations),
+          tolerance_(tolerance),
+          iterations_(0)
+    {
+        EEactive_.fill(true);
+        resetContactJacobian();
+    }
+
+    ContactImplicitFDSystem(const ContactImplicitFDSystem<RBDDynamics>& other)
+        : Base(other),
+          dynamics_(other.dynamics_),
+          dt_(other.dt_),
+          mu_(other.mu_),
+          erp_(other.erp_),
+          cfm_(other.cfm_),
+          zOffset_(other.zOffset_),
+          maxIterations_(other.maxIterations_),
+          tolerance_(other.tolerance_),
+          EEactive_(other.EEactive_),
+          iterations_(0)
+    {
+        resetContactJacobian();
+    }
+
+    virtual ~ContactImplicitFDSystem() {}
+    virtual ContactImplicitFDSystem<RBDDynamics>* clone() const override
+    {
+        return new ContactImplicitFDSystem<RBDDynamics>(*this);
+    }
+
+    virtual RBDDynamics& dynamics() override { return dynamics_; }
+    virtual const RBDDynamics& dynamics() const override { return dynamics_; }
+    virtual void propagateControlledDynamics(const state_vector_t& state,
+        const time_t n,
+        const control_vector_t& control,
+        state_vector_t& stateNext) override
+    {
+        typename RBDDynamics::RBDState_t x(tpl::RigidBodyPose<SCALAR>::EULER);
+        x.fromStateVectorEulerXyz(state);
+
+        // unconstrained velocity update
+        updateDynamicsTerms(x, control);
+        llt_.compute(M_);
+
+        const coordinate_vector_t v = x.toCoordinateVelocity();
+        coordinate_vector_t vNext = v + dt_ * llt_.solve(f_ - h_);
+
+        for (size_t i = 0; i < N_EE; i++)
+            impulses_[i].setZero();
+        iterations_ = 0;
+
+        if (detectContacts(x, vNext))
+            solveContactImpulses(vNext);
+
+        // semi-implicit Euler, the positions are updated with the new velocities
+        state_vector_t stateVelocityNext = state;
+        stateVelocityNext.template tail<NDOF>() = vNext;
+        typename RBDDynamics::RBDState_t xNext(tpl::RigidBodyPose<SCALAR>::EULER);
+        xNext.fromStateVectorEulerXyz(stateVelocityNext);
+
+        typename RBDDynamics::RBDAcceleration_t acceleration;
+        acceleration.base().fromVector6d((vNext - v).template head<6>() / dt_);
+        acceleration.joints().setAcceleration((vNext - v).template tail<NJOINTS>() / dt_);
+
+        stateNext = state + dt_ * acceleration.toStateUpdateVectorEulerXyz(xNext);
+    }
+
+    /**
+     * \brief Sets which end-effectors can make contact
+     * @param activeMap flags of active end-effectors
+     */
+    void setActiveEE(const ActiveMap& activeMap) { EEactive_ = activeMap; }
+    //! contact impulses of the last step, expressed in the world frame
+    const EEImpulses& getContactImpulses() const { return impulses_; }
+    //! number of projected Gauss-Seidel iterations of the last step
+    size_t getIterations() const { return iterations_; }
+    SCALAR& dt() { return dt_; }
+    SCALAR& mu() { return mu_; }
+    SCALAR& erp() { return erp_; }
+    SCALAR& cfm() { return cfm_; }
+    SCALAR& zOffset() { return zOffset_; }
+    size_t& maxIterations() { return maxIterations_; }
+    SCALAR& tolerance() { return tolerance_; }
+private:
+    //! the constraint Jacobian covers all end-effectors, the rows of the ones not in contact are skipped
+    void resetContactJacobian()
+    {
+        Jc_.ee_indices_.clear();
+        for (size_t i = 0; i < N_EE; i++)
+        {
+            Jc_.ee_indices_.push_back(i);
+            Jc_.eeInContact_[i] = true;
+        }
+        Jc_.c_size_ = 3 * N_EE;
+    }
+
+    //! Update M, h and f terms of the dynamics equation, see ProjectedDynamics
+    void updateDynamicsTerms(const typename RBDDynamics::RBDState_t& x, const control_vector_t& u)
+    {
+        Eigen::Matrix<SCALAR, NJOINTS, 1> jForces, jForcesGravity;
+        Eigen::Matrix<SCALAR, 6, 1> baseWrench, baseWrenchGravity;
+
+        auto& robcogen = dynamics_.kinematics().robcogen();
+        robcogen.inverseDynamics().C_terms_fully_actuated(
+            baseWrench, jForces, x.baseVelocities().getVector(), x.joints().getPositions(), x.joints().getVelocities());
+        robcogen.inverseDynamics().G_terms_fully_actuated(
+            baseWrenchGravity, jForcesGravity, x.basePose().computeGravityB6D(), x.joints().getPositions());
+
+        M_ = robcogen.jSim().update(x.joints().getPositions());
+
+        h_ << baseWrench + baseWrenchGravity, jForces + jForcesGravity;
+        f_ << Eigen::Matrix<SCALAR, 6, 1>::Zero(), u;
+    }
+
+    /*!
+     * \brief Collects the end-effectors that can touch the ground within the step
+     *
+     * An end-effector is considered if it penetrates the ground or would reach it with the unconstrained velocity.
+     * @param x current state
+     * @param vFree unconstrained generalized velocity at the end of the step
+     * @return true if any end-effector is in contact
+     */
+    bool detectContacts(const typename RBDDynamics::RBDState_t& x, const coordinate_vector_t& vFree)
+    {
+        Jc_.getJacobianOrigin(x, J_);
+        const Eigen::Matrix<SCALAR, 3, 3> R_WB = x.basePose().getRotationMatrix().toImplementation();
+
+        contacts_.clear();
+        for (size_t i = 0; i < N_EE; i++)
+        {
+            if (!EEactive_[i])
+                continue;
+
+            const Eigen::Matrix<SCALAR, 3, NDOF> J_W = R_WB * J_.template block<3, NDOF>(3 * i, 0);
+            const SCALAR gap =
+                dynamics_.kinematics().getEEPositionInWorld(i, x.basePose(), x.jointPositions()).toImplementation()(2) -
+                zOffset_;
+            const SCALAR vn = J_W.row(2) * vFree;
+
+            if (gap + dt_ * std::min(vn, SCALAR(0.0)) < SCALAR(0.0))
+            {
+                JW_.template block<3, NDOF>(3 * i, 0) = J_W;
+                gap_[i] = gap;
+                contacts_.push_back(i);
+            }
+        }
+
+        return !contacts_.empty();
+    }
+
+    /*!
+     * \brief Solves for the contact impulses by projected Gauss-Seidel and applies them to the velocity
+     * @param v unconstrained generalized velocity, the constrained velocity on return
+     */
+    void solveContactImpulses(coordinate_vector_t& v)
+    {
+        const size_t nc = contacts_.size();
+
+        MatrixXs J(3 * nc, NDOF);
+        VectorXs b = VectorXs::Zero(3 * nc);
+        for (size_t c = 0; c < nc; c++)
+        {
+            const size_t i = contacts_[c];
+            J.template middleRows<3>(3 * c) = JW_.template block<3, NDOF>(3 * i, 0);
+            b(3 * c + 2) = gap_[i] > SCALAR(0.0) ? gap_[i] / dt_ : erp_ * gap_[i] / dt_;
+        }
+
+        // Delassus operator and contact velocity without impulses
+        const MatrixXs MinvJt = llt_.solve(J.transpose());
+        MatrixXs G = J * MinvJt;
+        G.diagonal().array() += cfm_;
+        const VectorXs vc = J * v + b;
+
+        VectorXs P = VectorXs::Zero(3 * nc);
+        for (iterations_ = 1; iterations_ <= maxIterations_; iterations_++)
+        {
+            SCALAR maxDelta(0.0);
+            for (size_t c = 0; c < nc; c++)
+            {
+                const size_t n = 3 * c + 2;
+
+                // normal impulse, projected onto the positive half line
+                const SCALAR Pn = std::max(SCALAR(0.0), P(n) - (vc(n) + G.row(n).dot(P)) / G(n, n));
+                maxDelta = std::max(maxDelta, std::abs(Pn - P(n)));
+                P(n) = Pn;
+
+                // tangential impulse, projected onto the friction disc
+                const Eigen::Matrix<SCALAR, 2, 1> residual =
+                    vc.template segment<2>(3 * c) + G.template middleRows<2>(3 * c) * P;
+                const Eigen::Matrix<SCALAR, 2, 2> Gtt = G.template block<2, 2>(3 * c, 3 * c);
+                Eigen::Matrix<SCALAR, 2, 1> Pt = P.template segment<2>(3 * c) - Gtt.inverse() * residual;
+
+                const SCALAR PtNorm = Pt.norm();
+                if (PtNorm > mu_ * Pn)
+                    Pt *= mu_ * Pn / PtNorm;
+
+                maxDelta = std::max(maxDelta, (Pt - P.template segment<2>(3 * c)).template lpNorm<Eigen::Infinity>());
+                P.template segment<2>(3 * c) = Pt;
+            }
+
+            if (maxDelta <= tolerance_ * (SCALAR(1.0) + P.template lpNorm<Eigen::Infinity>()))
+                break;
+        }
+        iterations_ = std::min(iterations_, maxIterations_);
+
+        v += MinvJt * P;
+
+        for (size_t c = 0; c < nc; c++)
+            impulses_[contacts_[c]] = P.template segment<3>(3 * c);
+    }
+
+    RBDDynamics dynamics_;
+
+    SCALAR dt_;             //!< time step
+    SCALAR mu_;             //!< friction coefficient
+    SCALAR erp_;            //!< fraction of the penetration corrected per step
+    SCALAR cfm_;            //!< constraint force mixing
+    SCALAR zOffset_;        //!< height of the ground plane
+    size_t maxIterations_;  //!< maximum number of projected Gauss-Seidel iterations
+    SCALAR tolerance_;      //!< convergence tolerance of the projected Gauss-Seidel iterations
+    ActiveMap EEactive_;    //!< end-effectors that can make contact
+
+    ConstraintJacobian_t Jc_;
+    typename ConstraintJacobian_t::jacobian_t J_;   //!< contact Jacobians in the base frame
+    typename ConstraintJacobian_t::jacobian_t JW_;  //!< contact Jacobians in the world frame
+    std::array<SCALAR, N_EE> gap_;
+    std::vector<size_t> contacts_;
+
+    inertia_matrix_t M_;
+    coordinate_vector_t h_;
+    coordinate_vector_t f_;
+    Eigen::LLT<inertia_matrix_t> llt_;
+
+    EEImpulses impulses_;
+    size_t iterations_;
+};
+
+}  // namespace rbd
+}  // namespace ct
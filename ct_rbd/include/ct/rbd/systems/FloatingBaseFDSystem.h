@@ -60,6 +60,7 @@ public:
     virtual RBDDynamics& dynamics() override { return dynamics_; }
     virtual const RBDDynamics& dynamics() const override { return dynamics_; }
     void setContactModel(const std::shared_ptr<ContactModel>& contactModel) { eeContactModel_ = contactModel; }
+    const std::shared_ptr<ContactModel>& getContactModel() const { return eeContactModel_; }
     virtual void computePdot(const StateVector& x,
         const core::StateVector<RBDDynamics::NSTATE / 2, SCALAR>& v,
         const ControlVector& control,
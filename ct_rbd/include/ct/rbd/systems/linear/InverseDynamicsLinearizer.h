@@ -0,0 +1,179 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "RbdLinearizer.h"
+
+namespace ct {
+namespace rbd {
+
+/*!
+ *  \brief System Linearizer for FixBaseFDSystem and FloatingBaseFDSystem based on the inverse dynamics.
+ *
+ *  For the generalized acceleration \f$ \dot{v} = FD(x, u) \f$, the derivatives of the forward dynamics follow from
+ *  the ones of the inverse dynamics \f$ ID(x, \dot{v}) = S^T u \f$ as
+ *
+ *  \f$ \frac{\partial \dot{v}}{\partial x} = - M^{-1} \frac{\partial ID}{\partial x} \f$ and
+ *  \f$ \frac{\partial \dot{v}}{\partial u} = M^{-1} S^T \f$,
+ *
+ *  with the joint space inertia matrix \f$ M \f$ and the inverse dynamics evaluated at the current acceleration. Both
+ *  are evaluated with the RobCoGen inverse dynamics and joint space inertia matrix, so no code generation is required
+ *  and model changes only require recompiling the model.
+ *
+ *  - the control derivative is exact.
+ *  - the inverse dynamics are quadratic in the generalized velocity. A central difference with unit step is therefore
+ *    exact and used for the velocity derivative. If a contact model is active, the contact forces break this
+ *    structure and the velocity derivative is approximated by central differences.
+ *  - the configuration derivative is approximated by central differences of the inverse dynamics.
+ *
+ *  \note RobCoGen generates unrolled recursive algorithms per robot and does not expose a generic kinematic tree,
+ *  therefore the recursive derivatives of the RNEA can not be formed on top of it.
+ *
+ *  \warning only supports systems with Euler angle base orientation and joint torques as control inputs.
+ */
+template <class SYSTEM>
+class InverseDynamicsLinearizer : public RbdLinearizer<SYSTEM>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef RbdLinearizer<SYSTEM> Base;
+
+    static const bool FLOATING_BASE = Base::FLOATING_BASE;
+    static const size_t STATE_DIM = Base::STATE_DIM;
+    static const size_t CONTROL_DIM = Base::CONTROL_DIM;
+    static const size_t NJOINTS = Base::NJOINTS;
+
+    //! dimension of the generalized velocity
+    static const size_t NV = STATE_DIM / 2;
+
+    typedef typename Base::SCALAR SCALAR;
+    typedef typename Base::state_vector_t state_vector_t;
+    typedef typename Base::control_vector_t control_vector_t;
+    typedef typename Base::state_matrix_t state_matrix_t;
+    typedef typename Base::state_control_matrix_t state_control_matrix_t;
+
+    typedef Eigen::Matrix<SCALAR, NV, 1> generalized_vector_t;
+    typedef Eigen::Matrix<SCALAR, NV, STATE_DIM> id_jacobian_t;
+
+    /*!
+     * @param RBDSystem the system to linearize
+     * @param diffStep relative step size of the central differences w.r.t. the configuration
+     */
+    InverseDynamicsLinearizer(std::shared_ptr<SYSTEM> RBDSystem,
+        SCALAR diffStep = std::cbrt(std::numeric_limits<SCALAR>::epsilon()))
+        : Base(RBDSystem), diffStep_(diffStep)
+    {
+    }
+
+    InverseDynamicsLinearizer(const InverseDynamicsLinearizer& arg) : Base(arg), diffStep_(arg.diffStep_) {}
+    virtual ~InverseDynamicsLinearizer() override {}
+    InverseDynamicsLinearizer<SYSTEM>* clone() const override { return new InverseDynamicsLinearizer<SYSTEM>(*this); }
+    const state_matrix_t& getDerivativeState(const state_vector_t& x,
+        const control_vector_t& u,
+        const SCALAR t = 0.0) override
+    {
+        // generalized acceleration at the linearization point
+        state_vector_t xd;
+        this->RBDSystem_->computeControlledDynamics(x, t, u, xd);
+        const generalized_vector_t vd = xd.template tail<NV>();
+
+        const bool quadraticInVelocity = !hasContactModel();
+
+        id_jacobian_t dIDdx;
+        state_vector_t xPerturbed = x;
+        for (size_t i = 0; i < STATE_DIM; i++)
+        {
+            const SCALAR h = (i >= NV && quadraticInVelocity) ? SCALAR(1.0)
+                                                              : diffStep_ * std::max(SCALAR(1.0), std::abs(x(i)));
+
+            xPerturbed(i) = x(i) + h;
+            const generalized_vector_t idPlus = inverseDynamics(xPerturbed, vd);
+            xPerturbed(i) = x(i) - h;
+            const generalized_vector_t idMinus = inverseDynamics(xPerturbed, vd);
+            xPerturbed(i) = x(i);
+
+            dIDdx.col(i) = (idPlus - idMinus) / (SCALAR(2.0) * h);
+        }
+
+        const jsim_t& M = this->RBDSystem_->dynamics().kinematics().robcogen().jSim().update(
+            x.template segment<NJOINTS>(FLOATING_BASE * 6));
+        this->llt_.compute(M);
+
+        this->dFdx_.template bottomRows<NV>() = -this->llt_.solve(dIDdx);
+
+        if (FLOATING_BASE)
+            this->computeFloatingBaseKinematicDerivatives(x);
+
+        return this->dFdx_;
+    }
+
+    //! set the relative step size of the central differences w.r.t. the configuration
+    void setDiffStep(SCALAR diffStep) { diffStep_ = diffStep; }
+protected:
+    typedef typename Base::jsim_t jsim_t;
+    typedef typename SYSTEM::Dynamics Dynamics;
+
+    template <bool FB = FLOATING_BASE>
+    typename std::enable_if<!FB, bool>::type hasContactModel() const
+    {
+        return false;
+    }
+
+    template <bool FB = FLOATING_BASE>
+    typename std::enable_if<FB, bool>::type hasContactModel() const
+    {
+        return this->RBDSystem_->getContactModel() != nullptr;
+    }
+
+    //! joint torques required for the joint accelerations vd in state x
+    template <bool FB = FLOATING_BASE>
+    typename std::enable_if<!FB, generalized_vector_t>::type inverseDynamics(const state_vector_t& x,
+        const generalized_vector_t& vd)
+    {
+        typename Dynamics::ExtLinkForces_t linkForces(Eigen::Matrix<SCALAR, 6, 1>::Zero());
+        typename Dynamics::control_vector_t tau;
+
+        this->RBDSystem_->dynamics().kinematics().robcogen().inverseDynamics().id(
+            tau, x.template head<NJOINTS>(), x.template tail<NJOINTS>(), vd, linkForces);
+
+        return tau;
+    }
+
+    //! base wrench and joint torques required for the generalized acceleration vd in state x, including contacts
+    template <bool FB = FLOATING_BASE>
+    typename std::enable_if<FB, generalized_vector_t>::type inverseDynamics(const state_vector_t& x,
+        const generalized_vector_t& vd)
+    {
+        typename Dynamics::RBDState_t state(tpl::RigidBodyPose<SCALAR>::EULER);
+        state.fromStateVectorEulerXyz(x);
+
+        typename Dynamics::ExtLinkForces_t linkForces(Eigen::Matrix<SCALAR, 6, 1>::Zero());
+        if (hasContactModel())
+            this->RBDSystem_->mapEndeffectorForcesToLinkForces(
+                state, this->RBDSystem_->getContactModel()->computeContactForces(state), linkForces);
+
+        typename Dynamics::ForceVector_t baseWrench;
+        typename Dynamics::control_vector_t tau;
+
+        this->RBDSystem_->dynamics().kinematics().robcogen().inverseDynamics().id_fully_actuated(baseWrench, tau,
+            state.basePose().computeGravityB6D(), state.baseVelocities().getVector(), vd.template head<6>(),
+            state.joints().getPositions(), state.joints().getVelocities(), vd.template tail<NJOINTS>(), linkForces);
+
+        generalized_vector_t generalizedForce;
+        generalizedForce << baseWrench, tau;
+        return generalizedForce;
+    }
+
+    SCALAR diffStep_;
+};
+
+}  // namespace rbd
+}  // namespace ct
@@ -335,6 +335,59 @@ TEST(EEKinematicsTest, torqueMappingTest)
     }
 }
 
+// Test that cached kinematic quantities match the ones computed from scratch
+TEST(EEKinematicsTest, kinematicsCacheTest)
+{
+    RBDStateHyQ state;
+    TestHyQ::Kinematics kinematics;
+    TestHyQ::Kinematics kinematicsNoCache;
+    kinematicsNoCache.robcogen().setKinematicsCacheEnabled(false);
+
+    ASSERT_TRUE(kinematics.robcogen().kinematicsCacheEnabled());
+    ASSERT_FALSE(kinematicsNoCache.robcogen().kinematicsCacheEnabled());
+
+    const size_t nTests = 100;
+
+    for (size_t t = 0; t < nTests; t++)
+    {
+        // every other state only differs in the base, the joint positions stay cached
+        if (t % 2 == 0)
+            state.setRandom();
+        else
+            state.basePose().setRandom();
+
+        // query each quantity twice, in alternating order
+        for (size_t k = 0; k < 2; k++)
+        {
+            for (size_t i = 0; i < nFeet; i++)
+            {
+                ASSERT_TRUE(kinematics.getEEVelocityInWorld(i, state).toImplementation().isApprox(
+                    kinematicsNoCache.getEEVelocityInWorld(i, state).toImplementation()));
+
+                ASSERT_TRUE(kinematics.getEEPositionInWorld(i, state.basePose(), state.jointPositions())
+                                .toImplementation()
+                                .isApprox(kinematicsNoCache
+                                              .getEEPositionInWorld(i, state.basePose(), state.jointPositions())
+                                              .toImplementation()));
+
+                ASSERT_TRUE(kinematics.getEERotInWorld(i, state.basePose(), state.jointPositions())
+                                .isApprox(kinematicsNoCache.getEERotInWorld(
+                                    i, state.basePose(), state.jointPositions())));
+
+                ASSERT_TRUE(kinematics.getJacobianBaseEEbyId(i, state).isApprox(
+                    kinematicsNoCache.getJacobianBaseEEbyId(i, state)));
+
+                TestHyQ::Kinematics::EEForce eeForceW;
+                eeForceW.setRandom();
+                ASSERT_TRUE(
+                    kinematics.mapForceFromWorldToLink(eeForceW, state.basePose(), state.jointPositions(), i)
+                        .isApprox(kinematicsNoCache.mapForceFromWorldToLink(
+                            eeForceW, state.basePose(), state.jointPositions(), i)));
+            }
+        }
+    }
+}
+
 
 int main(int argc, char** argv)
 {
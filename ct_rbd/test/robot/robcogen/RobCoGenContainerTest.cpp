@@ -78,6 +78,44 @@ TEST(RobCoGenContainerTestHyQ, transformTest)
     ASSERT_FALSE(Base_RH_lowerleg.isApprox(transform::Zero()));
 }
 
+TEST(RobCoGenContainerTestHyQ, copyAndShareInertiaProperties)
+{
+    typedef ct::rbd::TestHyQ::RobCoGenContainer Container;
+    typedef ct::rbd::TestHyQ::Kinematics Kinematics;
+
+    const size_t njoints = Container::NJOINTS;
+    ct::rbd::JointState<njoints>::Position jointPos;
+    jointPos.setRandom();
+
+    // copies are independent
+    Container original;
+    Container copy(original);
+    ASSERT_NE(copy.inertiaPropertiesPtr(), original.inertiaPropertiesPtr());
+    ASSERT_FALSE(original.sharesInertiaProperties());
+    ASSERT_EQ(copy.inertiaProperties().getTotalMass(), original.inertiaProperties().getTotalMass());
+
+    // the dynamics engines of the copy work on its own members
+    original.jSim().update(jointPos);
+    copy.jSim().update(jointPos);
+    ASSERT_TRUE(copy.jSim().isApprox(original.jSim()));
+
+    // sharing is explicit
+    Container shared(original.inertiaPropertiesPtr());
+    ASSERT_EQ(shared.inertiaPropertiesPtr(), original.inertiaPropertiesPtr());
+    ASSERT_TRUE(original.sharesInertiaProperties());
+
+    Kinematics kinematics;
+    std::unique_ptr<Kinematics> kinematicsCopy(kinematics.clone());
+    std::unique_ptr<Kinematics> kinematicsShared(kinematics.cloneSharingInertiaProperties());
+    ASSERT_NE(kinematicsCopy->robcogen().inertiaPropertiesPtr(), kinematics.robcogen().inertiaPropertiesPtr());
+    ASSERT_EQ(kinematicsShared->robcogen().inertiaPropertiesPtr(), kinematics.robcogen().inertiaPropertiesPtr());
+    ASSERT_NE(&kinematicsShared->robcogen(), &kinematics.robcogen());
+
+    for (size_t i = 0; i < Kinematics::NUM_EE; i++)
+        ASSERT_TRUE(kinematicsShared->getEEPositionInBase(i, jointPos).toImplementation().isApprox(
+            kinematics.getEEPositionInBase(i, jointPos).toImplementation()));
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,148 @@
+/**********************************************************************************************************************
+This file is part of the Control Toolbox (https://github.com/ethz-adrl/control-toolbox), copyright by ETH Zurich.
+Licensed under the BSD-2 license (see LICENSE file in main directory)
+**********************************************************************************************************************/
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wunused-value"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+
+
+#include <ct/rbd/rbd.h>
+
+#include <memory>
+#include <array>
+
+#include <gtest/gtest.h>
+
+#include "../models/testhyq/RobCoGenTestHyQ.h"
+
+using namespace ct;
+using namespace ct::rbd;
+
+typedef ContactImplicitFDSystem<TestHyQ::Dynamics> HyQContactSystem;
+typedef FloatingBaseFDSystem<TestHyQ::Dynamics, false> HyQSystem;
+
+const size_t STATE_DIM = HyQContactSystem::STATE_DIM;
+const size_t CONTROL_DIM = HyQContactSystem::CONTROL_DIM;
+const size_t N_EE = HyQContactSystem::N_EE;
+
+//! lowest end-effector height of a state
+double lowestEEHeight(HyQContactSystem& system, const core::StateVector<STATE_DIM>& x)
+{
+    RBDState<12> state;
+    state.fromStateVectorEulerXyz(x);
+
+    double zMin = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < N_EE; i++)
+        zMin = std::min(zMin,
+            system.dynamics().kinematics().getEEPositionInWorld(i, state.basePose(), state.jointPositions()).z());
+    return zMin;
+}
+
+TEST(ContactImplicitFDSystemTest, free_flight_test)
+{
+    // far above the ground, a step is a semi-implicit Euler step of the forward dynamics
+    const double dt = 0.01;
+    HyQContactSystem contactSystem(dt);
+    HyQSystem system;
+
+    for (size_t i = 0; i < 20; i++)
+    {
+        RBDState<12> state;
+        state.setRandom();
+
+        core::StateVector<STATE_DIM> x = state.toStateVectorEulerXyz();
+        x(5) += 100.0;
+        core::ControlVector<CONTROL_DIM> u = core::ControlVector<CONTROL_DIM>::Random();
+
+        core::StateVector<STATE_DIM> xNext;
+        contactSystem.propagateControlledDynamics(x, 0, u, xNext);
+
+        core::StateVector<STATE_DIM> xd;
+        system.computeControlledDynamics(x, 0.0, u, xd);
+
+        const core::StateVector<STATE_DIM / 2> vNext = x.tail<STATE_DIM / 2>() + dt * xd.tail<STATE_DIM / 2>();
+        ASSERT_LT((xNext.tail<STATE_DIM / 2>() - vNext).array().abs().maxCoeff(), 1e-8);
+        ASSERT_EQ(contactSystem.getIterations(), 0u);
+        for (size_t j = 0; j < N_EE; j++)
+            ASSERT_EQ(contactSystem.getContactImpulses()[j].norm(), 0.0);
+
+        // the joint positions are updated with the new velocities
+        ASSERT_LT((xNext.segment<12>(6) - x.segment<12>(6) - dt * vNext.tail<12>()).array().abs().maxCoeff(), 1e-12);
+    }
+}
+
+TEST(ContactImplicitFDSystemTest, drop_test)
+{
+    // drop the robot with large time steps, the end-effectors must not sink into the ground and the impulses must lie
+    // in the friction cones
+    const double dt = 0.02;
+    const double mu = 0.7;
+    HyQContactSystem system(dt, mu);
+
+    RBDState<12> state;
+    state.setZero();
+    core::StateVector<STATE_DIM> x = state.toStateVectorEulerXyz();
+    x(5) = 0.1 - lowestEEHeight(system, x);
+    x.tail<12>().setRandom();
+
+    core::ControlVector<CONTROL_DIM> u = core::ControlVector<CONTROL_DIM>::Zero();
+
+    bool touchedDown = false;
+    for (size_t n = 0; n < 200; n++)
+    {
+        core::StateVector<STATE_DIM> xNext;
+        system.propagateControlledDynamics(x, n, u, xNext);
+        x = xNext;
+
+        ASSERT_TRUE(x.allFinite());
+        ASSERT_GT(lowestEEHeight(system, x), -0.02);
+
+        for (size_t i = 0; i < N_EE; i++)
+        {
+            const Eigen::Vector3d& P = system.getContactImpulses()[i];
+            ASSERT_GE(P(2), 0.0);
+            ASSERT_LE(P.head<2>().norm(), mu * P(2) + 1e-9);
+            touchedDown = touchedDown || P(2) > 0.0;
+        }
+    }
+
+    ASSERT_TRUE(touchedDown);
+
+    // a clone steps identically
+    std::shared_ptr<HyQContactSystem> clone(system.clone());
+    core::StateVector<STATE_DIM> x1, x2;
+    system.propagateControlledDynamics(x, 0, u, x1);
+    clone->propagateControlledDynamics(x, 0, u, x2);
+    ASSERT_TRUE(x1.isApprox(x2));
+}
+
+TEST(ContactImplicitFDSystemTest, linearization_test)
+{
+    std::shared_ptr<HyQContactSystem> system(new HyQContactSystem(0.01));
+    core::DiscreteSystemLinearizer<STATE_DIM, CONTROL_DIM> linearizer(system);
+
+    RBDState<12> state;
+    state.setZero();
+    core::StateVector<STATE_DIM> x = state.toStateVectorEulerXyz();
+    x(5) = -lowestEEHeight(*system, x);
+    core::ControlVector<CONTROL_DIM> u = core::ControlVector<CONTROL_DIM>::Zero();
+
+    core::StateMatrix<STATE_DIM> A;
+    core::StateControlMatrix<STATE_DIM, CONTROL_DIM> B;
+    linearizer.getAandB(x, u, x, 0, 1, A, B);
+
+    ASSERT_TRUE(A.allFinite());
+    ASSERT_TRUE(B.allFinite());
+    ASSERT_GT(B.bottomRows<STATE_DIM / 2>().array().abs().maxCoeff(), 0.0);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+#pragma GCC diagnostic pop
@@ -18,6 +18,7 @@ Licensed under the BSD-2 license (see LICENSE file in main directory)
 #include <gtest/gtest.h>
 
 #include <ct/rbd/systems/linear/RbdLinearizer.h>
+#include <ct/rbd/systems/linear/InverseDynamicsLinearizer.h>
 #include "ct/rbd/systems/FixBaseFDSystem.h"
 #include "ct/rbd/systems/FloatingBaseFDSystem.h"
 
@@ -112,6 +113,107 @@ TEST(RBDLinearizerTest, NumDiffComparisonFloatingBase)
     }
 }
 
+TEST(InverseDynamicsLinearizerTest, NumDiffComparisonFixedBase)
+{
+    typedef FixBaseFDSystem<TestIrb4600::Dynamics> IrbSystem;
+
+    const size_t STATE_DIM = IrbSystem::STATE_DIM;
+    const size_t CONTROL_DIM = IrbSystem::CONTROL_DIM;
+
+    std::shared_ptr<IrbSystem> irbSystem(new IrbSystem);
+    std::shared_ptr<IrbSystem> irbSystem2(new IrbSystem);
+
+    InverseDynamicsLinearizer<IrbSystem> idLinearizer(irbSystem);
+    core::SystemLinearizer<STATE_DIM, CONTROL_DIM> systemLinearizer(irbSystem2, true);
+
+    core::StateVector<STATE_DIM> x;
+    core::ControlVector<CONTROL_DIM> u;
+
+    size_t nTests = 500;
+    for (size_t i = 0; i < nTests; i++)
+    {
+        x.setRandom();
+        u.setRandom();
+
+        auto A_id = idLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_id = idLinearizer.getDerivativeControl(x, u, 0.0);
+
+        auto A_system = systemLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_system = systemLinearizer.getDerivativeControl(x, u, 0.0);
+
+        ASSERT_LT((A_id - A_system).array().abs().maxCoeff(), 1e-5);
+
+        ASSERT_LT((B_id - B_system).array().abs().maxCoeff(), 1e-4);
+    }
+}
+
+TEST(InverseDynamicsLinearizerTest, NumDiffComparisonFloatingBase)
+{
+    typedef FloatingBaseFDSystem<TestHyQ::Dynamics, false, false> HyQSystem;
+
+    const size_t STATE_DIM = HyQSystem::STATE_DIM;
+    const size_t CONTROL_DIM = HyQSystem::CONTROL_DIM;
+
+    std::shared_ptr<HyQSystem> hyqSystem(new HyQSystem);
+    std::shared_ptr<HyQSystem> hyqSystem2(new HyQSystem);
+
+    InverseDynamicsLinearizer<HyQSystem> idLinearizer(hyqSystem);
+    core::SystemLinearizer<STATE_DIM, CONTROL_DIM> systemLinearizer(hyqSystem2, true);
+
+    core::StateVector<STATE_DIM> x;
+    core::ControlVector<CONTROL_DIM> u;
+
+    size_t nTests = 500;
+    for (size_t i = 0; i < nTests; i++)
+    {
+        x.setRandom();
+        u.setRandom();
+
+        auto A_id = idLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_id = idLinearizer.getDerivativeControl(x, u, 0.0);
+
+        auto A_system = systemLinearizer.getDerivativeState(x, u, 0.0);
+        auto B_system = systemLinearizer.getDerivativeControl(x, u, 0.0);
+
+        ASSERT_LT((A_id - A_system).array().abs().maxCoeff(), 1e-5);
+
+        ASSERT_LT((B_id - B_system).array().abs().maxCoeff(), 1e-4);
+    }
+}
+
+TEST(InverseDynamicsLinearizerTest, NumDiffComparisonFloatingBaseContact)
+{
+    typedef FloatingBaseFDSystem<TestHyQ::Dynamics, false, false> HyQSystem;
+    typedef HyQSystem::ContactModel ContactModel;
+
+    const size_t STATE_DIM = HyQSystem::STATE_DIM;
+    const size_t CONTROL_DIM = HyQSystem::CONTROL_DIM;
+
+    std::shared_ptr<HyQSystem> hyqSystem(new HyQSystem);
+    hyqSystem->setContactModel(std::shared_ptr<ContactModel>(new ContactModel(5000.0, 1000.0, 100.0, 100.0, -0.02,
+        ContactModel::VELOCITY_SMOOTHING::SIGMOID, hyqSystem->dynamics().kinematicsPtr())));
+    std::shared_ptr<HyQSystem> hyqSystem2(hyqSystem->clone());
+
+    InverseDynamicsLinearizer<HyQSystem> idLinearizer(hyqSystem);
+    core::SystemLinearizer<STATE_DIM, CONTROL_DIM> systemLinearizer(hyqSystem2, true);
+
+    core::StateVector<STATE_DIM> x;
+    core::ControlVector<CONTROL_DIM> u;
+
+    size_t nTests = 100;
+    for (size_t i = 0; i < nTests; i++)
+    {
+        x.setRandom();
+        u.setRandom();
+
+        // both are approximations, compare relative to the magnitude of the stiff contact terms
+        auto A_id = idLinearizer.getDerivativeState(x, u, 0.0);
+        auto A_system = systemLinearizer.getDerivativeState(x, u, 0.0);
+
+        ASSERT_LT((A_id - A_system).array().abs().maxCoeff(), 1e-4 * (1.0 + A_system.array().abs().maxCoeff()));
+    }
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);